@@ -0,0 +1,386 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define CG_make_directory(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define CG_make_directory(path) mkdir(path, 0755)
+#endif
+
+/**
+ * The generator {@code SPACE/benchmarks/corpusGenerator.c} writes
+ * synthetic SPACE programs for the phase benchmark (phaseBenchmark.c).
+ *
+ * The program is built from the rules of definitions/space.grammar:
+ * enums, class hierarchies with fields, functions and constructors,
+ * nested control flow and long terms. The shape is set by the options,
+ * the same options (and seed) always write the same program, so the
+ * corpus is reproducible and does not have to be checked in.
+ *
+ * Compile and run (from the repository directory):
+ * gcc -O2 benchmarks/corpusGenerator.c -o corpusGenerator.exe
+ * corpusGenerator.exe large.txt --classes 400 --depth 4 --members 8 --term 12 --includes 16
+ * space large.txt large_lib/lib0.txt large_lib/lib1.txt ... -j 4
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+struct CorpusShape {
+	int classes;        //Classes in the main file
+	int hierarchy;      //Classes per "extends" chain
+	int members;        //Fields and functions per class
+	int depth;          //Nesting of the control flow in a function
+	int term;           //Operators per term
+	int statements;     //Statements per block
+	int includes;       //Included library files
+	unsigned int seed;
+};
+
+static unsigned int RANDOM_STATE = 42;
+
+int CG_parse_arguments(int argc, char *argv[], struct CorpusShape *shape, char **path);
+int CG_write_corpus(const char *path, struct CorpusShape *shape);
+void CG_write_library(FILE *file, int library, struct CorpusShape *shape);
+void CG_write_class(FILE *file, const char *prefix, int index, struct CorpusShape *shape);
+void CG_write_function(FILE *file, const char *prefix, int index, int member, struct CorpusShape *shape);
+void CG_write_block(FILE *file, int depth, int indent, struct CorpusShape *shape);
+void CG_write_term(FILE *file, int operators);
+void CG_write_indent(FILE *file, int indent);
+unsigned int CG_random(unsigned int bound);
+
+int main(int argc, char *argv[]) {
+	struct CorpusShape shape = {100, 4, 6, 3, 8, 4, 4, 42};
+	char *path = NULL;
+
+	if ((int)CG_parse_arguments(argc, argv, &shape, &path) == false) {
+		(void)printf("Usage: %s <output> [--classes <n>] [--hierarchy <n>] [--members <n>] [--depth <n>]\n", argv[0]);
+		(void)printf("       [--term <n>] [--statements <n>] [--includes <n>] [--seed <n>]\n");
+		return -1;
+	}
+
+	RANDOM_STATE = shape.seed;
+	return (int)CG_write_corpus(path, &shape) == true ? 0 : -1;
+}
+
+/**
+ * <p>
+ * Reads the output path and the shape of the corpus.
+ * </p>
+ *
+ * @returns true, if the arguments are valid
+ *
+ * @param argc          Argument count
+ * @param *argv[]       Arguments
+ * @param *shape        Shape to fill, keeps the defaults of missing options
+ * @param **path        Receives the output path
+ */
+int CG_parse_arguments(int argc, char *argv[], struct CorpusShape *shape, char **path) {
+	for (int i = 1; i < argc; i++) {
+		if (argv[i][0] != '-') {
+			(*path) = argv[i];
+			continue;
+		} else if (i + 1 >= argc) {
+			return false;
+		}
+
+		int value = (int)atoi(argv[++i]);
+
+		if (value < 0) {
+			return false;
+		} else if (strcmp(argv[i - 1], "--classes") == 0) {
+			shape->classes = value;
+		} else if (strcmp(argv[i - 1], "--hierarchy") == 0) {
+			shape->hierarchy = value > 0 ? value : 1;
+		} else if (strcmp(argv[i - 1], "--members") == 0) {
+			shape->members = value > 0 ? value : 1;
+		} else if (strcmp(argv[i - 1], "--depth") == 0) {
+			shape->depth = value;
+		} else if (strcmp(argv[i - 1], "--term") == 0) {
+			shape->term = value;
+		} else if (strcmp(argv[i - 1], "--statements") == 0) {
+			shape->statements = value > 0 ? value : 1;
+		} else if (strcmp(argv[i - 1], "--includes") == 0) {
+			shape->includes = value;
+		} else if (strcmp(argv[i - 1], "--seed") == 0) {
+			shape->seed = (unsigned int)value;
+		} else {
+			return false;
+		}
+	}
+
+	return (*path) != NULL;
+}
+
+/**
+ * <p>
+ * Writes the main file and the included library files
+ * ("<name>_lib/lib<n>.txt" next to the main file). The library files
+ * include their predecessor, so the driver gets a dependency chain.
+ * </p>
+ *
+ * @returns true, if all files were written
+ *
+ * @param *path     Path of the main file
+ * @param *shape    Shape of the corpus
+ */
+int CG_write_corpus(const char *path, struct CorpusShape *shape) {
+	//"include large_lib.lib0;" is made of identifiers, so other characters of the name become '_'
+	const char *slash = strrchr(path, '/');
+	const char *name = slash != NULL ? slash + 1 : path;
+	size_t directoryLength = (size_t)(name - path);
+	size_t nameLength = strcspn(name, ".");
+	char *libraryName = (char*)malloc(nameLength + 16);
+	char *libraryPath = (char*)malloc(directoryLength + nameLength + 32);
+
+	if (libraryName == NULL || libraryPath == NULL) {
+		(void)printf("Could not allocate the library path!\n");
+		(void)free(libraryName);
+		(void)free(libraryPath);
+		return false;
+	}
+
+	for (size_t i = 0; i < nameLength; i++) {
+		int valid = (name[i] >= 'a' && name[i] <= 'z') || (name[i] >= 'A' && name[i] <= 'Z') || (name[i] >= '0' && name[i] <= '9');
+		libraryName[i] = valid == true ? name[i] : '_';
+	}
+
+	(void)strcpy(&libraryName[nameLength], "_lib");
+	(void)snprintf(libraryPath, directoryLength + nameLength + 32, "%.*s%s", (int)directoryLength, path, libraryName);
+
+	if (shape->includes > 0) {
+		(void)CG_make_directory(libraryPath);
+	}
+
+	FILE *file = fopen(path, "w");
+
+	if (file == NULL) {
+		(void)printf("Could not open \"%s\"!\n", path);
+		(void)free(libraryName);
+		(void)free(libraryPath);
+		return false;
+	}
+
+	for (int i = 0; i < shape->includes; i++) {
+		(void)snprintf(libraryPath, directoryLength + nameLength + 32, "%.*s%s/lib%i.txt", (int)directoryLength, path, libraryName, i);
+		FILE *library = fopen(libraryPath, "w");
+
+		if (library == NULL) {
+			(void)printf("Could not open \"%s\"!\n", libraryPath);
+			(void)fclose(file);
+			(void)free(libraryName);
+			(void)free(libraryPath);
+			return false;
+		}
+
+		if (i > 0) {
+			(void)fprintf(library, "include %s.lib%i;\n\n", libraryName, i - 1);
+		}
+
+		(void)CG_write_library(library, i, shape);
+		(void)fclose(library);
+		(void)fprintf(file, "include %s.lib%i;\n", libraryName, i);
+	}
+
+	(void)free(libraryName);
+	(void)free(libraryPath);
+	(void)fprintf(file, "\nenum Direction {\n    LEFT : 1,\n    STAY,\n    RIGHT\n}\n\n");
+
+	for (int i = 0; i < shape->classes; i++) {
+		(void)CG_write_class(file, "Cls", i, shape);
+		(void)fprintf(file, "// Instance of class %i\n", i);
+		(void)fprintf(file, "var:Cls%i obj%i = new Cls%i();\n", i, i, i);
+		(void)fprintf(file, "var field%i = obj%i->number%i_0;\n\n", i, i, i - i % shape->hierarchy);
+	}
+
+	/* The main runnable ends with a long block */
+	(void)fprintf(file, "var a = 1;\nvar b = 2;\nvar c = 3;\nvar x = 0;\nvar y = 0;\n");
+	(void)CG_write_block(file, shape->depth, 0, shape);
+	(void)fclose(file);
+	return true;
+}
+
+/**
+ * <p>
+ * Writes the body of a library file, it has the same shape as the
+ * main file with fewer classes.
+ * </p>
+ */
+void CG_write_library(FILE *file, int library, struct CorpusShape *shape) {
+	char prefix[32];
+	(void)snprintf(prefix, sizeof(prefix), "Lib%i_", library);
+	int classes = shape->classes / 4 > 0 ? shape->classes / 4 : 1;
+
+	for (int i = 0; i < classes; i++) {
+		(void)CG_write_class(file, prefix, i, shape);
+	}
+}
+
+/**
+ * <p>
+ * Writes a class with fields, a constructor and functions. The class
+ * extends its predecessor, unless it starts a new hierarchy.
+ * </p>
+ *
+ * @param *file     File to write to
+ * @param *prefix   Prefix of the class name
+ * @param index     Number of the class
+ * @param *shape    Shape of the corpus
+ */
+void CG_write_class(FILE *file, const char *prefix, int index, struct CorpusShape *shape) {
+	if (index % shape->hierarchy == 0) {
+		(void)fprintf(file, "class %s%i => {\n", prefix, index);
+	} else {
+		(void)fprintf(file, "class %s%i extends %s%i => {\n", prefix, index, prefix, index - 1);
+	}
+
+	for (int i = 0; i < shape->members; i++) {
+		(void)fprintf(file, "    global var:int number%i_%i = %u;\n", index, i, CG_random(1000));
+	}
+
+	(void)fprintf(file, "    private var name%i = \"class number %i of the synthetic corpus\";\n\n", index, index);
+	(void)fprintf(file, "    this::constructor() {\n        number%i_0 = %u;\n    }\n\n", index, CG_random(1000));
+
+	for (int i = 0; i < shape->members; i++) {
+		(void)CG_write_function(file, prefix, index, i, shape);
+	}
+
+	(void)fprintf(file, "}\n\n");
+}
+
+/**
+ * <p>
+ * Writes a member function, that uses a field of the class. In a derived
+ * class it also reads the inherited fields of the parent and of the
+ * first class of the chain with "this->".
+ * </p>
+ */
+void CG_write_function(FILE *file, const char *prefix, int index, int member, struct CorpusShape *shape) {
+	(void)prefix;
+	(void)fprintf(file, "    global function get%i_%i(a, b) {\n", index, member);
+	(void)fprintf(file, "        var c = number%i_%i + a;\n", index, member);
+
+	if (index % shape->hierarchy != 0) {
+		(void)fprintf(file, "        var p = this->number%i_%i + this->number%i_%i;\n", index - 1, member, index - index % shape->hierarchy, member);
+	}
+
+	(void)fprintf(file, "        var x = 0;\n        var y = 0;\n");
+	(void)CG_write_block(file, shape->depth, 2, shape);
+	(void)fprintf(file, "        return c;\n    }\n\n");
+}
+
+/**
+ * <p>
+ * Writes the statements of a block, every statement can open a nested
+ * if, while or for block until the depth is reached.
+ * </p>
+ *
+ * @param *file     File to write to
+ * @param depth     Nesting levels left
+ * @param indent    Indentation in levels of 4 spaces
+ * @param *shape    Shape of the corpus
+ */
+void CG_write_block(FILE *file, int depth, int indent, struct CorpusShape *shape) {
+	for (int i = 0; i < shape->statements; i++) {
+		(void)CG_write_indent(file, indent);
+
+		switch (depth > 0 ? CG_random(6) : CG_random(3)) {
+		case 0:
+			(void)fprintf(file, "x = ");
+			(void)CG_write_term(file, shape->term);
+			(void)fprintf(file, ";\n");
+			break;
+		case 1:
+			(void)fprintf(file, "y += %u * (x - %u);\n", CG_random(10) + 1, CG_random(10));
+			break;
+		case 2:
+			(void)fprintf(file, "c -= %u;\n", CG_random(10) + 1);
+			break;
+		case 3:
+			(void)fprintf(file, "if (x < %u and y >= %u or x != c) {\n", CG_random(100), CG_random(100));
+			(void)CG_write_block(file, depth - 1, indent + 1, shape);
+			(void)CG_write_indent(file, indent);
+			(void)fprintf(file, "} else {\n");
+			(void)CG_write_block(file, depth - 1, indent + 1, shape);
+			(void)CG_write_indent(file, indent);
+			(void)fprintf(file, "}\n");
+			break;
+		case 4:
+			(void)fprintf(file, "while (x > %u) {\n", CG_random(10));
+			(void)CG_write_block(file, depth - 1, indent + 1, shape);
+			(void)CG_write_indent(file, indent);
+			(void)fprintf(file, "}\n");
+			break;
+		default:
+			(void)fprintf(file, "for (var:int i%i = 0; i%i < %u; i%i++) {\n", depth, depth, CG_random(50), depth);
+			(void)CG_write_block(file, depth - 1, indent + 1, shape);
+			(void)CG_write_indent(file, indent);
+			(void)fprintf(file, "}\n");
+			break;
+		}
+	}
+}
+
+/**
+ * <p>
+ * Writes a term with the provided number of arithmetic operators,
+ * every fourth operand is a parenthesized subterm.
+ * </p>
+ */
+void CG_write_term(FILE *file, int operators) {
+	static const char *OPERATORS[] = {"+", "-", "*", "/", "%"};
+	static const char *OPERANDS[] = {"a", "b", "c", "x", "y"};
+	(void)fprintf(file, "%s", OPERANDS[CG_random(5)]);
+
+	for (int i = 0; i < operators; i++) {
+		if (i % 4 == 3) {
+			(void)fprintf(file, " %s (%s + %u)", OPERATORS[CG_random(5)], OPERANDS[CG_random(5)], CG_random(100) + 1);
+		} else {
+			(void)fprintf(file, " %s %s", OPERATORS[CG_random(5)], i % 2 == 0 ? OPERANDS[CG_random(5)] : "2");
+		}
+	}
+}
+
+void CG_write_indent(FILE *file, int indent) {
+	for (int i = 0; i < indent; i++) {
+		(void)fprintf(file, "    ");
+	}
+}
+
+/**
+ * <p>
+ * Small linear congruential generator, so the corpus is the same on
+ * every C library (rand() is not).
+ * </p>
+ */
+unsigned int CG_random(unsigned int bound) {
+	RANDOM_STATE = RANDOM_STATE * 1103515245u + 12345u;
+	return bound == 0 ? 0 : (RANDOM_STATE >> 16) % bound;
+}
@@ -0,0 +1,167 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../headers/modules.h"
+#include "../headers/parsetree.h"
+#include "../headers/errors.h"
+#include "../headers/compilerContext.h"
+
+/**
+ * The microbenchmark {@code SPACE/benchmarks/flatTreeBenchmark.c}
+ * compares the pointer based parsetree (Node) with the flat tree
+ * (FlatTree) in memory and traversal time.
+ *
+ * The tree is shaped like a large program: a main runnable with many
+ * variables, each holding a type and a term of a few operators.
+ * Both traversals visit every node like SA_manage_runnable() does
+ * (details, then left and right) and must read the same data.
+ *
+ * Compile and run (from the repository directory):
+ * gcc -O2 benchmarks/flatTreeBenchmark.c main/input.c src/lexer.c src/syntaxAnalyzer.c src/parsetreeGenerator.c src/errorhandler.c src/modules.c src/hashmap.c src/list.c src/internPool.c src/compilerContext.c src/tokenIndex.c src/lineIndex.c src/treeCache.c src/semanticAnalyzer.c src/logger.c -o flatTreeBenchmark.exe
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define STATEMENTS 200000
+#define TERM_DEPTH 4
+#define ITERATIONS 20
+
+Node *PG_create_node(char *value, enum NodeType type, int line, int pos);
+void PG_allocate_node_details(Node *node, size_t size);
+
+char *NAMES[] = {"a", "b", "counter", "value", "x", "y", "index", "result"};
+
+Node *create_term(int depth, int line) {
+	if (depth == 0) {
+		return PG_create_node(NAMES[rand() % 8], _IDEN_NODE_, line, line * 10);
+	}
+
+	Node *operator = PG_create_node(depth % 2 == 0 ? "+" : "*", depth % 2 == 0 ? _PLUS_NODE_ : _MULTIPLY_NODE_, line, line * 10);
+	operator->leftNode = create_term(depth - 1, line);
+	operator->rightNode = create_term(depth - 1, line);
+	return operator;
+}
+
+Node *create_program() {
+	Node *root = PG_create_node("RUNNABLE", _RUNNABLE_NODE_, 0, 0);
+	(void)PG_allocate_node_details(root, STATEMENTS);
+
+	for (int i = 0; i < STATEMENTS; i++) {
+		Node *varNode = PG_create_node(NAMES[i % 8], _VAR_NODE_, i, i * 10);
+		(void)PG_allocate_node_details(varNode, 1);
+		varNode->details[0] = PG_create_node("int", _VAR_TYPE_NODE_, i, i * 10);
+		varNode->leftNode = PG_create_node("global", _MODIFIER_NODE_, i, i * 10);
+		varNode->rightNode = create_term(TERM_DEPTH, i);
+		root->details[i] = varNode;
+	}
+
+	return root;
+}
+
+size_t traverse_nodes(Node *node, size_t *memory) {
+	if (node == NULL) {
+		return 0;
+	}
+
+	size_t sum = (size_t)node->type + node->line + (size_t)node->value[0];
+	(*memory) += sizeof(Node) + sizeof(Node*) * node->detailsCount;
+
+	for (unsigned int i = 0; i < node->detailsCount; i++) {
+		sum += traverse_nodes(node->details[i], memory);
+	}
+
+	sum += traverse_nodes(node->leftNode, memory);
+	sum += traverse_nodes(node->rightNode, memory);
+	return sum;
+}
+
+size_t traverse_flat_nodes(FlatTree *tree, unsigned int index) {
+	if (index == FLAT_NODE_NONE) {
+		return 0;
+	}
+
+	FlatNode *node = &tree->nodes[index];
+	size_t sum = (size_t)node->type + node->line + (size_t)tree->values[node->valueId][0];
+
+	for (unsigned int i = 0; i < node->detailsCount; i++) {
+		sum += traverse_flat_nodes(tree, tree->details[node->detailsStart + i]);
+	}
+
+	sum += traverse_flat_nodes(tree, node->leftNode);
+	sum += traverse_flat_nodes(tree, node->rightNode);
+	return sum;
+}
+
+int main() {
+	// The nodes are bumped into the node arena of the context
+	struct CompilerContext *context = CC_create_context("flatTreeBenchmark");
+
+	if (context == NULL) {
+		return -1;
+	}
+
+	(void)srand(42);
+	Node *root = create_program();
+	FlatTree *tree = PG_flatten_tree(root);
+	size_t nodeMemory = 0;
+	size_t nodeSum = 0;
+	size_t flatSum = 0;
+
+	clock_t start = (clock_t)clock();
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		nodeMemory = 0;
+		nodeSum = traverse_nodes(root, &nodeMemory);
+	}
+
+	clock_t middle = (clock_t)clock();
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		flatSum = traverse_flat_nodes(tree, 0);
+	}
+
+	clock_t end = (clock_t)clock();
+
+	if (nodeSum != flatSum) {
+		(void)printf("Mismatch: %zu / %zu!\n", nodeSum, flatSum);
+		return -1;
+	}
+
+	size_t flatMemory = sizeof(FlatNode) * tree->nodeCount + sizeof(unsigned int) * tree->detailsLength + sizeof(char*) * tree->valueCount;
+	double nodeTime = ((double)(middle - start)) / CLOCKS_PER_SEC;
+	double flatTime = ((double)(end - middle)) / CLOCKS_PER_SEC;
+
+	(void)printf("Nodes:             %u (%u distinct values)\n", tree->nodeCount, tree->valueCount - 1);
+	(void)printf("Node memory:       %zu bytes (%zu bytes / Node)\n", nodeMemory, sizeof(Node));
+	(void)printf("FlatTree memory:   %zu bytes (%zu bytes / FlatNode)\n", flatMemory, sizeof(FlatNode));
+	(void)printf("Node traversal:    %f seconds\n", nodeTime);
+	(void)printf("Flat traversal:    %f seconds\n", flatTime);
+	(void)printf("Speedup:           %.2fx\n", flatTime > 0 ? nodeTime / flatTime : 0.0);
+
+	(void)FREE_FLAT_TREE(tree);
+	(void)FREE_COMPILER_CONTEXT(context);
+	return 0;
+}
@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../headers/hashmap.h"
+
+/**
+ * The microbenchmark {@code SPACE/benchmarks/hashMapBenchmark.c}
+ * compares the insert and lookup throughput of the chained HashMap
+ * (CreateNewHashMap()) with the open addressing HashMap
+ * (CreateNewOpenHashMap()).
+ *
+ * The keys look like identifiers ("value_1234"), the lookups are half
+ * hits and half misses. Both maps start small, so the resizes are
+ * part of the insert time.
+ *
+ * Compile and run (from the repository directory):
+ * gcc -O2 benchmarks/hashMapBenchmark.c src/hashmap.c -o hashMapBenchmark.exe
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define KEY_COUNT 1000000
+#define KEY_LENGTH 24
+#define LOOKUP_ROUNDS 4
+
+typedef struct HashMap *(*MapConstructor)(int initCapacity);
+
+void run_benchmark(const char *name, MapConstructor constructor, char **keys, char **missingKeys) {
+	struct HashMap *map = constructor(16);
+	clock_t start = (clock_t)clock();
+
+	for (int i = 0; i < KEY_COUNT; i++) {
+		(void)HM_add_entry(keys[i], NULL, map);
+	}
+
+	clock_t middle = (clock_t)clock();
+	int found = 0;
+
+	for (int n = 0; n < LOOKUP_ROUNDS; n++) {
+		for (int i = 0; i < KEY_COUNT; i++) {
+			found += HM_get_entry(keys[i], map) != NULL ? 1 : 0;
+			found += HM_get_entry(missingKeys[i], map) != NULL ? 1 : 0;
+		}
+	}
+
+	clock_t end = (clock_t)clock();
+	double insertTime = ((double)(middle - start)) / CLOCKS_PER_SEC;
+	double lookupTime = ((double)(end - middle)) / CLOCKS_PER_SEC;
+	double lookups = (double)KEY_COUNT * 2 * LOOKUP_ROUNDS;
+
+	(void)printf("%-16s insert: %7.2f M/s | lookup: %7.2f M/s | found: %i | resizes: %i\n", name,
+		insertTime > 0 ? KEY_COUNT / insertTime / 1e6 : 0.0, lookupTime > 0 ? lookups / lookupTime / 1e6 : 0.0,
+		found, map->resizes);
+	(void)HM_free(map);
+}
+
+int main() {
+	char *keyText = (char*)calloc((size_t)KEY_COUNT * 2, KEY_LENGTH);
+	char **keys = (char**)calloc(KEY_COUNT, sizeof(char*));
+	char **missingKeys = (char**)calloc(KEY_COUNT, sizeof(char*));
+
+	if (keyText == NULL || keys == NULL || missingKeys == NULL) {
+		(void)printf("Could not allocate the keys!\n");
+		return -1;
+	}
+
+	for (int i = 0; i < KEY_COUNT; i++) {
+		keys[i] = &keyText[(size_t)i * 2 * KEY_LENGTH];
+		missingKeys[i] = &keyText[((size_t)i * 2 + 1) * KEY_LENGTH];
+		(void)snprintf(keys[i], KEY_LENGTH, "value_%i", i);
+		(void)snprintf(missingKeys[i], KEY_LENGTH, "missing_%i", i);
+	}
+
+	(void)run_benchmark("Chained", CreateNewHashMap, keys, missingKeys);
+	(void)run_benchmark("Open addressing", CreateNewOpenHashMap, keys, missingKeys);
+
+	(void)free(keys);
+	(void)free(missingKeys);
+	(void)free(keyText);
+	return 0;
+}
@@ -0,0 +1,180 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../headers/modules.h"
+
+/**
+ * The microbenchmark {@code SPACE/benchmarks/keywordLookupBenchmark.c}
+ * compares the hashed keyword lookup (LX_get_keyword_type) with the
+ * linear strcmp() over the KEYWORD_LOOKUP (LX_get_keyword_type_linear).
+ *
+ * The corpus is keyword heavy: every second word is a keyword, the rest
+ * are identifiers, that partly share a prefix with a keyword.
+ * Before measuring, both lookups are checked to return the same types.
+ *
+ * The KEYWORD_HASH_SEED and the KEYWORD_HASH_TABLE of src/lexer.c are
+ * fixed at build time. If a keyword of the KEYWORD_LOOKUP is not found
+ * through them (e.g. after adding a keyword), the benchmark searches the
+ * first seed (starting with the FNV-1a offset basis), under which no two
+ * keywords collide, and prints the new seed and table instead.
+ *
+ * Compile and run (from the repository directory):
+ * gcc -O2 benchmarks/keywordLookupBenchmark.c main/input.c src/lexer.c src/syntaxAnalyzer.c src/parsetreeGenerator.c src/errorhandler.c src/modules.c src/hashmap.c src/list.c src/internPool.c src/compilerContext.c src/tokenIndex.c src/lineIndex.c src/treeCache.c src/semanticAnalyzer.c src/logger.c -o keywordBenchmark.exe
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define CORPUS_SIZE 4096
+#define ITERATIONS 2000
+
+//Has to match the KEYWORD_HASH_TABLE_SIZE of src/lexer.c
+#define KEYWORD_HASH_TABLE_SIZE 128
+#define KEYWORD_HASH_SEARCH_START 2166136261u
+#define KEYWORD_HASH_SEARCH_LIMIT (1u << 24)
+
+TOKENTYPES LX_get_keyword_type(const char *value);
+TOKENTYPES LX_get_keyword_type_linear(const char *value);
+unsigned int LX_hash_keyword(const char *value, unsigned int seed);
+const char *LX_get_keyword_name(int index);
+
+const char *KEYWORDS[] = {
+	"while", "if", "function", "var", "break", "return", "do", "class", "with",
+	"new", "true", "false", "null", "enum", "check", "is", "try", "catch",
+	"continue", "const", "include", "and", "or", "global", "secure", "private",
+	"export", "for", "this", "else", "int", "double", "float", "char", "extends",
+	"short", "long", "void", "constructor"
+};
+
+const char *IDENTIFIERS[] = {
+	"a", "i", "counter", "value", "varName", "classType", "whileLoop", "newObject",
+	"number", "getValue", "VAR", "constants", "format", "returnValue", "x1", "main"
+};
+
+double run_lookup(TOKENTYPES (*lookup)(const char *), const char **corpus, long long *checksum) {
+	clock_t start = (clock_t)clock();
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		for (int i = 0; i < CORPUS_SIZE; i++) {
+			(*checksum) += (long long)lookup(corpus[i]);
+		}
+	}
+
+	clock_t end = (clock_t)clock();
+	return ((double)(end - start)) / CLOCKS_PER_SEC;
+}
+
+/*
+Purpose: Search the first seed, under which no two keywords collide, and print it with its table
+Return Type: int => 0 if a seed was found, -1 if there is none within KEYWORD_HASH_SEARCH_LIMIT
+*/
+int generate_keyword_hash_table() {
+	unsigned char table[KEYWORD_HASH_TABLE_SIZE];
+
+	for (unsigned int n = 0; n < KEYWORD_HASH_SEARCH_LIMIT; n++) {
+		unsigned int seed = KEYWORD_HASH_SEARCH_START + n;
+		int collision = 0;
+		(void)memset(table, 0, sizeof(table));
+
+		for (int i = 0; LX_get_keyword_name(i) != NULL; i++) {
+			unsigned int slot = (unsigned int)LX_hash_keyword(LX_get_keyword_name(i), seed);
+
+			if (table[slot] != 0) {
+				collision = 1;
+				break;
+			}
+
+			table[slot] = (unsigned char)(i + 1);
+		}
+
+		if (collision == 1) {
+			continue;
+		}
+
+		(void)printf("#define KEYWORD_HASH_SEED %uu\n\n", seed);
+		(void)printf("const unsigned char KEYWORD_HASH_TABLE[KEYWORD_HASH_TABLE_SIZE] = {\n");
+
+		for (int i = 0; i < KEYWORD_HASH_TABLE_SIZE; i++) {
+			(void)printf("%s%d%s", i % 16 == 0 ? "\t" : "", table[i], i + 1 == KEYWORD_HASH_TABLE_SIZE ? "\n" : (i % 16 == 15 ? ",\n" : ", "));
+		}
+
+		(void)printf("};\n");
+		return 0;
+	}
+
+	(void)printf("No collision free seed found, increase KEYWORD_HASH_TABLE_SIZE!\n");
+	return -1;
+}
+
+int main() {
+	for (int i = 0; LX_get_keyword_name(i) != NULL; i++) {
+		const char *keyword = LX_get_keyword_name(i);
+
+		if (LX_get_keyword_type(keyword) != LX_get_keyword_type_linear(keyword)) {
+			(void)printf("The KEYWORD_HASH_TABLE misses \"%s\", replace the seed and the table in src/lexer.c with:\n\n", keyword);
+			(void)generate_keyword_hash_table();
+			return -1;
+		}
+	}
+
+
+	const int keywordCount = sizeof(KEYWORDS) / sizeof(KEYWORDS[0]);
+	const int identifierCount = sizeof(IDENTIFIERS) / sizeof(IDENTIFIERS[0]);
+	const char **corpus = (const char**)calloc(CORPUS_SIZE, sizeof(char*));
+
+	if (corpus == NULL) {
+		(void)printf("Could not allocate the corpus!\n");
+		return -1;
+	}
+
+	(void)srand(42);
+
+	for (int i = 0; i < CORPUS_SIZE; i++) {
+		corpus[i] = i % 2 == 0 ? KEYWORDS[rand() % keywordCount] : IDENTIFIERS[rand() % identifierCount];
+	}
+
+	for (int i = 0; i < CORPUS_SIZE; i++) {
+		if (LX_get_keyword_type(corpus[i]) != LX_get_keyword_type_linear(corpus[i])) {
+			(void)printf("Mismatch at \"%s\"!\n", corpus[i]);
+			(void)free(corpus);
+			return -1;
+		}
+	}
+
+	long long linearChecksum = 0;
+	long long hashedChecksum = 0;
+	double linearTime = (double)run_lookup(LX_get_keyword_type_linear, corpus, &linearChecksum);
+	double hashedTime = (double)run_lookup(LX_get_keyword_type, corpus, &hashedChecksum);
+	double lookups = (double)CORPUS_SIZE * ITERATIONS;
+
+	(void)printf("Lookups:           %.0f\n", lookups);
+	(void)printf("Linear strcmp:     %f seconds (%f ns / lookup)\n", linearTime, linearTime * 1e9 / lookups);
+	(void)printf("Perfect hash:      %f seconds (%f ns / lookup)\n", hashedTime, hashedTime * 1e9 / lookups);
+	(void)printf("Speedup:           %.2fx\n", hashedTime > 0 ? linearTime / hashedTime : 0.0);
+	(void)printf("Checksums:         %lld / %lld\n", linearChecksum, hashedChecksum);
+
+	(void)free(corpus);
+	return 0;
+}
@@ -0,0 +1,195 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/modules.h"
+#include "../headers/Token.h"
+#include "../headers/compilerContext.h"
+
+/**
+ * The benchmark {@code SPACE/benchmarks/lexerBenchmark.c} measures the
+ * throughput (MB/s) of the parallel chunked lexer (TokenizeParallel())
+ * against the sequential lexer on a source file, usually a large one of
+ * the corpusGenerator.c.
+ *
+ * Every iteration lexes the file in a new context. The tokens of the
+ * parallel lexer are compared with the sequential tokens (type, value,
+ * size, line and start) before the time is taken.
+ *
+ * Compile and run (from the repository directory):
+ * gcc -O2 benchmarks/lexerBenchmark.c main/input.c src/lexer.c src/syntaxAnalyzer.c src/parsetreeGenerator.c src/errorhandler.c src/modules.c src/hashmap.c src/list.c src/internPool.c src/compilerContext.c src/tokenIndex.c src/lineIndex.c src/treeCache.c src/semanticAnalyzer.c src/profiler.c src/logger.c -o lexerBenchmark.exe -lpsapi
+ * lexerBenchmark.exe large.txt --threads 4 --iterations 5
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define MAX_ITERATIONS 100
+#define DEFAULT_ITERATIONS 5
+
+//From src/profiler.c
+double PF_get_wall_time_us();
+
+struct LexerRun {
+	char *path;
+	int iterations;
+	int threads;
+
+	size_t bytes;
+	size_t tokens;
+	double sequentialMs;
+	double parallelMs;
+};
+
+int BM_parse_arguments(int argc, char *argv[], struct LexerRun *run);
+struct CompilerContext *BM_lex(struct LexerRun *run, int threads, double *bestMs);
+int BM_compare_tokens(struct CompilerContext *sequential, struct CompilerContext *parallel);
+
+int main(int argc, char *argv[]) {
+	struct LexerRun run;
+	(void)memset(&run, 0, sizeof(struct LexerRun));
+	run.iterations = DEFAULT_ITERATIONS;
+	run.threads = (int)CC_get_processor_count();
+
+	if ((int)BM_parse_arguments(argc, argv, &run) == false) {
+		(void)printf("Usage: %s <source> [--threads <2 - 64>] [--iterations <1 - %i>]\n", argv[0], MAX_ITERATIONS);
+		return -1;
+	}
+
+	run.sequentialMs = -1;
+	run.parallelMs = -1;
+
+	for (int i = 0; i < run.iterations; i++) {
+		struct CompilerContext *sequential = BM_lex(&run, 1, &run.sequentialMs);
+		struct CompilerContext *parallel = BM_lex(&run, run.threads, &run.parallelMs);
+
+		if (sequential == NULL || parallel == NULL) {
+			return -1;
+		}
+
+		int equal = (int)BM_compare_tokens(sequential, parallel);
+		run.tokens = sequential->tokenLength;
+		(void)FREE_COMPILER_CONTEXT(sequential);
+		(void)FREE_COMPILER_CONTEXT(parallel);
+
+		if (equal == false) {
+			return 1;
+		}
+	}
+
+	double megabytes = (double)run.bytes / 1e6;
+	(void)printf("Source:            %s\n", run.path);
+	(void)printf("Size:              %.2f MB | %zu tokens\n", megabytes, run.tokens);
+	(void)printf("Iterations:        %i\n\n", run.iterations);
+	(void)printf("sequential:        %10.3f ms | %8.2f MB/s\n", run.sequentialMs, run.sequentialMs > 0 ? megabytes / (run.sequentialMs / 1000.0) : 0.0);
+	(void)printf("parallel (%2i):     %10.3f ms | %8.2f MB/s\n", run.threads, run.parallelMs, run.parallelMs > 0 ? megabytes / (run.parallelMs / 1000.0) : 0.0);
+	(void)printf("speedup:           %10.2fx\n", run.parallelMs > 0 ? run.sequentialMs / run.parallelMs : 0.0);
+	return 0;
+}
+
+/**
+ * <p>
+ * Reads the source file and the options of the run.
+ * </p>
+ *
+ * @returns true, if the arguments are valid
+ */
+int BM_parse_arguments(int argc, char *argv[], struct LexerRun *run) {
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+			run->iterations = (int)atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+			run->threads = (int)atoi(argv[++i]);
+		} else if (argv[i][0] != '-' && run->path == NULL) {
+			run->path = argv[i];
+		} else {
+			return false;
+		}
+	}
+
+	//One processor still runs the chunks, it just can't get faster
+	run->threads = run->threads < 2 ? 2 : run->threads;
+	return run->path != NULL && run->iterations > 0 && run->iterations <= MAX_ITERATIONS && run->threads <= 64;
+}
+
+/**
+ * <p>
+ * Lexes the file in a new context and keeps the best time.
+ * </p>
+ *
+ * @returns The context with the tokens, NULL if it couldn't be created
+ *
+ * @param *run      Run of the benchmark
+ * @param threads   Threads of the lexer, 1 = sequential
+ * @param *bestMs   Best time so far (negative if there is none), set to the new best time
+ */
+struct CompilerContext *BM_lex(struct LexerRun *run, int threads, double *bestMs) {
+	struct CompilerContext *context = CC_create_context(run->path);
+
+	if (context == NULL) {
+		(void)printf("Could not create the compiler context!\n");
+		return NULL;
+	}
+
+	struct InputReaderResults input = ProcessInput(context, run->path);
+	run->bytes = input.fileLength;
+
+	double start = PF_get_wall_time_us();
+	(void)TokenizeParallel(context, threads);
+	double timeMs = (PF_get_wall_time_us() - start) / 1000.0;
+	(*bestMs) = (*bestMs) < 0 || timeMs < (*bestMs) ? timeMs : (*bestMs);
+	return context;
+}
+
+/**
+ * <p>
+ * Compares the tokens of the sequential and the parallel lexer.
+ * </p>
+ *
+ * @returns true, if all tokens are the same
+ */
+int BM_compare_tokens(struct CompilerContext *sequential, struct CompilerContext *parallel) {
+	if (sequential->tokenLength != parallel->tokenLength) {
+		(void)printf("Mismatch: %zu sequential tokens, %zu parallel tokens!\n", sequential->tokenLength, parallel->tokenLength);
+		return false;
+	}
+
+	for (size_t i = 0; i <= sequential->tokenLength; i++) {
+		TOKEN *expected = &sequential->tokens[i];
+		TOKEN *actual = &parallel->tokens[i];
+		int sameValue = expected->value == NULL ? actual->value == NULL : actual->value != NULL && strcmp(expected->value, actual->value) == 0;
+
+		if (expected->type != actual->type || sameValue == false || expected->size != actual->size
+			|| expected->line != actual->line || expected->tokenStart != actual->tokenStart) {
+			(void)printf("Mismatch at token %zu: \"%s\" (line %u, start %u) / \"%s\" (line %u, start %u)!\n", i,
+				expected->value != NULL ? expected->value : "(null)", expected->line, expected->tokenStart,
+				actual->value != NULL ? actual->value : "(null)", actual->line, actual->tokenStart);
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,413 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/modules.h"
+#include "../headers/Token.h"
+#include "../headers/hashmap.h"
+#include "../headers/compilerContext.h"
+
+/**
+ * The benchmark {@code SPACE/benchmarks/phaseBenchmark.c} runs every
+ * phase of the compiler in isolation on a source file, usually one of
+ * the corpusGenerator.c.
+ *
+ * Every iteration compiles the file in a new context. Only the phase
+ * itself is measured, the best and the median wall time are reported
+ * with the throughput of the phase (MB/s, tokens/s or nodes/s) and the
+ * peak RSS after it. "--baseline <file>" compares the best times with
+ * a stored run and fails, if a phase got slower than the tolerance.
+ * A missing baseline file is written, "--save-baseline" replaces it.
+ *
+ * Compile and run (from the repository directory):
+ * gcc -O2 benchmarks/phaseBenchmark.c main/input.c src/lexer.c src/syntaxAnalyzer.c src/parsetreeGenerator.c src/errorhandler.c src/modules.c src/hashmap.c src/list.c src/internPool.c src/compilerContext.c src/tokenIndex.c src/lineIndex.c src/treeCache.c src/semanticAnalyzer.c src/profiler.c src/logger.c -o phaseBenchmark.exe -lpsapi
+ * phaseBenchmark.exe large.txt --iterations 5 --baseline large.baseline
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define MAX_ITERATIONS 100
+#define DEFAULT_ITERATIONS 5
+#define DEFAULT_TOLERANCE 10.0
+
+//From src/profiler.c
+double PF_get_wall_time_us();
+long PF_get_peak_rss_kb();
+
+enum BenchmarkPhase {
+	BENCH_INPUT,
+	BENCH_LEXER,
+	BENCH_SYNTAX,
+	BENCH_PARSETREE,
+	BENCH_FRONT_END,
+	BENCH_SEMANTIC,
+	BENCH_HASHMAP,
+	BENCH_COUNT
+};
+
+//The throughput of a phase is measured in the unit, that the phase processes
+enum BenchmarkUnit {
+	UNIT_BYTES,
+	UNIT_TOKENS,
+	UNIT_NODES
+};
+
+struct PhaseResult {
+	double timesMs[MAX_ITERATIONS];
+	long peakRssKb;
+};
+
+static const char *BENCH_PHASE_NAMES[BENCH_COUNT] = {"input", "lexer", "syntax", "parsetree", "frontEnd", "semantic", "hashmap"};
+static const enum BenchmarkUnit BENCH_PHASE_UNITS[BENCH_COUNT] = {UNIT_BYTES, UNIT_BYTES, UNIT_TOKENS, UNIT_TOKENS, UNIT_TOKENS, UNIT_NODES, UNIT_TOKENS};
+
+struct BenchmarkRun {
+	char *path;
+	int iterations;
+	char *baselinePath;
+	int saveBaseline;
+	double tolerance;
+
+	size_t bytes;
+	size_t tokens;
+	size_t nodes;
+	struct PhaseResult phases[BENCH_COUNT];
+};
+
+int BM_parse_arguments(int argc, char *argv[], struct BenchmarkRun *run);
+int BM_run_iteration(struct BenchmarkRun *run, int iteration);
+void BM_run_front_end(struct BenchmarkRun *run, int iteration);
+void BM_run_hashmap(struct BenchmarkRun *run, struct CompilerContext *context, int iteration);
+void BM_record(struct BenchmarkRun *run, enum BenchmarkPhase phase, int iteration, double startUs);
+double BM_get_best(struct PhaseResult *result, int iterations);
+double BM_get_median(struct PhaseResult *result, int iterations);
+void BM_print_report(struct BenchmarkRun *run);
+int BM_compare_baseline(struct BenchmarkRun *run);
+int BM_write_baseline(struct BenchmarkRun *run);
+
+int main(int argc, char *argv[]) {
+	struct BenchmarkRun run;
+	(void)memset(&run, 0, sizeof(struct BenchmarkRun));
+	run.iterations = DEFAULT_ITERATIONS;
+	run.tolerance = DEFAULT_TOLERANCE;
+
+	if ((int)BM_parse_arguments(argc, argv, &run) == false) {
+		(void)printf("Usage: %s <source> [--iterations <1 - %i>] [--baseline <file>] [--save-baseline] [--tolerance <percent>]\n", argv[0], MAX_ITERATIONS);
+		return -1;
+	}
+
+	for (int i = 0; i < run.iterations; i++) {
+		if ((int)BM_run_iteration(&run, i) == false) {
+			return -1;
+		}
+
+		(void)BM_run_front_end(&run, i);
+	}
+
+	(void)BM_print_report(&run);
+
+	if (run.baselinePath == NULL) {
+		return 0;
+	}
+
+	FILE *baseline = run.saveBaseline == true ? NULL : fopen(run.baselinePath, "r");
+
+	if (baseline == NULL) {
+		return (int)BM_write_baseline(&run) == true ? 0 : -1;
+	}
+
+	(void)fclose(baseline);
+	return (int)BM_compare_baseline(&run) == true ? 0 : 1;
+}
+
+/**
+ * <p>
+ * Reads the source file and the options of the run.
+ * </p>
+ *
+ * @returns true, if the arguments are valid
+ */
+int BM_parse_arguments(int argc, char *argv[], struct BenchmarkRun *run) {
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--save-baseline") == 0) {
+			run->saveBaseline = true;
+		} else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+			run->iterations = (int)atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+			run->baselinePath = argv[++i];
+		} else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+			run->tolerance = atof(argv[++i]);
+		} else if (argv[i][0] != '-' && run->path == NULL) {
+			run->path = argv[i];
+		} else {
+			return false;
+		}
+	}
+
+	return run->path != NULL && run->iterations > 0 && run->iterations <= MAX_ITERATIONS
+		&& run->tolerance >= 0 && (run->saveBaseline == false || run->baselinePath != NULL);
+}
+
+/**
+ * <p>
+ * Compiles the file once with the two pass front end and measures the
+ * input, lexer, syntax, parsetree, semantic and HashMap phases.
+ * </p>
+ *
+ * @returns true, if the file could be compiled
+ *
+ * @param *run          Run to record the times in
+ * @param iteration     Number of the iteration
+ */
+int BM_run_iteration(struct BenchmarkRun *run, int iteration) {
+	struct CompilerContext *context = CC_create_context(run->path);
+
+	if (context == NULL) {
+		(void)printf("Could not create the compiler context!\n");
+		return false;
+	}
+
+	double start = PF_get_wall_time_us();
+	struct InputReaderResults input = ProcessInput(context, run->path);
+	(void)BM_record(run, BENCH_INPUT, iteration, start);
+
+	start = PF_get_wall_time_us();
+	TOKEN *tokens = Tokenize(context);
+	(void)BM_record(run, BENCH_LEXER, iteration, start);
+
+	start = PF_get_wall_time_us();
+	int containsErrors = (int)CheckInput(context, &tokens);
+	(void)BM_record(run, BENCH_SYNTAX, iteration, start);
+
+	if (containsErrors != 0) {
+		(void)printf("The source contains syntax errors, only valid sources can be measured!\n");
+		(void)FREE_COMPILER_CONTEXT(context);
+		return false;
+	}
+
+	start = PF_get_wall_time_us();
+	struct Node *root = GenerateParsetree(context, &tokens);
+	(void)BM_record(run, BENCH_PARSETREE, iteration, start);
+
+	run->bytes = input.fileLength;
+	run->tokens = context->tokenLength;
+	run->nodes = context->nodeCount;
+
+	start = PF_get_wall_time_us();
+	(void)CheckSemantic(context, root);
+	(void)BM_record(run, BENCH_SEMANTIC, iteration, start);
+
+	(void)BM_run_hashmap(run, context, iteration);
+	(void)FREE_COMPILER_CONTEXT(context);
+	return true;
+}
+
+/**
+ * <p>
+ * Measures the check and the build of the front end (CheckInputAndGenerateParsetree()),
+ * the input and the lexer run again in a new context before.
+ * </p>
+ */
+void BM_run_front_end(struct BenchmarkRun *run, int iteration) {
+	struct CompilerContext *context = CC_create_context(run->path);
+
+	if (context == NULL) {
+		return;
+	}
+
+	(void)ProcessInput(context, run->path);
+	TOKEN *tokens = Tokenize(context);
+	struct Node *root = NULL;
+
+	double start = PF_get_wall_time_us();
+	(void)CheckInputAndGenerateParsetree(context, &tokens, &root);
+	(void)BM_record(run, BENCH_FRONT_END, iteration, start);
+	(void)FREE_COMPILER_CONTEXT(context);
+}
+
+/**
+ * <p>
+ * Measures the HashMap like a symbol table: every identifier is added
+ * once, then every identifier token is looked up.
+ * </p>
+ */
+void BM_run_hashmap(struct BenchmarkRun *run, struct CompilerContext *context, int iteration) {
+	double start = PF_get_wall_time_us();
+	struct HashMap *map = SEMANTIC_OPEN_ADDRESSING_SYMBOL_TABLES == 1 ? CreateNewOpenHashMap(16) : CreateNewHashMap(16);
+	size_t found = 0;
+
+	for (size_t i = 0; i < context->tokenLength; i++) {
+		if (context->tokens[i].type == _IDENTIFIER_ && (int)HM_contains_key(context->tokens[i].value, map) == false) {
+			(void)HM_add_entry(context->tokens[i].value, NULL, map);
+		}
+	}
+
+	for (size_t i = 0; i < context->tokenLength; i++) {
+		found += context->tokens[i].type == _IDENTIFIER_ && HM_get_entry(context->tokens[i].value, map) != NULL ? 1 : 0;
+	}
+
+	(void)HM_free(map);
+	(void)BM_record(run, BENCH_HASHMAP, iteration, start);
+
+	if (found == 0 && context->tokenLength > 0) {
+		(void)printf("The HashMap found no identifier!\n");
+	}
+}
+
+void BM_record(struct BenchmarkRun *run, enum BenchmarkPhase phase, int iteration, double startUs) {
+	run->phases[phase].timesMs[iteration] = (PF_get_wall_time_us() - startUs) / 1000.0;
+
+	if (iteration == 0) {
+		run->phases[phase].peakRssKb = PF_get_peak_rss_kb();
+	}
+}
+
+double BM_get_best(struct PhaseResult *result, int iterations) {
+	double best = result->timesMs[0];
+
+	for (int i = 1; i < iterations; i++) {
+		best = result->timesMs[i] < best ? result->timesMs[i] : best;
+	}
+
+	return best;
+}
+
+double BM_get_median(struct PhaseResult *result, int iterations) {
+	double sorted[MAX_ITERATIONS];
+	(void)memcpy(sorted, result->timesMs, sizeof(double) * iterations);
+
+	for (int i = 1; i < iterations; i++) {
+		for (int n = i; n > 0 && sorted[n - 1] > sorted[n]; n--) {
+			double swap = sorted[n];
+			sorted[n] = sorted[n - 1];
+			sorted[n - 1] = swap;
+		}
+	}
+
+	return iterations % 2 == 1 ? sorted[iterations / 2] : (sorted[iterations / 2 - 1] + sorted[iterations / 2]) / 2.0;
+}
+
+/**
+ * <p>
+ * Prints the best and median time, the throughput and the peak RSS
+ * of every phase.
+ * </p>
+ */
+void BM_print_report(struct BenchmarkRun *run) {
+	(void)printf("Source:            %s\n", run->path);
+	(void)printf("Size:              %.2f MB | %zu tokens | %zu nodes\n", (double)run->bytes / 1e6, run->tokens, run->nodes);
+	(void)printf("Iterations:        %i\n\n", run->iterations);
+	(void)printf("%-12s %12s %12s %22s %14s\n", "Phase", "Best (ms)", "Median (ms)", "Throughput", "Peak RSS (KB)");
+
+	for (int i = 0; i < BENCH_COUNT; i++) {
+		double best = BM_get_best(&run->phases[i], run->iterations);
+		double seconds = best > 0 ? best / 1000.0 : 0.0;
+		char throughput[32] = "-";
+
+		if (seconds > 0) {
+			switch (BENCH_PHASE_UNITS[i]) {
+			case UNIT_BYTES: (void)snprintf(throughput, sizeof(throughput), "%.2f MB/s", (double)run->bytes / 1e6 / seconds); break;
+			case UNIT_TOKENS: (void)snprintf(throughput, sizeof(throughput), "%.2f M tokens/s", (double)run->tokens / 1e6 / seconds); break;
+			case UNIT_NODES: (void)snprintf(throughput, sizeof(throughput), "%.2f M nodes/s", (double)run->nodes / 1e6 / seconds); break;
+			}
+		}
+
+		(void)printf("%-12s %12.3f %12.3f %22s %14li\n", BENCH_PHASE_NAMES[i], best,
+			BM_get_median(&run->phases[i], run->iterations), throughput, run->phases[i].peakRssKb);
+	}
+}
+
+/**
+ * <p>
+ * Compares the best times with the baseline file. A phase, that is more
+ * than the tolerance slower, is a regression.
+ * </p>
+ *
+ * @returns true, if no phase regressed
+ */
+int BM_compare_baseline(struct BenchmarkRun *run) {
+	FILE *file = fopen(run->baselinePath, "r");
+
+	if (file == NULL) {
+		(void)printf("Could not open the baseline \"%s\"!\n", run->baselinePath);
+		return false;
+	}
+
+	char name[32];
+	double baselineMs = 0;
+	size_t baselineTokens = 0;
+	int regressions = 0;
+	(void)printf("\nBaseline:          %s (tolerance %.1f%%)\n", run->baselinePath, run->tolerance);
+
+	//Format: "tokens <count>", then one "<phase> <best ms>" per line
+	if (fscanf(file, "tokens %zu", &baselineTokens) == 1 && baselineTokens != run->tokens) {
+		(void)printf("Warning: the baseline was measured on %zu tokens, the source has %zu!\n", baselineTokens, run->tokens);
+	}
+
+	while (fscanf(file, "%31s %lf", name, &baselineMs) == 2) {
+		for (int i = 0; i < BENCH_COUNT; i++) {
+			if (strcmp(name, BENCH_PHASE_NAMES[i]) != 0) {
+				continue;
+			}
+
+			double best = BM_get_best(&run->phases[i], run->iterations);
+			double change = baselineMs > 0 ? (best - baselineMs) * 100.0 / baselineMs : 0.0;
+			int regressed = change > run->tolerance;
+			regressions += regressed;
+			(void)printf("%-12s %12.3f -> %10.3f ms  %+7.1f%%%s\n", name, baselineMs, best, change, regressed == true ? "  REGRESSION" : "");
+		}
+	}
+
+	(void)fclose(file);
+	(void)printf("%i regression(s)\n", regressions);
+	return regressions == 0;
+}
+
+/**
+ * <p>
+ * Writes the best times of the run as the new baseline.
+ * </p>
+ *
+ * @returns true, if the baseline was written
+ */
+int BM_write_baseline(struct BenchmarkRun *run) {
+	FILE *file = fopen(run->baselinePath, "w");
+
+	if (file == NULL) {
+		(void)printf("Could not write the baseline \"%s\"!\n", run->baselinePath);
+		return false;
+	}
+
+	(void)fprintf(file, "tokens %zu\n", run->tokens);
+
+	for (int i = 0; i < BENCH_COUNT; i++) {
+		(void)fprintf(file, "%s %.3f\n", BENCH_PHASE_NAMES[i], BM_get_best(&run->phases[i], run->iterations));
+	}
+
+	(void)fclose(file);
+	(void)printf("\nBaseline written to %s\n", run->baselinePath);
+	return true;
+}
@@ -0,0 +1,162 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../headers/modules.h"
+
+/**
+ * The microbenchmark {@code SPACE/benchmarks/scannerBenchmark.c}
+ * measures the throughput (MB/s) of the vectorized scanners in
+ * {@code SPACE/src/modules.c} against the character by character loops,
+ * the lexer used before.
+ *
+ * Three inputs are scanned: indentation (whitespaces and newlines), a
+ * block comment body and a long identifier run. Every result is checked
+ * against the scalar loop before the time is taken.
+ *
+ * Compile and run (from the repository directory), add -mavx2 for the
+ * 32 byte path:
+ * gcc -O2 benchmarks/scannerBenchmark.c src/modules.c -o scannerBenchmark.exe
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define INPUT_SIZE (1 << 20)
+#define ITERATIONS 200
+
+typedef size_t (*Scanner)(const char *input, size_t start, size_t end, size_t *newlines);
+
+size_t scalar_skip_whitespaces(const char *input, size_t start, size_t end, size_t *newlines) {
+	size_t i = start;
+
+	for (; i < end; i++) {
+		int whitespaceChar = (int)is_space(input[i]);
+
+		if (whitespaceChar == 0) {
+			break;
+		}
+
+		(*newlines) += whitespaceChar == 2 ? 1 : 0;
+	}
+
+	return i;
+}
+
+size_t scalar_skip_comment(const char *input, size_t start, size_t end, size_t *newlines) {
+	size_t i = start;
+
+	for (; i < end; i++) {
+		if (input[i] == '*' && input[i + 1] == '/') {
+			break;
+		}
+
+		(*newlines) += (int)is_space(input[i]) == 2 ? 1 : 0;
+	}
+
+	return i;
+}
+
+size_t scalar_skip_identifier(const char *input, size_t start, size_t end, size_t *newlines) {
+	size_t i = start;
+
+	while (i < end && is_space(input[i]) == 0 && check_for_operator(input[i]) == 0) {
+		i++;
+	}
+
+	return i;
+}
+
+size_t vector_skip_identifier(const char *input, size_t start, size_t end, size_t *newlines) {
+	return (size_t)skip_identifier_run(input, start, end);
+}
+
+/**
+ * <p>
+ * Fills the input: every line is filled with the given characters and one
+ * '\n' is put at the end of each 80 characters.
+ * </p>
+ */
+void fill_input(char *input, const char *alphabet, int withNewlines) {
+	size_t alphabetLength = strlen(alphabet);
+
+	for (size_t i = 0; i < INPUT_SIZE; i++) {
+		input[i] = withNewlines && i % 80 == 79 ? '\n' : alphabet[i % alphabetLength];
+	}
+
+	input[INPUT_SIZE] = '\0';
+}
+
+double measure(Scanner scanner, const char *input, size_t *result, size_t *newlines) {
+	clock_t start = (clock_t)clock();
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		*newlines = 0;
+		*result = scanner(input, 0, INPUT_SIZE, newlines);
+	}
+
+	clock_t end = (clock_t)clock();
+	return ((double)(end - start)) / CLOCKS_PER_SEC;
+}
+
+int run_benchmark(const char *name, Scanner scalar, Scanner vector, const char *input) {
+	size_t scalarResult = 0, vectorResult = 0;
+	size_t scalarNewlines = 0, vectorNewlines = 0;
+	double scalarTime = (double)measure(scalar, input, &scalarResult, &scalarNewlines);
+	double vectorTime = (double)measure(vector, input, &vectorResult, &vectorNewlines);
+
+	if (scalarResult != vectorResult || scalarNewlines != vectorNewlines) {
+		(void)printf("%s: mismatch (%zu / %zu, %zu / %zu newlines)!\n", name, scalarResult, vectorResult, scalarNewlines, vectorNewlines);
+		return 0;
+	}
+
+	double megabytes = (double)INPUT_SIZE * ITERATIONS / (1024.0 * 1024.0);
+	(void)printf("%-12s scalar: %8.1f MB/s | vector: %8.1f MB/s | speedup: %.2fx\n", name,
+		scalarTime > 0 ? megabytes / scalarTime : 0.0, vectorTime > 0 ? megabytes / vectorTime : 0.0,
+		vectorTime > 0 ? scalarTime / vectorTime : 0.0);
+	return 1;
+}
+
+int main() {
+	char *input = (char*)calloc(INPUT_SIZE + 1, sizeof(char));
+
+	if (input == NULL) {
+		(void)printf("Could not allocate the input!\n");
+		return -1;
+	}
+
+	int passed = 1;
+
+	(void)fill_input(input, " \t ", 1);
+	passed &= (int)run_benchmark("Whitespaces", scalar_skip_whitespaces, skip_whitespace_run, input);
+
+	(void)fill_input(input, "This * is a comment / body ", 1);
+	passed &= (int)run_benchmark("Comment", scalar_skip_comment, find_block_comment_end, input);
+
+	(void)fill_input(input, "abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789", 0);
+	passed &= (int)run_benchmark("Identifier", scalar_skip_identifier, vector_skip_identifier, input);
+
+	(void)free(input);
+	return passed ? 0 : -1;
+}
@@ -2,10 +2,10 @@ echo off
 SET PROFILE_MODE=0
 
 IF %PROFILE_MODE% == 0 (
-    gcc -Wall -Werror -Wpedantic main/input.c src/lexer.c src/syntaxAnalyzer.c src/parsetreeGenerator.c src/errorHandler.c src/modules.c src/hashmap.c src/list.c src/semanticAnalyzer.c main/main.c -o space.exe
+    gcc -Wall -Werror -Wpedantic main/input.c main/driver.c main/server.c src/lexer.c src/syntaxAnalyzer.c src/parsetreeGenerator.c src/errorHandler.c src/modules.c src/hashmap.c src/list.c src/internPool.c src/compilerContext.c src/tokenIndex.c src/lineIndex.c src/treeCache.c src/semanticAnalyzer.c src/profiler.c src/logger.c main/main.c -o space.exe -lpsapi
 )
 IF %PROFILE_MODE% == 1 (
-    gcc -Wall -Werror -Wpedantic -pg main/input.c src/lexer.c src/syntaxAnalyzer.c src/parsetreeGenerator.c src/errorHandler.c src/modules.c src/hashmap.c src/list.c src/semanticAnalyzer.c main/main.c -o space.exe
+    gcc -Wall -Werror -Wpedantic -pg main/input.c main/driver.c main/server.c src/lexer.c src/syntaxAnalyzer.c src/parsetreeGenerator.c src/errorHandler.c src/modules.c src/hashmap.c src/list.c src/internPool.c src/compilerContext.c src/tokenIndex.c src/lineIndex.c src/treeCache.c src/semanticAnalyzer.c src/profiler.c src/logger.c main/main.c -o space.exe -lpsapi
 )
 
 space.exe
@@ -71,12 +71,16 @@ typedef enum TOKENTYPES {
 //     Token     //
 ///////////////////
 
+// The positions are 32 bit, so a token takes 24 instead of 40 bytes.
+// (unsigned int)-1 marks the position of the EOF token.
+#define TOKEN_MAX_POSITION 0xFFFFFFFEu
+
 typedef struct TOKEN {
-    TOKENTYPES type;
     char *value;
-    size_t size;
-    size_t line;
-    size_t tokenStart;
+    unsigned int size;
+    unsigned int line;
+    unsigned int tokenStart;
+    TOKENTYPES type;
 } TOKEN;
 
 #endif  // SPACE_TOKEN_H_
@@ -0,0 +1,223 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_COMPILER_CONTEXT_H_
+#define SPACE_COMPILER_CONTEXT_H_
+
+#include <stdio.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "Token.h"
+#include "tokenIndex.h"
+#include "lineIndex.h"
+
+#ifdef _MSC_VER
+#define CC_THREAD_LOCAL __declspec(thread)
+#else
+#define CC_THREAD_LOCAL _Thread_local
+#endif
+
+/**
+ * <p>
+ * An error, that was found during the compilation. The line and
+ * column start at 1, 0 means unknown.
+ * </p>
+ * 
+ * <p>
+ * The console text is rendered, when the error is reported, and written
+ * with the other diagnostics ordered by the position at the end of the
+ * compilation (see CC_flush_diagnostics()).
+ * </p>
+ */
+struct Diagnostic {
+	size_t line;
+	size_t column;
+	int fatal;
+	char *message;
+	size_t position;
+	char *rendered;
+};
+
+/**
+ * <p>
+ * The console text of a diagnostic while it is rendered.
+ * </p>
+ */
+struct DiagnosticText {
+	char *text;
+	size_t length;
+	size_t capacity;
+};
+
+/**
+ * <p>
+ * A main statement, at which the source can be lexed and checked again
+ * after an edit (see CheckEditAndUpdateParsetree()). The start is the
+ * index of its first character, the terminator the index of the ";" or
+ * "}" before it and the detail the index of its first node in the
+ * details of the root.
+ * </p>
+ */
+struct StatementBoundary {
+	size_t start;
+	size_t terminator;
+	size_t line;
+	size_t detail;
+};
+
+/**
+ * <p>
+ * Holds the whole state of one compilation (one source file).
+ * </p>
+ * 
+ * <p>
+ * The public steps of the compiler (ProcessInput(), Tokenize(),
+ * CheckInput(), GenerateParsetree() and CheckSemantic()) get the context
+ * passed and make it the CURRENT_CONTEXT of the calling thread. Every
+ * thread can compile with its own context at the same time.
+ * </p>
+ */
+struct CompilerContext {
+	//Input
+	char *fileName;
+	char *buffer;
+	size_t bufferLength;
+	int bufferIsMapped;
+	size_t bufferMappedLength;
+	struct LineIndex lineIndex;
+
+	//Lexer
+	TOKEN *tokens;
+	size_t tokenLength;
+	size_t tokensCapacity;
+	struct TokenTextBlock *currentTextBlock;
+	struct TokenIndex tokenIndex;
+	size_t releasedTokens;
+
+	//Intern pool
+	struct InternSlot *internSlots;
+	size_t internCapacity;
+	size_t internLoad;
+	struct InternBlock *currentInternBlock;
+
+	//Syntax analyzer
+	int fileContainsErrors;
+	size_t maxTokenLength;
+	int panicModeOpenBraces;
+	size_t panicModeLastStartPos;
+	size_t buildPosition;   //Next main statement to build (see PG_append_main_statements())
+
+	//Parsetree generator
+	struct NodeArenaBlock *currentArenaBlock;
+	size_t nodeCount;
+	struct Node *root;
+
+	/*
+	Edit base of the compile server: the boundaries of the main statements
+	and the token positions of the root details, while the tree is built
+	(see CheckEditAndUpdateParsetree())
+	*/
+	int keepEditBase;
+	struct StatementBoundary *statementBoundaries;
+	size_t statementBoundaryCount;
+	size_t *mainStatementStarts;
+	size_t mainStatementCount;
+	size_t mainStatementCapacity;
+	size_t replacedNodes;
+
+	//Semantic analyzer
+	struct List *externalAccesses;
+	struct List *semanticTables;
+	struct List *semanticErrors;
+	unsigned int declarationGeneration;
+
+	/*
+	Set while the function bodies are checked in parallel: the schedule
+	of the bodies and the body, that the thread checks (NULL on the main
+	thread), see CheckSemantic()
+	*/
+	struct SemanticSchedule *semanticSchedule;
+	struct SemanticTask *semanticTask;
+
+	//Diagnostics
+	struct Diagnostic *diagnostics;
+	size_t diagnosticCount;
+	size_t diagnosticCapacity;
+	size_t suppressedDiagnostics;
+
+	/*
+	Diagnostics of the compilation, that are not in this context (the
+	bodies before a parallel body), they count for the limit
+	*/
+	size_t precedingDiagnostics;
+
+	//false only records the diagnostics (compile server)
+	int renderDiagnostics;
+
+	/*
+	If set, a fatal error jumps back to this point instead of exiting
+	the process (see CC_abort_compilation())
+	*/
+	jmp_buf *recoveryPoint;
+};
+
+/**
+ * <p>
+ * The context, the compiler works on in the calling thread.
+ * </p>
+ */
+extern CC_THREAD_LOCAL struct CompilerContext *CURRENT_CONTEXT;
+
+/**
+ * <p>
+ * Maximum of rendered diagnostics per compilation, 0 = no limit (see
+ * CC_parse_arguments()).
+ * </p>
+ */
+extern size_t CC_DIAGNOSTIC_LIMIT;
+
+int CC_parse_arguments(int *argc, char *argv[]);
+struct CompilerContext *CC_create_context(char *fileName);
+void CC_use_context(struct CompilerContext *context);
+struct Diagnostic *CC_add_diagnostic(size_t line, size_t column, int fatal, const char *format, ...);
+int CC_is_rendering_diagnostics();
+void CC_append_diagnostic_text(struct DiagnosticText *text, const char *format, ...);
+void CC_attach_diagnostic_text(struct Diagnostic *diagnostic, size_t position, struct DiagnosticText *text);
+void CC_flush_diagnostics(struct CompilerContext *context);
+void CC_write_diagnostics(struct CompilerContext *context, FILE *stream);
+void CC_clear_diagnostics(struct CompilerContext *context);
+void CC_free_edit_base(struct CompilerContext *context);
+void CC_abort_compilation(const char *message, size_t line, size_t column);
+int FREE_COMPILER_CONTEXT(struct CompilerContext *context);
+
+struct CC_Monitor;
+
+int CC_get_processor_count();
+void CC_run_parallel(int threadCount, void (*worker)(void *argument), void *argument);
+struct CC_Monitor *CC_create_monitor();
+void CC_enter_monitor(struct CC_Monitor *monitor);
+void CC_leave_monitor(struct CC_Monitor *monitor);
+void CC_wait_monitor(struct CC_Monitor *monitor);
+void CC_notify_monitor(struct CC_Monitor *monitor);
+void CC_free_monitor(struct CC_Monitor *monitor);
+
+#endif
@@ -29,11 +29,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////
 
 int FREE_MEMORY();
-
-void _init_error_token_cache_(TOKEN **tokens);
-void _init_error_buffer_cache_(char **buffer);
-void _init_error_token_size_cache_(int **arrayOfIndividualTokenSizes);
-void _init_error_tree_cache_(struct Node **root);
+void TERMINATE_COMPILATION(char *message, size_t line);
 
 void IO_FILE_EXCEPTION(char *Source, char *file);
 void IO_BUFFER_EXCEPTION(char *Step);
@@ -43,9 +39,10 @@ void IO_FILE_CLOSING_EXCEPTION();
 void LEXER_UNEXPECTED_SYMBOL_EXCEPTION(char **input, int pos, int maxBackPos, int line);
 void LEXER_NULL_TOKEN_EXCEPTION();
 void LEXER_UNFINISHED_POINTER_EXCEPTION();
-void LEXER_UNFINISHED_STRING_EXCEPTION(char **input, size_t errorPos, size_t lineNumber);
+void LEXER_UNFINISHED_STRING_EXCEPTION(char **input, size_t errorPos);
 void LEXER_NULL_TOKEN_VALUE_EXCEPTION();
 void LEXER_TOKEN_ERROR_EXCEPTION();
+void LEXER_INPUT_TOO_LARGE_EXCEPTION(size_t length);
 
 void PARSER_TOKEN_TRANSMISSION_EXCEPTION();
 
@@ -57,7 +54,6 @@ void SYNTAX_ANALYSIS_TOKEN_NULL_EXCEPTION();
 
 int FREE_BUFFER(char *buffer);
 int FREE_TOKENS(TOKEN *tokens);
-int FREE_TOKEN_LENGTHS(int *arrayOfIndividualTokenSizes);
 int FREE_NODE(struct Node *root);
 
 #endif  // SPACE_ERRORS_H_
@@ -26,6 +26,13 @@ struct HashMapEntry {
     void *value;
     char *key;
     struct HashMapEntry *linkedEntry;
+
+    /**
+     * <p>
+     * Cached hash of the key (only used by the open addressing map).
+     * </p>
+     */
+    unsigned int hash;
 };
 
 /**
@@ -57,9 +64,39 @@ struct HashMap {
 
     int resizes;
     int collissions;
+
+    /**
+     * <p>
+     * true, if the map uses open addressing (see CreateNewOpenHashMap()).
+     * The entries are stored inline in the slots then, the entries
+     * pointer is not used.
+     * </p>
+     */
+    int openAddressing;
+
+    /**
+     * <p>
+     * The slots of the open addressing map, a slot with a NULL key is empty.
+     * </p>
+     */
+    struct HashMapEntry *slots;
+};
+
+/**
+ * <p>
+ * Iterates over all entries of a HashMap (see HM_next_entry()).
+ * </p>
+ */
+struct HashMapIterator {
+    struct HashMap *map;
+    int bucket;
+    struct HashMapEntry *entry;
 };
 
 struct HashMap *CreateNewHashMap(int initCapacity);
+struct HashMap *CreateNewOpenHashMap(int initCapacity);
+struct HashMapIterator HM_create_iterator(struct HashMap *map);
+struct HashMapEntry *HM_next_entry(struct HashMapIterator *iterator);
 
 //Internal functions
 void HM_print_map(struct HashMap *map, int withList);
@@ -70,5 +107,6 @@ int HM_contains_entry(struct HashMapEntry *entry, struct HashMap *map);
 int HM_contains_key(char *key, struct HashMap *map);
 void HM_free(struct HashMap *map);
 void HM_clear(struct HashMap *map);
+void HM_get_statistics(long long *resizes, long long *collissions);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_INTERN_POOL_H_
+#define SPACE_INTERN_POOL_H_
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * <p>
+ * Compares two strings, interned strings only need the pointer
+ * comparison, other strings fall back to the byte comparison.
+ * </p>
+ */
+#define IP_EQUALS(a, b) ((a) == (b) || strcmp((a), (b)) == 0)
+
+char *IP_intern(const char *string);
+char *IP_intern_length(const char *string, size_t length);
+size_t IP_get_interned_count();
+int FREE_INTERN_POOL();
+
+#endif
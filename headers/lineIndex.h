@@ -0,0 +1,50 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_LINE_INDEX_H_
+#define SPACE_LINE_INDEX_H_
+
+#include <stddef.h>
+
+/**
+ * <p>
+ * The start of every line of the buffer, built once per buffer (see
+ * CompilerContext.lineIndex). The starts are 32 bit like the token
+ * positions.
+ * </p>
+ */
+struct LineIndex {
+	const char *buffer;
+	size_t length;
+	unsigned int *starts;
+	size_t count;
+};
+
+int LI_build_line_index(const char *buffer, size_t length);
+int LI_ensure_line_index();
+size_t LI_get_line(size_t position);
+size_t LI_get_column(size_t position);
+size_t LI_get_line_start(size_t line);
+size_t LI_get_line_length(size_t line);
+int FREE_LINE_INDEX();
+
+#endif
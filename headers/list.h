@@ -22,16 +22,38 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #ifndef SPACE_LIST_H_
 #define SPACE_LIST_H_
 
+#include <stddef.h>
+
+/**
+ * <p>
+ * Number of entries, that a list holds without an own entries array.
+ * Most param lists and external access lists of a body have less entries.
+ * </p>
+ */
+#define LIST_INLINE_CAPACITY 4
+
 struct List {
     size_t size;
     void **entries;
     size_t load;
+
+    /**
+     * <p>
+     * Storage of the first entries, {@code entries} points at it until
+     * the list grows over LIST_INLINE_CAPACITY.
+     * </p>
+     */
+    void *inlineEntries[LIST_INLINE_CAPACITY];
 };
 
 struct List *CreateNewList(int initialCapacity);
+void L_init_list(struct List *list, int initialCapacity);
 void L_add_item(struct List *list, void *ptr);
+void L_add_items(struct List *list, void **items, size_t count);
+int L_reserve_list(struct List *list, size_t capacity);
 void *L_get_item(struct List *list, int n);
 void L_print_list(struct List *list, int flag);
+void L_release_list(struct List *list);
 void FREE_LIST(struct List *list);
 
 #endif
\ No newline at end of file
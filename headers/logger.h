@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_LOGGER_H_
+#define SPACE_LOGGER_H_
+
+#include <stddef.h>
+#include <stdarg.h>
+
+/**
+ * <p>
+ * The phases, that can be logged separately.
+ * </p>
+ */
+enum LogPhase {
+	LOG_GENERAL,
+	LOG_LEXER,
+	LOG_SYNTAX,
+	LOG_PARSETREE,
+	LOG_SEMANTIC,
+	LOG_PHASE_COUNT
+};
+
+/**
+ * <p>
+ * Verbosity of a phase, a message is written if its level is less or
+ * equal to the level of the phase.
+ * </p>
+ *
+ * <ul>
+ * <li>LOG_INFO - Start and end of a phase, used time
+ * <li>LOG_DEBUG - Dumps (tokens, parsetree, scopes)
+ * <li>LOG_TRACE - Every checked term and report of the semantic analysis
+ * </ul>
+ */
+enum LogLevel {
+	LOG_OFF,
+	LOG_INFO,
+	LOG_DEBUG,
+	LOG_TRACE
+};
+
+extern enum LogLevel LOG_LEVELS[LOG_PHASE_COUNT];
+
+/**
+ * <p>
+ * Checks the level without a call, so a disabled message costs one
+ * comparison and its arguments are not evaluated.
+ * </p>
+ */
+#define LG_IS_ENABLED(phase, level) (LOG_LEVELS[(phase)] >= (level))
+
+#define LOG(phase, level, ...) do { \
+		if (LG_IS_ENABLED((phase), (level))) { \
+			(void)LG_write(__VA_ARGS__); \
+		} \
+	} while (0)
+
+int LG_parse_arguments(int *argc, char *argv[]);
+void LG_write(const char *format, ...);
+void LG_write_arguments(const char *format, va_list arguments);
+void LG_write_text(const char *text, size_t length);
+int LG_is_enabled();
+int LG_is_writing_to_stdout();
+void LG_close();
+
+#endif
@@ -24,16 +24,67 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "../headers/Token.h"
 
-// 1 = true; 0 = false
-#define LEXER_DEBUG_MODE 1
-#define LEXER_DISPLAY_USED_TIME 1
+struct CompilerContext;
 
-#define SYNTAX_ANALYZER_DEBUG_MODE 1
+// 1 = measure the time of the phase, it is written with "--log=<phase>:info" (see src/logger.c); 0 = no clock
+#define LEXER_DISPLAY_USED_TIME 1
 #define SYNTAX_ANALYZER_DISPLAY_USED_TIME 1
-
-#define PARSETREE_GENERATOR_DEBUG_MODE 1
 #define PARSETREE_GENERATOR_DISPLAY_USED_TIME 1
 
+// Threads for the lexer, 0 = one per processor; 1 = sequential
+#define LEXER_THREADS 0
+
+// Buffers with less characters are lexed sequentially (see src/lexer.c)
+#define LEXER_PARALLEL_MIN_LENGTH (1 << 22)
+
+// 1 = the syntax check runs first, then the checked main statements are built one by one (shared with the streaming front end and the edits, see src/syntaxAnalyzer.c); 0 = GenerateParsetree() builds the checked tokens as a whole
+#define CHECK_THEN_BUILD_FRONT_END 1
+
+// 1 = large buffers are lexed and checked in windows, the tokens of the checked main statements are released (needs CHECK_THEN_BUILD_FRONT_END, see src/syntaxAnalyzer.c); 0 = all tokens at once
+#define STREAMING_FRONT_END 1
+
+// Buffers with less characters keep all tokens at once, a window holds at least STREAMING_WINDOW_LENGTH characters
+#define STREAMING_MIN_LENGTH (1 << 24)
+#define STREAMING_WINDOW_LENGTH (1 << 20)
+
+//The windows are checked and built one after the other, with the statement builder of CHECK_THEN_BUILD_FRONT_END
+#if STREAMING_FRONT_END == 1 && CHECK_THEN_BUILD_FRONT_END == 0
+#error "STREAMING_FRONT_END needs CHECK_THEN_BUILD_FRONT_END"
+#endif
+
+// 1 = the compile server checks an edit by lexing and checking only the edited main statements (needs CHECK_THEN_BUILD_FRONT_END, see main/server.c); 0 = every edit compiles the whole source
+#define INCREMENTAL_EDITS 1
+
+// 1 = cache the parsetree next to the source file (see src/treeCache.c); 0 = no cache
+#define PARSETREE_CACHE_MODE 0
+
+// 1 = symbol tables use the open addressing HashMap; 0 = chained HashMap
+#define SEMANTIC_OPEN_ADDRESSING_SYMBOL_TABLES 1
+
+// 1 = identifiers are resolved with a cache per scope; 0 = walk the parent tables on every lookup
+#define SEMANTIC_RESOLUTION_CACHE 1
+
+// 1 = the types of member access chains without calls (e.g. a->b->c) are cached per scope and reused until a declaration is added; 0 = evaluate every chain
+#define SEMANTIC_ACCESS_TYPE_CACHE 1
+
+// 1 = member accesses on classes are resolved with a flattened member table (own and inherited members); 0 = walk the parent classes
+#define SEMANTIC_FLAT_MEMBER_TABLES 1
+
+// 1 = function and constructor bodies are checked in parallel after the declarations; 0 = in source order
+#define SEMANTIC_PARALLEL_BODIES 1
+
+// Threads for the parallel semantic analysis, 0 = one per processor
+#define SEMANTIC_ANALYSIS_THREADS 0
+
+// Rendered errors per compilation, "--max-errors=<n>" overrides it; 0 = no limit
+#define DIAGNOSTIC_LIMIT 0
+
+// 1 = "--stats" and "--trace" count the allocations by replacing the glibc allocator (glibc only, see src/profiler.c); 0 = no counting
+// Opt-in at build time with "-DPROFILER_COUNT_ALLOCATIONS=1", the default build leaves malloc() and free() of the C library alone
+#ifndef PROFILER_COUNT_ALLOCATIONS
+#define PROFILER_COUNT_ALLOCATIONS 0
+#endif
+
 //TERMINAL COLORS
 #define TEXT_COLOR_RED          "\033[38;2;230;70;70m"
 #define TEXT_COLOR_BLUE         "\033[38;2;80;150;230m"
@@ -46,6 +97,25 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 //////////     FUNCTIONS     /////////
 //////////////////////////////////////
 
+//Token classes, a token can be in multiple classes (see TOKEN_CLASSES in src/modules.c)
+#define TOKEN_CLASS_KEYWORD         (1u << 0)   // Keywords, that can't be identifiers (without "void" and "boolean")
+#define TOKEN_CLASS_MODIFIER        (1u << 1)   // global, secure, private
+#define TOKEN_CLASS_PRIMITIVE       (1u << 2)   // int, short, long, double, float, char, boolean, void
+#define TOKEN_CLASS_ASSIGNMENT      (1u << 3)   // +=, -=, *=, /=, ++, -- (without "=")
+#define TOKEN_CLASS_CONDITION       (1u << 4)   // ==, !=, <, >, <=, >=
+#define TOKEN_CLASS_LOGIC           (1u << 5)   // and, or, !
+#define TOKEN_CLASS_BOOL            (1u << 6)   // true, false
+#define TOKEN_CLASS_ARITHMETIC      (1u << 7)   // +, -, *, /, %
+#define TOKEN_CLASS_END_INDICATOR   (1u << 8)   // Tokens, that end an identifier (see is_end_indicator())
+#define TOKEN_CLASS_OPERATOR        (1u << 9)   // Operators, that end a term of the parsetree generator (see PG_is_operator())
+
+#define TOKEN_TYPE_COUNT (_TERM_FUNCTION_CALL_ + 1)
+
+extern const unsigned short TOKEN_CLASSES[TOKEN_TYPE_COUNT];
+
+//One table lookup, types outside of the enum are in no class
+#define IS_TOKEN_CLASS(type, tokenClass) ((unsigned int)(type) < TOKEN_TYPE_COUNT && (TOKEN_CLASSES[(type)] & (tokenClass)) != 0)
+
 int check_for_operator(char input);
 int is_space(char character);
 int is_empty_string(const char* string);
@@ -55,25 +125,43 @@ int is_end_indicator(const TOKEN *token);
 int is_keyword(TOKEN *token);
 int predict_is_conditional_assignment_type(TOKEN **tokens, size_t startPos, int maxToks);
 
+//Vectorized scanning
+int is_identifier_char(const char character);
+size_t skip_whitespace_run(const char *input, size_t start, size_t end, size_t *newlines);
+size_t skip_identifier_run(const char *input, size_t start, size_t end);
+size_t find_line_end(const char *input, size_t start, size_t end);
+size_t find_block_comment_end(const char *input, size_t start, size_t end, size_t *newlines);
+
 //Input reader
 struct InputReaderResults {
     char *buffer;
-    int *arrayOfIndividualTokenSizes;
-    int requiredTokenNumber;
     size_t fileLength;
 };
 
-struct InputReaderResults ProcessInput(char *path);
+struct InputReaderResults ProcessInput(struct CompilerContext *context, char *path);
+
+//Driver
+int RunDriver(int argc, char *argv[]);
+
+//Server
+int RunServer();
 
 //Lexer
-TOKEN *Tokenize(int **arrayOfIndividualTokenSizes);
+TOKEN *Tokenize(struct CompilerContext *context);
+TOKEN *TokenizeParallel(struct CompilerContext *context, int threads);
 
 //Parse
-struct Node *GenerateParsetree(TOKEN **tokens);
+struct Node *GenerateParsetree(struct CompilerContext *context, TOKEN **tokens);
 
 //int Check_syntax(TOKEN **tokens, size_t tokenArrayLength, char **buffer, size_t bufferSize);
 
-int CheckInput(TOKEN **tokens);
-int CheckSemantic(struct Node *root);
+int CheckInput(struct CompilerContext *context, TOKEN **tokens);
+int CheckInputAndGenerateParsetree(struct CompilerContext *context, TOKEN **tokens, struct Node **root);
+struct Node *GenerateCheckedParsetree(struct CompilerContext *context, TOKEN **tokens);
+int CheckStreamAndGenerateParsetree(struct CompilerContext *context, struct Node **root);
+int CheckEditAndUpdateParsetree(struct CompilerContext *context, size_t offset, size_t removedLength, size_t insertedLength);
+int CheckSemantic(struct CompilerContext *context, struct Node *root);
+void FREE_SEMANTIC_TABLES(struct CompilerContext *context);
+void FREE_SEMANTIC_SCHEDULE(struct CompilerContext *context);
 
 #endif
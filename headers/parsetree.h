@@ -77,39 +77,39 @@ typedef struct Node {
 
     /**
      * <p>
-     * Value that the node holds (source name)
+     * Line at which the Node can be found in the source code
      * </p>
      */
-    char *value;
+    unsigned int line;
 
     /**
      * <p>
-     * Line at which the Node can be found in the source code
+     * Position from the start in chars, at which the Node can be found
      * </p>
      */
-    size_t line;
+    unsigned int position;
 
     /**
      * <p>
-     * Position from the start in chars, at which the Node can be found
+     * Holds the size of the details array
      * </p>
      */
-    size_t position;
+    unsigned int detailsCount;
 
     /**
      * <p>
-     * Node array that is in the center, this is useful for
-     * parameters and type specifiers for instance.
+     * Value that the node holds (source name)
      * </p>
      */
-    struct Node **details;
+    char *value;
 
     /**
      * <p>
-     * Holds the size of the details array
+     * Node array that is in the center, this is useful for
+     * parameters and type specifiers for instance.
      * </p>
      */
-    size_t detailsCount;
+    struct Node **details;
 
     /**
      * <p>
@@ -126,4 +126,71 @@ typedef struct Node {
     struct Node *rightNode;
 } Node;
 
+/**
+ * <p>
+ * Index of a FlatNode, that does not exist (equal to a NULL pointer
+ * in the Node structure).
+ * </p>
+ */
+#define FLAT_NODE_NONE 0xFFFFFFFFu
+
+/**
+ * <p>
+ * The FlatNode is the flat counterpart of the Node. Instead of
+ * pointers it holds 32 bit indices into the arrays of the FlatTree,
+ * so one FlatNode takes 32 bytes.
+ * </p>
+ * 
+ * <p>
+ * The details of a FlatNode are the entries
+ * {@code details[detailsStart]} to
+ * {@code details[detailsStart + detailsCount - 1]} of the shared
+ * details array of the FlatTree.
+ * </p>
+ */
+typedef struct FlatNode {
+    enum NodeType type;
+
+    /**
+     * <p>
+     * Interned value, index into the values of the FlatTree
+     * </p>
+     */
+    unsigned int valueId;
+
+    unsigned int line;
+    unsigned int position;
+    unsigned int leftNode;
+    unsigned int rightNode;
+    unsigned int detailsStart;
+    unsigned int detailsCount;
+} FlatNode;
+
+/**
+ * <p>
+ * A parsetree in a flat form. The nodes are stored in preorder
+ * (node, details, left, right), the root is at index 0.
+ * </p>
+ * 
+ * <p>
+ * Every distinct value is stored once, the value with the id 0 is NULL.
+ * The values are borrowed from the tokens and nodes, so the FlatTree
+ * has to be freed before them.
+ * </p>
+ */
+typedef struct FlatTree {
+    FlatNode *nodes;
+    unsigned int nodeCount;
+
+    unsigned int *details;
+    unsigned int detailsLength;
+
+    char **values;
+    unsigned int valueCount;
+} FlatTree;
+
+FlatTree *PG_flatten_tree(Node *root);
+Node *PG_unflatten_tree(FlatTree *tree);
+void FREE_FLAT_TREE(FlatTree *tree);
+
 #endif
\ No newline at end of file
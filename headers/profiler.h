@@ -0,0 +1,49 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_PROFILER_H_
+#define SPACE_PROFILER_H_
+
+#include "compilerContext.h"
+
+/**
+ * <p>
+ * The measured phases of a compilation, in the order they run.
+ * </p>
+ */
+enum ProfilePhase {
+	PHASE_INPUT,
+	PHASE_TREE_CACHE,
+	PHASE_LEXER,
+	PHASE_SYNTAX,
+	PHASE_PARSETREE,
+	PHASE_SEMANTIC,
+	PHASE_COUNT
+};
+
+int PF_parse_arguments(int *argc, char *argv[]);
+int PF_is_enabled();
+void PF_begin_phase(enum ProfilePhase phase);
+void PF_end_phase(enum ProfilePhase phase);
+void PF_finish(struct CompilerContext *context);
+
+#endif
@@ -22,6 +22,8 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #ifndef SPACE_SEMANTIC_ANALYZER_H_
 #define SPACE_SEMANTIC_ANALYZER_H_
 
+#include "list.h"
+
 enum Visibility {
     P_GLOBAL,
     GLOBAL,
@@ -57,11 +59,65 @@ typedef struct SemanticEntry {
     void *reference;
     size_t line;
     size_t position;
+
+    /**
+     * <p>
+     * Order of the declaration, while the function bodies are checked in
+     * parallel (0 = declared in a body), see SA_is_entry_visible().
+     * </p>
+     */
+    size_t declarationIndex;
 } SemanticEntry;
 
 typedef struct SemanticTable {
-    struct List *paramList;
+    /**
+     * <p>
+     * The params of the table in declaration order, the list is part of
+     * the table (see L_init_list()).
+     * </p>
+     */
+    struct List paramList;
+
+    /**
+     * <p>
+     * The params of the paramList by name (NULL until the first param).
+     * </p>
+     */
+    struct HashMap *paramLookup;
     struct HashMap *symbolTable;
+
+    /**
+     * <p>
+     * Declarations, that were resolved from this table (see
+     * SA_resolve_declaration()), NULL until the first lookup.
+     * </p>
+     */
+    struct HashMap *resolutionCache;
+
+    /**
+     * <p>
+     * Types of the member access chains (e.g. a->b->c), that were evaluated
+     * in this table (see SA_get_cached_access_type()), NULL until the first chain.
+     * </p>
+     */
+    struct HashMap *accessTypeCache;
+
+    /**
+     * <p>
+     * Members of a CLASS table by name, including the inherited ones (see
+     * SA_create_member_table()). NULL, if the parent was not resolved, when
+     * the class was declared.
+     * </p>
+     */
+    struct HashMap *memberTable;
+
+    /**
+     * <p>
+     * The function body, that fills the table, while the bodies are
+     * checked in parallel (NULL = filled by the registration pass).
+     * </p>
+     */
+    struct SemanticTask *owner;
     struct SemanticTable *parent;
     enum ScopeType type;
     char *name;
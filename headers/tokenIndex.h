@@ -0,0 +1,61 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_TOKEN_INDEX_H_
+#define SPACE_TOKEN_INDEX_H_
+
+#include <stddef.h>
+#include "Token.h"
+
+/**
+ * <p>
+ * Returned by the index, if there is no such token or the tokens
+ * are not indexed.
+ * </p>
+ */
+#define TI_NONE 0xFFFFFFFFu
+
+/**
+ * <p>
+ * The index, every array has one entry per token (see
+ * CompilerContext.tokenIndex).
+ * </p>
+ */
+struct TokenIndex {
+	const TOKEN *tokens;
+	size_t length;
+	unsigned int *match;
+	unsigned int *nextSemicolon;
+	unsigned int *nextAssignment;
+	unsigned int *nextExpressionEnd;
+	unsigned char *closedTerm;
+};
+
+int TI_build_token_index(TOKEN *tokens, size_t length);
+unsigned int TI_get_match(const TOKEN *tokens, size_t position);
+unsigned int TI_get_next_semicolon(const TOKEN *tokens, size_t position);
+unsigned int TI_get_next_assignment(const TOKEN *tokens, size_t position);
+unsigned int TI_get_next_expression_end(const TOKEN *tokens, size_t position);
+int TI_is_closed_term(const TOKEN *tokens, size_t position);
+int FREE_TOKEN_INDEX();
+
+#endif
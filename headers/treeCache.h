@@ -0,0 +1,41 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_TREE_CACHE_H_
+#define SPACE_TREE_CACHE_H_
+
+#include <stddef.h>
+#include "parsetree.h"
+#include "compilerContext.h"
+
+/**
+ * <p>
+ * The cache file is stored next to the source file, with this suffix.
+ * </p>
+ */
+#define TREE_CACHE_SUFFIX ".sptc"
+
+Node *TC_load_parsetree(struct CompilerContext *context, const char *sourcePath, const char *buffer, size_t length);
+int TC_store_parsetree(const char *sourcePath, const char *buffer, size_t length, Node *root);
+unsigned long long TC_hash_source(const char *buffer, size_t length);
+
+#endif
@@ -0,0 +1,647 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include "../headers/modules.h"
+#include "../headers/treeCache.h"
+#include "../headers/compilerContext.h"
+#include "../headers/logger.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#define DR_NULL_DEVICE "NUL"
+#define DR_dup _dup
+#define DR_dup2 _dup2
+#define DR_open _open
+#define DR_close _close
+#define DR_fdopen _fdopen
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define DR_NULL_DEVICE "/dev/null"
+#define DR_dup dup
+#define DR_dup2 dup2
+#define DR_open open
+#define DR_close close
+#define DR_fdopen fdopen
+#endif
+
+#define true 1
+#define false 0
+
+#define DRIVER_LOG_SUFFIX ".log"
+#define DRIVER_MAX_JOBS 64
+
+////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////     Driver     ///////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+The driver compiles many source files at once: "space a.txt b.txt -j 4".
+
+Every file (compilation unit) is compiled in its own CompilerContext by a pool
+of "-j" threads. The front ends (lexer, syntax analyzer, parsetree) of all files
+run in parallel, the semantic analysis of a file is started after all input
+files it includes are compiled (the include statements form the dependency
+graph). A fatal error jumps back to the unit (see CC_abort_compilation()), the
+units, that include a failed unit, are skipped. The diagnostics of a file are
+written to "<file>.log".
+*/
+
+enum UnitState {
+	UNIT_WAITING,
+	UNIT_PARSING,
+	UNIT_PARSED,
+	UNIT_CHECKING,
+	UNIT_DONE
+};
+
+enum StepResult {
+	STEP_OK,
+	STEP_ERRORS,
+	STEP_FATAL,
+	STEP_NO_CONTEXT
+};
+
+struct CompilationUnit {
+	char *path;
+	int *dependents;
+	int dependentCount;
+	int openDependencies;
+	enum UnitState state;
+	int failed;
+	int failedDependency;   //Index of the failed unit, that this unit includes, -1 = none
+	struct CompilerContext *context;
+	struct Node *root;
+};
+
+/*
+Shared by the threads of the pool, guarded by the monitor: the queue holds the
+units in the order of the command line, first for the front end, then again
+for the semantic analysis (at most twice per unit)
+*/
+struct Driver {
+	struct CompilationUnit *units;
+	int unitCount;
+	int *queue;
+	int queueStart;
+	int queueEnd;
+	int running;
+	int failed;
+	FILE *output;
+	struct CC_Monitor *monitor;
+};
+
+int DR_parse_arguments(int argc, char *argv[], struct CompilationUnit **units, int *unitCount, int *jobs);
+int DR_add_dependencies(struct CompilationUnit *units, int unitCount, int unit);
+int DR_find_unit(struct CompilationUnit *units, int unitCount, const char *include);
+int DR_add_dependent(struct CompilationUnit *unit, int dependent);
+struct Node *GenerateValidatedParsetree(struct CompilerContext *context);
+void DR_run_units(void *argument);
+enum StepResult DR_generate_parsetree(struct CompilationUnit *unit);
+enum StepResult DR_check_semantic(struct CompilationUnit *unit);
+enum StepResult DR_get_step_result(struct CompilerContext *context, int failed);
+void DR_finish_step(struct Driver *driver, int unit, int checking, enum StepResult result);
+void DR_skip_unit(struct Driver *driver, int unit);
+void DR_skip_dependents(struct Driver *driver, int unit);
+void DR_write_log(struct CompilationUnit *unit, enum StepResult result);
+void DR_free_units(struct CompilationUnit *units, int unitCount);
+
+/*
+Purpose: Compile all source files of the command line in dependency order
+Return Type: int => 0 if every file compiled, otherwise -1
+Params: int argc => Argument count; char *argv[] => Source files and the "-j <count>" option
+*/
+int RunDriver(int argc, char *argv[]) {
+	struct Driver driver;
+	(void)memset(&driver, 0, sizeof(struct Driver));
+	int jobs = 0;
+
+	//The compiler output of the units goes to the null device, so a log on stdout would be lost
+	if ((int)LG_is_writing_to_stdout() == true && (int)LG_is_enabled() == true) {
+		(void)printf("With more than one file --log needs --log-file=<path>, the log of all files is written into it.\n");
+		return -1;
+	}
+
+	if ((int)DR_parse_arguments(argc, argv, &driver.units, &driver.unitCount, &jobs) == false) {
+		return -1;
+	}
+
+	for (int i = 0; i < driver.unitCount; i++) {
+		if ((int)DR_add_dependencies(driver.units, driver.unitCount, i) == false) {
+			(void)printf("Could not reserve the dependencies of %s!\n", driver.units[i].path);
+			(void)DR_free_units(driver.units, driver.unitCount);
+			return -1;
+		}
+	}
+
+	driver.queue = (int*)calloc((size_t)driver.unitCount * 2, sizeof(int));
+	driver.monitor = CC_create_monitor();
+
+	//The status lines keep the original stdout, the output of the compiler steps goes to the null device
+	(void)fflush(stdout);
+	int outputDescriptor = (int)DR_dup(1);
+	int nullDescriptor = (int)DR_open(DR_NULL_DEVICE, O_WRONLY);
+	driver.output = outputDescriptor != -1 ? DR_fdopen(outputDescriptor, "w") : NULL;
+
+	if (driver.queue == NULL || driver.monitor == NULL || driver.output == NULL || nullDescriptor == -1) {
+		(void)printf("Could not reserve the driver queue!\n");
+		(void)free(driver.queue);
+		(void)CC_free_monitor(driver.monitor);
+		(void)DR_free_units(driver.units, driver.unitCount);
+
+		if (driver.output != NULL) {
+			(void)fclose(driver.output);
+		}
+
+		if (nullDescriptor != -1) {
+			(void)DR_close(nullDescriptor);
+		}
+
+		return -1;
+	}
+
+	//The front ends of all units are independent
+	for (int i = 0; i < driver.unitCount; i++) {
+		driver.queue[driver.queueEnd++] = i;
+	}
+
+	(void)fprintf(driver.output, "Compiling %i files with %i jobs\n", driver.unitCount, jobs);
+	(void)fflush(driver.output);
+	(void)DR_dup2(nullDescriptor, 1);
+	(void)DR_close(nullDescriptor);
+
+	(void)CC_run_parallel(jobs > driver.unitCount ? driver.unitCount : jobs, DR_run_units, &driver);
+
+	(void)fflush(stdout);
+	(void)DR_dup2(outputDescriptor, 1);
+
+	//Units, that never got ready, include each other (or a unit of a cycle)
+	for (int i = 0; i < driver.unitCount; i++) {
+		if (driver.units[i].state != UNIT_DONE) {
+			(void)fprintf(driver.output, "[FAILED] %s (include cycle)\n", driver.units[i].path);
+			driver.failed++;
+		}
+	}
+
+	(void)fprintf(driver.output, "%i of %i files compiled\n", driver.unitCount - driver.failed, driver.unitCount);
+	(void)fclose(driver.output);
+	(void)free(driver.queue);
+	(void)CC_free_monitor(driver.monitor);
+	(void)DR_free_units(driver.units, driver.unitCount);
+	return driver.failed == 0 ? 0 : -1;
+}
+
+/*
+Purpose: Read the source files and the job count from the command line
+Return Type: int => true on success, false on invalid arguments
+Params: int argc => Argument count; char *argv[] => Arguments;
+		struct CompilationUnit **units => Receives the units; int *unitCount => Receives the unit count;
+		int *jobs => Receives the number of threads
+*/
+int DR_parse_arguments(int argc, char *argv[], struct CompilationUnit **units, int *unitCount, int *jobs) {
+	(*units) = (struct CompilationUnit*)calloc(argc > 0 ? (size_t)argc : 1, sizeof(struct CompilationUnit));
+	(*jobs) = (int)CC_get_processor_count();
+
+	if ((*units) == NULL) {
+		(void)printf("Could not reserve the compilation units!\n");
+		return false;
+	}
+
+	for (int i = 1; i < argc; i++) {
+		if ((int)strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+			(*jobs) = (int)atoi(argv[++i]);
+			continue;
+		}
+
+		struct CompilationUnit *unit = &(*units)[(*unitCount)++];
+		unit->path = argv[i];
+		unit->state = UNIT_WAITING;
+		unit->failedDependency = -1;
+	}
+
+	if ((*jobs) < 1 || (*jobs) > DRIVER_MAX_JOBS || (*unitCount) == 0) {
+		(void)printf("Usage: %s <file> [<file> ...] [-j <1 - %i>]\n", argv[0], DRIVER_MAX_JOBS);
+		(void)free(*units);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+Purpose: Scan the include statements of a unit and add it as a dependent to each included input file
+Return Type: int => true on success, false if a dependency could not be added
+Params: struct CompilationUnit *units => All units; int unitCount => Number of units;
+		int unit => Index of the unit to scan
+*/
+int DR_add_dependencies(struct CompilationUnit *units, int unitCount, int unit) {
+	FILE *file = fopen(units[unit].path, "rb");
+
+	//An unreadable file fails in its front end
+	if (file == NULL) {
+		return true;
+	}
+
+	//Only the statement starts are checked, so "include" in strings, comments or names is skipped
+	char include[256];
+	char line[4096];
+	int inComment = false;
+	size_t newlines = 0;
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		size_t i = 0;
+
+		while (line[i] != '\0') {
+			if (inComment == true) {
+				char *end = strstr(&line[i], "*/");
+				i = end == NULL ? strlen(line) : (size_t)(end - line) + 2;
+				inComment = end == NULL;
+				continue;
+			}
+
+			i = (size_t)skip_whitespace_run(line, i, strlen(line), &newlines);
+
+			if (line[i] == '/' && line[i + 1] == '*') {
+				inComment = true;
+				i += 2;
+				continue;
+			}
+
+			if ((int)strncmp(&line[i], "include", 7) != 0 || (int)is_identifier_char(line[i + 7]) == true) {
+				break;
+			}
+
+			//include a.b.c; => "a/b/c"
+			size_t length = 0;
+			i += 7;
+
+			while (line[i] != '\0' && line[i] != ';' && length < sizeof(include) - 1) {
+				if ((int)is_identifier_char(line[i]) == true) {
+					include[length++] = line[i];
+				} else if (line[i] == '.') {
+					include[length++] = '/';
+				}
+
+				i++;
+			}
+
+			include[length] = '\0';
+			int dependency = (int)DR_find_unit(units, unitCount, include);
+
+			//Without the edge the unit could be checked before its dependency
+			if (dependency != -1 && dependency != unit) {
+				if ((int)DR_add_dependent(&units[dependency], unit) == false) {
+					(void)fclose(file);
+					return false;
+				}
+
+				units[unit].openDependencies++;
+			}
+
+			break;
+		}
+	}
+
+	(void)fclose(file);
+	return true;
+}
+
+/*
+Purpose: Find the unit, that an include refers to: "a/b" matches "a/b.txt" or "src/a/b.space"
+Return Type: int => Index of the unit, -1 if the include is not an input file
+Params: struct CompilationUnit *units => All units; int unitCount => Number of units;
+		const char *include => Include path with '/' as the separator
+*/
+int DR_find_unit(struct CompilationUnit *units, int unitCount, const char *include) {
+	size_t includeLength = strlen(include);
+
+	if (includeLength == 0) {
+		return -1;
+	}
+
+	for (int i = 0; i < unitCount; i++) {
+		const char *path = units[i].path;
+		const char *extension = strrchr(path, '.');
+		size_t length = extension != NULL && strpbrk(extension, "/\\") == NULL ? (size_t)(extension - path) : strlen(path);
+
+		if (length < includeLength || (int)strncmp(path + length - includeLength, include, includeLength) != 0) {
+			continue;
+		}
+
+		if (length == includeLength || path[length - includeLength - 1] == '/' || path[length - includeLength - 1] == '\\') {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+Purpose: Add a dependent unit, that is checked after the unit finished
+Return Type: int => true on success, false if the dependents could not be reallocated
+Params: struct CompilationUnit *unit => Included unit; int dependent => Index of the including unit
+*/
+int DR_add_dependent(struct CompilationUnit *unit, int dependent) {
+	int *dependents = (int*)realloc(unit->dependents, sizeof(int) * (unit->dependentCount + 1));
+
+	if (dependents == NULL) {
+		return false;
+	}
+
+	unit->dependents = dependents;
+	unit->dependents[unit->dependentCount++] = dependent;
+	return true;
+}
+
+/*
+Purpose: Worker of the pool: run the next step of the queued units, till no unit can get ready anymore
+Return Type: void
+Params: void *argument => The Driver
+*/
+void DR_run_units(void *argument) {
+	struct Driver *driver = (struct Driver*)argument;
+	(void)CC_enter_monitor(driver->monitor);
+
+	while (true) {
+		//A running unit can still make its dependents ready
+		while (driver->queueStart == driver->queueEnd && driver->running > 0) {
+			(void)CC_wait_monitor(driver->monitor);
+		}
+
+		if (driver->queueStart == driver->queueEnd) {
+			break;
+		}
+
+		int index = driver->queue[driver->queueStart++];
+		struct CompilationUnit *unit = &driver->units[index];
+
+		//Skipped, while it was queued
+		if (unit->state == UNIT_DONE) {
+			continue;
+		}
+
+		int checking = unit->state == UNIT_PARSED;
+		unit->state = checking == true ? UNIT_CHECKING : UNIT_PARSING;
+		driver->running++;
+		(void)CC_leave_monitor(driver->monitor);
+
+		enum StepResult result = checking == true ? DR_check_semantic(unit) : DR_generate_parsetree(unit);
+
+		//The unit is finished, only this thread uses its context
+		if (result != STEP_OK || checking == true) {
+			(void)DR_write_log(unit, result);
+			(void)FREE_COMPILER_CONTEXT(unit->context);
+			unit->context = NULL;
+		}
+
+		(void)CC_enter_monitor(driver->monitor);
+		driver->running--;
+		(void)DR_finish_step(driver, index, checking, result);
+		(void)CC_notify_monitor(driver->monitor);
+	}
+
+	(void)CC_leave_monitor(driver->monitor);
+}
+
+/*
+Purpose: Read the file of a unit and generate its parsetree in a new context
+Return Type: enum StepResult => STEP_OK, if the parsetree was generated
+Params: struct CompilationUnit *unit => Unit to read
+*/
+enum StepResult DR_generate_parsetree(struct CompilationUnit *unit) {
+	struct CompilerContext *context = CC_create_context(unit->path);
+
+	if (context == NULL) {
+		return STEP_NO_CONTEXT;
+	}
+
+	//A fatal error jumps back here instead of exiting the driver
+	struct Node *volatile root = NULL;
+	jmp_buf recoveryPoint;
+	unit->context = context;
+	context->recoveryPoint = &recoveryPoint;
+
+	if (setjmp(recoveryPoint) == 0) {
+		struct InputReaderResults input = ProcessInput(context, unit->path);
+
+		if (PARSETREE_CACHE_MODE == 1) {
+			root = TC_load_parsetree(context, unit->path, input.buffer, input.fileLength);
+		}
+
+		if (root == NULL) {
+			root = GenerateValidatedParsetree(context);
+
+			if (root != NULL && PARSETREE_CACHE_MODE == 1) {
+				(void)TC_store_parsetree(unit->path, input.buffer, input.fileLength, root);
+			}
+		}
+	}
+
+	context->recoveryPoint = NULL;
+	unit->root = root;
+	return DR_get_step_result(context, root == NULL);
+}
+
+/*
+Purpose: Run the semantic analysis of a unit, whose dependencies are compiled
+Return Type: enum StepResult => STEP_OK, if the unit has no semantic errors
+Params: struct CompilationUnit *unit => Unit with the parsetree
+*/
+enum StepResult DR_check_semantic(struct CompilationUnit *unit) {
+	struct CompilerContext *context = unit->context;
+	volatile int containsErrors = true;
+	jmp_buf recoveryPoint;
+	(void)CC_use_context(context);
+	context->recoveryPoint = &recoveryPoint;
+
+	if (setjmp(recoveryPoint) == 0) {
+		containsErrors = (int)CheckSemantic(context, unit->root) != 0;
+	}
+
+	//A fatal error of the declarations leaves the queued bodies
+	context->recoveryPoint = NULL;
+	(void)FREE_SEMANTIC_SCHEDULE(context);
+	return DR_get_step_result(context, containsErrors);
+}
+
+/*
+Purpose: Get the result of a step from the diagnostics of the context
+Return Type: enum StepResult => STEP_FATAL after a fatal error, STEP_ERRORS if the step failed, else STEP_OK
+Params: struct CompilerContext *context => Context of the unit; int failed => true, if the step failed
+*/
+enum StepResult DR_get_step_result(struct CompilerContext *context, int failed) {
+	if (context->diagnosticCount > 0 && context->diagnostics[context->diagnosticCount - 1].fatal == true) {
+		return STEP_FATAL;
+	}
+
+	return failed == true ? STEP_ERRORS : STEP_OK;
+}
+
+/*
+Purpose: Report a finished step and queue the units, that got ready (called in the monitor)
+Return Type: void
+Params: struct Driver *driver => The driver; int unit => Index of the unit;
+		int checking => true after the semantic analysis, false after the front end; enum StepResult result => Result of the step
+*/
+void DR_finish_step(struct Driver *driver, int unit, int checking, enum StepResult result) {
+	struct CompilationUnit *compiled = &driver->units[unit];
+
+	if (result != STEP_OK) {
+		const char *reason = result == STEP_FATAL ? "fatal error" : result == STEP_NO_CONTEXT ? "could not create the compiler context"
+			: checking == true ? "semantic errors" : "syntax errors";
+		(void)fprintf(driver->output, "[FAILED] %s (%s", compiled->path, reason);
+		(void)fprintf(driver->output, result != STEP_NO_CONTEXT ? ", see %s%s)\n" : ")\n", compiled->path, DRIVER_LOG_SUFFIX);
+		(void)fflush(driver->output);
+		compiled->state = UNIT_DONE;
+		compiled->failed = true;
+		driver->failed++;
+		(void)DR_skip_dependents(driver, unit);
+		return;
+	}
+
+	if (checking == false) {
+		//A dependency failed, while the front end ran
+		if (compiled->failedDependency != -1) {
+			(void)DR_skip_unit(driver, unit);
+		} else if (compiled->openDependencies == 0) {
+			compiled->state = UNIT_PARSED;
+			driver->queue[driver->queueEnd++] = unit;
+		} else {
+			compiled->state = UNIT_PARSED;
+		}
+
+		return;
+	}
+
+	(void)fprintf(driver->output, "[OK] %s (see %s%s)\n", compiled->path, compiled->path, DRIVER_LOG_SUFFIX);
+	(void)fflush(driver->output);
+	compiled->state = UNIT_DONE;
+
+	for (int i = 0; i < compiled->dependentCount; i++) {
+		struct CompilationUnit *dependent = &driver->units[compiled->dependents[i]];
+
+		//A unit in its front end is queued, when the front end is done
+		if (--dependent->openDependencies == 0 && dependent->state == UNIT_PARSED) {
+			driver->queue[driver->queueEnd++] = compiled->dependents[i];
+		}
+	}
+}
+
+/*
+Purpose: Report a unit, whose dependency failed, and skip the units, that include it (called in the monitor)
+Return Type: void
+Params: struct Driver *driver => The driver; int unit => Index of the unit, its failedDependency is set
+*/
+void DR_skip_unit(struct Driver *driver, int unit) {
+	struct CompilationUnit *skipped = &driver->units[unit];
+	(void)fprintf(driver->output, "[SKIPPED] %s (dependency %s failed)\n", skipped->path, driver->units[skipped->failedDependency].path);
+	(void)fflush(driver->output);
+	skipped->state = UNIT_DONE;
+	skipped->failed = true;
+	driver->failed++;
+	(void)DR_skip_dependents(driver, unit);
+}
+
+/*
+Purpose: Skip the units, that include a failed unit, instead of checking them (called in the monitor)
+Return Type: void
+Params: struct Driver *driver => The driver; int unit => Index of the failed unit
+*/
+void DR_skip_dependents(struct Driver *driver, int unit) {
+	struct CompilationUnit *failed = &driver->units[unit];
+
+	for (int i = 0; i < failed->dependentCount; i++) {
+		struct CompilationUnit *dependent = &driver->units[failed->dependents[i]];
+
+		if (dependent->state == UNIT_DONE || dependent->failedDependency != -1) {
+			continue;
+		}
+
+		dependent->failedDependency = unit;
+
+		//A running front end is skipped, when it is done (see DR_finish_step())
+		if (dependent->state != UNIT_PARSING) {
+			(void)DR_skip_unit(driver, failed->dependents[i]);
+		}
+	}
+}
+
+/*
+Purpose: Write the diagnostics of a finished unit to "<file>.log"
+Return Type: void
+Params: struct CompilationUnit *unit => Finished unit; enum StepResult result => Result of its last step
+*/
+void DR_write_log(struct CompilationUnit *unit, enum StepResult result) {
+	size_t pathLength = strlen(unit->path);
+	char *logPath = unit->context != NULL ? (char*)malloc(pathLength + sizeof(DRIVER_LOG_SUFFIX)) : NULL;
+
+	if (logPath == NULL) {
+		return;
+	}
+
+	(void)memcpy(logPath, unit->path, pathLength);
+	(void)memcpy(logPath + pathLength, DRIVER_LOG_SUFFIX, sizeof(DRIVER_LOG_SUFFIX));
+	FILE *log = fopen(logPath, "w");
+	(void)free(logPath);
+
+	if (log == NULL) {
+		return;
+	}
+
+	(void)CC_write_diagnostics(unit->context, log);
+
+	//The fatal errors are not rendered, the error handlers wrote them to stdout
+	for (size_t i = 0; i < unit->context->diagnosticCount; i++) {
+		struct Diagnostic *diagnostic = &unit->context->diagnostics[i];
+
+		if (diagnostic->fatal == true && diagnostic->line > 0) {
+			(void)fprintf(log, "Fatal error (line %zu): %s\n", diagnostic->line, diagnostic->message);
+		} else if (diagnostic->fatal == true) {
+			(void)fprintf(log, "Fatal error: %s\n", diagnostic->message);
+		}
+	}
+
+	if (result == STEP_OK) {
+		(void)fprintf(log, "\n>>>>> %s has been successfully compiled. <<<<<\n", unit->path);
+	}
+
+	(void)fclose(log);
+}
+
+/*
+Purpose: Free the units
+Return Type: void
+Params: struct CompilationUnit *units => Units to free; int unitCount => Number of units
+*/
+void DR_free_units(struct CompilationUnit *units, int unitCount) {
+	for (int i = 0; i < unitCount; i++) {
+		(void)free(units[i].dependents);
+		(void)FREE_COMPILER_CONTEXT(units[i].context);
+	}
+
+	(void)free(units);
+}
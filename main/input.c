@@ -25,10 +25,22 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <ctype.h>
 #include "../headers/modules.h"
 #include "../headers/errors.h"
+#include "../headers/compilerContext.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #define true 1
 #define false 0
 
+#define INPUT_STREAM_CHUNK_SIZE 65536
+
 ////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////     Input     ////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -36,421 +48,236 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 void check_file_pointer(const FILE *fptr, char *pathToSourceFile);
 void check_file_length(const size_t length, char *pathToSourceFile);
 void reserve_buffer(const size_t fileLength, char **buffer);
-int get_minimum_token_number(char **buffer, int **arrayOfIndividualTokenSizes, const size_t bufferLength);
-int add_identifiers(size_t currentBufferCharacterPosition, size_t bufferLength, char **buffer, int **arrayOfIndividualTokenSizes, size_t currentTokenNumber);
-int set_operator_size(char **buffer, size_t bufferLength, size_t currentBufferCharacterPosition, int **arrayOfIndividualTokenSizes, size_t currentTokenNumber);
-int skip_string(char **buffer, size_t bufferLength, size_t currentBufferCharacterPosition, int **arrayOfIndividualTokenSizes, size_t currentTokenNumber);
-void reserve_token_lengths(const size_t fileLength, int **arrayOfIndividualTokenSizes);
-int check_double_operator(char currentInputChar, char NextInputChar);
-int is_correct_pointer(char **buffer, size_t currentBufferCharPos, const size_t maxSize);
-int skip_buffer_comment(char **buffer, size_t currentPos, size_t bufferLength, char crucialChar);
+int map_input_file(char *path, char **buffer, size_t *fileLength);
+void stream_input_file(char *path, char **buffer, size_t *fileLength);
 
 /*
-Purpose: Read in the source files to compile, then read in the grammar file and tokenize the whole input
-Return Type: int
-Params: NULL
+Purpose: Read in the source file to compile, the tokenization is done in a single pass by the lexer
+Return Type: struct InputReaderResults => Buffer with the source and its length
+Params: struct CompilerContext *context => Compilation, that receives the buffer;
+		char *path => Path to the source file, "-" reads the source from stdin
 */
-char *INPUT_BUFFER = NULL;
-int *ARRAY_OF_INDIVIDUAL_TOKEN_SIZES = NULL;
+struct InputReaderResults ProcessInput(struct CompilerContext *context, char *path) {
+	(void)CC_use_context(context);
+	size_t fileLength = 0;
 
-struct InputReaderResults ProcessInput(char *path) {
-	//File to read
-	FILE *filePointer = (FILE*)fopen(path, "r");
+	//Map regular files directly, everything else (pipes, stdin, ...) is streamed in chunks
+	if ((int)map_input_file(path, &context->buffer, &fileLength) == false) {
+		(void)stream_input_file(path, &context->buffer, &fileLength);
+	}
 
-	(void)check_file_pointer(filePointer, path);
-	
-	(void)fseek(filePointer, 0L, SEEK_END);
-	const size_t fileLength = (size_t)ftell(filePointer);
+	context->bufferLength = fileLength;
 	(void)check_file_length(fileLength, path);
 
-	//Character buffer for all input symbols
-	(void)reserve_buffer(fileLength, &INPUT_BUFFER);
-	(void)reserve_token_lengths(fileLength, &ARRAY_OF_INDIVIDUAL_TOKEN_SIZES);
-	(void)_init_error_buffer_cache_(&INPUT_BUFFER);
-	(void)_init_error_token_size_cache_(&ARRAY_OF_INDIVIDUAL_TOKEN_SIZES);
-
-	//Go back to the start of the file
-	(void)rewind(filePointer);
-
-	//Read the contents of the file into the buffer
-	(void)fread(INPUT_BUFFER, sizeof(char), fileLength, filePointer);
-	int requiredTokenLength = (int)get_minimum_token_number(&INPUT_BUFFER, &ARRAY_OF_INDIVIDUAL_TOKEN_SIZES, fileLength);
-
-	if (fclose(filePointer) == EOF) {
-		(void)IO_FILE_CLOSING_EXCEPTION();
-	}
-
 	//Create and return the results
 	struct InputReaderResults result;
-	result.buffer = INPUT_BUFFER;
-	result.arrayOfIndividualTokenSizes = ARRAY_OF_INDIVIDUAL_TOKEN_SIZES;
-	result.requiredTokenNumber = requiredTokenLength;
+	result.buffer = context->buffer;
 	result.fileLength = fileLength;
 
 	return result;
 }
 
 /*
-Purpose: Checks whether the file pointer is NULL or ot and adds a terminator character
-Return Type: void
-Params: FILE *fptr => File Pointer; 
-		char *pathToSourceFile => Absolute or relative path to the file
+Purpose: Maps a regular file read-only into memory, so the lexer can read straight from the mapping
+Return Type: int => true = file is mapped; false = file has to be streamed instead
+Params: char *path => Absolute or relative path to the file;
+		char **buffer => Buffer that is set to the start of the mapping;
+		size_t *fileLength => Is set to the length of the file
 */
-void check_file_pointer(const FILE *fptr, char *pathToSourceFile) {
-	if (fptr == NULL) {
-		char sourceFile[64] = {'\0'};
-		(void)strncpy(pathToSourceFile, sourceFile, 63);
-		(void)IO_FILE_EXCEPTION((char *)sourceFile, "input");
+#ifdef _WIN32
+int map_input_file(char *path, char **buffer, size_t *fileLength) {
+	if (strcmp(path, "-") == 0) {
+		return false;
 	}
-}
 
-/*
-Purpos: Checks if the file contains something or not
-Return Type: void
-Params: const long length => Length of the file; 
-		char *pathToSourceFile => Absolute or relative path to the file
-*/
-void check_file_length(const size_t length, char *pathToSourceFile) {
-	if (length == 0) {
-		(void)IO_FILE_EXCEPTION(pathToSourceFile, "input");
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
 	}
-}
 
-/*
-Purpose: Reserves a part of the memory based on the file size for the buffer
-Return Type: void
-Params: const long fileLength => Length of the file; 
-		char **buffer => The buffer to which the memory should be allocated
-*/
-void reserve_buffer(const size_t fileLength, char **buffer) {
-	if (fileLength > 0) {
-		*buffer = (char*)calloc(fileLength + 1, sizeof(char));
+	LARGE_INTEGER size;
+	SYSTEM_INFO systemInfo;
+	(void)GetSystemInfo(&systemInfo);
+
+	//The lexer relies on a '\0' behind the last character, which the mapping only provides if the file does not end on a page boundary
+	if (GetFileType(file) != FILE_TYPE_DISK
+		|| GetFileSizeEx(file, &size) == 0
+		|| size.QuadPart == 0
+		|| (size_t)size.QuadPart % systemInfo.dwPageSize == 0) {
+		(void)CloseHandle(file);
+		return false;
+	}
 
-		if (*buffer == NULL) {
-			(void)IO_BUFFER_RESERVATION_EXCEPTION();
-		}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	(void)CloseHandle(file);
 
-		(*buffer)[fileLength] = '\0';
+	if (mapping == NULL) {
+		return false;
 	}
-}
 
-/*
-Purpose: Reserves a part of the memory for the individual token lengths
-Return Type: void
-Params: const long fileLength => Length of the file;
-		int **arrayOfIndividualTokenSizes => Array to store the predicted token size
-*/
-void reserve_token_lengths(const size_t fileLength, int **arrayOfIndividualTokenSizes) {
-	if (fileLength > 0) {
-		*arrayOfIndividualTokenSizes = (int*)calloc(fileLength, sizeof(int));
+	char *view = (char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	(void)CloseHandle(mapping);
 
-		if (*arrayOfIndividualTokenSizes == NULL) {
-			(void)IO_BUFFER_RESERVATION_EXCEPTION();
-		}
+	if (view == NULL) {
+		return false;
 	}
+
+	*buffer = view;
+	*fileLength = (size_t)size.QuadPart;
+	CURRENT_CONTEXT->bufferIsMapped = true;
+	CURRENT_CONTEXT->bufferMappedLength = *fileLength;
+	return true;
 }
+#else
+int map_input_file(char *path, char **buffer, size_t *fileLength) {
+	if (strcmp(path, "-") == 0) {
+		return false;
+	}
 
-/*
-Purpose: Determine how much Tokens are required for the file to be processed
-Return Type: int => how much tokens
-Params: char **buffer => Pointer to the buffer, which holds the source files content;
-		int **arrayOfIndividualTokenSizes => Array for the individual token lengths;
-		const size_t bufferLength => Length of the buffer
-*/
-int get_minimum_token_number(char **buffer, int **arrayOfIndividualTokenSizes, const size_t bufferLength) {
-	int tokenNumber = 0;
-	int comment = 0;
-
-	if (*buffer != NULL && *arrayOfIndividualTokenSizes != NULL) {
-		for (size_t i = 0; i < bufferLength; i++) {
-			// If input is a comment
-			if ((*buffer)[i] == '/'
-				&& ((*buffer)[i + 1] == '/'
-				|| (*buffer)[i + 1] == '*')) {
-				i += (int)skip_buffer_comment(buffer, i, bufferLength, (*buffer)[i + 1]);
-				continue;
-			}
+	int fileDescriptor = (int)open(path, O_RDONLY);
 
-			int isWhitespace = (int)is_space((*buffer)[i]);
-			int isOperator = false;
-			
-			if (isWhitespace == false) {
-				if ((int)check_for_operator((*buffer)[i]) == true) {
-					if ((*buffer)[i] == '&'
-						|| (int)is_correct_pointer(buffer, i, bufferLength) == true) {
-						isOperator = false;
-					} else if ((*buffer)[i] == '-'
-						&& (int)is_digit((*buffer)[i + 1]) == true) {
-						isOperator = false;
-					} else {
-						isOperator = true;
-					}
-				}
-			}
-			
-			// If input is start of a string
-			if ((*buffer)[i] == '\"') {
-				i += (int)skip_string(buffer, bufferLength, i, arrayOfIndividualTokenSizes, tokenNumber);
-				tokenNumber++;
-				continue;
-			}
-			
-			if (isOperator) {
-				i += (int)set_operator_size(buffer, bufferLength, i, arrayOfIndividualTokenSizes, tokenNumber);
-				tokenNumber ++;
-				continue;
-			}
-			
-			if (!isWhitespace && !isOperator) {
-				i += (int)add_identifiers(i, bufferLength, buffer, arrayOfIndividualTokenSizes, tokenNumber);
-				tokenNumber ++;
-				continue;
-			}
-		}
+	if (fileDescriptor < 0) {
+		return false;
 	}
 
-	return tokenNumber - comment;
-}
-
-/*
-Purpose: Gives back the number of chars to skip as they are in a comment
-Return Type: int => Number of chars to skip
-Params: char **buffer => Buffer to be checked;
-		size_t currentPos => Position from where to start skipping;
-		size_t bufferLength => Maximum length of the input file;
-		char crucialChar => Character that determines the type of comment
-*/
-int skip_buffer_comment(char **buffer, size_t currentPos, size_t bufferLength, char crucialChar) {
-	int skip = 1;
+	struct stat fileStatus;
+	long pageSize = (long)sysconf(_SC_PAGESIZE);
+
+	//The lexer relies on a '\0' behind the last character, which the mapping only provides if the file does not end on a page boundary
+	if (fstat(fileDescriptor, &fileStatus) != 0
+		|| S_ISREG(fileStatus.st_mode) == 0
+		|| fileStatus.st_size == 0
+		|| pageSize <= 0
+		|| (size_t)fileStatus.st_size % (size_t)pageSize == 0) {
+		(void)close(fileDescriptor);
+		return false;
+	}
 
-	while (currentPos + skip < bufferLength) {
-		if (crucialChar == '/') {
-			if ((*buffer)[currentPos + skip] == '\n') {
-				break;
-			}
-		} else if (crucialChar == '*') {
-			if ((*buffer)[currentPos + skip] == '*'
-				&& (*buffer)[currentPos + skip + 1] == '/') {
-				skip++;
-				break;
-			}
-		} else {
-			printf("Something went wrong in the comment definition.");
-		}
+	const size_t length = (size_t)fileStatus.st_size;
+	void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	(void)close(fileDescriptor);
 
-		skip++;
+	if (mapping == MAP_FAILED) {
+		return false;
 	}
 
-	return skip;
+	(void)madvise(mapping, length, MADV_SEQUENTIAL);
+	*buffer = (char*)mapping;
+	*fileLength = length;
+	CURRENT_CONTEXT->bufferIsMapped = true;
+	CURRENT_CONTEXT->bufferMappedLength = length;
+	return true;
 }
+#endif
 
 /*
-Purpose: Check if a pointer is defined correctly
-Return Type: int => true = is correct defined pointer; false = not correct defined pointer;
-Params: char **buffer => Buffer to be checked;
-		size_T currentBufferCharPos => Position of the current character in the buffer;
-		const size_t maxSize => File size
+Purpose: Reads the input in fixed sized chunks into a growing buffer (used for pipes, stdin and as fallback)
+Return Type: void
+Params: char *path => Absolute or relative path to the file, "-" reads from stdin;
+		char **buffer => The buffer to which the content is written;
+		size_t *fileLength => Is set to the number of read characters
 */
-int is_correct_pointer(char **buffer, size_t currentBufferCharPos, const size_t maxSize) {
-	if (buffer != NULL) {
-		int skips = 0;
-		
-		while (currentBufferCharPos + skips < maxSize) {
-			if ((*buffer)[currentBufferCharPos + skips] == '*') {
-				skips++;
-			} else {
-				break;
-			}
-		}
-		
-		if ((int)is_space((*buffer)[currentBufferCharPos + skips]) == true
-			|| (int)is_digit((*buffer)[currentBufferCharPos + skips]) == true
-			|| (int)check_for_operator((*buffer)[currentBufferCharPos + skips]) == true) {
-			return false;
-		}
+void stream_input_file(char *path, char **buffer, size_t *fileLength) {
+	int readsFromStdin = strcmp(path, "-") == 0 ? true : false;
+	FILE *filePointer = readsFromStdin == true ? stdin : (FILE*)fopen(path, "r");
 
-		return true;
-	}
+	(void)check_file_pointer(filePointer, path);
 
-	return false;
-}
+	size_t capacity = INPUT_STREAM_CHUNK_SIZE;
+	size_t length = 0;
+	size_t readCharacters = 0;
+	(void)reserve_buffer(capacity, buffer);
 
-/*
-Purpose: Skips everything, till it scans a comment, operator, whitespace, string ect.
-Return Type: int => How many chars to skip
-Params: size_t currentBufferCharacterPosition => Position of the current character in the buffer;
-		size_t bufferLength => Length of the buffer;
-		char **buffer => Buffer, in which the content of the source file can be found;
-		int **arrayOfIndividualTokens => Array in which the size of every token is stored;
-		size_t tokenNumber => Current token number that is processed
-*/
-int add_identifiers(size_t currentBufferCharacterPosition, size_t bufferLength, char **buffer, int **arrayOfIndividualTokenSizes, size_t currentTokenNumber) {
-	int identifierLength = 0;
-	int isInReferenceToPointer = false;
+	do {
+		length += readCharacters;
 
-	while (currentBufferCharacterPosition + identifierLength < bufferLength) {
-		if ((int)is_space((*buffer)[currentBufferCharacterPosition + identifierLength]) == true) {
-			break;
-		}
+		if (capacity - length < INPUT_STREAM_CHUNK_SIZE) {
+			capacity *= 2;
+			char *newBuffer = (char*)realloc(*buffer, sizeof(char) * (capacity + 1));
 
-		if ((int)check_for_operator((*buffer)[currentBufferCharacterPosition + identifierLength]) == true) {
-			if ((*buffer)[currentBufferCharacterPosition + identifierLength] == '&') {
-				if ((*buffer)[currentBufferCharacterPosition + identifierLength + 1] == '(') {
-					isInReferenceToPointer = true;
-				}
-				
-				identifierLength++;
-				continue;
-			} else if ((*buffer)[currentBufferCharacterPosition + identifierLength] == '.') {
-				if ((int)is_digit((*buffer)[currentBufferCharacterPosition + identifierLength - 1]) == true
-					&& (int)is_digit((*buffer)[currentBufferCharacterPosition + identifierLength + 1]) == true) {
-					identifierLength++;
-					continue;
-				} else {
-					break;
-				}
-			} else if ((*buffer)[currentBufferCharacterPosition + identifierLength] == '*') {
-				if (isInReferenceToPointer == true) {
-					identifierLength++;
-					continue;
-				}
-			} else if ((*buffer)[currentBufferCharacterPosition + identifierLength] == ')'
-				|| (*buffer)[currentBufferCharacterPosition + identifierLength] == '(') {
-				if (isInReferenceToPointer == true) {
-					isInReferenceToPointer = false;
-					identifierLength++;
-					continue;
-				} else {
-					break;
-				}
-			} else if ((*buffer)[currentBufferCharacterPosition + identifierLength] == '-'
-				&& (int)is_digit((*buffer)[currentBufferCharacterPosition + identifierLength + 1]) == true) {
-				identifierLength++;
-				continue;
-			} else {
-				break;
+			if (newBuffer == NULL) {
+				(void)IO_BUFFER_RESERVATION_EXCEPTION();
 			}
-		}
 
-		if ((*buffer)[currentBufferCharacterPosition + identifierLength + 1] == '#') {
-			break;
+			*buffer = newBuffer;
 		}
 
-		identifierLength++;
-	}
+		readCharacters = (size_t)fread(*buffer + length, sizeof(char), INPUT_STREAM_CHUNK_SIZE, filePointer);
+	} while (readCharacters > 0);
+
+	(*buffer)[length] = '\0';
+	*fileLength = length;
 
-	(*arrayOfIndividualTokenSizes)[currentTokenNumber] = identifierLength + 1;
-	return identifierLength - 1;
+	if (readsFromStdin == false && fclose(filePointer) == EOF) {
+		(void)IO_FILE_CLOSING_EXCEPTION();
+	}
 }
 
 /*
-Purpose: Sets the size of the current integer in arrayOfIndividualTokens to the given operator size
-Return Type: int => 1 = double Operator; 0 = normal Operator
-Params: char **buffer => Buffer, in which the content of the source file can be found;
-		size_t bufferLength => Length of the buffer;
-		size_t currentBufferCharacterPasition => Position of the current character in the buffer;
-		int **arrayOfIndividualTokens => Array in which the size of every token is stored;
-		size_t tokenNumber => Current token number that is processed
+Purpose: Checks whether the file pointer is NULL or ot and adds a terminator character
+Return Type: void
+Params: FILE *fptr => File Pointer; 
+		char *pathToSourceFile => Absolute or relative path to the file
 */
-int set_operator_size(char **buffer, size_t bufferLength, size_t currentBufferCharacterPosition, int **arrayOfIndividualTokenSizes, size_t currentTokenNumber) {
-	if (currentBufferCharacterPosition + 1 < bufferLength) {
-		char currentCharacter = (*buffer)[currentBufferCharacterPosition];
-		char followingCharacter = (*buffer)[currentBufferCharacterPosition + 1];
-
-		if ((int)check_double_operator(currentCharacter, followingCharacter)) {
-			(*arrayOfIndividualTokenSizes)[currentTokenNumber] = 3;
-			return 1;
-		}
+void check_file_pointer(const FILE *fptr, char *pathToSourceFile) {
+	if (fptr == NULL) {
+		char sourceFile[64] = {'\0'};
+		(void)strncpy(sourceFile, pathToSourceFile, 63);
+		(void)IO_FILE_EXCEPTION((char *)sourceFile, "input");
 	}
-
-	(*arrayOfIndividualTokenSizes)[currentTokenNumber] = 2;
-	return 0;
 }
 
 /*
-Purpose: Skips a given string till the end and returns how many characters to skip
-Return Type: int => Count of how many characters to skip
-Params: const char **buffer => Buffer, that holds the source file content;
-		const size_t bufferLength => Length of the buffer;
-		const size_t currentBufferCharacterPosition => Poosition of the buffer reader or the position of the current character
-		int **arrayOfIndividualTokenSizes => Array with all the  sizes of every individual token;
-		const size_t currentTokenNumber => Position of the current token
+Purpos: Checks if the file contains something or not
+Return Type: void
+Params: const long length => Length of the file; 
+		char *pathToSourceFile => Absolute or relative path to the file
 */
-int skip_string(char **buffer, size_t bufferLength, size_t currentBufferCharacterPosition, int **arrayOfIndividualTokenSizes, size_t currentTokenNumber) {
-	size_t lengthOfString = 1;
-
-	// Skip the whole string till the end
-	while (currentTokenNumber + lengthOfString < bufferLength 
-			&& ((*buffer)[currentBufferCharacterPosition + lengthOfString] != '\"'
-			|| (*buffer)[currentBufferCharacterPosition + lengthOfString - 1] == '\\')) {
-		lengthOfString++;
+void check_file_length(const size_t length, char *pathToSourceFile) {
+	if (length == 0) {
+		(void)IO_FILE_EXCEPTION(pathToSourceFile, "input");
 	}
-
-	// "+2", 1 for the end quote and 1 for termination character
-	(*arrayOfIndividualTokenSizes)[currentTokenNumber] = lengthOfString + 2;
-	return lengthOfString;
 }
 
 /*
-Purpose: Check if the input is a double operator like "==" or "+="
-Return Type: int => true = true; false = false;
-Params: char currentInput => The current character of the input;
-		char NextChar => Following character of the input
+Purpose: Reserves a part of the memory based on the file size for the buffer
+Return Type: void
+Params: const long fileLength => Length of the file; 
+		char **buffer => The buffer to which the memory should be allocated
 */
-int check_double_operator(char currentInputChar, char NextInputChar) {
-	if ((currentInputChar == '+' || currentInputChar == '-' || currentInputChar == '/'
-		|| currentInputChar == '*' || currentInputChar == '!') && NextInputChar == '=') {
-		return true;
-	}
-
-	if ((currentInputChar == '+' && NextInputChar == '+')
-		|| (currentInputChar == '-' && NextInputChar == '-')
-		|| (currentInputChar == '=' && NextInputChar == '=')) {
-		return true;
-	}
+void reserve_buffer(const size_t fileLength, char **buffer) {
+	if (fileLength > 0) {
+		*buffer = (char*)calloc(fileLength + 1, sizeof(char));
 
-	if ((currentInputChar == '<' || currentInputChar == '>')
-		&& NextInputChar == '=') {
-		return true;
-	}
+		if (*buffer == NULL) {
+			(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		}
 
-	if (currentInputChar == '-' && NextInputChar == '>') {
-		return true;
-	} else if (currentInputChar == '=' && NextInputChar == '>') {
-		return true;
+		(*buffer)[fileLength] = '\0';
 	}
-
-	return false;
 }
 
 /*
-Purpose: Free the buffer
+Purpose: Free the buffer of the CURRENT_CONTEXT, a mapped buffer is unmapped
 Return Type: int => true = freed the buffer
 Params: char *buffer => Buffer to be freed
 */
-int alreadyFreedBuffer = false;
-
 int FREE_BUFFER(char *buffer) {
-	if (alreadyFreedBuffer == false) {
-		(void)free(buffer);
-		alreadyFreedBuffer = true;
-	}
-
-	return true;
-}
-
-/*
-Purpose: Free the token lengths array
-Return Type: int => 1 = freed the array
-Params: int *arrayOfIndividualTokenSizes => The array of individual token lengths to be freed
-*/
-int alreadyFreedTokenSizes = false;
+	if (buffer != NULL && buffer == CURRENT_CONTEXT->buffer) {
+		if (CURRENT_CONTEXT->bufferIsMapped == true) {
+			#ifdef _WIN32
+			(void)UnmapViewOfFile(buffer);
+			#else
+			(void)munmap(buffer, CURRENT_CONTEXT->bufferMappedLength);
+			#endif
+		} else {
+			(void)free(buffer);
+		}
 
-int FREE_TOKEN_LENGTHS(int *arrayOfIndividualTokenSizes) {
-	if (alreadyFreedTokenSizes == false) {
-		(void)free(arrayOfIndividualTokenSizes);
-		alreadyFreedTokenSizes = true;
+		CURRENT_CONTEXT->buffer = NULL;
+		CURRENT_CONTEXT->bufferIsMapped = false;
 	}
 
-	return 1;
+	return true;
 }
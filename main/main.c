@@ -22,61 +22,163 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include "../headers/modules.h"
 #include "../headers/hashmap.h"
 #include "../headers/errors.h"
+#include "../headers/treeCache.h"
+#include "../headers/compilerContext.h"
+#include "../headers/profiler.h"
+#include "../headers/logger.h"
 
 #include <time.h>
 #include <stdlib.h>
+#include <string.h>
 
-char *FILE_NAME = NULL;
-char **BUFFER = NULL;
-size_t BUFFER_LENGTH = 0;
-size_t TOKEN_LENGTH = 0;
-
-int main() {
-    (void)printf("SPACE-Language compiler [Version 0.0.1 - Alpha]\n");
-    (void)printf("Copyright (C) 2024 Lukas Nian En Lampl\n");
-    (void)printf("_________________________________________________\n\n");
-    
-    /////////////////////////////////////////
-    //////////     INPUT READER    //////////
-    /////////////////////////////////////////
-    char *path = "../SPACE/prgm.txt";
-    FILE_NAME = "prgm.txt";
-
-    struct InputReaderResults inputReaderResults = ProcessInput(path);
-    int *arrayOfIndividualTokenSizes = inputReaderResults.arrayOfIndividualTokenSizes;
-    BUFFER = &inputReaderResults.buffer;
-    BUFFER_LENGTH = inputReaderResults.fileLength;
-    TOKEN_LENGTH = inputReaderResults.requiredTokenNumber;
+/**
+ * <p>
+ * Runs the lexer, the syntax analyzer and the parsetree generator.
+ * </p>
+ * 
+ * @returns The parsetree, NULL if the source contains syntax errors
+ * 
+ * @param *context  Compilation with the source buffer
+ */
+struct Node *GenerateValidatedParsetree(struct CompilerContext *context) {
+    //Large buffers are lexed and checked window by window, the lexer is part of the syntax phase then
+    if (STREAMING_FRONT_END == 1 && context->bufferLength >= STREAMING_MIN_LENGTH) {
+        struct Node *root = NULL;
+        LOG(LOG_GENERAL, LOG_INFO, "Tokenize and check the input in windows\n");
+        (void)PF_begin_phase(PHASE_SYNTAX);
+        int containsSyntaxErrors = (int)CheckStreamAndGenerateParsetree(context, &root);
+        (void)PF_end_phase(PHASE_SYNTAX);
+        return containsSyntaxErrors == 0 ? root : NULL;
+    }
 
     //////////////////////////////////
     //////////     LEXER    //////////
     //////////////////////////////////
-    printf("Tokenize\n");
-    TOKEN *tokens = Tokenize(&arrayOfIndividualTokenSizes);
-    (void)FREE_TOKEN_LENGTHS(inputReaderResults.arrayOfIndividualTokenSizes);
+    LOG(LOG_GENERAL, LOG_INFO, "Tokenize\n");
+    (void)PF_begin_phase(PHASE_LEXER);
+    TOKEN *tokens = Tokenize(context);
+    (void)PF_end_phase(PHASE_LEXER);
 
     ////////////////////////////////////////
     /////     CHECK SYNTAX FUNCTION     ////
     ////////////////////////////////////////
 
     //0 = no errors, 1 = with errors
-    int containsSyntaxErrors = (int)CheckInput(&tokens);
+    (void)PF_begin_phase(PHASE_SYNTAX);
+    int containsSyntaxErrors = (int)CheckInput(context, &tokens);
+    (void)PF_end_phase(PHASE_SYNTAX);
 
     /////////////////////////////////////////
     ///////     GENERATE PARSETREE     //////
     /////////////////////////////////////////
     if (containsSyntaxErrors != 0) {
+        return NULL;
+    }
+
+    //The checked main statements are built one by one, like in the streaming front end
+    (void)PF_begin_phase(PHASE_PARSETREE);
+    struct Node *root = CHECK_THEN_BUILD_FRONT_END == 1
+        ? GenerateCheckedParsetree(context, &tokens)
+        : GenerateParsetree(context, &tokens);
+    (void)PF_end_phase(PHASE_PARSETREE);
+    return root;
+}
+
+int main(int argc, char *argv[]) {
+    //"--stats" and "--trace" are taken out of the arguments (see src/profiler.c)
+    if ((int)PF_parse_arguments(&argc, argv) == 0) {
+        return -1;
+    }
+
+    //"--log=<phase>:<level>" and "--log-file=<path>" enable the debug output (see src/logger.c)
+    if ((int)LG_parse_arguments(&argc, argv) == 0) {
+        return -1;
+    }
+
+    //"--max-errors=<n>" limits the written errors (see src/compilerContext.c)
+    if ((int)CC_parse_arguments(&argc, argv) == 0) {
+        return -1;
+    }
+
+    //The compile server answers requests on stdin, the banner would break its protocol
+    if (argc == 2 && strcmp(argv[1], "--server") == 0) {
+        return RunServer();
+    }
+
+    (void)printf("SPACE-Language compiler [Version 0.0.1 - Alpha]\n");
+    (void)printf("Copyright (C) 2024 Lukas Nian En Lampl\n");
+    (void)printf("_________________________________________________\n\n");
+    
+    //More than one source file (or "-j <count>") compiles the files in parallel, each in its own context
+    if (argc > 2) {
+        if ((int)PF_is_enabled() == 1) {
+            (void)printf("--stats and --trace measure a single source file, compile the files one by one.\n");
+            return -1;
+        }
+
+        return RunDriver(argc, argv);
+    }
+
+    /////////////////////////////////////////
+    //////////     INPUT READER    //////////
+    /////////////////////////////////////////
+    //The source file can be passed as the first argument, "-" reads the source from stdin
+    char *path = argc > 1 ? argv[1] : "../SPACE/prgm.txt";
+    struct CompilerContext *context = CC_create_context(argc > 1 ? argv[1] : "prgm.txt");
+
+    if (context == NULL) {
+        (void)LG_close();
         return -1;
     }
 
-    struct Node *root = GenerateParsetree(&tokens);
+    (void)PF_begin_phase(PHASE_INPUT);
+    struct InputReaderResults inputReaderResults = ProcessInput(context, path);
+    (void)PF_end_phase(PHASE_INPUT);
+
+    //////////////////////////////////////////
+    //////////     PARSETREE CACHE    ////////
+    //////////////////////////////////////////
+    //On a hit the lexer, the syntax analyzer and the parsetree generator are skipped
+    struct Node *root = NULL;
+
+    if (PARSETREE_CACHE_MODE == 1) {
+        (void)PF_begin_phase(PHASE_TREE_CACHE);
+        root = TC_load_parsetree(context, path, inputReaderResults.buffer, inputReaderResults.fileLength);
+        (void)PF_end_phase(PHASE_TREE_CACHE);
+    }
+
+    if (root != NULL) {
+        LOG(LOG_GENERAL, LOG_INFO, "Parsetree loaded from the cache (%s%s)\n", path, TREE_CACHE_SUFFIX);
+    } else {
+        root = GenerateValidatedParsetree(context);
+
+        if (root == NULL) {
+            (void)CC_flush_diagnostics(context);
+            (void)PF_finish(context);
+            (void)FREE_COMPILER_CONTEXT(context);
+            (void)LG_close();
+            return -1;
+        }
+
+        if (PARSETREE_CACHE_MODE == 1) {
+            (void)TC_store_parsetree(path, inputReaderResults.buffer, inputReaderResults.fileLength, root);
+        }
+    }
 
-    int containsSemanticErrors = (int)CheckSemantic(root);
+    (void)PF_begin_phase(PHASE_SEMANTIC);
+    int containsSemanticErrors = (int)CheckSemantic(context, root);
+    (void)PF_end_phase(PHASE_SEMANTIC);
+    (void)CC_flush_diagnostics(context);
+    (void)PF_finish(context);
 
     if (containsSemanticErrors != 0) {
+        (void)FREE_COMPILER_CONTEXT(context);
+        (void)LG_close();
         return -1;
     }
 
     (void)FREE_MEMORY();
+    (void)FREE_COMPILER_CONTEXT(context);
     (void)printf("\n>>>>> %s has been successfully compiled. <<<<<\n", path);
+    (void)LG_close();
 }
\ No newline at end of file
@@ -0,0 +1,810 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include "../headers/modules.h"
+#include "../headers/errors.h"
+#include "../headers/hashmap.h"
+#include "../headers/list.h"
+#include "../headers/internPool.h"
+#include "../headers/tokenIndex.h"
+#include "../headers/treeCache.h"
+#include "../headers/compilerContext.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#define SV_NULL_DEVICE "NUL"
+#define SV_dup _dup
+#define SV_dup2 _dup2
+#define SV_open _open
+#define SV_close _close
+#define SV_fdopen _fdopen
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define SV_NULL_DEVICE "/dev/null"
+#define SV_dup dup
+#define SV_dup2 dup2
+#define SV_open open
+#define SV_close close
+#define SV_fdopen fdopen
+#endif
+
+#define true 1
+#define false 0
+
+#define SERVER_LINE_SIZE 4096
+
+//From src/profiler.c, a monotonic clock: clock() is the CPU time of the process and also counts the worker threads
+double PF_get_wall_time_us();
+
+////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////     Server     ///////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+The server keeps the compiler alive between compilations: "space --server".
+
+Every line on stdin is one JSON request, every request is answered by one
+JSON line on stdout:
+{"id": 1, "method": "check", "path": "app.txt"}
+{"id": 1, "method": "check", "path": "app.txt", "source": "var a = 5;"}
+{"id": 2, "method": "edit", "path": "app.txt", "offset": 8, "removed": 1, "text": "6"}
+{"id": 3, "method": "shutdown"}
+
+A fatal error does not exit the process, it jumps back to the request
+(see CC_abort_compilation()) and is answered as a diagnostic. The output
+of the compiler steps is discarded, so it can't mix into the responses.
+
+Per path the server remembers the last compilation: an unchanged source is
+answered from the stored diagnostics, a changed source is compiled with the
+intern pool of the last compilation (the strings are interned already).
+
+An edit replaces "removed" characters at "offset" of the last source with
+the "text". The last compilation keeps its source, parsetree and statement
+boundaries, so only the edited main statements are lexed and checked again
+(see CheckEditAndUpdateParsetree()). The semantic analysis checks the whole
+tree again.
+*/
+
+struct ServerEntry {
+	char *path;
+	unsigned long long sourceHash;
+	size_t sourceLength;
+	struct CompilerContext *context;
+};
+
+struct ServerRequest {
+	char *id;
+	char *method;
+	char *path;
+	char *source;
+	char *text;
+	size_t offset;
+	size_t removed;
+	int isEdit;
+};
+
+struct Node *GenerateValidatedParsetree(struct CompilerContext *context);
+
+char *SV_read_line(FILE *input);
+int SV_parse_request(const char *line, struct ServerRequest *request);
+char *SV_get_json_value(const char *line, const char *key, int raw);
+char *SV_unescape_json_string(const char *start, const char **end);
+int SV_get_json_size(const char *line, const char *key, size_t *value);
+void SV_check_source(struct HashMap *entries, struct ServerRequest *request, FILE *responses);
+struct ServerEntry *SV_get_entry(struct HashMap *entries, const char *path);
+int SV_load_source(struct CompilerContext *context, struct ServerRequest *request, struct CompilerContext *previous);
+int SV_is_valid_edit(struct ServerRequest *request, struct CompilerContext *previous);
+void SV_adopt_intern_pool(struct CompilerContext *context, struct CompilerContext *previous);
+void SV_adopt_edit_base(struct CompilerContext *context, struct CompilerContext *previous);
+void SV_reset_front_end(struct CompilerContext *context);
+void SV_release_front_end(struct CompilerContext *context);
+void SV_write_response(FILE *responses, struct ServerRequest *request, struct CompilerContext *context, int cached, int incremental, double timeMs);
+void SV_write_json_string(FILE *responses, const char *string);
+void SV_free_request(struct ServerRequest *request);
+void SV_free_entries(struct HashMap *entries);
+
+/*
+Purpose: Answer compile requests from stdin until "shutdown" or the end of the input
+Return Type: int => 0 on a regular shutdown, otherwise -1
+Params: void
+*/
+int RunServer() {
+	//The responses keep the original stdout, the compiler output goes to the null device
+	(void)fflush(stdout);
+	int responseDescriptor = (int)SV_dup(1);
+	int nullDescriptor = (int)SV_open(SV_NULL_DEVICE, O_WRONLY);
+	FILE *responses = responseDescriptor != -1 ? SV_fdopen(responseDescriptor, "w") : NULL;
+
+	if (responses == NULL || nullDescriptor == -1) {
+		(void)printf("Could not open the server streams!\n");
+		return -1;
+	}
+
+	(void)SV_dup2(nullDescriptor, 1);
+	(void)SV_close(nullDescriptor);
+
+	struct HashMap *entries = CreateNewHashMap(16);
+	char *line = NULL;
+
+	while ((line = SV_read_line(stdin)) != NULL) {
+		struct ServerRequest request;
+
+		if ((int)SV_parse_request(line, &request) == false) {
+			(void)fprintf(responses, "{\"id\":null,\"status\":\"error\",\"message\":\"Invalid request.\"}\n");
+		} else if (request.method != NULL && (int)strcmp(request.method, "shutdown") == 0) {
+			(void)fprintf(responses, "{\"id\":%s,\"status\":\"ok\"}\n", request.id != NULL ? request.id : "null");
+			(void)SV_free_request(&request);
+			(void)free(line);
+			break;
+		} else if (request.method != NULL && request.path != NULL
+			&& ((int)strcmp(request.method, "check") == 0 || (int)strcmp(request.method, "compile") == 0
+			|| (int)strcmp(request.method, "edit") == 0)) {
+			(void)SV_check_source(entries, &request, responses);
+		} else {
+			(void)fprintf(responses, "{\"id\":%s,\"status\":\"error\",\"message\":\"Unknown method or missing path.\"}\n",
+				request.id != NULL ? request.id : "null");
+		}
+
+		(void)fflush(responses);
+		(void)SV_free_request(&request);
+		(void)free(line);
+	}
+
+	(void)fflush(responses);
+	(void)SV_free_entries(entries);
+	(void)fclose(responses);
+	return 0;
+}
+
+/*
+Purpose: Read one line of any length
+Return Type: char * => The allocated line without the '\n', NULL at the end of the input
+Params: FILE *input => Stream to read from
+*/
+char *SV_read_line(FILE *input) {
+	size_t capacity = SERVER_LINE_SIZE, length = 0;
+	char *line = (char*)malloc(capacity);
+
+	if (line == NULL) {
+		return NULL;
+	}
+
+	while (fgets(&line[length], (int)(capacity - length), input) != NULL) {
+		length += strlen(&line[length]);
+
+		if (length > 0 && line[length - 1] == '\n') {
+			line[--length] = '\0';
+			return line;
+		}
+
+		if (length + 1 == capacity) {
+			char *grownLine = (char*)realloc(line, capacity * 2);
+
+			if (grownLine == NULL) {
+				(void)free(line);
+				return NULL;
+			}
+
+			line = grownLine;
+			capacity *= 2;
+		}
+	}
+
+	if (length == 0) {
+		(void)free(line);
+		return NULL;
+	}
+
+	return line;
+}
+
+/*
+Purpose: Read the fields of a request line
+Return Type: int => true if the line is a JSON object, otherwise false
+Params: const char *line => Request line; struct ServerRequest *request => Receives the fields
+*/
+int SV_parse_request(const char *line, struct ServerRequest *request) {
+	(void)memset(request, 0, sizeof(struct ServerRequest));
+
+	while (*line == ' ' || *line == '\t' || *line == '\r') {
+		line++;
+	}
+
+	if (*line != '{') {
+		return false;
+	}
+
+	request->id = SV_get_json_value(line, "id", true);
+	request->method = SV_get_json_value(line, "method", false);
+	request->path = SV_get_json_value(line, "path", false);
+	request->source = SV_get_json_value(line, "source", false);
+	request->text = SV_get_json_value(line, "text", false);
+	request->isEdit = request->method != NULL && (int)strcmp(request->method, "edit") == 0;
+	request->isEdit = request->isEdit == true && request->text != NULL && (int)SV_get_json_size(line, "offset", &request->offset) == true;
+
+	//Without "removed" the text is inserted
+	if ((int)SV_get_json_size(line, "removed", &request->removed) == false) {
+		request->removed = 0;
+	}
+
+	return true;
+}
+
+/*
+Purpose: Find the value of a key in a flat JSON object
+Return Type: char * => The allocated value (unescaped string or the raw JSON text), NULL if missing
+Params: const char *line => JSON object; const char *key => Key to look for;
+		int raw => true returns the JSON text of the value (for the "id")
+*/
+char *SV_get_json_value(const char *line, const char *key, int raw) {
+	size_t keyLength = strlen(key);
+	const char *position = line;
+
+	while ((position = strchr(position, '"')) != NULL) {
+		const char *end = NULL;
+		char *name = SV_unescape_json_string(position, &end);
+
+		if (name == NULL) {
+			return NULL;
+		}
+
+		int matches = strlen(name) == keyLength && (int)strcmp(name, key) == 0;
+		(void)free(name);
+		position = end;
+
+		while (*position == ' ' || *position == '\t') {
+			position++;
+		}
+
+		//A string, that is not followed by ':' is a value
+		if (*position != ':') {
+			continue;
+		}
+
+		position++;
+
+		while (*position == ' ' || *position == '\t') {
+			position++;
+		}
+
+		if (matches == false) {
+			continue;
+		}
+
+		if (raw == false) {
+			return *position == '"' ? SV_unescape_json_string(position, &end) : NULL;
+		}
+
+		const char *valueEnd = position;
+
+		if (*valueEnd == '"') {
+			(void)free(SV_unescape_json_string(position, &valueEnd));
+		} else {
+			while (*valueEnd != '\0' && *valueEnd != ',' && *valueEnd != '}' && *valueEnd != ' ') {
+				valueEnd++;
+			}
+		}
+
+		size_t length = (size_t)(valueEnd - position);
+		char *value = (char*)malloc(length + 1);
+
+		if (value != NULL && length > 0) {
+			(void)memcpy(value, position, length);
+			value[length] = '\0';
+			return value;
+		}
+
+		(void)free(value);
+		return NULL;
+	}
+
+	return NULL;
+}
+
+/*
+Purpose: Read a number value of a flat JSON object
+Return Type: int => true if the key has a number value, otherwise false
+Params: const char *line => JSON object; const char *key => Key to look for; size_t *value => Receives the number
+*/
+int SV_get_json_size(const char *line, const char *key, size_t *value) {
+	char *text = SV_get_json_value(line, key, true);
+	char *end = NULL;
+
+	if (text == NULL || text[0] < '0' || text[0] > '9') {
+		(void)free(text);
+		return false;
+	}
+
+	unsigned long long number = strtoull(text, &end, 10);
+	int valid = end != NULL && *end == '\0';
+	(void)free(text);
+	(*value) = (size_t)number;
+	return valid;
+}
+
+/*
+Purpose: Unescape a JSON string
+Return Type: char * => The allocated string, NULL if the string is not terminated
+Params: const char *start => Opening '"'; const char **end => Receives the position behind the closing '"'
+*/
+char *SV_unescape_json_string(const char *start, const char **end) {
+	const char *position = start + 1;
+	size_t length = 0;
+
+	while (*position != '\0' && *position != '"') {
+		position += *position == '\\' && position[1] != '\0' ? 2 : 1;
+		length++;
+	}
+
+	if (*position != '"') {
+		(*end) = position;
+		return NULL;
+	}
+
+	(*end) = position + 1;
+	char *string = (char*)malloc(length + 1);
+
+	if (string == NULL) {
+		return NULL;
+	}
+
+	size_t index = 0;
+
+	for (position = start + 1; *position != '"'; position++) {
+		if (*position != '\\') {
+			string[index++] = *position;
+			continue;
+		}
+
+		position++;
+
+		switch (*position) {
+		case 'n':
+			string[index++] = '\n';
+			break;
+		case 't':
+			string[index++] = '\t';
+			break;
+		case 'r':
+			string[index++] = '\r';
+			break;
+		case 'b':
+			string[index++] = '\b';
+			break;
+		case 'f':
+			string[index++] = '\f';
+			break;
+		case 'u': {
+			//Only ASCII is decoded, everything else is replaced by '?'
+			unsigned int code = 0;
+			int digits = 0;
+
+			for (; digits < 4 && position[digits + 1] != '\0' && position[digits + 1] != '"'; digits++) {
+				char hex = position[digits + 1];
+				code = code * 16 + (unsigned int)(hex >= 'a' ? hex - 'a' + 10 : hex >= 'A' ? hex - 'A' + 10 : hex - '0');
+			}
+
+			string[index++] = code < 128 ? (char)code : '?';
+			position += digits;
+			break;
+		}
+		default:
+			string[index++] = *position;
+			break;
+		}
+	}
+
+	string[index] = '\0';
+	return string;
+}
+
+/*
+Purpose: Check one source (or an edit of the last one) and write the response
+Return Type: void
+Params: struct HashMap *entries => Last compilation per path; struct ServerRequest *request => The request;
+		FILE *responses => Stream for the response
+*/
+void SV_check_source(struct HashMap *entries, struct ServerRequest *request, FILE *responses) {
+	double start = (double)PF_get_wall_time_us();
+	struct ServerEntry *entry = SV_get_entry(entries, request->path);
+
+	if (entry == NULL) {
+		(void)fprintf(responses, "{\"id\":%s,\"status\":\"error\",\"message\":\"Out of memory.\"}\n",
+			request->id != NULL ? request->id : "null");
+		return;
+	}
+
+	if (request->isEdit == false && (int)strcmp(request->method, "edit") == 0) {
+		(void)fprintf(responses, "{\"id\":%s,\"status\":\"error\",\"message\":\"An edit needs an offset and a text.\"}\n",
+			request->id != NULL ? request->id : "null");
+		return;
+	} else if (request->isEdit == true && (int)SV_is_valid_edit(request, entry->context) == false) {
+		(void)fprintf(responses, "{\"id\":%s,\"status\":\"error\",\"message\":\"The edit is not in the last source of the path.\"}\n",
+			request->id != NULL ? request->id : "null");
+		return;
+	}
+
+	struct CompilerContext *context = CC_create_context(entry->path);
+
+	if (context == NULL) {
+		(void)fprintf(responses, "{\"id\":%s,\"status\":\"error\",\"message\":\"Out of memory.\"}\n",
+			request->id != NULL ? request->id : "null");
+		return;
+	}
+
+	//The responses carry the diagnostics, the console text would go to the null device
+	context->renderDiagnostics = false;
+	context->keepEditBase = INCREMENTAL_EDITS == 1;
+
+	//Changed by the code between setjmp() and a longjmp(), so they have to be volatile
+	volatile int cached = false;
+	volatile int incremental = false;
+	jmp_buf recoveryPoint;
+	context->recoveryPoint = &recoveryPoint;
+
+	if (setjmp(recoveryPoint) == 0) {
+		if ((int)SV_load_source(context, request, entry->context) == true) {
+			unsigned long long sourceHash = TC_hash_source(context->buffer, context->bufferLength);
+			cached = entry->context != NULL && entry->sourceHash == sourceHash && entry->sourceLength == context->bufferLength;
+			entry->sourceHash = sourceHash;
+			entry->sourceLength = context->bufferLength;
+
+			if (cached == false) {
+				(void)SV_adopt_intern_pool(context, entry->context);
+
+				//An edit with syntax errors is compiled as a whole, so the errors are the same as without the edit base
+				if (INCREMENTAL_EDITS == 1 && request->isEdit == true) {
+					(void)SV_adopt_edit_base(context, entry->context);
+					incremental = (int)CheckEditAndUpdateParsetree(context, request->offset, request->removed, strlen(request->text)) == 0;
+
+					if (incremental == false) {
+						(void)SV_reset_front_end(context);
+					}
+				}
+
+				struct Node *root = incremental == true ? context->root : GenerateValidatedParsetree(context);
+
+				if (root != NULL) {
+					(void)CheckSemantic(context, root);
+				}
+			}
+		}
+	}
+
+	(void)CC_use_context(context);
+	context->recoveryPoint = NULL;
+	(void)FREE_SEMANTIC_SCHEDULE(context);
+	(void)SV_release_front_end(context);
+	double timeMs = ((double)PF_get_wall_time_us() - start) / 1000.0;
+
+	if (cached == true) {
+		(void)SV_write_response(responses, request, entry->context, true, false, timeMs);
+		(void)FREE_COMPILER_CONTEXT(context);
+		return;
+	}
+
+	//A failed compilation has no hash, the next request compiles again
+	if (context->diagnosticCount > 0 && context->diagnostics[context->diagnosticCount - 1].fatal == true) {
+		entry->sourceHash = 0;
+		entry->sourceLength = 0;
+	}
+
+	(void)SV_write_response(responses, request, context, false, incremental, timeMs);
+	(void)FREE_COMPILER_CONTEXT(entry->context);
+	entry->context = context;
+}
+
+/*
+Purpose: Find or create the entry of a path
+Return Type: struct ServerEntry * => The entry, NULL if no memory could be reserved
+Params: struct HashMap *entries => Entries by path; const char *path => Path of the source
+*/
+struct ServerEntry *SV_get_entry(struct HashMap *entries, const char *path) {
+	struct HashMapEntry *mapEntry = HM_get_entry((char*)path, entries);
+
+	if (mapEntry != NULL) {
+		return (struct ServerEntry*)mapEntry->value;
+	}
+
+	struct ServerEntry *entry = (struct ServerEntry*)calloc(1, sizeof(struct ServerEntry));
+
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	entry->path = (char*)malloc(strlen(path) + 1);
+
+	if (entry->path == NULL) {
+		(void)free(entry);
+		return NULL;
+	}
+
+	(void)strcpy(entry->path, path);
+	(void)HM_add_entry(entry->path, entry, entries);
+	return entry;
+}
+
+/*
+Purpose: Read the source of a request into the context
+Return Type: int => true if the source could be read, otherwise false
+Params: struct CompilerContext *context => Compilation; struct ServerRequest *request => Request with
+		the path and the optional inline source or the edit; struct CompilerContext *previous => Last
+		compilation of the same path, that is edited (can be NULL)
+*/
+int SV_load_source(struct CompilerContext *context, struct ServerRequest *request, struct CompilerContext *previous) {
+	if (request->isEdit == true) {
+		size_t textLength = strlen(request->text);
+		size_t length = previous->bufferLength - request->removed + textLength;
+		context->buffer = (char*)malloc(length + 1);
+
+		if (context->buffer == NULL) {
+			(void)CC_add_diagnostic(0, 0, true, "Could not reserve the source buffer.");
+			return false;
+		}
+
+		size_t rest = request->offset + request->removed;
+		(void)memcpy(context->buffer, previous->buffer, request->offset);
+		(void)memcpy(&context->buffer[request->offset], request->text, textLength);
+		(void)memcpy(&context->buffer[request->offset + textLength], &previous->buffer[rest], previous->bufferLength - rest);
+		context->buffer[length] = '\0';
+		context->bufferLength = length;
+		context->bufferIsMapped = false;
+		return true;
+	} else if (request->source == NULL) {
+		(void)ProcessInput(context, request->path);
+		return context->buffer != NULL;
+	}
+
+	//The request owns the inline source, the context gets a copy that the lexer can read until the end
+	size_t length = strlen(request->source);
+	context->buffer = (char*)malloc(length + 1);
+
+	if (context->buffer == NULL) {
+		(void)CC_add_diagnostic(0, 0, true, "Could not reserve the source buffer.");
+		return false;
+	}
+
+	(void)memcpy(context->buffer, request->source, length + 1);
+	context->bufferLength = length;
+	context->bufferIsMapped = false;
+	return true;
+}
+
+/*
+Purpose: Check, that the replaced characters of an edit are in the last source of the path
+Return Type: int => true if the edit can be applied, otherwise false
+Params: struct ServerRequest *request => The edit; struct CompilerContext *previous => Last compilation
+		of the same path (can be NULL)
+*/
+int SV_is_valid_edit(struct ServerRequest *request, struct CompilerContext *previous) {
+	if (previous == NULL || previous->buffer == NULL) {
+		return false;
+	}
+
+	return request->offset <= previous->bufferLength && request->removed <= previous->bufferLength - request->offset;
+}
+
+/*
+Purpose: Move the intern pool of the last compilation into the new context
+Return Type: void
+Params: struct CompilerContext *context => New compilation; struct CompilerContext *previous => Last
+		compilation of the same path (can be NULL)
+*/
+void SV_adopt_intern_pool(struct CompilerContext *context, struct CompilerContext *previous) {
+	if (previous == NULL || context->internSlots != NULL) {
+		return;
+	}
+
+	context->internSlots = previous->internSlots;
+	context->internCapacity = previous->internCapacity;
+	context->internLoad = previous->internLoad;
+	context->currentInternBlock = previous->currentInternBlock;
+
+	previous->internSlots = NULL;
+	previous->internCapacity = 0;
+	previous->internLoad = 0;
+	previous->currentInternBlock = NULL;
+}
+
+/*
+Purpose: Move the parsetree and the statement boundaries of the last compilation into the new context
+Return Type: void
+Params: struct CompilerContext *context => New compilation of the edit; struct CompilerContext *previous =>
+		Last compilation of the same path
+*/
+void SV_adopt_edit_base(struct CompilerContext *context, struct CompilerContext *previous) {
+	if (previous->root == NULL || context->root != NULL) {
+		return;
+	}
+
+	//The nodes are in the arena of the last compilation, so the arena is moved with the tree
+	context->root = previous->root;
+	context->currentArenaBlock = previous->currentArenaBlock;
+	context->nodeCount = previous->nodeCount;
+	context->replacedNodes = previous->replacedNodes;
+	context->statementBoundaries = previous->statementBoundaries;
+	context->statementBoundaryCount = previous->statementBoundaryCount;
+
+	previous->root = NULL;
+	previous->currentArenaBlock = NULL;
+	previous->nodeCount = 0;
+	previous->replacedNodes = 0;
+	previous->statementBoundaries = NULL;
+	previous->statementBoundaryCount = 0;
+}
+
+/*
+Purpose: Drop the edit base and the state of a failed incremental check, so the source can be compiled as a whole
+Return Type: void
+Params: struct CompilerContext *context => Compilation of the edit
+*/
+void SV_reset_front_end(struct CompilerContext *context) {
+	(void)FREE_TOKENS(context->tokens);
+	(void)FREE_NODE(context->root);
+	(void)CC_free_edit_base(context);
+	(void)FREE_TOKEN_INDEX();
+	(void)CC_clear_diagnostics(context);
+	context->root = NULL;
+	context->nodeCount = 0;
+	context->tokenLength = 0;
+	context->fileContainsErrors = false;
+	context->maxTokenLength = 0;
+	context->panicModeOpenBraces = 0;
+	context->panicModeLastStartPos = 0;
+	context->buildPosition = 0;
+}
+
+/*
+Purpose: Free the tokens, the diagnostics and the intern pool stay. The source and the parsetree
+		with its statement boundaries stay for the next edit.
+Return Type: void
+Params: struct CompilerContext *context => Finished compilation
+*/
+void SV_release_front_end(struct CompilerContext *context) {
+	int fatal = context->diagnosticCount > 0 && context->diagnostics[context->diagnosticCount - 1].fatal == true;
+
+	//Tables of an aborted check, their names point into the source and the tokens
+	(void)FREE_SEMANTIC_TABLES(context);
+
+	//A mapped file can change on the disk, the edit gets a copy of the compiled source
+	if (context->buffer != NULL && context->bufferIsMapped == true) {
+		char *buffer = (char*)malloc(context->bufferLength + 1);
+
+		if (buffer != NULL) {
+			(void)memcpy(buffer, context->buffer, context->bufferLength);
+			buffer[context->bufferLength] = '\0';
+		}
+
+		(void)FREE_BUFFER(context->buffer);
+		context->buffer = buffer;
+	}
+
+	(void)FREE_TOKENS(context->tokens);
+
+	//Without boundaries (e.g. syntax errors or the streaming front end) the next edit is compiled as a whole
+	if (context->root == NULL || context->statementBoundaryCount == 0 || fatal == true) {
+		(void)FREE_NODE(context->root);
+		(void)CC_free_edit_base(context);
+		context->root = NULL;
+		context->nodeCount = 0;
+	}
+
+	(void)FREE_TOKEN_INDEX();
+	(void)FREE_LINE_INDEX();
+
+	if (context->externalAccesses != NULL) {
+		(void)FREE_LIST(context->externalAccesses);
+		context->externalAccesses = NULL;
+	}
+}
+
+/*
+Purpose: Write the response of a check request
+Return Type: void
+Params: FILE *responses => Response stream; struct ServerRequest *request => The request;
+		struct CompilerContext *context => Compilation with the diagnostics; int cached => true if the
+		source was unchanged; int incremental => true if only the edited statements were checked again;
+		double timeMs => Time of the request
+*/
+void SV_write_response(FILE *responses, struct ServerRequest *request, struct CompilerContext *context, int cached, int incremental, double timeMs) {
+	(void)fprintf(responses, "{\"id\":%s,\"file\":", request->id != NULL ? request->id : "null");
+	(void)SV_write_json_string(responses, request->path);
+	(void)fprintf(responses, ",\"status\":\"%s\",\"cached\":%s,\"incremental\":%s,\"timeMs\":%.3f,\"diagnostics\":[",
+		context->diagnosticCount == 0 ? "ok" : "error", cached == true ? "true" : "false", incremental == true ? "true" : "false", timeMs);
+
+	for (size_t i = 0; i < context->diagnosticCount; i++) {
+		struct Diagnostic *diagnostic = &context->diagnostics[i];
+		(void)fprintf(responses, "%s{\"line\":%zu,\"column\":%zu,\"severity\":\"%s\",\"message\":",
+			i == 0 ? "" : ",", diagnostic->line, diagnostic->column, diagnostic->fatal == true ? "fatal" : "error");
+		(void)SV_write_json_string(responses, diagnostic->message);
+		(void)fputc('}', responses);
+	}
+
+	(void)fprintf(responses, "]}\n");
+}
+
+/*
+Purpose: Write a string as escaped JSON string
+Return Type: void
+Params: FILE *responses => Response stream; const char *string => String to write
+*/
+void SV_write_json_string(FILE *responses, const char *string) {
+	(void)fputc('"', responses);
+
+	for (; *string != '\0'; string++) {
+		unsigned char character = (unsigned char)*string;
+
+		if (character == '"' || character == '\\') {
+			(void)fputc('\\', responses);
+			(void)fputc(character, responses);
+		} else if (character == '\n') {
+			(void)fputs("\\n", responses);
+		} else if (character == '\t') {
+			(void)fputs("\\t", responses);
+		} else if (character < 0x20) {
+			(void)fprintf(responses, "\\u%04x", character);
+		} else {
+			(void)fputc(character, responses);
+		}
+	}
+
+	(void)fputc('"', responses);
+}
+
+/*
+Purpose: Free the fields of a request
+Return Type: void
+Params: struct ServerRequest *request => Request to free
+*/
+void SV_free_request(struct ServerRequest *request) {
+	(void)free(request->id);
+	(void)free(request->method);
+	(void)free(request->path);
+	(void)free(request->source);
+	(void)free(request->text);
+}
+
+/*
+Purpose: Free all entries with their last compilation
+Return Type: void
+Params: struct HashMap *entries => Entries by path
+*/
+void SV_free_entries(struct HashMap *entries) {
+	struct HashMapIterator iterator = HM_create_iterator(entries);
+	struct HashMapEntry *mapEntry = NULL;
+
+	while ((mapEntry = HM_next_entry(&iterator)) != NULL) {
+		struct ServerEntry *entry = (struct ServerEntry*)mapEntry->value;
+		(void)FREE_COMPILER_CONTEXT(entry->context);
+		(void)free(entry->path);
+		entry->path = NULL;
+	}
+
+	//The map frees the entries (the values) itself
+	(void)HM_free(entries);
+}
@@ -0,0 +1,710 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "../headers/compilerContext.h"
+#include "../headers/modules.h"
+#include "../headers/errors.h"
+#include "../headers/list.h"
+#include "../headers/internPool.h"
+#include "../headers/tokenIndex.h"
+#include "../headers/lineIndex.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/** 
+ * The subprogram {@code SPACE/src/compilerContext.c} was created
+ * to hold the state of a compilation in one place.
+ * 
+ * Before, the buffer, the tokens, the intern pool, the node arena and
+ * the analyzer flags were globals, so only one file could be compiled
+ * per process. Now every compilation has its own CompilerContext, the
+ * steps of the compiler work on the CURRENT_CONTEXT of their thread.
+ * 
+ * Only the keyword hash table of the lexer is shared, it is built
+ * once before the first context is used.
+ * 
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define DIAGNOSTIC_MESSAGE_SIZE 512
+#define DIAGNOSTIC_TEXT_SIZE 512
+#define MAX_THREADS 64
+
+/**
+ * <p>
+ * A lock with a condition, the threads of CC_run_parallel() use it
+ * to wait for each other.
+ * </p>
+ */
+struct CC_Monitor {
+	#ifdef _WIN32
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE condition;
+	#else
+	pthread_mutex_t lock;
+	pthread_cond_t condition;
+	#endif
+};
+
+struct CC_ParallelWorker {
+	void (*worker)(void *argument);
+	void *argument;
+};
+
+CC_THREAD_LOCAL struct CompilerContext *CURRENT_CONTEXT = NULL;
+
+size_t CC_DIAGNOSTIC_LIMIT = DIAGNOSTIC_LIMIT;
+
+int CC_compare_diagnostics(const void *first, const void *second);
+
+/**
+ * <p>
+ * Takes "--max-errors=<n>" out of the arguments and sets the limit of
+ * the rendered diagnostics, 0 renders all.
+ * </p>
+ * 
+ * @returns true, if the arguments are valid
+ * 
+ * @param *argc     Argument count, reduced by the taken arguments
+ * @param *argv[]   Arguments, the taken arguments are removed
+ */
+int CC_parse_arguments(int *argc, char *argv[]) {
+	int count = 0;
+
+	for (int i = 0; i < (*argc); i++) {
+		if (i > 0 && strncmp(argv[i], "--max-errors=", 13) == 0) {
+			char *end = NULL;
+			long limit = strtol(&argv[i][13], &end, 10);
+
+			if (end == &argv[i][13] || *end != '\0' || limit < 0) {
+				(void)printf("Invalid error limit \"%s\", use --max-errors=<n> (0 = no limit)\n", &argv[i][13]);
+				return false;
+			}
+
+			CC_DIAGNOSTIC_LIMIT = (size_t)limit;
+		} else {
+			argv[count++] = argv[i];
+		}
+	}
+
+	(*argc) = count;
+	argv[count] = NULL;
+	return true;
+}
+
+/**
+ * <p>
+ * Creates a new, empty context for the compilation of one source file
+ * and makes it the CURRENT_CONTEXT of the calling thread.
+ * </p>
+ * 
+ * @returns The new context
+ * 
+ * @param *fileName     Name of the source file, used in the error messages
+ */
+struct CompilerContext *CC_create_context(char *fileName) {
+	struct CompilerContext *context = (struct CompilerContext*)calloc(1, sizeof(struct CompilerContext));
+
+	if (context == NULL) {
+		(void)printf("An error occured while trying to allocate memory.\n");
+		return NULL;
+	}
+
+	context->fileName = fileName;
+	context->renderDiagnostics = true;
+	(void)CC_use_context(context);
+	return context;
+}
+
+/**
+ * <p>
+ * Makes the context the CURRENT_CONTEXT of the calling thread, every
+ * following step of the compiler works on it.
+ * </p>
+ * 
+ * @param *context  Context to work on
+ */
+void CC_use_context(struct CompilerContext *context) {
+	CURRENT_CONTEXT = context;
+}
+
+/**
+ * <p>
+ * Records an error of the CURRENT_CONTEXT, the message is formatted
+ * like printf().
+ * </p>
+ * 
+ * <p>
+ * The analyzers attach the rendered console text afterwards (see
+ * CC_attach_diagnostic_text()). Over the limit a non-fatal error is only
+ * counted.
+ * </p>
+ * 
+ * @returns The recorded diagnostic till the next diagnostic is added, NULL if it was not recorded
+ * 
+ * @param line      Line of the error (starting at 1, 0 = unknown)
+ * @param column    Column of the error (starting at 1, 0 = unknown)
+ * @param fatal     true, if the compilation could not continue
+ * @param *format   Format of the message
+ */
+struct Diagnostic *CC_add_diagnostic(size_t line, size_t column, int fatal, const char *format, ...) {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+
+	if (context == NULL) {
+		return NULL;
+	}
+
+	if (fatal == false && CC_DIAGNOSTIC_LIMIT > 0 && context->precedingDiagnostics + context->diagnosticCount >= CC_DIAGNOSTIC_LIMIT) {
+		context->suppressedDiagnostics++;
+		return NULL;
+	}
+
+	if (context->diagnosticCount == context->diagnosticCapacity) {
+		size_t capacity = context->diagnosticCapacity == 0 ? 8 : context->diagnosticCapacity * 2;
+		struct Diagnostic *diagnostics = (struct Diagnostic*)realloc(context->diagnostics, sizeof(struct Diagnostic) * capacity);
+
+		if (diagnostics == NULL) {
+			return NULL;
+		}
+
+		context->diagnostics = diagnostics;
+		context->diagnosticCapacity = capacity;
+	}
+
+	char message[DIAGNOSTIC_MESSAGE_SIZE];
+	va_list arguments;
+	va_start(arguments, format);
+	(void)vsnprintf(message, sizeof(message), format, arguments);
+	va_end(arguments);
+
+	struct Diagnostic *diagnostic = &context->diagnostics[context->diagnosticCount];
+	diagnostic->message = (char*)malloc(strlen(message) + 1);
+
+	if (diagnostic->message == NULL) {
+		return NULL;
+	}
+
+	(void)strcpy(diagnostic->message, message);
+	diagnostic->line = line;
+	diagnostic->column = column;
+	diagnostic->fatal = fatal;
+	diagnostic->position = 0;
+	diagnostic->rendered = NULL;
+	context->diagnosticCount++;
+	return diagnostic;
+}
+
+/**
+ * <p>
+ * Checks, if the next error of the CURRENT_CONTEXT is rendered, so the
+ * analyzers skip the formatting of errors, that are not written.
+ * </p>
+ * 
+ * @returns true, if the context renders its diagnostics and the limit is not reached
+ */
+int CC_is_rendering_diagnostics() {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+	return context != NULL && context->renderDiagnostics == true
+		&& (CC_DIAGNOSTIC_LIMIT == 0 || context->precedingDiagnostics + context->diagnosticCount < CC_DIAGNOSTIC_LIMIT);
+}
+
+/**
+ * <p>
+ * Appends formatted text like printf() to the console text of a
+ * diagnostic.
+ * </p>
+ * 
+ * @param *text     Text to append to
+ * @param *format   Format of the text
+ */
+void CC_append_diagnostic_text(struct DiagnosticText *text, const char *format, ...) {
+	va_list arguments;
+	va_start(arguments, format);
+	int length = (int)vsnprintf(NULL, 0, format, arguments);
+	va_end(arguments);
+
+	if (length < 0) {
+		return;
+	}
+
+	if (text->length + (size_t)length + 1 > text->capacity) {
+		size_t capacity = text->capacity == 0 ? DIAGNOSTIC_TEXT_SIZE : text->capacity;
+
+		while (capacity < text->length + (size_t)length + 1) {
+			capacity *= 2;
+		}
+
+		char *grownText = (char*)realloc(text->text, capacity);
+
+		if (grownText == NULL) {
+			return;
+		}
+
+		text->text = grownText;
+		text->capacity = capacity;
+	}
+
+	va_start(arguments, format);
+	(void)vsnprintf(text->text + text->length, (size_t)length + 1, format, arguments);
+	va_end(arguments);
+	text->length += (size_t)length;
+}
+
+/**
+ * <p>
+ * Gives the console text to the diagnostic, it is written by
+ * CC_flush_diagnostics(). If the diagnostic was not recorded, the text
+ * is freed.
+ * </p>
+ * 
+ * @param *diagnostic   Diagnostic of CC_add_diagnostic(), can be NULL
+ * @param position      Position of the error in the buffer, orders the output
+ * @param *text         Rendered text, it is empty afterwards
+ */
+void CC_attach_diagnostic_text(struct Diagnostic *diagnostic, size_t position, struct DiagnosticText *text) {
+	if (diagnostic != NULL) {
+		diagnostic->position = position;
+		diagnostic->rendered = text->text;
+	} else {
+		(void)free(text->text);
+	}
+
+	text->text = NULL;
+	text->length = 0;
+	text->capacity = 0;
+}
+
+/**
+ * <p>
+ * Writes the rendered diagnostics of the context ordered by their
+ * position with one write, followed by the number of errors over the
+ * limit. The structured diagnostics stay in the context.
+ * </p>
+ * 
+ * @param *context  Context with the diagnostics
+ */
+void CC_flush_diagnostics(struct CompilerContext *context) {
+	(void)CC_write_diagnostics(context, stdout);
+}
+
+/**
+ * <p>
+ * Writes the rendered diagnostics like CC_flush_diagnostics() into a
+ * stream, e.g. the log of a unit of the driver.
+ * </p>
+ * 
+ * @param *context  Context with the diagnostics
+ * @param *stream   Stream to write to
+ */
+void CC_write_diagnostics(struct CompilerContext *context, FILE *stream) {
+	if (context == NULL || context->renderDiagnostics == false) {
+		return;
+	}
+
+	size_t renderedCount = 0;
+	size_t length = 0;
+
+	for (size_t i = 0; i < context->diagnosticCount; i++) {
+		if (context->diagnostics[i].rendered != NULL) {
+			length += strlen(context->diagnostics[i].rendered);
+			renderedCount++;
+		}
+	}
+
+	struct Diagnostic **ordered = renderedCount > 0 ? (struct Diagnostic**)malloc(sizeof(struct Diagnostic*) * renderedCount) : NULL;
+	char *output = renderedCount > 0 ? (char*)malloc(length + 1) : NULL;
+
+	if (renderedCount > 0 && (ordered == NULL || output == NULL)) {
+		(void)free(ordered);
+		(void)free(output);
+		return;
+	}
+
+	for (size_t i = 0, n = 0; i < context->diagnosticCount; i++) {
+		if (context->diagnostics[i].rendered != NULL) {
+			ordered[n++] = &context->diagnostics[i];
+		}
+	}
+
+	//Equal positions keep the order, in which they were reported
+	if (renderedCount > 0) {
+		(void)qsort(ordered, renderedCount, sizeof(struct Diagnostic*), CC_compare_diagnostics);
+	}
+
+	length = 0;
+
+	//The parallel bodies do not see the errors of the other bodies, so the limit is applied here again
+	size_t shownCount = CC_DIAGNOSTIC_LIMIT > 0 && renderedCount > CC_DIAGNOSTIC_LIMIT ? CC_DIAGNOSTIC_LIMIT : renderedCount;
+	context->suppressedDiagnostics += renderedCount - shownCount;
+
+	for (size_t i = 0; i < renderedCount; i++) {
+		if (i < shownCount) {
+			size_t textLength = strlen(ordered[i]->rendered);
+			(void)memcpy(output + length, ordered[i]->rendered, textLength);
+			length += textLength;
+		}
+
+		(void)free(ordered[i]->rendered);
+		ordered[i]->rendered = NULL;
+	}
+
+	if (length > 0) {
+		(void)fwrite(output, 1, length, stream);
+	}
+
+	if (context->suppressedDiagnostics > 0) {
+		(void)fprintf(stream, "%zu more errors were not shown (--max-errors=%zu).\n", context->suppressedDiagnostics, CC_DIAGNOSTIC_LIMIT);
+		context->suppressedDiagnostics = 0;
+	}
+
+	(void)free(ordered);
+	(void)free(output);
+}
+
+/**
+ * <p>
+ * Orders the diagnostics by their position, then by their address in
+ * the array (the order of the reports).
+ * </p>
+ */
+int CC_compare_diagnostics(const void *first, const void *second) {
+	const struct Diagnostic *firstDiagnostic = *(const struct Diagnostic *const *)first;
+	const struct Diagnostic *secondDiagnostic = *(const struct Diagnostic *const *)second;
+
+	if (firstDiagnostic->position != secondDiagnostic->position) {
+		return firstDiagnostic->position < secondDiagnostic->position ? -1 : 1;
+	}
+
+	return firstDiagnostic < secondDiagnostic ? -1 : firstDiagnostic > secondDiagnostic ? 1 : 0;
+}
+
+/**
+ * <p>
+ * Stops the compilation of the CURRENT_CONTEXT after a fatal error.
+ * </p>
+ * 
+ * <p>
+ * If the context has a recoveryPoint, the error is recorded as a
+ * fatal diagnostic and the function jumps back to the recovery point,
+ * the caller frees the context then. Without a recovery point the
+ * diagnostics so far are written and the function returns, the caller
+ * terminates the process as before.
+ * </p>
+ * 
+ * @param *message  Description of the error
+ * @param line      Line of the error (starting at 1, 0 = unknown)
+ * @param column    Column of the error (starting at 1, 0 = unknown)
+ */
+void CC_abort_compilation(const char *message, size_t line, size_t column) {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+
+	if (context == NULL) {
+		return;
+	}
+
+	//The caller exits, the errors till now are written before
+	if (context->recoveryPoint == NULL) {
+		(void)CC_flush_diagnostics(context);
+		return;
+	}
+
+	(void)CC_add_diagnostic(line, column, true, "%s", message);
+	(void)longjmp(*context->recoveryPoint, 1);
+}
+
+/**
+ * <p>
+ * Drops the recorded diagnostics of the context, e.g. the syntax errors of
+ * the streaming front end before an unfinished string (see LX_lex_window()).
+ * </p>
+ * 
+ * @param *context  Context, whose diagnostics are dropped
+ */
+void CC_clear_diagnostics(struct CompilerContext *context) {
+	for (size_t i = 0; i < context->diagnosticCount; i++) {
+		(void)free(context->diagnostics[i].message);
+		(void)free(context->diagnostics[i].rendered);
+	}
+
+	context->diagnosticCount = 0;
+	context->suppressedDiagnostics = 0;
+}
+
+/**
+ * <p>
+ * Frees the edit base of the context (see CheckEditAndUpdateParsetree()),
+ * the parsetree stays.
+ * </p>
+ * 
+ * @param *context  Context, whose edit base is freed
+ */
+void CC_free_edit_base(struct CompilerContext *context) {
+	(void)free(context->statementBoundaries);
+	(void)free(context->mainStatementStarts);
+	context->statementBoundaries = NULL;
+	context->statementBoundaryCount = 0;
+	context->mainStatementStarts = NULL;
+	context->mainStatementCount = 0;
+	context->mainStatementCapacity = 0;
+	context->replacedNodes = 0;
+}
+
+/**
+ * <p>
+ * Frees everything, that was reserved in the context (buffer, tokens,
+ * parsetree, edit base, intern pool, token index, the external accesses
+ * and the diagnostics) and the context itself.
+ * </p>
+ * 
+ * @returns true, if the context was freed
+ * 
+ * @param *context  Context to free
+ */
+int FREE_COMPILER_CONTEXT(struct CompilerContext *context) {
+	if (context == NULL) {
+		return false;
+	}
+
+	struct CompilerContext *previousContext = CURRENT_CONTEXT;
+	(void)CC_use_context(context);
+	(void)FREE_SEMANTIC_SCHEDULE(context);
+	(void)FREE_SEMANTIC_TABLES(context);
+	(void)FREE_BUFFER(context->buffer);
+	(void)FREE_TOKENS(context->tokens);
+	(void)FREE_NODE(context->root);
+	(void)CC_free_edit_base(context);
+	(void)FREE_INTERN_POOL();
+	(void)FREE_TOKEN_INDEX();
+	(void)FREE_LINE_INDEX();
+
+	if (context->externalAccesses != NULL) {
+		(void)FREE_LIST(context->externalAccesses);
+	}
+
+	(void)CC_clear_diagnostics(context);
+	(void)free(context->diagnostics);
+
+	(void)free(context);
+	(void)CC_use_context(previousContext == context ? NULL : previousContext);
+	return true;
+}
+
+/**
+ * <p>
+ * Returns the number of online processors.
+ * </p>
+ * 
+ * @returns The number of processors (at least 1, at most 64)
+ */
+int CC_get_processor_count() {
+	#ifdef _WIN32
+	SYSTEM_INFO info;
+	(void)GetSystemInfo(&info);
+	int count = (int)info.dwNumberOfProcessors;
+	#else
+	int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	#endif
+
+	return count < 1 ? 1 : count > MAX_THREADS ? MAX_THREADS : count;
+}
+
+#ifdef _WIN32
+DWORD WINAPI CC_start_worker(LPVOID parameter) {
+	struct CC_ParallelWorker *worker = (struct CC_ParallelWorker*)parameter;
+	(void)worker->worker(worker->argument);
+	return 0;
+}
+#else
+void *CC_start_worker(void *parameter) {
+	struct CC_ParallelWorker *worker = (struct CC_ParallelWorker*)parameter;
+	(void)worker->worker(worker->argument);
+	return NULL;
+}
+#endif
+
+/**
+ * <p>
+ * Runs the worker on the calling thread and on threadCount - 1 new
+ * threads, the function returns after all workers returned.
+ * </p>
+ * 
+ * <p>
+ * The new threads start without a CURRENT_CONTEXT. If a thread can't be
+ * started, the other workers do its work.
+ * </p>
+ * 
+ * @param threadCount   Number of threads (including the calling thread)
+ * @param *worker       Function to run on every thread
+ * @param *argument     Argument, that is passed to every worker
+ */
+void CC_run_parallel(int threadCount, void (*worker)(void *argument), void *argument) {
+	struct CC_ParallelWorker parallelWorker = {worker, argument};
+	int started = 0;
+	threadCount = threadCount > MAX_THREADS ? MAX_THREADS : threadCount;
+
+	#ifdef _WIN32
+	HANDLE threads[MAX_THREADS];
+
+	for (int i = 1; i < threadCount; i++) {
+		threads[started] = CreateThread(NULL, 0, CC_start_worker, &parallelWorker, 0, NULL);
+		started += threads[started] != NULL ? 1 : 0;
+	}
+	#else
+	pthread_t threads[MAX_THREADS];
+
+	for (int i = 1; i < threadCount; i++) {
+		started += (int)pthread_create(&threads[started], NULL, CC_start_worker, &parallelWorker) == 0 ? 1 : 0;
+	}
+	#endif
+
+	(void)worker(argument);
+
+	for (int i = 0; i < started; i++) {
+		#ifdef _WIN32
+		(void)WaitForSingleObject(threads[i], INFINITE);
+		(void)CloseHandle(threads[i]);
+		#else
+		(void)pthread_join(threads[i], NULL);
+		#endif
+	}
+}
+
+/**
+ * <p>
+ * Creates a monitor (lock and condition).
+ * </p>
+ * 
+ * @returns The new monitor, NULL if no memory could be reserved
+ */
+struct CC_Monitor *CC_create_monitor() {
+	struct CC_Monitor *monitor = (struct CC_Monitor*)calloc(1, sizeof(struct CC_Monitor));
+
+	if (monitor == NULL) {
+		return NULL;
+	}
+
+	#ifdef _WIN32
+	(void)InitializeCriticalSection(&monitor->lock);
+	(void)InitializeConditionVariable(&monitor->condition);
+	#else
+	(void)pthread_mutex_init(&monitor->lock, NULL);
+	(void)pthread_cond_init(&monitor->condition, NULL);
+	#endif
+
+	return monitor;
+}
+
+/**
+ * <p>
+ * Locks the monitor.
+ * </p>
+ * 
+ * @param *monitor  Monitor to lock
+ */
+void CC_enter_monitor(struct CC_Monitor *monitor) {
+	#ifdef _WIN32
+	(void)EnterCriticalSection(&monitor->lock);
+	#else
+	(void)pthread_mutex_lock(&monitor->lock);
+	#endif
+}
+
+/**
+ * <p>
+ * Unlocks the monitor.
+ * </p>
+ * 
+ * @param *monitor  Monitor to unlock
+ */
+void CC_leave_monitor(struct CC_Monitor *monitor) {
+	#ifdef _WIN32
+	(void)LeaveCriticalSection(&monitor->lock);
+	#else
+	(void)pthread_mutex_unlock(&monitor->lock);
+	#endif
+}
+
+/**
+ * <p>
+ * Unlocks the monitor until another thread calls CC_notify_monitor(),
+ * the monitor has to be locked by the calling thread.
+ * </p>
+ * 
+ * @param *monitor  Monitor to wait on
+ */
+void CC_wait_monitor(struct CC_Monitor *monitor) {
+	#ifdef _WIN32
+	(void)SleepConditionVariableCS(&monitor->condition, &monitor->lock, INFINITE);
+	#else
+	(void)pthread_cond_wait(&monitor->condition, &monitor->lock);
+	#endif
+}
+
+/**
+ * <p>
+ * Wakes up all threads, that wait on the monitor.
+ * </p>
+ * 
+ * @param *monitor  Monitor to notify
+ */
+void CC_notify_monitor(struct CC_Monitor *monitor) {
+	#ifdef _WIN32
+	(void)WakeAllConditionVariable(&monitor->condition);
+	#else
+	(void)pthread_cond_broadcast(&monitor->condition);
+	#endif
+}
+
+/**
+ * <p>
+ * Frees the monitor, no thread may wait on it anymore.
+ * </p>
+ * 
+ * @param *monitor  Monitor to free
+ */
+void CC_free_monitor(struct CC_Monitor *monitor) {
+	if (monitor == NULL) {
+		return;
+	}
+
+	#ifdef _WIN32
+	(void)DeleteCriticalSection(&monitor->lock);
+	#else
+	(void)pthread_mutex_destroy(&monitor->lock);
+	(void)pthread_cond_destroy(&monitor->condition);
+	#endif
+
+	(void)free(monitor);
+}
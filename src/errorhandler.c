@@ -25,48 +25,29 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <string.h>
 #include "../headers/modules.h"
 #include "../headers/errors.h"
+#include "../headers/internPool.h"
+#include "../headers/tokenIndex.h"
+#include "../headers/lineIndex.h"
+#include "../headers/compilerContext.h"
 
 #define true 1
 #define false 0
 
-extern char *FILE_NAME;
-
-// Cache
-TOKEN *TokenCache = NULL;
-char *BufferCache = NULL;
-int *arrayOfIndividualTokenSizesCache = NULL;
-struct Node *rootNode = NULL;
-
-/*
-Purpose: Initialize the token array, so it can be freed at an error
-Return Type: void
-Params: TOKEN **tokens -> Pointer to the token array from the lexer
-*/
-void _init_error_token_cache_(TOKEN **tokens) {
-	TokenCache = (*tokens);
-}
-
 /*
-Purpose: Initialize the input buffer, so it can be freed at an error
+Purpose: End the compilation after a fatal error. With a recovery point in the CURRENT_CONTEXT
+		(compile server) the error is recorded and the compilation jumps back, otherwise the
+		memory is freed and the process exits
 Return Type: void
-Params: char **buffer -> Pointer to the buffer
+Params: char *message => Description of the error; size_t line => Line of the error (0 = unknown)
 */
-void _init_error_buffer_cache_(char **buffer) {
-	BufferCache = (*buffer);
-}
+void TERMINATE_COMPILATION(char *message, size_t line) {
+	(void)CC_abort_compilation(message, line, 0);
 
-/*
-Purpose: Initialize the sizes of the tokens, so it can be freed at an error
-Return Type: void
-Params: int **arrayOfIndividualTokenSizes => Sizes of the individual tokens
-*/
-void _init_error_token_size_cache_(int **arrayOfIndividualTokenSizes) {
-	arrayOfIndividualTokenSizesCache = (*arrayOfIndividualTokenSizes);
+	if ((int)FREE_MEMORY() == true) {
+		(void)exit(EXIT_FAILURE);
+	}
 }
 
-void _init_error_tree_cache_(struct Node **root) {
-	rootNode = (*root);
-}
 /*
 Purpose: Throw an IO exception
 Return Type: void
@@ -77,9 +58,9 @@ void IO_FILE_EXCEPTION(char *Source, char *file) {
 	(void)printf("\nIOException at %s file: %s\n", file, Source);
 	(void)printf("File: NULL => Can't processes NULL!");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	char message[128];
+	(void)snprintf(message, sizeof(message), "Can't read the file \"%s\".", Source);
+	(void)TERMINATE_COMPILATION(message, 0);
 }
 
 /*
@@ -90,9 +71,7 @@ Params: char *Step -> Part of the compiler, which has a buffer overflow
 void IO_BUFFER_EXCEPTION(char *Step) {
 	(void)printf("BufferException: Buffer out of bounds at %s.\n", Step);
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Buffer out of bounds.", 0);
 }
 
 /*
@@ -103,9 +82,7 @@ Params: void
 void IO_BUFFER_RESERVATION_EXCEPTION() {
 	(void)printf("An error occured while trying to allocate memory.\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("An error occured while trying to allocate memory.", 0);
 }
 
 /*
@@ -116,9 +93,7 @@ Params: void
 void IO_FILE_CLOSING_EXCEPTION() {
 	(void)printf("Unable to close the file.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Unable to close the file.", 0);
 }
 
 /*
@@ -215,9 +190,7 @@ void LEXER_UNEXPECTED_SYMBOL_EXCEPTION(char **input, int pos, int maxBackPos, in
 		}
 	}
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Unexpected symbol has been found in the input.", line + 1);
 }
 
 /*
@@ -229,9 +202,7 @@ void LEXER_NULL_TOKEN_EXCEPTION() {
 	(void)printf("An fatal error occured while trying to assign the file content into tokens.\n");
 	(void)printf("More data than tokens are available.\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("More data than tokens are available.", 0);
 }
 
 /*
@@ -242,9 +213,7 @@ Params: void
 void LEXER_UNFINISHED_POINTER_EXCEPTION() {
 	(void)printf("Unfinished or invalid pointer declaration");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Unfinished or invalid pointer declaration.", 0);
 }
 
 /*
@@ -255,9 +224,7 @@ Params: void
 void LEXER_NULL_TOKEN_VALUE_EXCEPTION() {
 	(void)printf("Token with value NULL detected => Cannot process NULL.\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Token with value NULL detected.", 0);
 }
 
 /*
@@ -268,9 +235,18 @@ Params: void
 void LEXER_TOKEN_ERROR_EXCEPTION() {
 	(void)printf("NULL token found => Cannot process NULL Token.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("NULL token found.", 0);
+}
+
+/*
+Purpose: Throw an error, if the input is too large for the 32 bit token positions
+Return Type: void
+Params: size_t length -> Length of the input
+*/
+void LEXER_INPUT_TOO_LARGE_EXCEPTION(size_t length) {
+	(void)printf("The input has %zu characters, at most %u characters can be lexed.\n", length, TOKEN_MAX_POSITION);
+
+	(void)TERMINATE_COMPILATION("The input is too large.", 0);
 }
 
 /*
@@ -282,9 +258,7 @@ void PARSER_TOKEN_TRANSMISSION_EXCEPTION() {
 	(void)printf("An fatal error occured while transmitting the tokens to the parsing section.\n");
 	(void)printf("Tokens = NULL, NULL can't be processed.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("The tokens couldn't be transmitted to the parsing section.", 0);
 }
 
 /*
@@ -296,9 +270,7 @@ void PARSER_RULE_RESERVATION_EXCEPTION() {
 	(void)printf("An error occured while reservating memory for the Grammar rule.\n");
 	(void)printf("*Pointer NULL, NULL can't be processed.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Memory for the grammar rules couldn't be reserved.", 0);
 }
 
 /*
@@ -309,9 +281,7 @@ Params: void
 void PARSER_RULE_FILE_CORRUPTION_EXCEPTION() {
 	(void)printf("The parser rule file is corrupted and can't be processed anymore.\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("The parser rule file is corrupted.", 0);
 }
 
 /*
@@ -323,9 +293,7 @@ void PARSER_RULE_TRANSMISSION_EXCEPTION() {
 	(void)printf("An fatal error occured while transmitting the rules to the parsing section.\n");
 	(void)printf("GrammarRules = NULL, NULL can't be processed.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("The rules couldn't be transmitted to the parsing section.", 0);
 }
 
 /*
@@ -336,9 +304,7 @@ Params: void
 void LIST_OVERFLOW_EXCEPTION() {
 	(void)printf("Too much data was pushed into the list, can't process more than LIST_SIZE\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Too much data was pushed into the list.", 0);
 }
 
 /*
@@ -349,70 +315,40 @@ Params: void
 void LIST_UNDERFLOW_EXCEPTION() {
 	(void)printf("Can't access to data at position NULL in the list.\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Can't access data at position NULL in the list.", 0);
 }
 
 /*
 Purpose: Throw an error, when there is a string, that is not finished
 Return Type: void
 Params: char **input => Source code;
-		size_t errorPos => Position from where the string starts;
-		size_t lineNumber => Line number of the string start;
+		size_t errorPos => Position from where the string starts
 */
-void LEXER_UNFINISHED_STRING_EXCEPTION(char **input, size_t errorPos, size_t lineNumber) {
-	(void)printf("Unfinished string at end of file. (%s)\n", FILE_NAME);
+void LEXER_UNFINISHED_STRING_EXCEPTION(char **input, size_t errorPos) {
+	(void)printf("Unfinished string at end of file. (%s)\n", CURRENT_CONTEXT->fileName);
 	(void)printf("-----------------------------------------------------\n");
 
 	char buffer[32];
-	int charPosition = 0;
-	int printPosition = errorPos;
+	size_t sourceLine = (size_t)LI_get_line(errorPos);
+	size_t lineStart = (size_t)LI_get_line_start(sourceLine);
+	size_t lineLength = (size_t)LI_get_line_length(sourceLine);
 
-	for (int i = errorPos; i > 0; i--) {
-		if ((*input)[i] == '\n' || (i - 1) <= 0) {
-			printPosition = i - 1;
-			charPosition++;
-			break;
-		}
-
-		charPosition++;
-	}
-
-	int msgLength = (int)snprintf(buffer, 32, "%li : %i | ", (lineNumber + 1), charPosition);
-	(void)printf("%s", buffer);
-
-	for (int i = printPosition; (*input)[i] != '\0'; i++) {
-		(void)printf("%c", (*input)[i]);
-
-		if ((*input)[i + 1] == '\n' || (*input)[i + 1] == '\0') {
-			(void)printf("\n");
-			break;
-		}
-	}
+	int msgLength = (int)snprintf(buffer, 32, "%li : %li | ", (sourceLine + 1), (errorPos - lineStart + 1));
+	(void)printf("%s%.*s\n", buffer, (int)lineLength, &(*input)[lineStart]);
 
 	for (int i = 0; i < msgLength; i++) {
 		(void)printf(" ");
 	}
 
-	for (int i = printPosition; (*input)[i] != '\0'; i++) {
-		if (i >= errorPos) {
-			(void)printf("^");
-		} else {
-			(void)printf("~");
-		}
-
-		if ((*input)[i + 1] == '\n' || (*input)[i + 1] == '\0') {
-			(void)printf("\n");
-			break;
-		}
+	for (size_t i = lineStart; i < lineStart + lineLength; i++) {
+		(void)printf(i >= errorPos ? "^" : "~");
 	}
 
+	(void)printf("\n");
+
 	(void)printf("-----------------------------------------------------\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Unfinished string at end of file.", sourceLine + 1);
 }
 
 /*
@@ -425,9 +361,7 @@ void SYNTAX_MISMATCH_EXCEPTION(char *value, char *awaited) {
 	(void)printf("Terminated compile process due to rule mismatch!\n");
 	(void)printf("Problem: \"%s\", awaited \"%s\"\n", value, awaited);
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Terminated compile process due to rule mismatch.", 0);
 }
 
 /*
@@ -438,33 +372,31 @@ Params: void
 void SYNTAX_ANALYSIS_TOKEN_NULL_EXCEPTION() {
 	(void)printf("Terminated compile process due to token NULL, NULL can't be processed!\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Terminated compile process due to token NULL.", 0);
 }
 
 void PARSE_TREE_NODE_RESERVATION_EXCEPTION() {
 	(void)printf("Terminated parsetree generation due to memory reservation exception!\n");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)TERMINATE_COMPILATION("Terminated parsetree generation due to memory reservation exception.", 0);
 }
 
 /*
-Purpose: Frees the reserved memory on error throw
+Purpose: Frees the reserved memory of the CURRENT_CONTEXT on error throw
 Return Type: int => true = successfully freed; false = error occured, terminate
 Params: void
 */
 int FREE_MEMORY() {
 	int free = 0;
 
-	free += (int)FREE_BUFFER(BufferCache);
-	free += (int)FREE_TOKENS(TokenCache);
-	free += (int)FREE_TOKEN_LENGTHS(arrayOfIndividualTokenSizesCache);
-	free += (int)FREE_NODE(rootNode);
+	free += (int)FREE_BUFFER(CURRENT_CONTEXT->buffer);
+	free += (int)FREE_TOKENS(CURRENT_CONTEXT->tokens);
+	free += (int)FREE_NODE(CURRENT_CONTEXT->root);
+	free += (int)FREE_INTERN_POOL();
+	free += (int)FREE_TOKEN_INDEX();
+	free += (int)FREE_LINE_INDEX();
 
-	if (free == 4) {
+	if (free == 6) {
 		(void)printf("\n\n\nProgram exited successful\n");
 		return true;
 	}
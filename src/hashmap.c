@@ -26,6 +26,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include "../headers/hashmap.h"
 #include "../headers/modules.h"
 #include "../headers/errors.h"
+#include "../headers/internPool.h"
 
 /** 
  * The subprogram {@code SPACE/src/hashmap.c} was created
@@ -43,6 +44,12 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
  * Total Collisions:        78'050'943
  * Resizings:               30 (150 initial capacity)
  * 
+ * Next to the chained map there is an open addressing map
+ * (see CreateNewOpenHashMap()) behind the same HM_* functions. It stores
+ * the entries inline with linear probing, caches the 32 bit hash of each
+ * key and grows by powers of two, so it needs no allocation per entry
+ * and never hashes a key again on a resize.
+ * 
  * @see SPACE/docs/hashmap.md
  * 
  * @version 1.0     15.06.2024
@@ -77,6 +84,33 @@ static const float MAXIMUM_LOAD_FACTOR = 0.66f;
  */
 static const float SCALE_FACTOR = 2.0f;
 
+/**
+ * <p>
+ * This defines the minimum capacity of the open addressing map.
+ * The capacity is always a power of two.
+ * </p>
+ */
+static const int MINIMUM_OPEN_CAPACITY = 8;
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define HM_ATOMIC_ADD(counter, value) (void)_InterlockedExchangeAdd64(&(counter), (value))
+#define HM_ATOMIC_LOAD(counter) _InterlockedCompareExchange64(&(counter), 0, 0)
+#else
+#define HM_ATOMIC_ADD(counter, value) (void)__atomic_fetch_add(&(counter), (value), __ATOMIC_RELAXED)
+#define HM_ATOMIC_LOAD(counter) __atomic_load_n(&(counter), __ATOMIC_RELAXED)
+#endif
+
+/**
+ * <p>
+ * Resizes and collisions of all maps, a map adds its collisions on a
+ * resize and when it is freed (see HM_get_statistics()). The maps can
+ * be used by more than one thread, so the totals are added atomically.
+ * </p>
+ */
+static long long TOTAL_RESIZES = 0;
+static long long TOTAL_COLLISSIONS = 0;
+
 ///// PROTOTYPES /////
 
 struct HashMapEntry *HM_create_new_entry(char *key, void *value);
@@ -90,6 +124,13 @@ int HM_is_prime(int num);
 void HM_free_row(struct HashMap *map, int index);
 void HM_free_entry(struct HashMapEntry *entry, int freeList);
 
+unsigned int HM_hash_key(const char *key);
+void HM_open_add_entry(char *key, void *value, struct HashMap *map);
+struct HashMapEntry *HM_open_get_entry(char *key, struct HashMap *map);
+void HM_open_remove_entry(struct HashMapEntry *entry, struct HashMap *map);
+void HM_open_resize(struct HashMap *map, int newCapacity);
+void HM_open_clear(struct HashMap *map);
+
 struct HashMap *CreateNewHashMap(int initCapacity) {
 	struct HashMap *map = (struct HashMap*)calloc(1, sizeof(struct HashMap));
 	int primeCap = (int)HM_get_next_prime_number(initCapacity);
@@ -105,11 +146,72 @@ struct HashMap *CreateNewHashMap(int initCapacity) {
 	return map;
 }
 
+/**
+ * <p>
+ * Creates a new HashMap, that uses open addressing.
+ * </p>
+ * 
+ * <p>
+ * The entries are stored inline in one slot array and found by
+ * linear probing. The map keeps its load at 0.75 or below and
+ * doubles its capacity, when the load would exceed it.
+ * </p>
+ * 
+ * <p><strong>Note:</strong>
+ * The entries returned by HM_get_entry() are only valid until the next
+ * entry is added or removed, since the slots can move.
+ * </p>
+ * 
+ * @returns A pointer to the HashMap
+ * 
+ * @param initCapacity  Number of entries that fit without a resize
+ */
+struct HashMap *CreateNewOpenHashMap(int initCapacity) {
+	struct HashMap *map = (struct HashMap*)calloc(1, sizeof(struct HashMap));
+
+	if (map == NULL) {
+		printf("Hashmap allocation failed!\n");
+		exit(0);
+	}
+
+	int capacity = MINIMUM_OPEN_CAPACITY;
+
+	while (capacity * 3 < initCapacity * 4) {
+		capacity *= 2;
+	}
+
+	map->openAddressing = true;
+	map->capacity = capacity;
+	map->slots = (struct HashMapEntry*)calloc(capacity, sizeof(struct HashMapEntry));
+
+	if (map->slots == NULL) {
+		printf("Hashmap allocation failed!\n");
+		HM_free(map);
+		exit(0);
+	}
+
+	return map;
+}
+
 void HM_print_map(struct HashMap *map, int withList) {
 	if (map == NULL) {
 		return;
 	}
 
+	if (map->openAddressing == true) {
+		printf("HashMap@[%p] (open addressing)\n", (void*)map);
+		printf("Map Capacity: %i\n", map->capacity);
+		printf("Map Load: %i\n", map->load);
+		printf("Map Resizes: %i\n", map->resizes);
+		printf("\n");
+
+		for (int i = 0; withList == true && i < map->capacity; i++) {
+			printf("Slot %6i|%-23s|%-24p|\n", i, map->slots[i].key == NULL ? "(null)" : map->slots[i].key, map->slots[i].value);
+		}
+
+		return;
+	}
+
 	printf("HashMap@[%p]\n", (void*)map);
 	printf("Map Capacity: %i\n", map->capacity);
 	printf("Map Collision: %i\n", map->collissions);
@@ -175,6 +277,11 @@ void HM_print_map(struct HashMap *map, int withList) {
  * @param *map      HashMap to add the entry to
  */
 void HM_add_entry(char *key, void *value, struct HashMap *map) {
+	if (map->openAddressing == true) {
+		(void)HM_open_add_entry(key, value, map);
+		return;
+	}
+
 	struct HashMapEntry *entry = HM_create_new_entry(key, value);
 	map->load++;
 	(void)HM_add_internal_entry(entry, map);
@@ -305,12 +412,16 @@ struct HashMapEntry *HM_get_entry(char *key, struct HashMap *map) {
 	if (key == NULL || map == NULL) {
 		return NULL;
 	}
+
+	if (map->openAddressing == true) {
+		return HM_open_get_entry(key, map);
+	}
 	
 	int hashPos = (int)HM_get_position_based_on_hash(key, map->capacity);
 	struct HashMapEntry *temp = map->entries[hashPos];
 	
 	while (temp != NULL) {
-		if ((int)strcmp(temp->key, key) == 0) {
+		if (IP_EQUALS(temp->key, key)) {
 			return temp;
 		}
 
@@ -357,12 +468,17 @@ int HM_contains_key(char *key, struct HashMap *map) {
  * @param *map      Map from which the entry should be removed
  */
 void HM_remove_entry(struct HashMapEntry *entry, struct HashMap *map) {
+	if (map->openAddressing == true) {
+		(void)HM_open_remove_entry(entry, map);
+		return;
+	}
+
 	int hashPos = (int)HM_get_position_based_on_hash(entry->key, map->capacity);
 	struct HashMapEntry *prevEntry = map->entries[hashPos];
 	struct HashMapEntry *temp = map->entries[hashPos];
 
 	while (temp != NULL) {
-		if ((int)strcmp(temp->key, entry->key) == 0) {
+		if (IP_EQUALS(temp->key, entry->key)) {
 			prevEntry->linkedEntry = temp->linkedEntry;
 			(void)HM_free_entry(temp, false);
 			map->load--;
@@ -399,6 +515,8 @@ void HM_resize_hashmap(struct HashMap *map, int newCapacity) {
 		return;
 	}
 	
+	HM_ATOMIC_ADD(TOTAL_COLLISSIONS, (long long)map->collissions);
+	HM_ATOMIC_ADD(TOTAL_RESIZES, 1);
 	map->collissions = 0;
 	map->resizes++;
 	map->capacity = newCapacity;
@@ -526,15 +644,37 @@ void HM_free(struct HashMap *map) {
 		return;
 	}
 
+	HM_ATOMIC_ADD(TOTAL_COLLISSIONS, (long long)map->collissions);
+
 	if (map->entries != NULL) {
 		(void)HM_clear(map);
 		(void)free(map->entries);
 		map->entries = NULL;
 	}
 
+	if (map->slots != NULL) {
+		(void)HM_open_clear(map);
+		(void)free(map->slots);
+		map->slots = NULL;
+	}
+
 	(void)free(map);
 }
 
+/**
+ * <p>
+ * Returns the resizes and collisions of all maps so far. The collisions
+ * of a map, that was not resized or freed yet, are not included.
+ * </p>
+ * 
+ * @param *resizes      Set to the number of resizes
+ * @param *collissions  Set to the number of collisions
+ */
+void HM_get_statistics(long long *resizes, long long *collissions) {
+	(*resizes) = (long long)HM_ATOMIC_LOAD(TOTAL_RESIZES);
+	(*collissions) = (long long)HM_ATOMIC_LOAD(TOTAL_COLLISSIONS);
+}
+
 /**
  * <p>
  * Clears the whole HashMap.
@@ -543,6 +683,11 @@ void HM_free(struct HashMap *map) {
  * @param *map  Pointer to the map to clear
  */
 void HM_clear(struct HashMap *map) {
+	if (map != NULL && map->openAddressing == true) {
+		(void)HM_open_clear(map);
+		return;
+	}
+
 	if (map == NULL || map->entries == NULL) {
 		printf("No map to clear!\n");
 		return;
@@ -557,15 +702,25 @@ void HM_clear(struct HashMap *map) {
 	}
 }
 
+/**
+ * <p>
+ * Frees an entry and its value.
+ * </p>
+ * 
+ * <p>
+ * The key is not freed, since the keys are borrowed from the
+ * token values / node values and are released with them.
+ * </p>
+ * 
+ * @param *entry    Entry to free
+ * @param freeList  Whether to free the linked entries too or not
+ */
 void HM_free_entry(struct HashMapEntry *entry, int freeList) {
 	if (entry == NULL) {
 		return;
 	}
 
-	if (entry->key != NULL) {
-		(void)free(entry->key);
-		entry->key = NULL;
-	}
+	entry->key = NULL;
 
 	if (entry->value != NULL) {
 		(void)free(entry->value);
@@ -579,4 +734,255 @@ void HM_free_entry(struct HashMapEntry *entry, int freeList) {
 
 	(void)free(entry);
 	entry = NULL;
-}
\ No newline at end of file
+}
+
+/**
+ * <p>
+ * Creates an iterator over all entries of the HashMap.
+ * </p>
+ * 
+ * @returns The iterator, that is positioned before the first entry
+ * 
+ * @param *map  Map to iterate over
+ */
+struct HashMapIterator HM_create_iterator(struct HashMap *map) {
+	struct HashMapIterator iterator = {map, -1, NULL};
+	return iterator;
+}
+
+/**
+ * <p>
+ * Moves the iterator to the next entry, linked entries of the chained
+ * map are visited as well.
+ * </p>
+ * 
+ * @returns The next entry or NULL, if all entries were visited
+ * 
+ * @param *iterator     Iterator to move
+ */
+struct HashMapEntry *HM_next_entry(struct HashMapIterator *iterator) {
+	struct HashMap *map = iterator->map;
+
+	if (map == NULL) {
+		return NULL;
+	}
+
+	if (map->openAddressing == false && iterator->entry != NULL
+		&& iterator->entry->linkedEntry != NULL) {
+		iterator->entry = iterator->entry->linkedEntry;
+		return iterator->entry;
+	}
+
+	while (++iterator->bucket < map->capacity) {
+		if (map->openAddressing == true) {
+			iterator->entry = map->slots[iterator->bucket].key != NULL ? &map->slots[iterator->bucket] : NULL;
+		} else {
+			iterator->entry = map->entries[iterator->bucket];
+		}
+
+		if (iterator->entry != NULL) {
+			return iterator->entry;
+		}
+	}
+
+	iterator->entry = NULL;
+	return NULL;
+}
+
+/**
+ * <p>
+ * Computes the FNV-1a hash of a key (open addressing map).
+ * </p>
+ * 
+ * @returns The 32 bit hash
+ * 
+ * @param *key  Key to hash
+ */
+unsigned int HM_hash_key(const char *key) {
+	unsigned int hash = 2166136261u;
+
+	for (int i = 0; key[i] != '\0'; i++) {
+		hash = (hash ^ (unsigned char)key[i]) * 16777619u;
+	}
+
+	return hash;
+}
+
+/**
+ * <p>
+ * Adds an entry into the open addressing map.
+ * </p>
+ * 
+ * <p>
+ * Like in the chained map, a key that is already in the map is
+ * added again, HM_get_entry() returns the entry that was added first.
+ * </p>
+ * 
+ * @param *key      Key of the entry
+ * @param *value    Value of the entry
+ * @param *map      HashMap to add the entry to
+ */
+void HM_open_add_entry(char *key, void *value, struct HashMap *map) {
+	if (key == NULL) {
+		printf("No key to add!\n");
+		return;
+	}
+
+	if ((map->load + 1) * 4 > map->capacity * 3) {
+		(void)HM_open_resize(map, map->capacity * 2);
+	}
+
+	unsigned int hash = (unsigned int)HM_hash_key(key);
+	int mask = map->capacity - 1;
+	int slot = (int)(hash & mask);
+
+	while (map->slots[slot].key != NULL) {
+		slot = (slot + 1) & mask;
+		map->collissions++;
+	}
+
+	map->slots[slot].key = key;
+	map->slots[slot].value = value;
+	map->slots[slot].hash = hash;
+	map->load++;
+}
+
+/**
+ * <p>
+ * Gets an entry out of the open addressing map. The bytes of a key are
+ * only compared, if the cached hash matches.
+ * </p>
+ * 
+ * @returns The entry or NULL, if no entry was found
+ * 
+ * @param *key  Key of the entry
+ * @param *map  HashMap to search in
+ */
+struct HashMapEntry *HM_open_get_entry(char *key, struct HashMap *map) {
+	unsigned int hash = (unsigned int)HM_hash_key(key);
+	int mask = map->capacity - 1;
+	int slot = (int)(hash & mask);
+
+	while (map->slots[slot].key != NULL) {
+		if (map->slots[slot].hash == hash && IP_EQUALS(map->slots[slot].key, key)) {
+			return &map->slots[slot];
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return NULL;
+}
+
+/**
+ * <p>
+ * Removes an entry from the open addressing map and frees its value.
+ * </p>
+ * 
+ * <p>
+ * Instead of leaving a tombstone, the following entries of the probe
+ * sequence are shifted back, so lookups never have to skip deleted slots.
+ * </p>
+ * 
+ * @param *entry    Entry to remove
+ * @param *map      Map from which the entry should be removed
+ */
+void HM_open_remove_entry(struct HashMapEntry *entry, struct HashMap *map) {
+	struct HashMapEntry *found = HM_open_get_entry(entry->key, map);
+
+	if (found == NULL) {
+		return;
+	}
+
+	int mask = map->capacity - 1;
+	int hole = (int)(found - map->slots);
+	(void)free(found->value);
+	map->load--;
+
+	for (int next = (hole + 1) & mask; map->slots[next].key != NULL; next = (next + 1) & mask) {
+		int home = (int)(map->slots[next].hash & mask);
+
+		// Move the entry into the hole, if its home slot is not between the hole and itself
+		if (((next - home) & mask) >= ((next - hole) & mask)) {
+			map->slots[hole] = map->slots[next];
+			hole = next;
+		}
+	}
+
+	map->slots[hole].key = NULL;
+	map->slots[hole].value = NULL;
+	map->slots[hole].hash = 0;
+}
+
+/**
+ * <p>
+ * Resizes the open addressing map. The cached hashes are reused,
+ * so no key is hashed again.
+ * </p>
+ * 
+ * @param *map          HashMap to resize
+ * @param newCapacity   New capacity (power of two)
+ */
+void HM_open_resize(struct HashMap *map, int newCapacity) {
+	struct HashMapEntry *slots = (struct HashMapEntry*)calloc(newCapacity, sizeof(struct HashMapEntry));
+
+	if (slots == NULL) {
+		printf("Hashmap allocation failed!\n");
+		HM_free(map);
+		exit(0);
+	}
+
+	int mask = newCapacity - 1;
+	int oldMask = map->capacity - 1;
+	int start = 0;
+
+	// Start behind an empty slot, so every probe sequence is moved in order and equal keys keep their order
+	while (map->slots[start].key != NULL) {
+		start++;
+	}
+
+	for (int n = 1; n <= map->capacity; n++) {
+		int i = (start + n) & oldMask;
+
+		if (map->slots[i].key == NULL) {
+			continue;
+		}
+
+		int slot = (int)(map->slots[i].hash & mask);
+
+		while (slots[slot].key != NULL) {
+			slot = (slot + 1) & mask;
+		}
+
+		slots[slot] = map->slots[i];
+	}
+
+	(void)free(map->slots);
+	map->slots = slots;
+	map->capacity = newCapacity;
+	HM_ATOMIC_ADD(TOTAL_COLLISSIONS, (long long)map->collissions);
+	HM_ATOMIC_ADD(TOTAL_RESIZES, 1);
+	map->collissions = 0;
+	map->resizes++;
+}
+
+/**
+ * <p>
+ * Clears the open addressing map and frees the values.
+ * </p>
+ * 
+ * @param *map  Pointer to the map to clear
+ */
+void HM_open_clear(struct HashMap *map) {
+	for (int i = 0; i < map->capacity; i++) {
+		if (map->slots[i].key == NULL) {
+			continue;
+		}
+
+		(void)free(map->slots[i].value);
+		map->slots[i].key = NULL;
+		map->slots[i].value = NULL;
+	}
+
+	map->load = 0;
+}
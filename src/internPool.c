@@ -0,0 +1,256 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/internPool.h"
+#include "../headers/errors.h"
+#include "../headers/compilerContext.h"
+
+/** 
+ * The subprogram {@code SPACE/src/internPool.c} was created
+ * to provide a pool, that stores every distinct string once.
+ * 
+ * The lexer interns the token values, so equal identifiers in the
+ * tokens, nodes and semantic tables point to the same string. Comparing
+ * them (see IP_EQUALS) becomes a pointer comparison in most cases.
+ * 
+ * The strings are packed into large text blocks and found through an
+ * open addressing table with linear probing, that also stores the hash
+ * and length of each string, so a probe only compares bytes on a likely hit.
+ * 
+ * Every compilation has its own pool (see CompilerContext).
+ * 
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define INTERN_BLOCK_SIZE 65536
+#define INTERN_INITIAL_CAPACITY 1024
+
+/**
+ * <p>
+ * A block of the pool, that holds the interned strings.
+ * </p>
+ */
+struct InternBlock {
+	struct InternBlock *previousBlock;
+	size_t capacity;
+	size_t used;
+	char text[];
+};
+
+/**
+ * <p>
+ * A slot of the lookup table, the string is NULL if the slot is empty.
+ * </p>
+ */
+struct InternSlot {
+	char *string;
+	size_t length;
+	unsigned int hash;
+};
+
+unsigned int IP_hash(const char *string, size_t length);
+void IP_resize_slots(size_t capacity);
+char *IP_store_string(const char *string, size_t length);
+
+/**
+ * <p>
+ * Interns a string.
+ * </p>
+ * 
+ * @returns The pooled string, equal strings always return the same pointer
+ * 
+ * @param *string   String to intern (NULL returns NULL)
+ */
+char *IP_intern(const char *string) {
+	if (string == NULL) {
+		return NULL;
+	}
+
+	return IP_intern_length(string, strlen(string));
+}
+
+/**
+ * <p>
+ * Interns the first characters of a string.
+ * </p>
+ * 
+ * @returns The pooled, '\0' terminated string
+ * 
+ * @param *string   String to intern
+ * @param length    Number of characters to intern
+ */
+char *IP_intern_length(const char *string, size_t length) {
+	// Keep the load factor at 0.5 or below
+	if ((CURRENT_CONTEXT->internLoad + 1) * 2 > CURRENT_CONTEXT->internCapacity) {
+		(void)IP_resize_slots(CURRENT_CONTEXT->internCapacity == 0 ? INTERN_INITIAL_CAPACITY : CURRENT_CONTEXT->internCapacity * 2);
+	}
+
+	unsigned int hash = (unsigned int)IP_hash(string, length);
+	size_t slot = hash & (CURRENT_CONTEXT->internCapacity - 1);
+
+	while (CURRENT_CONTEXT->internSlots[slot].string != NULL) {
+		struct InternSlot *current = &CURRENT_CONTEXT->internSlots[slot];
+
+		if (current->hash == hash && current->length == length
+			&& (int)memcmp(current->string, string, length) == 0) {
+			return current->string;
+		}
+
+		slot = (slot + 1) & (CURRENT_CONTEXT->internCapacity - 1);
+	}
+
+	CURRENT_CONTEXT->internSlots[slot].string = IP_store_string(string, length);
+	CURRENT_CONTEXT->internSlots[slot].length = length;
+	CURRENT_CONTEXT->internSlots[slot].hash = hash;
+	CURRENT_CONTEXT->internLoad++;
+	return CURRENT_CONTEXT->internSlots[slot].string;
+}
+
+/**
+ * <p>
+ * Computes the FNV-1a hash of a string.
+ * </p>
+ * 
+ * @returns The hash
+ * 
+ * @param *string   String to hash
+ * @param length    Number of characters to hash
+ */
+unsigned int IP_hash(const char *string, size_t length) {
+	unsigned int hash = 2166136261u;
+
+	for (size_t i = 0; i < length; i++) {
+		hash = (hash ^ (unsigned char)string[i]) * 16777619u;
+	}
+
+	return hash;
+}
+
+/**
+ * <p>
+ * Resizes the lookup table and reinserts all strings.
+ * </p>
+ * 
+ * @param capacity  New capacity (power of two)
+ */
+void IP_resize_slots(size_t capacity) {
+	struct InternSlot *slots = (struct InternSlot*)calloc(capacity, sizeof(struct InternSlot));
+
+	if (slots == NULL) {
+		(void)CC_abort_compilation("Could not reserve the intern pool.", 0, 0);
+		(void)FREE_MEMORY();
+		(void)printf("Could not reserve the intern pool!\n");
+		(void)exit(EXIT_FAILURE);
+	}
+
+	for (size_t i = 0; i < CURRENT_CONTEXT->internCapacity; i++) {
+		if (CURRENT_CONTEXT->internSlots[i].string == NULL) {
+			continue;
+		}
+
+		size_t slot = CURRENT_CONTEXT->internSlots[i].hash & (capacity - 1);
+
+		while (slots[slot].string != NULL) {
+			slot = (slot + 1) & (capacity - 1);
+		}
+
+		slots[slot] = CURRENT_CONTEXT->internSlots[i];
+	}
+
+	(void)free(CURRENT_CONTEXT->internSlots);
+	CURRENT_CONTEXT->internSlots = slots;
+	CURRENT_CONTEXT->internCapacity = capacity;
+}
+
+/**
+ * <p>
+ * Copies a string into the current block, a new block is added if
+ * the string does not fit anymore.
+ * </p>
+ * 
+ * @returns The copied, '\0' terminated string
+ * 
+ * @param *string   String to copy
+ * @param length    Number of characters to copy
+ */
+char *IP_store_string(const char *string, size_t length) {
+	if (CURRENT_CONTEXT->currentInternBlock == NULL
+		|| CURRENT_CONTEXT->currentInternBlock->capacity - CURRENT_CONTEXT->currentInternBlock->used < length + 1) {
+		size_t capacity = length + 1 > INTERN_BLOCK_SIZE ? length + 1 : INTERN_BLOCK_SIZE;
+		struct InternBlock *block = (struct InternBlock*)calloc(1, sizeof(struct InternBlock) + capacity);
+
+		if (block == NULL) {
+			(void)CC_abort_compilation("Could not reserve the intern pool.", 0, 0);
+			(void)FREE_MEMORY();
+			(void)printf("Could not reserve the intern pool!\n");
+			(void)exit(EXIT_FAILURE);
+		}
+
+		block->previousBlock = CURRENT_CONTEXT->currentInternBlock;
+		block->capacity = capacity;
+		block->used = 0;
+		CURRENT_CONTEXT->currentInternBlock = block;
+	}
+
+	char *copy = CURRENT_CONTEXT->currentInternBlock->text + CURRENT_CONTEXT->currentInternBlock->used;
+	(void)memcpy(copy, string, length);
+	copy[length] = '\0';
+	CURRENT_CONTEXT->currentInternBlock->used += length + 1;
+	return copy;
+}
+
+/**
+ * <p>
+ * Returns the number of distinct strings in the pool.
+ * </p>
+ */
+size_t IP_get_interned_count() {
+	return CURRENT_CONTEXT->internLoad;
+}
+
+/**
+ * <p>
+ * Frees the intern pool with all interned strings.
+ * </p>
+ * 
+ * @returns true, if the pool was freed
+ */
+int FREE_INTERN_POOL() {
+	while (CURRENT_CONTEXT->currentInternBlock != NULL) {
+		struct InternBlock *previousBlock = CURRENT_CONTEXT->currentInternBlock->previousBlock;
+		(void)free(CURRENT_CONTEXT->currentInternBlock);
+		CURRENT_CONTEXT->currentInternBlock = previousBlock;
+	}
+
+	(void)free(CURRENT_CONTEXT->internSlots);
+	CURRENT_CONTEXT->internSlots = NULL;
+	CURRENT_CONTEXT->internCapacity = 0;
+	CURRENT_CONTEXT->internLoad = 0;
+	return true;
+}
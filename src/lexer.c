@@ -24,9 +24,28 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <stdlib.h>
 #include <ctype.h>
 #include <time.h>
+#include <setjmp.h>
 #include "../headers/modules.h"
 #include "../headers/errors.h"
 #include "../headers/Token.h"
+#include "../headers/internPool.h"
+#include "../headers/tokenIndex.h"
+#include "../headers/lineIndex.h"
+#include "../headers/compilerContext.h"
+#include "../headers/logger.h"
+
+#define true 1
+#define false 0
+
+#define TOKEN_TEXT_BLOCK_SIZE 65536
+#define MINIMUM_TOKEN_CAPACITY 64
+#define LEXER_CHUNKS_PER_THREAD 2
+#define STREAMING_SCAN_STEP 4096
+
+#define KEYWORD_HASH_TABLE_SIZE 128
+#define KEYWORD_HASH_SEED 2166136404u
+#define KEYWORD_HASH_PRIME 16777619u
+#define MAX_KEYWORD_LENGTH 11
 
 /** 
  * The subprogram {@code SPACE/src/lexer.c} was created
@@ -40,8 +59,14 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
  * A token is defined as a token, when an operator is detected, a string starts,
  * a whitespace (-sequence) starts or the EOF is reached.
  * 
- * For ressource friendlyness, the sizes of the tokens are precalculated using the
- * {@code SPACE/main/input.c} module.
+ * The source is only read once. The token array is a growable vector, that doubles
+ * its capacity whenever it is full. The token values are not allocated one by one,
+ * instead they are packed into a pool of large text blocks (see LX_ensure_token_value_size()),
+ * so all values are released with a handful of frees.
+ * 
+ * Large buffers are split into chunks behind newlines outside of strings and
+ * comments, the chunks are lexed in parallel (see LX_lex_chunks()). The streaming
+ * front end lexes the buffer in windows, that are split the same way (see LX_lex_window()).
  * 
  * @see SPACE/main/input.c
  * 
@@ -49,8 +74,78 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
  * @author Lukas Nian En Lampl
 */
 
-void LX_set_token_value_to_awaited_size(TOKEN **tokens, int **tokenLengthsArray);
-void LX_resize_tokens_value(TOKEN *token, size_t oldSize);
+/**
+ * <p>
+ * The state of the split scan at a character (see LX_scan_segment()).
+ * </p>
+ */
+enum LexerScanState {
+	SCAN_CODE,
+	SCAN_STRING,
+	SCAN_CHARACTER_ARRAY,
+	SCAN_BLOCK_COMMENT,
+	SCAN_LINE_COMMENT,
+	SCAN_STATE_COUNT
+};
+
+/**
+ * <p>
+ * A part of the buffer, that is scanned for split points. The results are
+ * stored for every state, the scan could start in.
+ * </p>
+ */
+struct LexerSegment {
+	size_t start;
+	size_t end;
+	enum LexerScanState endStates[SCAN_STATE_COUNT];
+	size_t endPositions[SCAN_STATE_COUNT];
+
+	//Index behind the first newline, at which a chunk can start (0 = none)
+	size_t splits[SCAN_STATE_COUNT];
+};
+
+/**
+ * <p>
+ * A part of the buffer, that is lexed on its own context.
+ * </p>
+ */
+struct LexerChunk {
+	struct CompilerContext context;
+	size_t start;
+	size_t end;
+	size_t tokenCount;
+	size_t lines;
+	int failed;
+};
+
+struct LexerSchedule {
+	struct CompilerContext *context;
+	struct LexerSegment *segments;
+	struct LexerChunk *chunks;
+	size_t count;
+	size_t next;
+	struct CC_Monitor *monitor;
+};
+
+TOKEN* LX_tokenize(int threads);
+size_t LX_lex_range(size_t start, size_t firstToken, size_t *lines);
+size_t LX_lex_chunks(int threads, size_t *lineNumber);
+void LX_scan_segments(void *argument);
+size_t LX_scan_segment(const char *input, size_t position, size_t end, size_t bufferLength, enum LexerScanState *state, size_t *split);
+size_t LX_reconcile_segments(struct LexerSchedule *schedule);
+void LX_lex_chunk_queue(void *argument);
+size_t LX_merge_chunks(struct LexerSchedule *schedule, size_t *lineNumber);
+void LX_free_schedule(struct LexerSchedule *schedule);
+size_t LX_lex_window(size_t *position, size_t *lineNumber, size_t keptTokens);
+size_t LX_find_window_end(size_t start, int *endsInString);
+void LX_release_tokens(size_t count, size_t tokenCount);
+void LX_free_token_text();
+int LX_lex_section(size_t start, size_t end, size_t *lineNumber, size_t *tokenCount);
+
+void LX_reserve_token_array(size_t capacity);
+void LX_ensure_token_capacity(size_t requiredTokens);
+void LX_ensure_token_value_size(TOKEN *token, size_t requiredSize);
+void LX_add_token_text_block(size_t minimumCapacity);
 int LX_eof_token_clearance_check(TOKEN *token, size_t lineNumber);
 int LX_token_clearance_check(TOKEN *token, size_t lineNumber);
 void LX_set_line_number(TOKEN *token, size_t lineNumber);
@@ -67,8 +162,12 @@ void LX_write_double_operator_in_token(TOKEN *token, char currentChar, char next
 void LX_write_default_operator_in_token(TOKEN *token, char currentChar, size_t lineNumber);
 void LX_set_keyword_type_to_token(TOKEN *token);
 TOKENTYPES LX_get_keyword_type(const char *value);
+TOKENTYPES LX_get_keyword_type_linear(const char *value);
+unsigned int LX_hash_keyword(const char *value, unsigned int seed);
+const char *LX_get_keyword_name(int index);
 int LX_check_for_number(TOKEN *token);
 void LX_set_EOF_token(TOKEN *token);
+void LX_intern_token_values(TOKEN *tokens, size_t tokenCount);
 
 int LX_check_for_operator(char input);
 int LX_check_for_double_operator(char currentChar, char nextChar);
@@ -139,47 +238,45 @@ struct kwLookup KEYWORD_LOOKUP[] = {
 
 /**
  * <p>
- * This variable is invoked on the Tokenize() function and is set
- * to the buffer length.
+ * Perfect hash table for the KEYWORD_LOOKUP.
  * </p>
  * 
- * <p><strong>Usage:</strong>
- * This is used to provide a global boundary checking
- * variable and thus preventing out of bounds accesses in parts
- * that access the buffer directly.
- * </p>
- */
-extern size_t BUFFER_LENGTH;
-
-/**
  * <p>
- * This holds the maximum length of the precalculated tokens.
- * </p>
- * 
- * <p><strong>Usage:</strong>
- * Provides a variable, that can be used globally for ensuring
- * that an access into the TOKEN array is not out of bounds.
+ * Every slot holds the index + 1 of the keyword in the KEYWORD_LOOKUP,
+ * 0 marks an empty slot. No two keywords collide under the KEYWORD_HASH_SEED.
+ * The seed and the table are generated by the keywordLookupBenchmark, it
+ * checks them and prints new ones, if a keyword is added or changed.
  * </p>
  */
-extern size_t TOKEN_LENGTH;
-size_t maxTokensLength = 0;
+const unsigned char KEYWORD_HASH_TABLE[KEYWORD_HASH_TABLE_SIZE] = {
+	0, 34, 0, 0, 36, 0, 0, 0, 39, 12, 0, 0, 0, 29, 0, 0,
+	18, 0, 9, 0, 4, 0, 0, 26, 0, 0, 35, 0, 0, 0, 0, 17,
+	0, 0, 31, 0, 0, 0, 10, 0, 20, 37, 0, 0, 0, 0, 0, 0,
+	38, 0, 0, 0, 0, 0, 0, 0, 14, 0, 0, 11, 13, 0, 25, 3,
+	0, 0, 0, 0, 0, 0, 0, 33, 19, 0, 15, 22, 0, 0, 28, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 24, 23, 16, 27, 0,
+	0, 0, 0, 21, 0, 0, 0, 0, 1, 0, 0, 0, 0, 7, 32, 0,
+	0, 0, 2, 0, 0, 0, 8, 0, 5, 30, 0, 0, 0, 0, 0, 6
+};
 
 /**
  * <p>
- * A flag whether the token array is already / was already reserved
- * or not. (Important for freeing memory afterwards)
+ * A block of the token text pool, in which the token values are stored.
  * </p>
- */
-int tokensreserved = 0;
-
-/**
+ * 
  * <p>
- * The future token array.
+ * Every token value is a '\0' terminated span inside of a block. The
+ * blocks are never moved, so the value pointers stay valid till
+ * FREE_TOKENS() is called. Only the last reserved value can grow in place,
+ * all other values are moved to the end of the pool when growing.
  * </p>
  */
-TOKEN *TOKENS = NULL;
-extern char **BUFFER;
-extern char *FILE_NAME;
+struct TokenTextBlock {
+	struct TokenTextBlock *previousBlock;
+	size_t capacity;
+	size_t used;
+	char text[];
+};
 
 /**
  * <p>
@@ -192,29 +289,55 @@ extern char *FILE_NAME;
  * but for identifiying double operators like '++' or '+=' etc. another
  * character is loaded.
  * </p>
+ * <p>
+ * The input is only scanned once, the token array grows on demand.
+ * </p>
  * @returns The final token array with all tokens
  * 
- * @param **arrayOfIndividualTokenSizes     Sizes of the indiviual tokens
+ * @param *context  Compilation with the source buffer, receives the tokens
  */
-TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
-	// TOKEN defined in modules.h
-	TOKENS = (struct TOKEN*)calloc((TOKEN_LENGTH + 2), sizeof(struct TOKEN));
-	maxTokensLength = TOKEN_LENGTH + 1;
-	char **input = BUFFER;
+TOKEN* Tokenize(struct CompilerContext *context) {
+	(void)CC_use_context(context);
+	int threads = LEXER_THREADS > 0 ? LEXER_THREADS : (int)CC_get_processor_count();
+	return LX_tokenize(CURRENT_CONTEXT->bufferLength >= LEXER_PARALLEL_MIN_LENGTH ? threads : 1);
+}
 
-	// When the TOKEN array couldn't be allocated, then throw an IO_BUFFER_RESERVATION_EXCEPTION (errors.h)
-	if (TOKENS == NULL) {
-		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+/**
+ * <p>
+ * Lexes the input like Tokenize(), but splits it into chunks for the
+ * provided number of threads regardless of its size (see LX_lex_chunks()).
+ * </p>
+ * 
+ * @returns The final token array with all tokens, the same as Tokenize() returns
+ * 
+ * @param *context  Compilation with the source buffer, receives the tokens
+ * @param threads   Number of threads, 1 lexes sequentially
+ */
+TOKEN* TokenizeParallel(struct CompilerContext *context, int threads) {
+	(void)CC_use_context(context);
+	return LX_tokenize(threads);
+}
+
+/**
+ * <p>
+ * Lexes the buffer of the CURRENT_CONTEXT and adds the EOF token.
+ * </p>
+ * 
+ * @returns The final token array with all tokens
+ * 
+ * @param threads   Number of threads for the chunks, 1 lexes sequentially
+ */
+TOKEN* LX_tokenize(int threads) {
+	if (CURRENT_CONTEXT->bufferLength > TOKEN_MAX_POSITION) {
+		(void)LEXER_INPUT_TOO_LARGE_EXCEPTION(CURRENT_CONTEXT->bufferLength);
+		return NULL;
 	}
 
-	(void)LX_set_token_value_to_awaited_size(&TOKENS, arrayOfIndividualTokenSizes);
-	tokensreserved = 1;
-	
-	// Set a pointer on the token array to free it, when the program crashes or ends
-	(void)_init_error_token_cache_(&TOKENS);
-	// Set StoragePointer and Index to 0 for new counting
-	size_t storageIndex = 0;
-	size_t storagePointer = 0;
+	//Before the lexing, so the errors of the lexer can use it already
+	(void)LI_build_line_index(CURRENT_CONTEXT->buffer, CURRENT_CONTEXT->bufferLength);
+
+	// Rough guess of the token number, the array doubles if the guess is too small
+	(void)LX_reserve_token_array(CURRENT_CONTEXT->bufferLength / 8 + MINIMUM_TOKEN_CAPACITY);
 
 	// CLOCK FOR DEBUG PURPOSES ONLY!!
 	clock_t start, end;
@@ -224,8 +347,64 @@ TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
 	}
 
 	size_t lineNumber = 0;
+	size_t storagePointer = threads > 1 ? (size_t)LX_lex_chunks(threads, &lineNumber) : (size_t)LX_lex_range(0, 0, &lineNumber);
+
+	/////////////////////////
+	///     EOF TOKEN     ///
+	/////////////////////////
+	(void)LX_ensure_token_capacity(storagePointer + 2);
+	storagePointer += (int)LX_eof_token_clearance_check(&(CURRENT_CONTEXT->tokens[storagePointer]), lineNumber);
+	(void)LX_set_EOF_token(&CURRENT_CONTEXT->tokens[storagePointer]);
+	CURRENT_CONTEXT->tokenLength = storagePointer;
+	(void)LX_intern_token_values(CURRENT_CONTEXT->tokens, CURRENT_CONTEXT->tokenLength + 1);
+	(void)TI_build_token_index(CURRENT_CONTEXT->tokens, CURRENT_CONTEXT->tokenLength + 1);
+	storagePointer--;
+
+	// END CLOCK AND PRINT RESULT
+	if (LEXER_DISPLAY_USED_TIME == 1) {
+		end = (clock_t)clock();
+	}
+
+	if (LG_IS_ENABLED(LOG_LEXER, LOG_DEBUG)) {
+		(void)LX_print_result(CURRENT_CONTEXT->tokens, storagePointer);
+	}
+
+	if (LEXER_DISPLAY_USED_TIME == 1 && LG_IS_ENABLED(LOG_LEXER, LOG_INFO)) {
+		(void)LG_write("Finished with %li tokens and %li lines in total.\n", storagePointer + 1, lineNumber + 1);
+		(void)LX_print_cpu_time(((double) (end - start)) / CLOCKS_PER_SEC);
+	}
+
+	return CURRENT_CONTEXT->tokens;
+}
+
+/**
+ * <p>
+ * Lexes the buffer of the CURRENT_CONTEXT from the start index up to the
+ * bufferLength into the tokens of the context.
+ * </p>
+ * 
+ * <p>
+ * The token starts are indices in the whole buffer. The start has to be 0
+ * or the index behind a newline, that ends a token (see LX_scan_segment()).
+ * The tokens are written from the first token on, the tokens before it
+ * are kept (see LX_lex_window()).
+ * </p>
+ * 
+ * @returns The index of the token after the last closed token, it holds the
+ * unclosed token at the end of the buffer, if there is one
+ * 
+ * @param start         Index of the first character to lex
+ * @param firstToken    Index of the first token to write, it has to be empty
+ * @param *lines        Line counter, increased by the lexed lines
+ */
+size_t LX_lex_range(size_t start, size_t firstToken, size_t *lines) {
+	char **input = &CURRENT_CONTEXT->buffer;
+	// Set StoragePointer and Index to 0 for new counting
+	size_t storageIndex = 0;
+	size_t storagePointer = firstToken;
+	size_t lineNumber = (*lines);
 
-	for (size_t i = 0; i < BUFFER_LENGTH; i++) {
+	for (size_t i = start; i < CURRENT_CONTEXT->bufferLength; i++) {
 		// When the input character at index i is a hashtag, then skip the input till the next hashtag
 		if ((*input)[i] == '/'
 			&& ((*input)[i + 1] == '/' || (*input)[i + 1] == '*')) {
@@ -233,16 +412,11 @@ TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
 			continue;
 		}
 
-		if (storagePointer > maxTokensLength) {
-			(void)LEXER_NULL_TOKEN_EXCEPTION();
-		}
+		// A single character can close the current token and fill the next one
+		(void)LX_ensure_token_capacity(storagePointer + 2);
 
-		// Check if the Size is bigger than the expected, if true, then increase the size of the token value
-		if (storageIndex > TOKENS[storagePointer].size) {
-			(void)LX_set_keyword_type_to_token(&TOKENS[storagePointer]);
-			(void)LX_resize_tokens_value(&TOKENS[storagePointer], TOKENS[storagePointer].size);
-		} else if (storageIndex == 0) {
-			TOKENS[storagePointer].tokenStart = i;
+		if (storageIndex == 0) {
+			CURRENT_CONTEXT->tokens[storagePointer].tokenStart = (unsigned int)i;
 		}
 
 		// Checks if input is a whitespace (if isspace() returns a non-zero number the integer is set to 1 else to 0)
@@ -250,29 +424,29 @@ TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
 		int isOperator = isWhiteSpace != 1 ? (int)check_for_operator((*input)[i]) : 0; //Checks if input at i is an operator from above
 		// Check if the input character at index i is the beginning of an string or character array
 		if ((*input)[i] == '"' || (*input)[i] == '\'') {
-			storagePointer += (int)LX_token_clearance_check(&TOKENS[storagePointer], lineNumber);
-			i += (int)LX_write_string_in_token(&TOKENS[storagePointer], input, i, (*input)[i], &lineNumber);
-			(void)LX_set_line_number(&TOKENS[storagePointer], lineNumber);
+			storagePointer += (int)LX_token_clearance_check(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber);
+			i += (int)LX_write_string_in_token(&CURRENT_CONTEXT->tokens[storagePointer], input, i, (*input)[i], &lineNumber);
+			(void)LX_set_line_number(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber);
 			storagePointer++;
 			storageIndex = 0;
 			continue;
 		}
 
-		if (i + 1 >= BUFFER_LENGTH) {
-			(void)LX_set_keyword_type_to_token(&TOKENS[storagePointer]);
-			(void)LX_set_line_number(&TOKENS[storagePointer], lineNumber);
+		if (i + 1 >= CURRENT_CONTEXT->bufferLength) {
+			(void)LX_set_keyword_type_to_token(&CURRENT_CONTEXT->tokens[storagePointer]);
+			(void)LX_set_line_number(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber);
 		}
 
 		// If the input character at index i is a whitespace, then filter the whitespace character
 		if (isWhiteSpace > 0) {
-			(void)LX_set_keyword_type_to_token(&TOKENS[storagePointer]);
+			(void)LX_set_keyword_type_to_token(&CURRENT_CONTEXT->tokens[storagePointer]);
 
 			// If the current token is already filled or not, if then add "\0" to close the string  
-			if ((int)LX_token_clearance_check(&TOKENS[storagePointer], lineNumber)) { 
-				if (TOKENS[storagePointer].size > storageIndex) {
-					TOKENS[storagePointer].value[storageIndex] = '\0';
+			if ((int)LX_token_clearance_check(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber)) { 
+				if (CURRENT_CONTEXT->tokens[storagePointer].size > storageIndex) {
+					CURRENT_CONTEXT->tokens[storagePointer].value[storageIndex] = '\0';
 				} else {
-					TOKENS[storagePointer].value[storageIndex - 1] = '\0';
+					CURRENT_CONTEXT->tokens[storagePointer].value[storageIndex - 1] = '\0';
 				}
 
 				storagePointer++;
@@ -286,120 +460,673 @@ TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
 		// Execute if input at i is an operator
 		if (isOperator) {
 			// Check if the TOKEN could be a FLOAT or not
-			if ((*input)[i] == '.' 
+			if ((*input)[i] == '.' && i > 0
 				&& ((int)is_digit((*input)[i - 1])
 				&& (int)is_digit((*input)[i + 1]))) {
-				(void)LX_put_type_float_in_token(&TOKENS[storagePointer], storageIndex);
+				(void)LX_put_type_float_in_token(&CURRENT_CONTEXT->tokens[storagePointer], storageIndex);
 				storageIndex++;
 				continue;
 			} else if ((*input)[i] == '*') {
 				if ((int)is_space((*input)[i + 1]) == 0
 					&& (int)is_digit((*input)[i + 1]) == 0
 					&& (*input)[i + 1] != '=') {
-					int ptrRet = (int)LX_write_pointer_in_token(&TOKENS[storagePointer], input, i);
+					int ptrRet = (int)LX_write_pointer_in_token(&CURRENT_CONTEXT->tokens[storagePointer], input, i);
 
 					if (ptrRet > 0) {
 						i += ptrRet - 1;
 						storageIndex = ptrRet - 1;
-						(void)LX_set_line_number(&TOKENS[storagePointer], lineNumber);
+						(void)LX_set_line_number(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber);
 						storageIndex++;
 					}
 
 					continue;
 				}
 			} else if ((*input)[i] == '-' && (int)is_digit((*input)[i + 1]) == 1) {
-				storagePointer += (int)LX_token_clearance_check(&TOKENS[storagePointer], lineNumber);
+				storagePointer += (int)LX_token_clearance_check(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber);
 				storageIndex = 0;
-				TOKENS[storagePointer].value[storageIndex++] = (*input)[i];
-				TOKENS[storagePointer].type = _NUMBER_;
+				(void)LX_ensure_token_value_size(&CURRENT_CONTEXT->tokens[storagePointer], storageIndex + 2);
+				CURRENT_CONTEXT->tokens[storagePointer].value[storageIndex++] = (*input)[i];
+				CURRENT_CONTEXT->tokens[storagePointer].type = _NUMBER_;
 				continue;
 			}
 
 			// Check if the current token is used or not, and if it increases storagePointer by 1
-			(void)LX_set_keyword_type_to_token(&TOKENS[storagePointer]);
-			storagePointer += (int)LX_token_clearance_check(&TOKENS[storagePointer], lineNumber); 
+			(void)LX_set_keyword_type_to_token(&CURRENT_CONTEXT->tokens[storagePointer]);
+			storagePointer += (int)LX_token_clearance_check(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber); 
 			// Check whether the input could be an ELEMENT ACCESSOR or not
 			if (((*input)[i] == '-' || (*input)[i] == '=') && (*input)[i + 1] == '>') {
-				(void)LX_write_class_accessor_or_creator_in_token(&TOKENS[storagePointer], (*input)[i], lineNumber);
-				TOKENS[storagePointer].tokenStart = i;
+				(void)LX_write_class_accessor_or_creator_in_token(&CURRENT_CONTEXT->tokens[storagePointer], (*input)[i], lineNumber);
+				CURRENT_CONTEXT->tokens[storagePointer].tokenStart = (unsigned int)i;
 				storagePointer++;
 				storageIndex = 0;
 				i++;
 				continue;
 			} else if ((*input)[i] == '&') {
 				if ((*input)[i + 1] == '(' && (*input)[i + 2] == '*') {
-					i += (int)LX_is_reference_on_pointer(&TOKENS[storagePointer], input, i);
-					(void)LX_set_line_number(&TOKENS[storagePointer], lineNumber);
-					TOKENS[storagePointer].tokenStart = i;
+					i += (int)LX_is_reference_on_pointer(&CURRENT_CONTEXT->tokens[storagePointer], input, i);
+					(void)LX_set_line_number(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber);
+					CURRENT_CONTEXT->tokens[storagePointer].tokenStart = (unsigned int)i;
 					storageIndex = 0;
 					storagePointer++;
 					continue;
 				} else {
-					(void)LX_write_reference_in_token(&TOKENS[storagePointer]);
-					(void)LX_set_line_number(&TOKENS[storagePointer], lineNumber);
-					TOKENS[storagePointer].tokenStart = i;
+					(void)LX_write_reference_in_token(&CURRENT_CONTEXT->tokens[storagePointer]);
+					(void)LX_set_line_number(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber);
+					CURRENT_CONTEXT->tokens[storagePointer].tokenStart = (unsigned int)i;
 					storageIndex++;
 					continue;
 				}
 
 			// Figure out whether the input is a double operator like "++" or "--" or not
 			} else if ((int)LX_check_for_double_operator((*input)[i], (*input)[i + 1])) {
-				TOKENS[storagePointer].tokenStart = i;
-				(void)LX_write_double_operator_in_token(&TOKENS[storagePointer], (*input)[i], (*input)[i + 1]);
-				(void)LX_set_line_number(&TOKENS[storagePointer], lineNumber);
-				TOKENS[storagePointer].tokenStart = ++i;
+				CURRENT_CONTEXT->tokens[storagePointer].tokenStart = (unsigned int)i;
+				(void)LX_write_double_operator_in_token(&CURRENT_CONTEXT->tokens[storagePointer], (*input)[i], (*input)[i + 1]);
+				(void)LX_set_line_number(&CURRENT_CONTEXT->tokens[storagePointer], lineNumber);
+				CURRENT_CONTEXT->tokens[storagePointer].tokenStart = (unsigned int)++i;
 				storagePointer++;
 				storageIndex = 0;
 				continue;
 			}
 			//If non if the above is approved, the input gets processed as a 'normal' Operator
-			TOKENS[storagePointer].tokenStart = i;
-			(void)LX_write_default_operator_in_token(&TOKENS[storagePointer], (*input)[i], lineNumber);
+			CURRENT_CONTEXT->tokens[storagePointer].tokenStart = (unsigned int)i;
+			(void)LX_write_default_operator_in_token(&CURRENT_CONTEXT->tokens[storagePointer], (*input)[i], lineNumber);
 			storagePointer++;
 			storageIndex = 0;
 			continue;
 		} else {
-			TOKEN *token = &TOKENS[storagePointer];
-
-			if (token->size > storageIndex + 1) {
-				// Sets the rest as IDENTIFIER. Adding the current input to the current token value
-				token->value[storageIndex++] = (*input)[i];
-				token->line = lineNumber;
-				(void)LX_check_for_number(token);
-
-				if (token->type != _FLOAT_
-					&& token->type != _NUMBER_
-					&& token->type != _REFERENCE_
-					&& token->type != _POINTER_) {
-					token->type = _IDENTIFIER_;
+			TOKEN *token = &CURRENT_CONTEXT->tokens[storagePointer];
+			// Take the whole run of letters, digits and '_' at once, the last character of the buffer is left for the EOF handling above
+			size_t runLength = CURRENT_CONTEXT->bufferLength - 1 > i ? (size_t)skip_identifier_run(*input, i, CURRENT_CONTEXT->bufferLength - 1) - i : 0;
+			runLength = runLength == 0 ? 1 : runLength;
+			(void)LX_ensure_token_value_size(token, storageIndex + runLength + 1);
+
+			// Sets the rest as IDENTIFIER. Adding the current input to the current token value
+			(void)memcpy(&token->value[storageIndex], &(*input)[i], sizeof(char) * runLength);
+			storageIndex += runLength;
+			i += runLength - 1;
+			token->line = (unsigned int)lineNumber;
+			(void)LX_check_for_number(token);
+
+			if (token->type != _FLOAT_
+				&& token->type != _NUMBER_
+				&& token->type != _REFERENCE_
+				&& token->type != _POINTER_) {
+				token->type = _IDENTIFIER_;
+			}
+		}
+	}
+
+	(*lines) = lineNumber;
+	return storagePointer;
+}
+
+/**
+ * <p>
+ * Lexes the buffer in chunks on the provided number of threads and
+ * concatenates the tokens of the chunks.
+ * </p>
+ * 
+ * <p>
+ * The buffer is split into segments. The segments are scanned in parallel
+ * for every state the lexer could be in at the start of a segment (see
+ * LX_scan_segment()), afterwards the real states are reconciled from the
+ * first segment on. A chunk starts behind the first newline of a segment,
+ * that ends a token outside of strings and comments, so every chunk is
+ * lexed like in the sequential lexer. The chunk contexts share the buffer,
+ * the line numbers of a chunk are moved by the lines before the chunk.
+ * </p>
+ * 
+ * <p>
+ * An unfinished string and a buffer without a split point are lexed
+ * sequentially, an error in a chunk is thrown again on the calling thread.
+ * </p>
+ * 
+ * @returns The index of the token after the last closed token (see LX_lex_range())
+ * 
+ * @param threads       Number of threads
+ * @param *lineNumber   Line counter, set to the lexed lines
+ */
+size_t LX_lex_chunks(int threads, size_t *lineNumber) {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+	struct LexerSchedule schedule;
+	(void)memset(&schedule, 0, sizeof(struct LexerSchedule));
+	schedule.context = context;
+	schedule.count = (size_t)threads * LEXER_CHUNKS_PER_THREAD;
+	schedule.segments = (struct LexerSegment*)calloc(schedule.count, sizeof(struct LexerSegment));
+	schedule.chunks = (struct LexerChunk*)calloc(schedule.count, sizeof(struct LexerChunk));
+	schedule.monitor = CC_create_monitor();
+
+	if (schedule.segments == NULL || schedule.chunks == NULL || schedule.monitor == NULL
+		|| context->bufferLength < schedule.count * 2) {
+		(void)LX_free_schedule(&schedule);
+		return LX_lex_range(0, 0, lineNumber);
+	}
+
+	for (size_t i = 0; i < schedule.count; i++) {
+		schedule.segments[i].start = context->bufferLength / schedule.count * i;
+		schedule.segments[i].end = i + 1 < schedule.count ? context->bufferLength / schedule.count * (i + 1) : context->bufferLength;
+	}
+
+	(void)CC_run_parallel(threads, LX_scan_segments, &schedule);
+	size_t chunkCount = (size_t)LX_reconcile_segments(&schedule);
+
+	if (chunkCount < 2) {
+		(void)LX_free_schedule(&schedule);
+		return LX_lex_range(0, 0, lineNumber);
+	}
+
+	schedule.count = chunkCount;
+	schedule.next = 0;
+	(void)CC_run_parallel(threads > (int)chunkCount ? (int)chunkCount : threads, LX_lex_chunk_queue, &schedule);
+	(void)CC_use_context(context);
+
+	//The first failed chunk in source order is thrown, its line is moved by the lines of the chunks before
+	size_t lines = 0;
+
+	for (size_t i = 0; i < chunkCount; i++) {
+		if (schedule.chunks[i].failed == true) {
+			char message[256];
+			struct CompilerContext *chunkContext = &schedule.chunks[i].context;
+			struct Diagnostic *fatal = chunkContext->diagnosticCount > 0 ? &chunkContext->diagnostics[chunkContext->diagnosticCount - 1] : NULL;
+			size_t line = fatal != NULL && fatal->line > 0 ? fatal->line + lines : 0;
+			(void)snprintf(message, sizeof(message), "%s", fatal != NULL ? fatal->message : "Lexing failed.");
+			(void)LX_free_schedule(&schedule);
+			(void)TERMINATE_COMPILATION(message, line);
+			return 0;
+		}
+
+		lines += schedule.chunks[i].lines;
+	}
+
+	size_t storagePointer = (size_t)LX_merge_chunks(&schedule, lineNumber);
+	(void)LX_free_schedule(&schedule);
+	return storagePointer;
+}
+
+/**
+ * <p>
+ * Worker of the split scan: scans the next segment for every state at its
+ * start, until all segments are scanned.
+ * </p>
+ * 
+ * @param *argument     The LexerSchedule
+ */
+void LX_scan_segments(void *argument) {
+	struct LexerSchedule *schedule = (struct LexerSchedule*)argument;
+	const char *input = schedule->context->buffer;
+	size_t bufferLength = schedule->context->bufferLength;
+
+	while (true) {
+		(void)CC_enter_monitor(schedule->monitor);
+		size_t index = schedule->next < schedule->count ? schedule->next++ : schedule->count;
+		(void)CC_leave_monitor(schedule->monitor);
+
+		if (index == schedule->count) {
+			return;
+		}
+
+		struct LexerSegment *segment = &schedule->segments[index];
+
+		//The first segment starts in code
+		for (int state = 0; state < (index == 0 ? 1 : SCAN_STATE_COUNT); state++) {
+			segment->endStates[state] = (enum LexerScanState)state;
+			segment->splits[state] = 0;
+			segment->endPositions[state] = (size_t)LX_scan_segment(input, segment->start, segment->end, bufferLength, &segment->endStates[state], &segment->splits[state]);
+		}
+	}
+}
+
+/**
+ * <p>
+ * Scans the input from the position to the end of a segment and follows
+ * the strings and comments like the lexer does.
+ * </p>
+ * 
+ * <p>
+ * A split point is the index behind a newline in code, that is not the end
+ * of a line comment. The lexer closes the current token at such a newline
+ * (a comment does not close it), so a chunk can start there.
+ * </p>
+ * 
+ * @returns The index, at which the scan stopped (the end or behind it)
+ * 
+ * @param *input        Source buffer
+ * @param position      Index to start at
+ * @param end           End of the segment (exclusive)
+ * @param bufferLength  Length of the buffer
+ * @param *state        State at the position, set to the state at the end
+ * @param *split        Set to the first split point of the segment, if it was 0
+ */
+size_t LX_scan_segment(const char *input, size_t position, size_t end, size_t bufferLength, enum LexerScanState *state, size_t *split) {
+	while (position < end) {
+		char current = input[position];
+
+		switch (*state) {
+		case SCAN_CODE:
+			if (current == '/' && (input[position + 1] == '/' || input[position + 1] == '*')) {
+				//The '*' can already be the start of the "*/"
+				(*state) = input[position + 1] == '/' ? SCAN_LINE_COMMENT : SCAN_BLOCK_COMMENT;
+			} else if (current == '"' || current == '\'') {
+				(*state) = current == '"' ? SCAN_STRING : SCAN_CHARACTER_ARRAY;
+			} else if (current == '&' && input[position + 1] == '(' && input[position + 2] == '*') {
+				//"&(*ptr)" is taken as a whole (see LX_is_reference_on_pointer())
+				size_t referenceEnd = position + 1;
+
+				while (referenceEnd < bufferLength && input[referenceEnd] != ')' && (int)is_space(input[referenceEnd]) == 0) {
+					referenceEnd++;
 				}
+
+				position = referenceEnd < bufferLength && input[referenceEnd] == ')' ? referenceEnd : position;
+			} else if (current == '\n' && (*split) == 0) {
+				(*split) = position + 1;
 			}
+
+			position++;
+			break;
+		case SCAN_STRING:
+		case SCAN_CHARACTER_ARRAY: {
+			const char *quote = (const char*)memchr(&input[position], (*state) == SCAN_STRING ? '"' : '\'', end - position);
+			position = quote != NULL ? (size_t)(quote - input) + 1 : end;
+			(*state) = quote != NULL ? SCAN_CODE : (*state);
+			break;
+		}
+		case SCAN_BLOCK_COMMENT: {
+			size_t newlines = 0;
+			size_t commentEnd = (size_t)find_block_comment_end(input, position, end, &newlines);
+			position = commentEnd < end ? commentEnd + 2 : end;
+			(*state) = commentEnd < end ? SCAN_CODE : (*state);
+			break;
+		}
+		case SCAN_LINE_COMMENT: {
+			size_t lineEnd = (size_t)find_line_end(input, position, end);
+			position = lineEnd < end ? lineEnd + 1 : end;
+			(*state) = lineEnd < end ? SCAN_CODE : (*state);
+			break;
+		}
+		default:
+			return end;
 		}
 	}
-	
-	/////////////////////////
-	///     EOF TOKEN     ///
-	/////////////////////////
-	storagePointer += (int)LX_eof_token_clearance_check(&(TOKENS[storagePointer]), lineNumber);
-	(void)LX_set_EOF_token(&TOKENS[storagePointer]);
-	maxTokensLength = storagePointer > maxTokensLength ? storagePointer : maxTokensLength;
-	storagePointer--;
 
-	// END CLOCK AND PRINT RESULT
-	if (LEXER_DISPLAY_USED_TIME == 1) {
-		end = (clock_t)clock();
+	return position;
+}
+
+/**
+ * <p>
+ * Follows the states through the scanned segments and sets the chunks
+ * to the split points.
+ * </p>
+ * 
+ * <p>
+ * If the scan of the previous segment stopped behind the start of a
+ * segment (e.g. at a "*&#47;" on the border), the segment is scanned again
+ * from there.
+ * </p>
+ * 
+ * @returns The number of chunks, 0 if the buffer ends in a string
+ * 
+ * @param *schedule     Schedule with the scanned segments
+ */
+size_t LX_reconcile_segments(struct LexerSchedule *schedule) {
+	const char *input = CURRENT_CONTEXT->buffer;
+	size_t bufferLength = CURRENT_CONTEXT->bufferLength;
+	enum LexerScanState state = SCAN_CODE;
+	size_t position = 0;
+	size_t chunkCount = 1;
+	schedule->chunks[0].start = 0;
+
+	for (size_t i = 0; i < schedule->count; i++) {
+		struct LexerSegment *segment = &schedule->segments[i];
+		size_t split = 0;
+
+		if (position > segment->start) {
+			position = (size_t)LX_scan_segment(input, position, segment->end, bufferLength, &state, &split);
+		} else {
+			split = segment->splits[state];
+			position = segment->endPositions[state];
+			state = segment->endStates[state];
+		}
+
+		//The first chunk starts at 0, every other at the first split point of its segment
+		if (i > 0 && split > schedule->chunks[chunkCount - 1].start && split < bufferLength) {
+			schedule->chunks[chunkCount - 1].end = split;
+			schedule->chunks[chunkCount++].start = split;
+		}
 	}
 
-	if (LEXER_DEBUG_MODE == 1) {
-		(void)LX_print_result(TOKENS, storagePointer);
+	//The sequential lexer reports the unfinished string
+	if (state == SCAN_STRING || state == SCAN_CHARACTER_ARRAY) {
+		return 0;
 	}
 
-	if (LEXER_DISPLAY_USED_TIME == 1) {
-		(void)printf("Finished with %li tokens and %li lines in total.\n", storagePointer + 1, lineNumber + 1);
-		(void)LX_print_cpu_time(((double) (end - start)) / CLOCKS_PER_SEC);
+	schedule->chunks[chunkCount - 1].end = bufferLength;
+	return chunkCount;
+}
+
+/**
+ * <p>
+ * Worker of the chunks: lexes the next chunk in its own context, until
+ * all chunks are lexed.
+ * </p>
+ * 
+ * <p>
+ * The context shares the buffer, but has its own tokens and token text
+ * blocks. A fatal error jumps back to the worker and marks the chunk.
+ * </p>
+ * 
+ * @param *argument     The LexerSchedule
+ */
+void LX_lex_chunk_queue(void *argument) {
+	struct LexerSchedule *schedule = (struct LexerSchedule*)argument;
+	struct CompilerContext *previousContext = CURRENT_CONTEXT;
+
+	while (true) {
+		(void)CC_enter_monitor(schedule->monitor);
+		size_t index = schedule->next < schedule->count ? schedule->next++ : schedule->count;
+		(void)CC_leave_monitor(schedule->monitor);
+
+		if (index == schedule->count) {
+			return;
+		}
+
+		struct LexerChunk *chunk = &schedule->chunks[index];
+		jmp_buf recoveryPoint;
+		chunk->context = *schedule->context;
+		chunk->context.bufferLength = chunk->end;
+		chunk->context.tokens = NULL;
+		chunk->context.tokensCapacity = 0;
+		chunk->context.currentTextBlock = NULL;
+		chunk->context.diagnostics = NULL;
+		chunk->context.diagnosticCount = 0;
+		chunk->context.diagnosticCapacity = 0;
+		chunk->context.recoveryPoint = &recoveryPoint;
+		(void)CC_use_context(&chunk->context);
+
+		if (setjmp(recoveryPoint) == 0) {
+			(void)LX_reserve_token_array((chunk->end - chunk->start) / 8 + MINIMUM_TOKEN_CAPACITY);
+			chunk->tokenCount = (size_t)LX_lex_range(chunk->start, 0, &chunk->lines);
+		} else {
+			chunk->failed = true;
+		}
+
+		chunk->context.recoveryPoint = NULL;
+		(void)CC_use_context(previousContext);
+	}
+}
+
+/**
+ * <p>
+ * Copies the tokens of the chunks in order into the CURRENT_CONTEXT and
+ * moves their line numbers by the lines of the chunks before. The text
+ * blocks of the chunks are added to the token text pool of the context.
+ * </p>
+ * 
+ * @returns The index of the token after the last closed token
+ * 
+ * @param *schedule     Schedule with the lexed chunks
+ * @param *lineNumber   Set to the lines of all chunks
+ */
+size_t LX_merge_chunks(struct LexerSchedule *schedule, size_t *lineNumber) {
+	size_t tokenCount = 0;
+
+	for (size_t i = 0; i < schedule->count; i++) {
+		tokenCount += schedule->chunks[i].tokenCount;
 	}
 
-	return TOKENS;
+	//The last chunk can end with an unclosed token
+	(void)LX_ensure_token_capacity(tokenCount + 2);
+	size_t storagePointer = 0;
+	size_t lines = 0;
+
+	for (size_t i = 0; i < schedule->count; i++) {
+		struct LexerChunk *chunk = &schedule->chunks[i];
+		size_t copiedTokens = i + 1 < schedule->count ? chunk->tokenCount : chunk->tokenCount + 1;
+
+		for (size_t n = 0; n < copiedTokens; n++) {
+			CURRENT_CONTEXT->tokens[storagePointer + n] = chunk->context.tokens[n];
+			CURRENT_CONTEXT->tokens[storagePointer + n].line += (unsigned int)lines;
+		}
+
+		struct TokenTextBlock *oldestBlock = chunk->context.currentTextBlock;
+
+		while (oldestBlock != NULL && oldestBlock->previousBlock != NULL) {
+			oldestBlock = oldestBlock->previousBlock;
+		}
+
+		if (oldestBlock != NULL) {
+			oldestBlock->previousBlock = CURRENT_CONTEXT->currentTextBlock;
+			CURRENT_CONTEXT->currentTextBlock = chunk->context.currentTextBlock;
+			chunk->context.currentTextBlock = NULL;
+		}
+
+		storagePointer += chunk->tokenCount;
+		lines += chunk->lines;
+	}
+
+	(*lineNumber) = lines;
+	return storagePointer;
+}
+
+/**
+ * <p>
+ * Frees the segments, the chunks with their remaining tokens and the
+ * monitor of a schedule.
+ * </p>
+ * 
+ * @param *schedule     Schedule to free
+ */
+void LX_free_schedule(struct LexerSchedule *schedule) {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+
+	for (size_t i = 0; schedule->chunks != NULL && i < schedule->count; i++) {
+		struct CompilerContext *chunkContext = &schedule->chunks[i].context;
+		(void)CC_use_context(chunkContext);
+		(void)FREE_TOKENS(chunkContext->tokens);
+
+		for (size_t n = 0; n < chunkContext->diagnosticCount; n++) {
+			(void)free(chunkContext->diagnostics[n].message);
+			(void)free(chunkContext->diagnostics[n].rendered);
+		}
+
+		(void)free(chunkContext->diagnostics);
+	}
+
+	(void)CC_use_context(context);
+	(void)free(schedule->segments);
+	(void)free(schedule->chunks);
+
+	if (schedule->monitor != NULL) {
+		(void)CC_free_monitor(schedule->monitor);
+	}
+}
+
+/**
+ * <p>
+ * Lexes the next window of the buffer for the streaming front end (see
+ * CheckStreamAndGenerateParsetree()).
+ * </p>
+ * 
+ * <p>
+ * A window holds at least STREAMING_WINDOW_LENGTH characters and ends at
+ * a split point like a chunk (see LX_scan_segment()), so no token crosses
+ * two windows. The new tokens are written behind the kept tokens of the
+ * previous window, they keep their absolute positions and line numbers.
+ * The values of the new tokens are interned, so the token text blocks
+ * are released right away. The last window adds the EOF token.
+ * </p>
+ * 
+ * @returns The number of tokens in the array (without the EOF token)
+ * 
+ * @param *position     Start of the window, set to the start of the next window
+ * @param *lineNumber   Line counter, increased by the lexed lines
+ * @param keptTokens    Number of tokens, that are kept at the start of the array
+ */
+size_t LX_lex_window(size_t *position, size_t *lineNumber, size_t keptTokens) {
+	if ((*position) == 0) {
+		if (CURRENT_CONTEXT->bufferLength > TOKEN_MAX_POSITION) {
+			(void)LEXER_INPUT_TOO_LARGE_EXCEPTION(CURRENT_CONTEXT->bufferLength);
+			return 0;
+		}
+
+		(void)LI_build_line_index(CURRENT_CONTEXT->buffer, CURRENT_CONTEXT->bufferLength);
+		(void)LX_reserve_token_array(STREAMING_WINDOW_LENGTH / 8 + MINIMUM_TOKEN_CAPACITY);
+	}
+
+	size_t bufferLength = CURRENT_CONTEXT->bufferLength;
+	int endsInString = false;
+	size_t end = (size_t)LX_find_window_end(*position, &endsInString);
+
+	//Without the windows the lexer would report the unfinished string before the syntax errors are found
+	if (endsInString == true) {
+		(void)CC_clear_diagnostics(CURRENT_CONTEXT);
+	}
+
+	CURRENT_CONTEXT->bufferLength = end;
+	size_t storagePointer = (size_t)LX_lex_range(*position, keptTokens, lineNumber);
+	CURRENT_CONTEXT->bufferLength = bufferLength;
+	(*position) = end;
+	(void)LX_ensure_token_capacity(storagePointer + 2);
+
+	if (end < bufferLength) {
+		(void)LX_intern_token_values(&CURRENT_CONTEXT->tokens[keptTokens], storagePointer - keptTokens);
+
+		//The window ends at a newline, so the next token is still empty
+		(void)memset(&CURRENT_CONTEXT->tokens[storagePointer], 0, sizeof(TOKEN));
+		(void)LX_free_token_text();
+		CURRENT_CONTEXT->tokenLength = storagePointer;
+		return storagePointer;
+	}
+
+	storagePointer += (int)LX_eof_token_clearance_check(&(CURRENT_CONTEXT->tokens[storagePointer]), *lineNumber);
+	(void)LX_set_EOF_token(&CURRENT_CONTEXT->tokens[storagePointer]);
+	(void)LX_intern_token_values(&CURRENT_CONTEXT->tokens[keptTokens], storagePointer - keptTokens + 1);
+	CURRENT_CONTEXT->tokenLength = storagePointer;
+	return storagePointer;
+}
+
+/**
+ * <p>
+ * Finds the end of the window, that starts at the provided index.
+ * </p>
+ * 
+ * <p>
+ * The strings and comments are followed up to the minimum length of the
+ * window, after that the scan goes on in small steps till the next split
+ * point. The last window is scanned to the end, so an unfinished string
+ * is known before the window is lexed.
+ * </p>
+ * 
+ * @returns The first split point behind the minimum length, the buffer length if there is none
+ * 
+ * @param start             Start of the window, it has to be 0 or a split point
+ * @param *endsInString     Set to true, if the buffer ends in a string (only for the last window)
+ */
+size_t LX_find_window_end(size_t start, int *endsInString) {
+	const char *input = CURRENT_CONTEXT->buffer;
+	size_t bufferLength = CURRENT_CONTEXT->bufferLength;
+	enum LexerScanState state = SCAN_CODE;
+	size_t split = 0;
+	size_t position = (size_t)LX_scan_segment(input, start, bufferLength - start > STREAMING_WINDOW_LENGTH
+		? start + STREAMING_WINDOW_LENGTH : bufferLength, bufferLength, &state, &split);
+
+	while (position < bufferLength) {
+		size_t stepEnd = bufferLength - position > STREAMING_SCAN_STEP ? position + STREAMING_SCAN_STEP : bufferLength;
+		split = 0;
+		position = (size_t)LX_scan_segment(input, position, stepEnd, bufferLength, &state, &split);
+
+		if (split != 0 && split < bufferLength) {
+			return split;
+		}
+	}
+
+	(*endsInString) = state == SCAN_STRING || state == SCAN_CHARACTER_ARRAY;
+	return bufferLength;
+}
+
+/**
+ * <p>
+ * Releases the first tokens of the array, the remaining tokens are moved
+ * to the start and the free entries are set to 0 again.
+ * </p>
+ * 
+ * @param count         Number of tokens to release
+ * @param tokenCount    Number of tokens in the array
+ */
+void LX_release_tokens(size_t count, size_t tokenCount) {
+	size_t keptTokens = tokenCount - count;
+	(void)memmove(CURRENT_CONTEXT->tokens, &CURRENT_CONTEXT->tokens[count], sizeof(TOKEN) * keptTokens);
+	(void)memset(&CURRENT_CONTEXT->tokens[keptTokens], 0, sizeof(TOKEN) * (count + 1));
+	CURRENT_CONTEXT->tokenLength = keptTokens;
+	CURRENT_CONTEXT->releasedTokens += count;
+}
+
+/**
+ * <p>
+ * Frees the token text blocks, the values of the tokens have to be
+ * interned already.
+ * </p>
+ */
+void LX_free_token_text() {
+	while (CURRENT_CONTEXT->currentTextBlock != NULL) {
+		struct TokenTextBlock *previousBlock = CURRENT_CONTEXT->currentTextBlock->previousBlock;
+		(void)free(CURRENT_CONTEXT->currentTextBlock);
+		CURRENT_CONTEXT->currentTextBlock = previousBlock;
+	}
+}
+
+/**
+ * <p>
+ * Lexes a section of the edited buffer for the compile server (see
+ * CheckEditAndUpdateParsetree()).
+ * </p>
+ * 
+ * <p>
+ * The section starts at the first character of a main statement and ends
+ * at the first character of a later one. Its tokens are written from the
+ * start of the array and keep their positions in the whole buffer. Behind
+ * them follow the keyword at the end of the section and the EOF token, so
+ * the syntax analyzer sees the start of the next statement like in the
+ * whole token stream. A section up to the end of the buffer ends with the
+ * EOF token only.
+ * </p>
+ * 
+ * @returns false, if the end of the section is in a string or comment
+ * 
+ * @param start         Index of the first character of the section
+ * @param end           Index of the first character of the next statement, the buffer length for the last one
+ * @param *lineNumber   Line at the start, set to the line at the end of the section
+ * @param *tokenCount   Set to the number of tokens in the section
+ */
+int LX_lex_section(size_t start, size_t end, size_t *lineNumber, size_t *tokenCount) {
+	size_t bufferLength = CURRENT_CONTEXT->bufferLength;
+	enum LexerScanState state = SCAN_CODE;
+	size_t split = 0;
+
+	if ((size_t)LX_scan_segment(CURRENT_CONTEXT->buffer, start, end, bufferLength, &state, &split) != end || state != SCAN_CODE) {
+		return false;
+	}
+
+	(void)LX_reserve_token_array((end - start) / 8 + MINIMUM_TOKEN_CAPACITY);
+
+	//The keyword is lexed in the same range, a line comment right before it ends with a newline inside the range
+	CURRENT_CONTEXT->bufferLength = end < bufferLength ? (size_t)skip_identifier_run(CURRENT_CONTEXT->buffer, end, bufferLength) : end;
+	size_t storagePointer = (size_t)LX_lex_range(start, 0, lineNumber);
+	CURRENT_CONTEXT->bufferLength = bufferLength;
+	(*tokenCount) = storagePointer;
+
+	//The keyword is the last token of the range, so its type is set here
+	if (end < bufferLength) {
+		(void)LX_set_keyword_type_to_token(&CURRENT_CONTEXT->tokens[storagePointer]);
+	}
+
+	(void)LX_ensure_token_capacity(storagePointer + 2);
+	storagePointer += (int)LX_eof_token_clearance_check(&(CURRENT_CONTEXT->tokens[storagePointer]), *lineNumber);
+	(void)LX_set_EOF_token(&CURRENT_CONTEXT->tokens[storagePointer]);
+	(void)LX_intern_token_values(CURRENT_CONTEXT->tokens, storagePointer + 1);
+	(void)LX_free_token_text();
+	CURRENT_CONTEXT->tokenLength = storagePointer;
+	(*tokenCount) = end < bufferLength ? (*tokenCount) : storagePointer;
+	return true;
 }
 
 /**
@@ -451,7 +1178,9 @@ int LX_is_reference_on_pointer(TOKEN *token, char **buffer, size_t currentSymbol
 
 	while ((*buffer)[currentSymbolIndex + symbolsToSkip + 1] != ')'
 		&& (int)is_space((*buffer)[currentSymbolIndex + symbolsToSkip + 1]) == 0
-		&& currentSymbolIndex + symbolsToSkip + 1 < BUFFER_LENGTH) {
+		&& currentSymbolIndex + symbolsToSkip + 1 < CURRENT_CONTEXT->bufferLength) {
+		(void)LX_ensure_token_value_size(token, symbolsToSkip + 3);
+
 		if (token->size > symbolsToSkip + 2) {
 			token->value[symbolsToSkip + 2] = (*buffer)[currentSymbolIndex + symbolsToSkip + 2];
 		}
@@ -460,10 +1189,15 @@ int LX_is_reference_on_pointer(TOKEN *token, char **buffer, size_t currentSymbol
 	}
 
 	if ((*buffer)[currentSymbolIndex + symbolsToSkip + 1] != ')') {
-		token->value = "";
+		if (token->value != NULL) {
+			(void)memset(token->value, 0, sizeof(char) * token->size);
+		}
+
 		return 0;
 	}
 
+	(void)LX_ensure_token_value_size(token, symbolsToSkip + 3);
+
 	if (token->size >= symbolsToSkip + 2) {
 		token->value[0] = '&';
 		token->value[1] = '(';
@@ -491,7 +1225,7 @@ int LX_write_pointer_in_token(TOKEN *token, char **buffer, size_t currentBufferC
 
 	int pointers = 0;
 
-	for (size_t i = 0; i + currentBufferCharPos < BUFFER_LENGTH; i++) {
+	for (size_t i = 0; i + currentBufferCharPos < CURRENT_CONTEXT->bufferLength; i++) {
 		char currentChar = (*buffer)[currentBufferCharPos + i];
 
 		if (currentChar == '*') {
@@ -508,9 +1242,7 @@ int LX_write_pointer_in_token(TOKEN *token, char **buffer, size_t currentBufferC
 		break;
 	}
 
-	while (token->size < pointers + 1) {
-		(void)LX_resize_tokens_value(token, token->size);
-	}
+	(void)LX_ensure_token_value_size(token, pointers + 2);
 
 	for (int i = 0; i < pointers; i++) {
 		token->value[i] = '*';
@@ -531,11 +1263,9 @@ int LX_write_pointer_in_token(TOKEN *token, char **buffer, size_t currentBufferC
 void LX_write_reference_in_token(TOKEN *token) {
 	if (token != NULL) {
 		token->type = _REFERENCE_;
-
-		if (token->size > 1) {
-			token->value[0] = '&';
-			token->value[1] = '\0';
-		}
+		(void)LX_ensure_token_value_size(token, 2);
+		token->value[0] = '&';
+		token->value[1] = '\0';
 	}
 }
 
@@ -548,67 +1278,132 @@ void LX_write_reference_in_token(TOKEN *token) {
  * @param lineNumber    Line number to set
  */
 void LX_set_line_number(TOKEN *token, size_t lineNumber) {
-	token->line = lineNumber;
+	token->line = (unsigned int)lineNumber;
 }
 
 /**
  * <p>
- * Allocates the memory to the predicted size from the
- * input module.
+ * Reserves the token array with the provided capacity.
  * </p>
  * 
  * <p>
- * Calloc is used, in order to have 0 values only.
+ * The new part of the array is set to 0, the token values
+ * are reserved separately by LX_ensure_token_capacity().
  * </p>
  * 
- * @param **tokens              Pointer to the token array to calloc
- * @param **tokenLengthsArray   Sizes of the individual tokens
+ * @param capacity  Number of tokens the array should be able to hold
  */
-void LX_set_token_value_to_awaited_size(TOKEN **tokens, int **tokenLengthsArray) {
-	if (*tokens != NULL && tokenLengthsArray != NULL) {
-		for (int i = 0; i < maxTokensLength; i++) {
-			// Calloc as much space as predicted; Tokens at i has the value length of tokenLengths at i
-			(*tokens)[i].value = (char*)calloc((*tokenLengthsArray)[i], sizeof(char));
-			(*tokens)[i].size = (*tokenLengthsArray)[i];
-
-			// If the allocation of the memory should fail an error gets called
-			if ((*tokens)[i].value == NULL) {
-				(void)IO_BUFFER_RESERVATION_EXCEPTION();
-			}
+void LX_reserve_token_array(size_t capacity) {
+	if (capacity <= CURRENT_CONTEXT->tokensCapacity) {
+		return;
+	}
+
+	TOKEN *newTokens = (TOKEN*)realloc(CURRENT_CONTEXT->tokens, sizeof(TOKEN) * capacity);
+
+	// When the TOKEN array couldn't be allocated, then throw an IO_BUFFER_RESERVATION_EXCEPTION (errors.h)
+	if (newTokens == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	}
+
+	(void)memset(newTokens + CURRENT_CONTEXT->tokensCapacity, 0, sizeof(TOKEN) * (capacity - CURRENT_CONTEXT->tokensCapacity));
+	CURRENT_CONTEXT->tokens = newTokens;
+	CURRENT_CONTEXT->tokensCapacity = capacity;
+}
+
+/**
+ * <p>
+ * Makes sure, that the first N tokens exist in the token array.
+ * </p>
+ * 
+ * <p>
+ * If the array is full, the capacity is doubled (amortized O(1) per token).
+ * The values of new tokens are NULL till something is written into them.
+ * </p>
+ * 
+ * @param requiredTokens    Number of tokens that have to be available
+ */
+void LX_ensure_token_capacity(size_t requiredTokens) {
+	if (requiredTokens > CURRENT_CONTEXT->tokensCapacity) {
+		size_t newCapacity = CURRENT_CONTEXT->tokensCapacity > 0 ? CURRENT_CONTEXT->tokensCapacity : MINIMUM_TOKEN_CAPACITY;
+
+		while (newCapacity < requiredTokens) {
+			newCapacity *= 2;
 		}
+
+		(void)LX_reserve_token_array(newCapacity);
 	}
 }
 
 /**
  * <p>
- * Resizes a tokens value to the 125% of its old size.
+ * Makes sure, that the value of the token can hold at least the
+ * required size.
  * </p>
  * 
  * <p>
- * The occurance of wrong determined token sizes is rare, but
- * for the case it increments by 25%, in order to provide more
- * space if needed without reserving each by each. This
- * results in better performance but in less ressource friendlyness.
+ * If the value is the last span of the token text pool, it just
+ * grows in place. Otherwise a new span is reserved at the end of the pool
+ * and the old content is copied into it. The pool memory is set to 0, so
+ * every value is '\0' terminated as long as it is smaller than its size.
  * </p>
  * 
- * @param *token    Token to resize
- * @param oldSize   Size of the token before the resize
+ * @param *token        Token to resize
+ * @param requiredSize  Minimum size of the value (including the '\0')
  */
-void LX_resize_tokens_value(TOKEN *token, size_t oldSize) {
-	int newSize = (int)(oldSize * 1.25);
-	char *newValue = (char*)realloc(token->value, sizeof(char) * newSize);
+void LX_ensure_token_value_size(TOKEN *token, size_t requiredSize) {
+	if (token->value != NULL && token->size >= requiredSize) {
+		return;
+	}
 
-	if (token->value == NULL) {
-		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	if (token->value != NULL && CURRENT_CONTEXT->currentTextBlock != NULL
+		&& token->value + token->size == CURRENT_CONTEXT->currentTextBlock->text + CURRENT_CONTEXT->currentTextBlock->used
+		&& CURRENT_CONTEXT->currentTextBlock->used - token->size + requiredSize <= CURRENT_CONTEXT->currentTextBlock->capacity) {
+		CURRENT_CONTEXT->currentTextBlock->used += requiredSize - token->size;
+		token->size = (unsigned int)requiredSize;
+		return;
 	}
 
-	token->value = newValue;
-	token->size = newSize;
+	if (CURRENT_CONTEXT->currentTextBlock == NULL
+		|| CURRENT_CONTEXT->currentTextBlock->capacity - CURRENT_CONTEXT->currentTextBlock->used < requiredSize) {
+		(void)LX_add_token_text_block(requiredSize);
+	}
+
+	char *newValue = CURRENT_CONTEXT->currentTextBlock->text + CURRENT_CONTEXT->currentTextBlock->used;
 
-	// Set the new allocated memory to '0'
 	if (token->value != NULL) {
-		(void)memset(token->value + oldSize, 0, sizeof(char) * (oldSize * 0.25));
+		(void)memcpy(newValue, token->value, sizeof(char) * token->size);
+	}
+
+	CURRENT_CONTEXT->currentTextBlock->used += requiredSize;
+	token->value = newValue;
+	token->size = (unsigned int)requiredSize;
+}
+
+/**
+ * <p>
+ * Adds a new block to the token text pool.
+ * </p>
+ * 
+ * <p>
+ * The block holds at least TOKEN_TEXT_BLOCK_SIZE characters, values
+ * that are larger get a block of their own size. A calloc is used, in
+ * order to have 0 values only.
+ * </p>
+ * 
+ * @param minimumCapacity   Number of characters the block has to hold at least
+ */
+void LX_add_token_text_block(size_t minimumCapacity) {
+	size_t capacity = minimumCapacity > TOKEN_TEXT_BLOCK_SIZE ? minimumCapacity : TOKEN_TEXT_BLOCK_SIZE;
+	struct TokenTextBlock *block = (struct TokenTextBlock*)calloc(1, sizeof(struct TokenTextBlock) + sizeof(char) * capacity);
+
+	if (block == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
 	}
+
+	block->previousBlock = CURRENT_CONTEXT->currentTextBlock;
+	block->capacity = capacity;
+	block->used = 0;
+	CURRENT_CONTEXT->currentTextBlock = block;
 }
 
 /**
@@ -628,7 +1423,7 @@ void LX_resize_tokens_value(TOKEN *token, size_t oldSize) {
 int LX_token_clearance_check(TOKEN *token, size_t lineNumber) {
 	if (token != NULL && token->value != NULL) {
 		if (token->value[0] != 0) {
-			token->line = lineNumber;
+			token->line = (unsigned int)lineNumber;
 			return 1;
 		}
 	}
@@ -656,25 +1451,26 @@ int LX_token_clearance_check(TOKEN *token, size_t lineNumber) {
  */
 int LX_skip_comment(char **input, const size_t currentIndex, size_t *lineNumber) {
 	char crucialChar = (*input)[currentIndex + 1];
-	int jumpForward = 0;
 
-	while ((jumpForward + currentIndex + 1) < BUFFER_LENGTH) {
-		char currentCharacter = (*input)[currentIndex + jumpForward];
-		char nextCharacter = (*input)[currentIndex + jumpForward + 1];
-		//Check for '\n'
-		(*lineNumber) += (int)is_space(currentCharacter) == 2 ? 1 : 0;
+	if (currentIndex + 1 >= CURRENT_CONTEXT->bufferLength) {
+		return 0;
+	}
 
-		if (crucialChar == '*' && currentCharacter == '*' && nextCharacter == '/') {
-			jumpForward++;
-			break;
-		} else if (crucialChar == '/' && currentCharacter == '\n') {
-			break;
-		}
+	// The comment can not go further than the second last character
+	size_t limit = CURRENT_CONTEXT->bufferLength - 1;
 
-		jumpForward++;
+	if (crucialChar == '*') {
+		size_t commentEnd = (size_t)find_block_comment_end(*input, currentIndex, limit, lineNumber);
+		return commentEnd < limit ? (int)(commentEnd + 1 - currentIndex) : (int)(limit - currentIndex);
 	}
 
-	return jumpForward;
+	size_t lineEnd = (size_t)find_line_end(*input, currentIndex, limit);
+
+	if (lineEnd < limit) {
+		(*lineNumber)++;
+	}
+
+	return (int)(lineEnd - currentIndex);
 }
 
 /**
@@ -693,24 +1489,14 @@ int LX_skip_comment(char **input, const size_t currentIndex, size_t *lineNumber)
 int LX_write_string_in_token(TOKEN *token, char **input, const size_t currentInputIndex, const char crucialCharacter, size_t *lineNumber) {
 	int jumpForward = 1;
 
-	if (input != NULL && token != NULL && token->value != NULL) {
-		int currentIncremental = 1;
-		int currentTokenSize = (((token->size * currentIncremental) - 1));
-
+	if (input != NULL && token != NULL) {
 		// write the current character into the current token value
 		// while the input is not the crucial character again the input gets set into the current token value
 		while (((*input)[currentInputIndex + jumpForward] != crucialCharacter)
-			&& (currentInputIndex + jumpForward) < BUFFER_LENGTH) {
-			// If the string size is bigger than size, resize the token
-			if (jumpForward + 1 >= currentTokenSize) {
-				(void)LX_resize_tokens_value(token, currentTokenSize);
-				currentIncremental++;
-				currentTokenSize = (((token->size * currentIncremental) - 1));
-			}
-
-			if (token->size > jumpForward) {
-				token->value[jumpForward] = (*input)[currentInputIndex + jumpForward];
-			}
+			&& (currentInputIndex + jumpForward) < CURRENT_CONTEXT->bufferLength) {
+			// +3 keeps space for the closing character and the '\0'
+			(void)LX_ensure_token_value_size(token, jumpForward + 3);
+			token->value[jumpForward] = (*input)[currentInputIndex + jumpForward];
 
 			if ((int)is_space((*input)[currentInputIndex + jumpForward]) == 2) {
 				(*lineNumber)++;
@@ -720,7 +1506,7 @@ int LX_write_string_in_token(TOKEN *token, char **input, const size_t currentInp
 		}
 
 		if ((*input)[currentInputIndex + jumpForward] != crucialCharacter) {
-			(void)LEXER_UNFINISHED_STRING_EXCEPTION(input, currentInputIndex, *lineNumber);
+			(void)LEXER_UNFINISHED_STRING_EXCEPTION(input, currentInputIndex);
 		}
 
 		if (crucialCharacter == '"') {
@@ -729,20 +1515,11 @@ int LX_write_string_in_token(TOKEN *token, char **input, const size_t currentInp
 			token->type = _CHARACTER_ARRAY_;
 		}
 
+		// End the whole token with the crucial character and the '\0' character
+		(void)LX_ensure_token_value_size(token, jumpForward + 2);
 		token->value[0] = crucialCharacter;
-
-		if (token->size > jumpForward) {
-			token->value[jumpForward] = crucialCharacter;
-		} else {
-			token->value[token->size - 1] = crucialCharacter;
-		}
-
-		// End the whole token with the '\0' character
-		if (token->size >= jumpForward + 1) {
-			token->value[jumpForward + 1] = '\0';
-		} else {
-			token->value[token->size - 1] = crucialCharacter;
-		}
+		token->value[jumpForward] = crucialCharacter;
+		token->value[jumpForward + 1] = '\0';
 	}
 
 	return jumpForward;
@@ -760,23 +1537,10 @@ int LX_write_string_in_token(TOKEN *token, char **input, const size_t currentInp
  * @param *lineNumber           Current line number
  */
 int LX_skip_whitespaces(char **input, size_t currentInputIndex, size_t *lineNumber) {
-	int jumpForward = 0;
-
-	while ((currentInputIndex + jumpForward) < BUFFER_LENGTH) {
-		int whitespaceChar = (int)is_space((*input)[(currentInputIndex + jumpForward)]);
-		
-		if (whitespaceChar == 0) {
-			break;
-		} else if (whitespaceChar == 2) {
-			(*lineNumber)++;
-		}
-
-		jumpForward++;
-		continue;
-	}
+	size_t runEnd = (size_t)skip_whitespace_run(*input, currentInputIndex, CURRENT_CONTEXT->bufferLength, lineNumber);
 
 	// return the value of how much the input index has to skip until there's another non whitespace character
-	return jumpForward - 1;
+	return (int)(runEnd - currentInputIndex) - 1;
 }
 
 /**
@@ -788,12 +1552,10 @@ int LX_skip_whitespaces(char **input, size_t currentInputIndex, size_t *lineNumb
  * @param symbolIndex   Position of the dot in the buffer
  */
 void LX_put_type_float_in_token(TOKEN *token, const size_t symbolIndex) {
-	if (token != NULL && token->value != NULL) {
+	if (token != NULL) {
 		token->type = _FLOAT_;
-
-		if (token->size > symbolIndex) {
-			token->value[symbolIndex] = '.';
-		}
+		(void)LX_ensure_token_value_size(token, symbolIndex + 2);
+		token->value[symbolIndex] = '.';
 	}
 }
 
@@ -803,7 +1565,7 @@ void LX_put_type_float_in_token(TOKEN *token, const size_t symbolIndex) {
  * </p>
  * 
  * <p>
- * If the size of the token should be to small, the token is resized.
+ * If the size of the token should be to small, the token value is resized.
  * </p>
  * 
  * @param *token        Token to write the operation into
@@ -811,28 +1573,12 @@ void LX_put_type_float_in_token(TOKEN *token, const size_t symbolIndex) {
  * @param lineNumber    Current line number
  */
 void LX_write_class_accessor_or_creator_in_token(TOKEN *token, char crucialChar, size_t lineNumber) {
-	if (token != NULL && token->value != NULL) {
-		char src[3];
-		src[0] = crucialChar;
-		src[1] = '>';
-		src[2] = '\0';
-		
-		// Check for possible buffer overflow (important when changes occour)
-		if ((int)strlen(src) <= token->size) {
-			(void)strncpy(token->value, src, token->size);
-		} else {
-			int length = (int)strlen(src) * sizeof(char) + sizeof(char);
-			token->value = (char*)realloc(token->value, length);
-
-			if (token->value == NULL) {
-				(void)IO_BUFFER_RESERVATION_EXCEPTION();
-			}
-
-			(void)strncpy(token->value, src, token->size);
-			token->size = length;
-		}
-		
-		token->line = lineNumber;
+	if (token != NULL) {
+		(void)LX_ensure_token_value_size(token, 3);
+		token->value[0] = crucialChar;
+		token->value[1] = '>';
+		token->value[2] = '\0';
+		token->line = (unsigned int)lineNumber;
 
 		switch (crucialChar) {
 		case '-':
@@ -860,7 +1606,8 @@ void LX_write_class_accessor_or_creator_in_token(TOKEN *token, char crucialChar,
  * @param nextChar      Second char of the double operator
  */
 void LX_write_double_operator_in_token(TOKEN *token, char currentChar, char nextChar) {
-	if (token != NULL && token->value != NULL) {
+	if (token != NULL) {
+		(void)LX_ensure_token_value_size(token, 3);
 		token->value[0] = currentChar;
 		token->value[1] = nextChar;
 		token->value[2] = '\0';
@@ -883,7 +1630,8 @@ void LX_write_double_operator_in_token(TOKEN *token, char currentChar, char next
  * @param lineNumber    Line of the token
  */
 void LX_write_default_operator_in_token(TOKEN *token, char currentChar, size_t lineNumber) {
-	if (token != NULL && token->value != NULL) {
+	if (token != NULL) {
+		(void)LX_ensure_token_value_size(token, 2);
 		token->value[0] = currentChar;
 		token->value[1] = '\0';
 		(void)LX_set_line_number(token, lineNumber);
@@ -905,12 +1653,7 @@ void LX_write_default_operator_in_token(TOKEN *token, char currentChar, size_t l
 void LX_set_EOF_token(TOKEN *token) {
 	if (token != NULL) {
 		char *src = "$EOF$\0";
-		token->value = (char*)calloc(sizeof(char), 7);
-
-		if (token->value == NULL) {
-			printf("ERROR ON ALLOCATIONG MEMORY FOR EOF TOKEN!\n");
-		}
-
+		(void)LX_ensure_token_value_size(token, 7);
 		(void)strncpy(token->value, src, 6 * sizeof(char));
 		
 		token->value[6] = '\0';
@@ -943,6 +1686,29 @@ void LX_set_keyword_type_to_token(TOKEN *token) {
 	}
 }
 
+/**
+ * <p>
+ * Replaces the values of the tokens with their interned strings
+ * (see SPACE/src/internPool.c).
+ * </p>
+ * 
+ * <p>
+ * Equal values of the tokens share the same pointer afterwards, so the
+ * parsetree and the semantic analyzer can compare them by pointer.
+ * The size of the tokens stays as it is.
+ * </p>
+ * 
+ * @param *tokens       Token array
+ * @param tokenCount    Number of tokens (including the EOF token)
+ */
+void LX_intern_token_values(TOKEN *tokens, size_t tokenCount) {
+	for (size_t i = 0; i < tokenCount; i++) {
+		if (tokens[i].value != NULL) {
+			tokens[i].value = IP_intern(tokens[i].value);
+		}
+	}
+}
+
 /**
  * <p>
  * Checks if a token is a number or not.
@@ -1062,17 +1828,12 @@ TOKENTYPES LX_fill_condition_type(char *value) {
  * @param *tokens   Token to free
  */
 int FREE_TOKENS(TOKEN *tokens) {
-	if (tokensreserved == 1 && tokens != NULL) {
-		for (int i = 0; i < maxTokensLength; i++) {
-			if (tokens[i].value != NULL) {
-				(void)free(tokens[i].value);
-				tokens[i].value = NULL;
-			}
-		}
-
+	if (tokens != NULL && tokens == CURRENT_CONTEXT->tokens) {
+		// The token values are spans inside of the text blocks
+		(void)LX_free_token_text();
 		(void)free(tokens);
-		tokens = NULL;
-		tokensreserved = 0;
+		CURRENT_CONTEXT->tokens = NULL;
+		CURRENT_CONTEXT->tokensCapacity = 0;
 	}
 
 	return 1;
@@ -1113,7 +1874,7 @@ int LX_check_for_double_operator(char currentChar, char nextChar) {
 
 /**
  * <p><strong>DEBUG ONLY!</strong>
- * This function prints the details of the lexer for the DEBUG_MODE = 1.
+ * This function prints the details of the lexer for "--log=lexer:debug".
  * </p>
  * 
  * @param *tokens               Tokens to print
@@ -1121,18 +1882,18 @@ int LX_check_for_double_operator(char currentChar, char nextChar) {
  */
 void LX_print_result(TOKEN *tokens, size_t currenTokenIndex) {
 	if (tokens != NULL) {
-		(void)printf("\n>>>>>>>>>>>>>>>>>>>>    LEXER    <<<<<<<<<<<<<<<<<<<<\n\n");
+		(void)LG_write("\n>>>>>>>>>>>>>>>>>>>>    LEXER    <<<<<<<<<<<<<<<<<<<<\n\n");
 
 		for (size_t i = 0; i < currenTokenIndex + 2; i++) {
 			if (tokens[i].value == NULL) {
-				printf("Token: (NULL)\n");
+				(void)LG_write("Token: (NULL)\n");
 				continue;
 			}
 
-			(void)printf("Token: %3lu | Type: %-2d | Size: %3li | Line: %3li | Start of TOKEN: %3li -> Token: %s\n", i, (int)tokens[i].type, tokens[i].size, tokens[i].line, tokens[i].tokenStart, tokens[i].value);
+			(void)LG_write("Token: %3lu | Type: %-2d | Size: %3u | Line: %3i | Start of TOKEN: %3i -> Token: %s\n", i, (int)tokens[i].type, tokens[i].size, (int)tokens[i].line, (int)tokens[i].tokenStart, tokens[i].value);
 		}
 
-		(void)printf("\n>>>>>    Buffer successfully lexed    <<<<<\n");
+		(void)LG_write("\n>>>>>    Buffer successfully lexed    <<<<<\n");
 	}
 }
 
@@ -1146,11 +1907,56 @@ void LX_print_result(TOKEN *tokens, size_t currenTokenIndex) {
  * would look like this: _KW_VAR_.
  * </p>
  * 
+ * <p>
+ * All keywords are lowercase and at most MAX_KEYWORD_LENGTH characters
+ * long, so most identifiers are rejected while hashing. The remaining
+ * ones need exactly one lookup in the KEYWORD_HASH_TABLE and one compare.
+ * </p>
+ * 
  * @returns The converted TOKENTYPES
  * 
  * @param *value    Value to convert
  */
 TOKENTYPES LX_get_keyword_type(const char *value) {
+	if (value == NULL || value[0] == '\0') {
+		return _UNDEF_;
+	}
+
+	unsigned int hash = KEYWORD_HASH_SEED;
+
+	for (size_t i = 0; value[i] != '\0'; i++) {
+		if (i >= MAX_KEYWORD_LENGTH || value[i] < 'a' || value[i] > 'z') {
+			return _IDENTIFIER_;
+		}
+
+		hash = (hash ^ (unsigned char)value[i]) * KEYWORD_HASH_PRIME;
+	}
+
+	int entry = KEYWORD_HASH_TABLE[(hash ^ (hash >> 15)) % KEYWORD_HASH_TABLE_SIZE];
+
+	if (entry == 0 || (int)strcmp(value, KEYWORD_LOOKUP[entry - 1].kwName) != 0) {
+		return _IDENTIFIER_;
+	}
+
+	return KEYWORD_LOOKUP[entry - 1].kwValue;
+}
+
+/**
+ * <p>
+ * Returns the according keyword type by comparing the input with
+ * every entry of the KEYWORD_LOOKUP.
+ * </p>
+ * 
+ * <p>
+ * This is the reference for LX_get_keyword_type() and is only used
+ * for verifying and benchmarking the hashed lookup.
+ * </p>
+ * 
+ * @returns The converted TOKENTYPES
+ * 
+ * @param *value    Value to convert
+ */
+TOKENTYPES LX_get_keyword_type_linear(const char *value) {
 	if (value == NULL || (int)is_empty_string(value) == 1) {
 		return _UNDEF_;
 	}
@@ -1166,6 +1972,42 @@ TOKENTYPES LX_get_keyword_type(const char *value) {
 	return _IDENTIFIER_;
 }
 
+/**
+ * <p>
+ * Hashes a keyword (FNV-1a with a variable offset basis) and
+ * returns its slot in the KEYWORD_HASH_TABLE.
+ * </p>
+ * 
+ * @returns The slot of the keyword
+ * 
+ * @param *value    Keyword to hash
+ * @param seed      Offset basis of the hash
+ */
+unsigned int LX_hash_keyword(const char *value, unsigned int seed) {
+	unsigned int hash = seed;
+
+	for (size_t i = 0; value[i] != '\0'; i++) {
+		hash = (hash ^ (unsigned char)value[i]) * KEYWORD_HASH_PRIME;
+	}
+
+	return (hash ^ (hash >> 15)) % KEYWORD_HASH_TABLE_SIZE;
+}
+
+/**
+ * <p>
+ * Returns the name of a keyword in the KEYWORD_LOOKUP, so the
+ * keywordLookupBenchmark can check and generate the KEYWORD_HASH_TABLE.
+ * </p>
+ * 
+ * @returns The name of the keyword, NULL if the index is out of the KEYWORD_LOOKUP
+ * 
+ * @param index     Index of the keyword
+ */
+const char *LX_get_keyword_name(int index) {
+	int length = (sizeof(KEYWORD_LOOKUP) / sizeof(KEYWORD_LOOKUP[0]));
+	return index >= 0 && index < length ? KEYWORD_LOOKUP[index].kwName : NULL;
+}
+
 /**
  * <p><strong>DEBUG ONLY!</strong>
  * Prints out the totaly used time in seconds.
@@ -1174,5 +2016,5 @@ TOKENTYPES LX_get_keyword_type(const char *value) {
  * @param cpu_time_used     CPU time that was used to run the lexer module
  */
 void LX_print_cpu_time(float cpu_time_used) {
-	(void)printf("\nCPU time used for LEXING: %f seconds\n", cpu_time_used);
+	(void)LG_write("\nCPU time used for LEXING: %f seconds\n", cpu_time_used);
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/Token.h"
+#include "../headers/lineIndex.h"
+#include "../headers/compilerContext.h"
+#include "../headers/errors.h"
+
+/** 
+ * The subprogram {@code SPACE/src/lineIndex.c} was created
+ * to provide the start of every line in the source buffer.
+ * 
+ * The index is built once per buffer with memchr(), which the C
+ * libraries scan vectorized. Afterwards the line and the column of a
+ * position are found by a binary search and the text of a line is a
+ * slice of the buffer, so the error messages don't rescan the buffer
+ * backward and forward for every error.
+ * 
+ * The lexer builds the index before the buffer is lexed and the semantic
+ * analysis makes sure, that it exists before the bodies are checked in
+ * parallel. The other threads only read it.
+ * 
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+/**
+ * <p>
+ * The index of the current compilation (see CompilerContext).
+ * </p>
+ */
+#define LINE_INDEX (CURRENT_CONTEXT->lineIndex)
+
+/**
+ * <p>
+ * Builds the index over the buffer, a previous index is replaced.
+ * </p>
+ * 
+ * @returns true, if the index was built
+ * 
+ * @param *buffer   The source buffer
+ * @param length    Length of the buffer
+ */
+int LI_build_line_index(const char *buffer, size_t length) {
+	(void)FREE_LINE_INDEX();
+
+	if (buffer == NULL || length > TOKEN_MAX_POSITION) {
+		return false;
+	}
+
+	size_t capacity = length / 32 + 16;
+	LINE_INDEX.starts = (unsigned int*)malloc(sizeof(unsigned int) * capacity);
+
+	if (LINE_INDEX.starts == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return false;
+	}
+
+	LINE_INDEX.starts[0] = 0;
+	LINE_INDEX.count = 1;
+	const char *newLine = (const char*)memchr(buffer, '\n', length);
+
+	while (newLine != NULL) {
+		if (LINE_INDEX.count == capacity) {
+			capacity *= 2;
+			unsigned int *starts = (unsigned int*)realloc(LINE_INDEX.starts, sizeof(unsigned int) * capacity);
+
+			if (starts == NULL) {
+				(void)FREE_LINE_INDEX();
+				(void)IO_BUFFER_RESERVATION_EXCEPTION();
+				return false;
+			}
+
+			LINE_INDEX.starts = starts;
+		}
+
+		size_t start = (size_t)(newLine - buffer) + 1;
+		LINE_INDEX.starts[LINE_INDEX.count++] = (unsigned int)start;
+		newLine = (const char*)memchr(buffer + start, '\n', length - start);
+	}
+
+	LINE_INDEX.buffer = buffer;
+	LINE_INDEX.length = length;
+	return true;
+}
+
+/**
+ * <p>
+ * Builds the index for the buffer of the CURRENT_CONTEXT, if it is
+ * not built yet.
+ * </p>
+ * 
+ * @returns true, if the index is built
+ */
+int LI_ensure_line_index() {
+	//The chunks of the parallel lexer share the index with a shorter bufferLength
+	if (LINE_INDEX.starts != NULL && LINE_INDEX.buffer == CURRENT_CONTEXT->buffer) {
+		return true;
+	}
+
+	return LI_build_line_index(CURRENT_CONTEXT->buffer, CURRENT_CONTEXT->bufferLength);
+}
+
+/**
+ * <p>
+ * Finds the line of a position with a binary search over the starts.
+ * </p>
+ * 
+ * @returns The line of the position (starting at 0), positions behind the buffer are in the last line
+ * 
+ * @param position  Position in the buffer
+ */
+size_t LI_get_line(size_t position) {
+	if ((int)LI_ensure_line_index() == false) {
+		return 0;
+	}
+
+	size_t low = 0;
+	size_t high = LINE_INDEX.count - 1;
+
+	while (low < high) {
+		size_t middle = low + (high - low + 1) / 2;
+
+		if (LINE_INDEX.starts[middle] <= position) {
+			low = middle;
+		} else {
+			high = middle - 1;
+		}
+	}
+
+	return low;
+}
+
+/**
+ * <p>
+ * Gets the number of characters between the start of the line and
+ * the position.
+ * </p>
+ * 
+ * @returns The column of the position (starting at 0), 0 for positions behind the buffer
+ * 
+ * @param position  Position in the buffer
+ */
+size_t LI_get_column(size_t position) {
+	size_t line = (size_t)LI_get_line(position);
+
+	if (position > LINE_INDEX.length) {
+		return 0;
+	}
+
+	return LINE_INDEX.starts != NULL ? position - LINE_INDEX.starts[line] : 0;
+}
+
+/**
+ * @returns The position of the first character of the line, the buffer length if there is no such line
+ * 
+ * @param line  Line starting at 0
+ */
+size_t LI_get_line_start(size_t line) {
+	if ((int)LI_ensure_line_index() == false || line >= LINE_INDEX.count) {
+		return CURRENT_CONTEXT->bufferLength;
+	}
+
+	return LINE_INDEX.starts[line];
+}
+
+/**
+ * @returns The number of characters in the line without the '\n'
+ * 
+ * @param line  Line starting at 0
+ */
+size_t LI_get_line_length(size_t line) {
+	if ((int)LI_ensure_line_index() == false || line >= LINE_INDEX.count) {
+		return 0;
+	}
+
+	size_t end = line + 1 < LINE_INDEX.count ? LINE_INDEX.starts[line + 1] - 1 : LINE_INDEX.length;
+	return end - LINE_INDEX.starts[line];
+}
+
+/**
+ * <p>
+ * Frees the line index.
+ * </p>
+ * 
+ * @returns true, if the index was freed
+ */
+int FREE_LINE_INDEX() {
+	(void)free(LINE_INDEX.starts);
+	LINE_INDEX.buffer = NULL;
+	LINE_INDEX.length = 0;
+	LINE_INDEX.starts = NULL;
+	LINE_INDEX.count = 0;
+	return true;
+}
@@ -30,12 +30,17 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
  * The subprogram {@code SPACE/src/list.c} was created
  * to provide a list and its basic functionalities.
  * 
- * The main feature of the list is dynamic resizing.
+ * The main feature of the list is dynamic resizing. Small lists keep
+ * their entries inline (LIST_INLINE_CAPACITY), so they need no own
+ * entries array.
  * 
  * @version 1.0     24.06.2024
  * @author Lukas Nian En Lampl
 */
 
+#define true 1
+#define false 0
+
 /**
  * <p>
  * This defines the resizing factor.
@@ -44,19 +49,23 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 const float FACTOR = 2.0;
 
-void L_resize_list(struct List *list);
+int L_resize_list(struct List *list, size_t minimumSize);
 
 /**
  * <p>
  * Creates a new list and returns a pointer to the list.
  * </p>
  * 
+ * <p>
+ * A capacity up to LIST_INLINE_CAPACITY uses the inline entries, the
+ * list is a single allocation then.
+ * </p>
+ * 
  * @returns A pointer to the list
  * 
- * @param initialCapacity   The initialCapacity of the list (always at least 16)
+ * @param initialCapacity   The initialCapacity of the list
  */
 struct List *CreateNewList(int initialCapacity) {
-	initialCapacity = initialCapacity < 16 ? 16 : initialCapacity;
 	struct List *list = (struct List*)calloc(1, sizeof(struct List));
 
 	if (list == NULL) {
@@ -64,12 +73,33 @@ struct List *CreateNewList(int initialCapacity) {
 		return NULL;
 	}
 
-	list->entries = (void**)calloc(initialCapacity, sizeof(void*));
-	list->size = initialCapacity;
-	list->load = 0;
+	(void)L_init_list(list, initialCapacity);
 	return list;
 }
 
+/**
+ * <p>
+ * Initializes a list, that is part of another structure.
+ * </p>
+ * 
+ * <p><strong>Note:</strong>
+ * The list has to be released with L_release_list() instead of FREE_LIST().
+ * </p>
+ * 
+ * @param *list             List to initialize
+ * @param initialCapacity   The initialCapacity of the list
+ */
+void L_init_list(struct List *list, int initialCapacity) {
+	list->entries = list->inlineEntries;
+	list->size = LIST_INLINE_CAPACITY;
+	list->load = 0;
+	(void)memset(list->inlineEntries, 0, sizeof(list->inlineEntries));
+
+	if (initialCapacity > LIST_INLINE_CAPACITY) {
+		(void)L_resize_list(list, (size_t)initialCapacity);
+	}
+}
+
 /**
  * <p>
  * Adds an item to the provided list.
@@ -88,13 +118,53 @@ void L_add_item(struct List *list, void *ptr) {
 		return;
 	}
 
-	if (list->load >= list->size) {
-		(void)L_resize_list(list);
+	if (list->load >= list->size
+		&& (int)L_resize_list(list, list->load + 1) == false) {
+		return;
 	}
 
 	list->entries[list->load++] = ptr;
 }
 
+/**
+ * <p>
+ * Adds multiple items to the provided list, the list is resized
+ * at most once.
+ * </p>
+ * 
+ * @param *list     List to which to add the items
+ * @param **items   Pointers to add into the list
+ * @param count     Number of pointers
+ */
+void L_add_items(struct List *list, void **items, size_t count) {
+	if (list == NULL || items == NULL || count == 0
+		|| (int)L_reserve_list(list, list->load + count) == false) {
+		return;
+	}
+
+	(void)memcpy(list->entries + list->load, items, sizeof(void*) * count);
+	list->load += count;
+}
+
+/**
+ * <p>
+ * Makes sure, that the list can hold the provided number of entries
+ * without another resize.
+ * </p>
+ * 
+ * @returns true, if the list has the capacity
+ * 
+ * @param *list     List to reserve the entries in
+ * @param capacity  Number of entries the list has to hold
+ */
+int L_reserve_list(struct List *list, size_t capacity) {
+	if (list == NULL || list->entries == NULL) {
+		return false;
+	}
+
+	return capacity <= list->size ? true : (int)L_resize_list(list, capacity);
+}
+
 /**
  * <p>
  * Resizes a provided list.
@@ -102,22 +172,40 @@ void L_add_item(struct List *list, void *ptr) {
  * 
  * <p>
  * The new size is equal to this equation:
- * $ newSize = \floor (oldSize * FACTOR) $
+ * $ newSize = \max(\floor (oldSize * FACTOR), minimumSize) $
+ * The inline entries are copied into a new array, when the list
+ * grows for the first time. The new entries are NULL.
  * </p>
  * 
- * @param *list     List to resize
+ * @returns true, if the list was resized, the old entries are kept if not
+ * 
+ * @param *list         List to resize
+ * @param minimumSize   Number of entries the list has to hold at least
  */
-void L_resize_list(struct List *list) {
+int L_resize_list(struct List *list, size_t minimumSize) {
 	size_t newSize = (size_t)(FACTOR * list->size);
-	list->entries = (void**)realloc(list->entries, sizeof(void*) * newSize);
+	newSize = newSize < minimumSize ? minimumSize : newSize;
+	void **entries = NULL;
 
-	if (list->entries == NULL) {
+	if (list->entries == list->inlineEntries) {
+		entries = (void**)malloc(sizeof(void*) * newSize);
+
+		if (entries != NULL) {
+			(void)memcpy(entries, list->inlineEntries, sizeof(void*) * list->size);
+		}
+	} else {
+		entries = (void**)realloc(list->entries, sizeof(void*) * newSize);
+	}
+
+	if (entries == NULL) {
 		printf("ERROR ON RESIZING THE LIST!\n");
-		return;
+		return false;
 	}
 
-	(void)memset(list->entries + list->size, 0, list->size);
+	(void)memset(entries + list->size, 0, sizeof(void*) * (newSize - list->size));
+	list->entries = entries;
 	list->size = newSize;
+	return true;
 }
 
 /**
@@ -171,9 +259,25 @@ void L_print_list(struct List *list, int flag) {
 	return;
 }
 
-void FREE_LIST(struct List *list) {
+/**
+ * <p>
+ * Frees the entries of a list, that was initialized with L_init_list().
+ * The items themselves are not freed.
+ * </p>
+ * 
+ * @param *list     List to release
+ */
+void L_release_list(struct List *list) {
+	if (list->entries != list->inlineEntries) {
+		(void)free(list->entries);
+	}
+
+	list->entries = NULL;
 	list->load = 0;
 	list->size = 0;
-	(void)free(list->entries);
+}
+
+void FREE_LIST(struct List *list) {
+	(void)L_release_list(list);
 	(void)free(list);
 }
\ No newline at end of file
@@ -0,0 +1,252 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/logger.h"
+
+/**
+ * The subprogram {@code SPACE/src/logger.c} was created
+ * to write the debug output of the compiler phases.
+ *
+ * The output is off by default. "--log=<phase>:<level>,..." enables it
+ * at runtime for single phases, a disabled message is skipped by the
+ * LOG() macro before its arguments are formatted. The messages are
+ * written into a large buffer of the sink (stdout or "--log-file=<path>"),
+ * so a dump is not written line by line.
+ *
+ * @see SPACE/docs/logger.md
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define LOG_BUFFER_SIZE (1 << 16)
+
+enum LogLevel LOG_LEVELS[LOG_PHASE_COUNT] = {LOG_OFF};
+
+static FILE *LOG_SINK = NULL;
+
+static const char *LOG_PHASE_NAMES[LOG_PHASE_COUNT] = {"general", "lexer", "syntax", "parsetree", "semantic"};
+static const char *LOG_LEVEL_NAMES[] = {"off", "info", "debug", "trace"};
+
+int LG_parse_selection(char *selection);
+int LG_find_name(const char *name, size_t length, const char **names, int count);
+
+/**
+ * <p>
+ * Takes "--log", "--log=<selection>" and "--log-file=<path>" out of the
+ * arguments and sets the levels of the phases.
+ * </p>
+ *
+ * <p>
+ * The selection is a comma separated list of "<level>" (all phases),
+ * "<phase>" (debug level) or "<phase>:<level>", e.g. "--log=info,lexer:debug".
+ * </p>
+ *
+ * @returns true, if the arguments are valid
+ *
+ * @param *argc     Argument count, reduced by the log arguments
+ * @param *argv[]   Arguments, the log arguments are removed
+ */
+int LG_parse_arguments(int *argc, char *argv[]) {
+	int count = 0;
+	char *logFile = NULL;
+
+	for (int i = 0; i < (*argc); i++) {
+		if (i > 0 && strcmp(argv[i], "--log") == 0) {
+			for (int n = 0; n < LOG_PHASE_COUNT; n++) {
+				LOG_LEVELS[n] = LOG_DEBUG;
+			}
+		} else if (i > 0 && strncmp(argv[i], "--log=", 6) == 0) {
+			if ((int)LG_parse_selection(&argv[i][6]) == false) {
+				(void)printf("Invalid log selection \"%s\", use --log=<level> or --log=<phase>:<level>,...\n", &argv[i][6]);
+				(void)printf("Phases: general, lexer, syntax, parsetree, semantic, all | Levels: off, info, debug, trace\n");
+				return false;
+			}
+		} else if (i > 0 && strncmp(argv[i], "--log-file=", 11) == 0 && argv[i][11] != '\0') {
+			logFile = &argv[i][11];
+		} else {
+			argv[count++] = argv[i];
+		}
+	}
+
+	(*argc) = count;
+	argv[count] = NULL;
+
+	if (logFile != NULL) {
+		LOG_SINK = fopen(logFile, "w");
+
+		if (LOG_SINK == NULL) {
+			(void)printf("Could not open the log file \"%s\"!\n", logFile);
+			return false;
+		}
+	}
+
+	//Without a log the sink keeps its buffering, so the normal output stays interactive
+	if ((int)LG_is_enabled() == true) {
+		(void)setvbuf(LOG_SINK != NULL ? LOG_SINK : stdout, NULL, _IOFBF, LOG_BUFFER_SIZE);
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Sets the levels of a "--log=" selection.
+ * </p>
+ *
+ * @returns true, if all entries of the selection are valid
+ *
+ * @param *selection    The comma separated selection
+ */
+int LG_parse_selection(char *selection) {
+	size_t position = 0;
+
+	while (selection[position] != '\0') {
+		size_t length = strcspn(&selection[position], ",");
+		char *entry = &selection[position];
+		char *separator = (char*)memchr(entry, ':', length);
+		size_t phaseLength = separator != NULL ? (size_t)(separator - entry) : length;
+		int level = separator != NULL ? (int)LG_find_name(separator + 1, length - phaseLength - 1, LOG_LEVEL_NAMES, LOG_TRACE + 1)
+			: (int)LG_find_name(entry, length, LOG_LEVEL_NAMES, LOG_TRACE + 1);
+
+		//"<level>" selects all phases, "<phase>" the debug level
+		int allPhases = (separator == NULL && level >= 0) || (phaseLength == 3 && strncmp(entry, "all", 3) == 0);
+		int phase = allPhases == true ? -1 : (int)LG_find_name(entry, phaseLength, LOG_PHASE_NAMES, LOG_PHASE_COUNT);
+		level = separator == NULL && level < 0 ? LOG_DEBUG : level;
+
+		if ((allPhases == false && phase < 0) || level < 0) {
+			return false;
+		}
+
+		for (int n = 0; n < LOG_PHASE_COUNT; n++) {
+			if (allPhases == true || phase == n) {
+				LOG_LEVELS[n] = (enum LogLevel)level;
+			}
+		}
+
+		position += length;
+		position += selection[position] == ',' ? 1 : 0;
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Finds a name with the provided length in a list of names.
+ * </p>
+ *
+ * @returns The index of the name, -1 if it is not in the list
+ */
+int LG_find_name(const char *name, size_t length, const char **names, int count) {
+	for (int i = 0; i < count; i++) {
+		if (strlen(names[i]) == length && strncmp(names[i], name, length) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * <p>
+ * Writes a message like printf() into the sink, it is only called
+ * through the LOG() macro or after LG_IS_ENABLED() was checked.
+ * </p>
+ *
+ * @param *format   Format of the message
+ */
+void LG_write(const char *format, ...) {
+	va_list arguments;
+	va_start(arguments, format);
+	(void)LG_write_arguments(format, arguments);
+	va_end(arguments);
+}
+
+void LG_write_arguments(const char *format, va_list arguments) {
+	(void)vfprintf(LOG_SINK != NULL ? LOG_SINK : stdout, format, arguments);
+}
+
+/**
+ * <p>
+ * Writes an already formatted text into the sink.
+ * </p>
+ *
+ * @param *text     Text to write
+ * @param length    Length of the text
+ */
+void LG_write_text(const char *text, size_t length) {
+	if (length == 0) {
+		return;
+	}
+
+	(void)fwrite(text, 1, length, LOG_SINK != NULL ? LOG_SINK : stdout);
+}
+
+/**
+ * <p>
+ * Checks, if any phase is logged.
+ * </p>
+ *
+ * @returns true, if at least one phase has a level
+ */
+int LG_is_enabled() {
+	for (int n = 0; n < LOG_PHASE_COUNT; n++) {
+		if (LOG_LEVELS[n] != LOG_OFF) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * <p>
+ * Checks, if the log shares stdout with the normal output. The log and
+ * the normal output have to be written in order then.
+ * </p>
+ *
+ * @returns true, if there is no log file
+ */
+int LG_is_writing_to_stdout() {
+	return LOG_SINK == NULL;
+}
+
+/**
+ * <p>
+ * Writes the rest of the buffer and closes the log file.
+ * </p>
+ */
+void LG_close() {
+	if (LOG_SINK != NULL) {
+		(void)fclose(LOG_SINK);
+		LOG_SINK = NULL;
+	}
+
+	(void)fflush(stdout);
+}
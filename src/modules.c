@@ -24,6 +24,34 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <string.h>
 #include "../headers/modules.h"
 
+/*
+The scanners below classify SCAN_BLOCK_WIDTH characters at once and return a
+bitmask per character class (bit n = character n of the block).
+AVX2 handles 32 characters, SSE2 and NEON 16, the scalar fallback 8.
+The class of whitespaces is the same as the one of is_space().
+*/
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define SCAN_WITH_AVX2
+	#define SCAN_BLOCK_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define SCAN_WITH_SSE2
+	#define SCAN_BLOCK_WIDTH 16
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	#include <arm_neon.h>
+	#define SCAN_WITH_NEON
+	#define SCAN_BLOCK_WIDTH 16
+#else
+	#define SCAN_BLOCK_WIDTH 8
+#endif
+
+#if SCAN_BLOCK_WIDTH == 32
+	#define FULL_SCAN_MASK 0xFFFFFFFFu
+#else
+	#define FULL_SCAN_MASK ((1u << SCAN_BLOCK_WIDTH) - 1u)
+#endif
+
 /*
 Purpose: Check if a character is a space character
 Return Type: int => 1 = is whitespace char; 0 = is not a whitespace char
@@ -91,63 +119,390 @@ int check_for_operator(char input) {
 	}
 }
 
-int is_primitive(TOKENTYPES type) {
-	switch (type) {
-	case _KW_INT_:
-	case _KW_SHORT_:
-	case _KW_LONG_:
-	case _KW_DOUBLE_:
-	case _KW_FLOAT_:
-	case _KW_CHAR_:
-	case _KW_BOOLEAN_:
-	case _KW_VOID_:
-		return 1;
-	default:
-		return 0;
+//////////////////////////////////////
+//////     VECTORIZED SCANNING     ///
+//////////////////////////////////////
+
+struct ScanMasks {
+	unsigned int whitespace;
+	unsigned int newline;
+	unsigned int identifier;
+	unsigned int star;
+};
+
+/*
+Purpose: Count the set bits of a mask
+Return Type: int => Number of set bits
+Params: unsigned int mask => Mask to count
+*/
+static int count_mask_bits(unsigned int mask) {
+#if defined(__GNUC__) || defined(__clang__)
+	return (int)__builtin_popcount(mask);
+#else
+	int count = 0;
+
+	for (; mask != 0; count++) {
+		mask &= mask - 1;
 	}
+
+	return count;
+#endif
 }
 
-const TOKENTYPES endIndicators[] = {
-_OP_EQUALS_, _OP_SEMICOLON_, _OP_LEFT_EDGE_BRACKET_, _OP_SMALLER_CONDITION_,
-_OP_GREATER_CONDITION_, _OP_SMALLER_OR_EQUAL_CONDITION_, _OP_GREATER_OR_EQUAL_CONDITION_,
-_OP_NOT_EQUALS_CONDITION_, _OP_EQUALS_CONDITION_, _OP_COLON_, _KW_AND_, _KW_OR_,
-_OP_MINUS_EQUALS_, _OP_PLUS_EQUALS_, _OP_MULTIPLY_EQUALS_, _OP_DIVIDE_EQUALS_,
-_OP_LEFT_BRACKET_, _OP_COMMA_, _OP_CLASS_CREATOR_,
-_OP_LEFT_BRACE_, _OP_QUESTION_MARK_, _OP_CLASS_ACCESSOR_, _OP_RIGHT_BRACE_};
+/*
+Purpose: Get the index of the lowest set bit of a mask
+Return Type: int => Index of the lowest set bit (mask has to be non-zero)
+Params: unsigned int mask => Mask to check
+*/
+static int lowest_mask_bit(unsigned int mask) {
+#if defined(__GNUC__) || defined(__clang__)
+	return (int)__builtin_ctz(mask);
+#else
+	int index = 0;
 
-int is_end_indicator(const TOKEN *token) {
-	if (token->type == __EOF__) {
-		return 1;
+	while ((mask & 1u) == 0) {
+		mask >>= 1;
+		index++;
 	}
 
-	unsigned char length = (sizeof(endIndicators) / sizeof(endIndicators[0]));
+	return index;
+#endif
+}
 
-	for (unsigned char i = 0; i < length; i++) {
-		if (token->type == endIndicators[i]) {
-			return 1;
+/*
+Purpose: Get the bits below a given index
+Return Type: unsigned int => Mask with all bits below the index set
+Params: int index => Index below the SCAN_BLOCK_WIDTH
+*/
+static unsigned int mask_below(int index) {
+	return (1u << index) - 1u;
+}
+
+#if defined(SCAN_WITH_AVX2)
+/*
+Purpose: Classify 32 characters with AVX2
+Return Type: struct ScanMasks => Masks of the character classes
+Params: const char *block => Start of the 32 characters
+*/
+static struct ScanMasks classify_block(const char *block) {
+	__m256i chars = _mm256_loadu_si256((const __m256i*)block);
+	// (c - base) <= range, unsigned, via min
+	__m256i control = _mm256_sub_epi8(chars, _mm256_set1_epi8(9));
+	__m256i isControl = _mm256_cmpeq_epi8(_mm256_min_epu8(control, _mm256_set1_epi8(4)), control);
+	__m256i isSpace = _mm256_or_si256(isControl, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' ')));
+	__m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+	__m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+	__m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	__m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(25)), letter);
+	__m256i isIdentifier = _mm256_or_si256(_mm256_or_si256(isDigit, isLetter), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_')));
+	struct ScanMasks masks;
+	masks.whitespace = (unsigned int)_mm256_movemask_epi8(isSpace);
+	masks.newline = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n')));
+	masks.identifier = (unsigned int)_mm256_movemask_epi8(isIdentifier);
+	masks.star = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('*')));
+	return masks;
+}
+#elif defined(SCAN_WITH_SSE2)
+/*
+Purpose: Classify 16 characters with SSE2
+Return Type: struct ScanMasks => Masks of the character classes
+Params: const char *block => Start of the 16 characters
+*/
+static struct ScanMasks classify_block(const char *block) {
+	__m128i chars = _mm_loadu_si128((const __m128i*)block);
+	// (c - base) <= range, unsigned, via min
+	__m128i control = _mm_sub_epi8(chars, _mm_set1_epi8(9));
+	__m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(control, _mm_set1_epi8(4)), control);
+	__m128i isSpace = _mm_or_si128(isControl, _mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')));
+	__m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+	__m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+	__m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	__m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(25)), letter);
+	__m128i isIdentifier = _mm_or_si128(_mm_or_si128(isDigit, isLetter), _mm_cmpeq_epi8(chars, _mm_set1_epi8('_')));
+	struct ScanMasks masks;
+	masks.whitespace = (unsigned int)_mm_movemask_epi8(isSpace);
+	masks.newline = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')));
+	masks.identifier = (unsigned int)_mm_movemask_epi8(isIdentifier);
+	masks.star = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('*')));
+	return masks;
+}
+#elif defined(SCAN_WITH_NEON)
+/*
+Purpose: Turn a NEON comparison result into a 16 bit mask (NEON has no movemask)
+Return Type: unsigned int => Mask of the lanes, that are set
+Params: uint8x16_t lanes => Comparison result (0x00 or 0xFF per lane)
+*/
+static unsigned int neon_movemask(uint8x16_t lanes) {
+	static const uint8_t bitWeights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+	uint8x16_t weighted = vandq_u8(lanes, vld1q_u8(bitWeights));
+	return (unsigned int)vaddv_u8(vget_low_u8(weighted)) | ((unsigned int)vaddv_u8(vget_high_u8(weighted)) << 8);
+}
+
+/*
+Purpose: Classify 16 characters with NEON
+Return Type: struct ScanMasks => Masks of the character classes
+Params: const char *block => Start of the 16 characters
+*/
+static struct ScanMasks classify_block(const char *block) {
+	uint8x16_t chars = vld1q_u8((const uint8_t*)block);
+	uint8x16_t isControl = vcleq_u8(vsubq_u8(chars, vdupq_n_u8(9)), vdupq_n_u8(4));
+	uint8x16_t isSpace = vorrq_u8(isControl, vceqq_u8(chars, vdupq_n_u8(' ')));
+	uint8x16_t isDigit = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('0')), vdupq_n_u8(9));
+	uint8x16_t isLetter = vcleq_u8(vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a')), vdupq_n_u8(25));
+	uint8x16_t isIdentifier = vorrq_u8(vorrq_u8(isDigit, isLetter), vceqq_u8(chars, vdupq_n_u8('_')));
+	struct ScanMasks masks;
+	masks.whitespace = (unsigned int)neon_movemask(isSpace);
+	masks.newline = (unsigned int)neon_movemask(vceqq_u8(chars, vdupq_n_u8('\n')));
+	masks.identifier = (unsigned int)neon_movemask(isIdentifier);
+	masks.star = (unsigned int)neon_movemask(vceqq_u8(chars, vdupq_n_u8('*')));
+	return masks;
+}
+#else
+/*
+Purpose: Classify 8 characters without vector instructions
+Return Type: struct ScanMasks => Masks of the character classes
+Params: const char *block => Start of the 8 characters
+*/
+static struct ScanMasks classify_block(const char *block) {
+	struct ScanMasks masks = {0, 0, 0, 0};
+
+	for (int i = 0; i < SCAN_BLOCK_WIDTH; i++) {
+		masks.whitespace |= is_space(block[i]) > 0 ? 1u << i : 0;
+		masks.newline |= block[i] == '\n' ? 1u << i : 0;
+		masks.identifier |= is_identifier_char(block[i]) ? 1u << i : 0;
+		masks.star |= block[i] == '*' ? 1u << i : 0;
+	}
+
+	return masks;
+}
+#endif
+
+/*
+Purpose: Check if a character can be part of a run of identifier characters (letters, digits and '_')
+Return Type: int => 1 = is identifier character; 0 = is not
+Params: const char character => Character to be checked
+*/
+int is_identifier_char(const char character) {
+	return (character >= 'a' && character <= 'z')
+		|| (character >= 'A' && character <= 'Z')
+		|| (character >= '0' && character <= '9')
+		|| character == '_';
+}
+
+/*
+Purpose: Skip a run of whitespaces and count the newlines in it
+Return Type: size_t => Index of the first non whitespace character (or end)
+Params: const char *input => Input to scan;
+		size_t start => Index to start from;
+		size_t end => Index to stop at (exclusive);
+		size_t *newlines => Gets increased by the number of '\n' in the run
+*/
+size_t skip_whitespace_run(const char *input, size_t start, size_t end, size_t *newlines) {
+	size_t i = start;
+
+	for (; i + SCAN_BLOCK_WIDTH <= end; i += SCAN_BLOCK_WIDTH) {
+		struct ScanMasks masks = classify_block(&input[i]);
+
+		if (masks.whitespace != FULL_SCAN_MASK) {
+			int stop = (int)lowest_mask_bit(~masks.whitespace);
+			(*newlines) += (int)count_mask_bits(masks.newline & (unsigned int)mask_below(stop));
+			return i + stop;
 		}
+
+		(*newlines) += (int)count_mask_bits(masks.newline);
 	}
 
-	return 0;
+	for (; i < end; i++) {
+		int whitespaceChar = (int)is_space(input[i]);
+
+		if (whitespaceChar == 0) {
+			break;
+		}
+
+		(*newlines) += whitespaceChar == 2 ? 1 : 0;
+	}
+
+	return i;
 }
 
-TOKENTYPES KeywordLookupTable[] = {
-	_KW_WHILE_, _KW_IF_, _KW_FUNCTION_, _KW_VAR_, _KW_BREAK_, _KW_BREAK_, _KW_RETURN_,
-	_KW_DO_, _KW_CLASS_, _KW_WITH_, _KW_NEW_, _KW_TRUE_, _KW_FALSE_, _KW_NULL_, _KW_ENUM_,
-	_KW_CHECK_, _KW_IS_, _KW_TRY_, _KW_CATCH_, _KW_CONTINUE_, _KW_CONST_, _KW_INCLUDE_,
-	_KW_AND_, _KW_OR_, _KW_GLOBAL_, _KW_SECURE_, _KW_PRIVATE_, _KW_EXPORT_, _KW_FOR_,
-	_KW_THIS_, _KW_ELSE_, _KW_INT_, _KW_DOUBLE_, _KW_FLOAT_, _KW_CHAR_,
-	_KW_SHORT_, _KW_LONG_, _KW_CONSTRUCTOR_, _KW_EXTENDS_
-};
+/*
+Purpose: Skip a run of identifier characters (see is_identifier_char())
+Return Type: size_t => Index of the first character outside of the run (or end)
+Params: const char *input => Input to scan;
+		size_t start => Index to start from;
+		size_t end => Index to stop at (exclusive)
+*/
+size_t skip_identifier_run(const char *input, size_t start, size_t end) {
+	size_t i = start;
 
-int is_keyword(TOKEN *token) {
-	for (int i = 0; i < sizeof(KeywordLookupTable) / sizeof(KeywordLookupTable[0]); i++) {
-		if (token->type == KeywordLookupTable[i]) {
-			return 1;
+	for (; i + SCAN_BLOCK_WIDTH <= end; i += SCAN_BLOCK_WIDTH) {
+		struct ScanMasks masks = classify_block(&input[i]);
+
+		if (masks.identifier != FULL_SCAN_MASK) {
+			return i + (int)lowest_mask_bit(~masks.identifier);
 		}
 	}
 
-	return 0;
+	while (i < end && (int)is_identifier_char(input[i])) {
+		i++;
+	}
+
+	return i;
+}
+
+/*
+Purpose: Find the next '\n'
+Return Type: size_t => Index of the next '\n' (or end)
+Params: const char *input => Input to scan;
+		size_t start => Index to start from;
+		size_t end => Index to stop at (exclusive)
+*/
+size_t find_line_end(const char *input, size_t start, size_t end) {
+	size_t i = start;
+
+	for (; i + SCAN_BLOCK_WIDTH <= end; i += SCAN_BLOCK_WIDTH) {
+		struct ScanMasks masks = classify_block(&input[i]);
+
+		if (masks.newline != 0) {
+			return i + (int)lowest_mask_bit(masks.newline);
+		}
+	}
+
+	while (i < end && input[i] != '\n') {
+		i++;
+	}
+
+	return i;
+}
+
+/*
+Purpose: Find the next "*" that is followed by a '/' and count the newlines on the way
+Return Type: size_t => Index of the '*' (or end); input[end] has to be readable
+Params: const char *input => Input to scan;
+		size_t start => Index to start from;
+		size_t end => Index to stop at (exclusive);
+		size_t *newlines => Gets increased by the number of '\n' before the returned index
+*/
+size_t find_block_comment_end(const char *input, size_t start, size_t end, size_t *newlines) {
+	size_t i = start;
+
+	for (; i + SCAN_BLOCK_WIDTH <= end; i += SCAN_BLOCK_WIDTH) {
+		struct ScanMasks masks = classify_block(&input[i]);
+
+		for (unsigned int stars = masks.star; stars != 0; stars &= stars - 1) {
+			int position = (int)lowest_mask_bit(stars);
+
+			if (input[i + position + 1] == '/') {
+				(*newlines) += (int)count_mask_bits(masks.newline & (unsigned int)mask_below(position));
+				return i + position;
+			}
+		}
+
+		(*newlines) += (int)count_mask_bits(masks.newline);
+	}
+
+	for (; i < end; i++) {
+		if (input[i] == '*' && input[i + 1] == '/') {
+			break;
+		}
+
+		(*newlines) += input[i] == '\n' ? 1 : 0;
+	}
+
+	return i;
+}
+
+/*
+The classes of every token type, built by the compiler from the TOKENTYPES enum.
+The parser asks for a class with IS_TOKEN_CLASS() instead of comparing strings
+or walking lists of types.
+*/
+const unsigned short TOKEN_CLASSES[TOKEN_TYPE_COUNT] = {
+	[__EOF__] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_KW_WHILE_] = TOKEN_CLASS_KEYWORD,
+	[_KW_IF_] = TOKEN_CLASS_KEYWORD,
+	[_KW_FUNCTION_] = TOKEN_CLASS_KEYWORD,
+	[_KW_VAR_] = TOKEN_CLASS_KEYWORD,
+	[_KW_BREAK_] = TOKEN_CLASS_KEYWORD,
+	[_KW_RETURN_] = TOKEN_CLASS_KEYWORD,
+	[_KW_DO_] = TOKEN_CLASS_KEYWORD,
+	[_KW_CLASS_] = TOKEN_CLASS_KEYWORD,
+	[_KW_WITH_] = TOKEN_CLASS_KEYWORD,
+	[_KW_NEW_] = TOKEN_CLASS_KEYWORD,
+	[_KW_TRUE_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_BOOL,
+	[_KW_FALSE_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_BOOL,
+	[_KW_NULL_] = TOKEN_CLASS_KEYWORD,
+	[_KW_ENUM_] = TOKEN_CLASS_KEYWORD,
+	[_KW_CHECK_] = TOKEN_CLASS_KEYWORD,
+	[_KW_IS_] = TOKEN_CLASS_KEYWORD,
+	[_KW_TRY_] = TOKEN_CLASS_KEYWORD,
+	[_KW_CATCH_] = TOKEN_CLASS_KEYWORD,
+	[_KW_CONTINUE_] = TOKEN_CLASS_KEYWORD,
+	[_KW_CONST_] = TOKEN_CLASS_KEYWORD,
+	[_KW_INCLUDE_] = TOKEN_CLASS_KEYWORD,
+	[_KW_AND_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_LOGIC | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_KW_OR_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_LOGIC | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_KW_GLOBAL_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_MODIFIER,
+	[_KW_SECURE_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_MODIFIER,
+	[_KW_PRIVATE_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_MODIFIER,
+	[_KW_EXPORT_] = TOKEN_CLASS_KEYWORD,
+	[_KW_FOR_] = TOKEN_CLASS_KEYWORD,
+	[_KW_THIS_] = TOKEN_CLASS_KEYWORD,
+	[_KW_ELSE_] = TOKEN_CLASS_KEYWORD,
+	[_KW_CONSTRUCTOR_] = TOKEN_CLASS_KEYWORD,
+	[_KW_INT_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_PRIMITIVE,
+	[_KW_DOUBLE_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_PRIMITIVE,
+	[_KW_FLOAT_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_PRIMITIVE,
+	[_KW_CHAR_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_PRIMITIVE,
+	[_KW_VOID_] = TOKEN_CLASS_PRIMITIVE,
+	[_KW_BOOLEAN_] = TOKEN_CLASS_PRIMITIVE,
+	[_KW_SHORT_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_PRIMITIVE,
+	[_KW_LONG_] = TOKEN_CLASS_KEYWORD | TOKEN_CLASS_PRIMITIVE,
+	[_KW_EXTENDS_] = TOKEN_CLASS_KEYWORD,
+	[_OP_PLUS_] = TOKEN_CLASS_ARITHMETIC | TOKEN_CLASS_OPERATOR,
+	[_OP_MINUS_] = TOKEN_CLASS_ARITHMETIC | TOKEN_CLASS_OPERATOR,
+	[_OP_MULTIPLY_] = TOKEN_CLASS_ARITHMETIC | TOKEN_CLASS_OPERATOR,
+	[_OP_DIVIDE_] = TOKEN_CLASS_ARITHMETIC | TOKEN_CLASS_OPERATOR,
+	[_OP_MODULU_] = TOKEN_CLASS_ARITHMETIC | TOKEN_CLASS_OPERATOR,
+	[_OP_DOT_] = TOKEN_CLASS_OPERATOR,
+	[_OP_COMMA_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_LEFT_BRACKET_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_RIGHT_BRACKET_] = TOKEN_CLASS_OPERATOR,
+	[_OP_LEFT_BRACE_] = TOKEN_CLASS_END_INDICATOR,
+	[_OP_RIGHT_BRACE_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_LEFT_EDGE_BRACKET_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_RIGHT_EDGE_BRACKET_] = TOKEN_CLASS_OPERATOR,
+	[_OP_GREATER_CONDITION_] = TOKEN_CLASS_CONDITION | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_SMALLER_CONDITION_] = TOKEN_CLASS_CONDITION | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_NOT_] = TOKEN_CLASS_LOGIC,
+	[_OP_NOT_EQUALS_CONDITION_] = TOKEN_CLASS_CONDITION | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_EQUALS_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_EQUALS_CONDITION_] = TOKEN_CLASS_CONDITION | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_GREATER_OR_EQUAL_CONDITION_] = TOKEN_CLASS_CONDITION | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_SMALLER_OR_EQUAL_CONDITION_] = TOKEN_CLASS_CONDITION | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_CLASS_ACCESSOR_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_SEMICOLON_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_PLUS_EQUALS_] = TOKEN_CLASS_ASSIGNMENT | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_MINUS_EQUALS_] = TOKEN_CLASS_ASSIGNMENT | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_DIVIDE_EQUALS_] = TOKEN_CLASS_ASSIGNMENT | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_MULTIPLY_EQUALS_] = TOKEN_CLASS_ASSIGNMENT | TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_ADD_ONE_] = TOKEN_CLASS_ASSIGNMENT | TOKEN_CLASS_OPERATOR,
+	[_OP_SUBTRACT_ONE_] = TOKEN_CLASS_ASSIGNMENT | TOKEN_CLASS_OPERATOR,
+	[_OP_COLON_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR,
+	[_OP_CLASS_CREATOR_] = TOKEN_CLASS_END_INDICATOR,
+	[_OP_QUESTION_MARK_] = TOKEN_CLASS_END_INDICATOR | TOKEN_CLASS_OPERATOR
+};
+
+int is_primitive(TOKENTYPES type) {
+	return IS_TOKEN_CLASS(type, TOKEN_CLASS_PRIMITIVE) ? 1 : 0;
+}
+
+int is_end_indicator(const TOKEN *token) {
+	return IS_TOKEN_CLASS(token->type, TOKEN_CLASS_END_INDICATOR) ? 1 : 0;
+}
+
+int is_keyword(TOKEN *token) {
+	return IS_TOKEN_CLASS(token->type, TOKEN_CLASS_KEYWORD) ? 1 : 0;
 }
 
 /**
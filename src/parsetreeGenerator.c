@@ -28,6 +28,9 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include "../headers/errors.h"
 #include "../headers/parsetree.h"
 #include "../headers/Token.h"
+#include "../headers/tokenIndex.h"
+#include "../headers/compilerContext.h"
+#include "../headers/logger.h"
 
 /** 
  * <p>
@@ -51,12 +54,46 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #define true 1
 #define false 0
 
+#define NODE_ARENA_BLOCK_SIZE 65536
+#define NODE_ARENA_ALIGNMENT sizeof(void*)
+
 ////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////     PARSE TREE GENERATOR     ////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////
 
 const int UNINITIALZED = -1;
 
+/**
+ * <p>
+ * A block of the node arena. The nodes, details arrays and generated
+ * values of the tree are bumped into the blocks one after another, so
+ * the nodes of the same statement are next to each other in memory.
+ * </p>
+ * 
+ * <p>
+ * The blocks are chained backwards, the whole tree is released from the
+ * current block of the CompilerContext on (see FREE_NODE()).
+ * </p>
+*/
+struct NodeArenaBlock {
+	struct NodeArenaBlock *previousBlock;
+	size_t capacity;
+	size_t used;
+	char memory[];
+};
+
+/**
+ * <p>
+ * Holds the state while a parsetree is flattened (see PG_flatten_tree()).
+ * The internSlots are an open addressing table of value ids (0 = empty).
+ * </p>
+*/
+struct FlatTreeBuilder {
+	FlatTree *tree;
+	unsigned int *internSlots;
+	size_t internCapacity;
+};
+
 /**
  * <p>
  * Defines a NodeReport, the basic unit of the parsetree generator.
@@ -137,6 +174,8 @@ enum processDirection {
 void PG_print_cpu_time(float cpu_time_used);
 NodeReport PG_create_runnable_tree(TOKEN **tokens, size_t startPos, enum RUNNABLE_TYPE type);
 NodeReport PG_get_report_based_on_token(TOKEN **tokens, size_t startPos, enum RUNNABLE_TYPE type);
+NodeReport PG_create_modified_tree(TOKEN **tokens, size_t startPos);
+NodeReport PG_create_else_tree(TOKEN **tokens, size_t startPos);
 int PG_predict_function_call(TOKEN **tokens, size_t startPos);
 NodeReport PG_create_else_statement_tree(TOKEN **tokens, size_t startPos);
 NodeReport PG_create_else_if_statement_tree(TOKEN **tokens, size_t startPos);
@@ -224,32 +263,67 @@ Node *PG_create_modifier_node(TOKEN *token, int *skip);
 Node *PG_create_node(char *value, enum NodeType type, int line, int pos);
 NodeReport PG_create_node_report(Node *topNode, int tokensToSkip);
 void PG_allocate_node_details(Node *node, size_t size);
+void *PG_arena_allocate(size_t size);
+void *PG_arena_resize(void *memory, size_t oldSize, size_t newSize);
+void PG_add_node_arena_block(size_t minimumCapacity);
+void PG_count_flat_tree_size(Node *node, size_t *nodeCount, size_t *detailsLength);
+unsigned int PG_add_flat_node(struct FlatTreeBuilder *builder, Node *node);
+unsigned int PG_intern_flat_value(struct FlatTreeBuilder *builder, char *value);
+Node *PG_create_node_from_flat_node(FlatTree *tree, unsigned int index);
 void PG_print_from_top_node(Node *topNode, int depth, int pos);
 int FREE_NODE(Node *node);
+Node *PG_create_main_runnable(TOKEN **tokens);
+size_t PG_append_main_statements(Node *runnable, TOKEN **tokens, size_t position, size_t end);
+void PG_record_main_statement(size_t index, size_t position);
+size_t PG_replace_main_statements(Node *root, size_t first, size_t end, Node *runnable, long long lines, long long characters);
+void PG_move_positions(Node *node, long long lines, long long characters);
+void PG_print_parsetree(Node *root);
 
 /**
  * <p>
- * Holds the size of the token array.
+ * Creates the subtree of a statement, that starts with a keyword.
  * </p>
-*/
-extern size_t TOKEN_LENGTH;
+ */
+typedef NodeReport (*NodeRule)(TOKEN **tokens, size_t startPos);
+
+/**
+ * <p>
+ * The rule of every keyword, that starts a statement, indexed by the
+ * token type (see KEYWORD_RUNNABLE_RULES of the syntax analyzer).
+ * Tokens without a rule (NULL) are predicted as an assignment or a term.
+ * </p>
+ */
+const NodeRule STATEMENT_TREE_RULES[TOKEN_TYPE_COUNT] = {
+	[_KW_VAR_] = PG_create_variable_tree,        [_KW_CONST_] = PG_create_variable_tree,
+	[_KW_INCLUDE_] = PG_create_include_tree,     [_KW_EXPORT_] = PG_create_export_tree,
+	[_KW_FOR_] = PG_create_for_statement_tree,   [_KW_ENUM_] = PG_create_enum_tree,
+	[_KW_FUNCTION_] = PG_create_function_tree,   [_KW_CATCH_] = PG_create_catch_tree,
+	[_KW_TRY_] = PG_create_try_tree,             [_KW_CLASS_] = PG_create_class_tree,
+	[_KW_WHILE_] = PG_create_while_statement_tree, [_KW_DO_] = PG_create_do_statement_tree,
+	[_KW_CHECK_] = PG_create_check_statement_tree, [_KW_IF_] = PG_create_if_statement_tree,
+	[_KW_ELSE_] = PG_create_else_tree,           [_KW_CONTINUE_] = PG_create_abort_operation_tree,
+	[_KW_BREAK_] = PG_create_abort_operation_tree, [_KW_RETURN_] = PG_create_return_statement_tree,
+	[_KW_GLOBAL_] = PG_create_modified_tree,     [_KW_SECURE_] = PG_create_modified_tree,
+	[_KW_PRIVATE_] = PG_create_modified_tree
+};
 
 /**
  * <p>
  * This is the entrypoint of the parsetree.
  * </p>
  * 
+ * @param *context  Compilation, that the tokens belong to
  * @param **tokens  Pointer to the token array
- * @param TOKEN_LENGTH   Length of the token array
 */
-Node *GenerateParsetree(TOKEN **tokens) {
-	(void)printf("\n\n\n>>>>>>>>>>>>>>>>>>>>    PARSETREE    <<<<<<<<<<<<<<<<<<<<\n\n");
+Node *GenerateParsetree(struct CompilerContext *context, TOKEN **tokens) {
+	(void)CC_use_context(context);
+	LOG(LOG_PARSETREE, LOG_INFO, "\n\n\n>>>>>>>>>>>>>>>>>>>>    PARSETREE    <<<<<<<<<<<<<<<<<<<<\n\n");
 
-	if (tokens == NULL || TOKEN_LENGTH == 0) {
+	if (tokens == NULL || CURRENT_CONTEXT->tokenLength == 0) {
 		(void)PARSER_TOKEN_TRANSMISSION_EXCEPTION();
 	}
 
-	printf("TOKEN_LENGTH: %li\n", TOKEN_LENGTH);
+	LOG(LOG_PARSETREE, LOG_INFO, "TOKEN_LENGTH: %li\n", CURRENT_CONTEXT->tokenLength);
 
 	// CLOCK FOR DEBUG PURPOSES ONLY!!
 	clock_t start, end;
@@ -265,15 +339,15 @@ Node *GenerateParsetree(TOKEN **tokens) {
 		end = (clock_t)clock();            
 	}
 	
-	if (PARSETREE_GENERATOR_DEBUG_MODE == 1) {
+	if (LG_IS_ENABLED(LOG_PARSETREE, LOG_DEBUG)) {
 		if (runnable.node == NULL) {
-			printf("Something went wrong in the parsetree generation step.");
+			(void)LG_write("Something went wrong in the parsetree generation step.");
 		} else {
 			(void)PG_print_from_top_node(runnable.node, 0, 0);
 		}
 	}
 
-	if (PARSETREE_GENERATOR_DISPLAY_USED_TIME == 1) {
+	if (PARSETREE_GENERATOR_DISPLAY_USED_TIME == 1 && LG_IS_ENABLED(LOG_PARSETREE, LOG_INFO)) {
 		(void)PG_print_cpu_time(((double) (end - start)) / CLOCKS_PER_SEC);
 	}
 
@@ -281,11 +355,209 @@ Node *GenerateParsetree(TOKEN **tokens) {
 		printf("Something went wrong (PG)!\n");
 	}
 
-	(void)printf("\n\n\n>>>>>    Tokens converted to tree    <<<<<\n\n");
+	LOG(LOG_PARSETREE, LOG_INFO, "\n\n\n>>>>>    Tokens converted to tree    <<<<<\n\n");
 
+	CURRENT_CONTEXT->root = runnable.node;
 	return runnable.node;
 }
 
+/**
+ * <p>
+ * Creates the top [RUNNABLE] node for GenerateCheckedParsetree(),
+ * the streaming front end and the edits.
+ * </p>
+ * 
+ * <p>
+ * The statements are appended by PG_append_main_statements(), after
+ * the syntax analyzer accepted them.
+ * </p>
+ * 
+ * @returns The empty [RUNNABLE] node
+ * 
+ * @param **tokens  Pointer to the token array
+ */
+Node *PG_create_main_runnable(TOKEN **tokens) {
+	if (tokens == NULL || CURRENT_CONTEXT->tokenLength == 0) {
+		(void)PARSER_TOKEN_TRANSMISSION_EXCEPTION();
+	}
+
+	TOKEN *token = &(*tokens)[0];
+	return PG_create_node("RUNNABLE", _RUNNABLE_NODE_, token->line, token->tokenStart);
+}
+
+/**
+ * <p>
+ * Builds the statements of the main runnable from `position` on and
+ * appends them to the [RUNNABLE] node, like PG_create_runnable_tree() does.
+ * </p>
+ * 
+ * <p>
+ * Only statements that start before `end` are built, so the streaming
+ * front end can build the checked statements of a window.
+ * </p>
+ * 
+ * @returns Position of the next statement, the token length if the runnable is complete
+ * 
+ * @param *runnable Node created by PG_create_main_runnable()
+ * @param **tokens  Pointer to the token array
+ * @param position  Position of the next statement to build
+ * @param end       Position till where the tokens are checked
+ */
+size_t PG_append_main_statements(Node *runnable, TOKEN **tokens, size_t position, size_t end) {
+	while (position < end && position < CURRENT_CONTEXT->tokenLength) {
+		TOKEN *currentToken = &(*tokens)[position];
+
+		if (currentToken->type == _OP_LEFT_BRACE_
+			|| currentToken->type == __EOF__) {
+			return CURRENT_CONTEXT->tokenLength;
+		}
+
+		NodeReport report = PG_get_report_based_on_token(tokens, position, Main);
+
+		if (report.node != NULL) {
+			unsigned int index = runnable->detailsCount;
+			(void)PG_allocate_node_details(runnable, index + 1);
+
+			if (CURRENT_CONTEXT->keepEditBase == true) {
+				(void)PG_record_main_statement(index, position);
+			}
+
+			runnable->details[index] = report.node;
+			position += report.tokensToSkip;
+		} else {
+			position++;
+		}
+	}
+
+	return position;
+}
+
+/**
+ * <p>
+ * Stores the token position of a new detail of the main runnable, so the
+ * statement boundaries of the edit base can be mapped to the details
+ * (see CheckEditAndUpdateParsetree()).
+ * </p>
+ * 
+ * @param index     Index of the detail
+ * @param position  Position of the first token of the statement
+ */
+void PG_record_main_statement(size_t index, size_t position) {
+	if (index >= CURRENT_CONTEXT->mainStatementCapacity) {
+		size_t capacity = CURRENT_CONTEXT->mainStatementCapacity == 0 ? 64 : CURRENT_CONTEXT->mainStatementCapacity * 2;
+		size_t *starts = (size_t*)realloc(CURRENT_CONTEXT->mainStatementStarts, sizeof(size_t) * capacity);
+
+		if (starts == NULL) {
+			(void)CC_abort_compilation("Could not reserve the statement starts.", 0, 0);
+			return;
+		}
+
+		CURRENT_CONTEXT->mainStatementStarts = starts;
+		CURRENT_CONTEXT->mainStatementCapacity = capacity;
+	}
+
+	CURRENT_CONTEXT->mainStatementStarts[index] = position;
+	CURRENT_CONTEXT->mainStatementCount = index + 1;
+}
+
+/**
+ * <p>
+ * Replaces details of the root with the details of another runnable and
+ * moves the details behind them by the lines and characters of the edit.
+ * </p>
+ * 
+ * <p>
+ * The arena can't release single nodes, so the replaced nodes are only
+ * counted (replacedNodes of the context). The new details array is
+ * reserved in the arena as well.
+ * </p>
+ * 
+ * @returns The number of new details
+ * 
+ * @param *root         Root of the parsetree
+ * @param first         Index of the first replaced detail
+ * @param end           Index behind the last replaced detail, (size_t)-1 for all details up to the end
+ * @param *runnable     Runnable with the new details
+ * @param lines         Number of lines to move the details behind
+ * @param characters    Number of characters to move the details behind
+ */
+size_t PG_replace_main_statements(Node *root, size_t first, size_t end, Node *runnable, long long lines, long long characters) {
+	end = end < root->detailsCount ? end : (size_t)root->detailsCount;
+	size_t count = end - first;
+	size_t detailsCount = (size_t)root->detailsCount - count + (size_t)runnable->detailsCount;
+	Node **details = (Node**)PG_arena_allocate(sizeof(Node*) * (detailsCount > 0 ? detailsCount : 1));
+	size_t detailsLength = 0;
+
+	for (size_t i = first; i < end; i++) {
+		(void)PG_count_flat_tree_size(root->details[i], &CURRENT_CONTEXT->replacedNodes, &detailsLength);
+	}
+
+	for (size_t i = 0; i < first; i++) {
+		details[i] = root->details[i];
+	}
+
+	for (unsigned int i = 0; i < runnable->detailsCount; i++) {
+		details[first + i] = runnable->details[i];
+	}
+
+	for (size_t i = end; i < root->detailsCount; i++) {
+		details[i - count + runnable->detailsCount] = root->details[i];
+
+		if (lines != 0 || characters != 0) {
+			(void)PG_move_positions(root->details[i], lines, characters);
+		}
+	}
+
+	root->details = details;
+	root->detailsCount = (unsigned int)detailsCount;
+	return (size_t)runnable->detailsCount;
+}
+
+/**
+ * <p>
+ * Moves the lines and positions of a subtree, e.g. behind an edit. The
+ * nodes at the EOF ((unsigned int)-1) keep their position.
+ * </p>
+ * 
+ * @param *node         Node to start from
+ * @param lines         Number of lines to move
+ * @param characters    Number of characters to move
+ */
+void PG_move_positions(Node *node, long long lines, long long characters) {
+	if (node == NULL) {
+		return;
+	}
+
+	node->line = node->line != (unsigned int)-1 ? (unsigned int)((long long)node->line + lines) : node->line;
+	node->position = node->position != (unsigned int)-1 ? (unsigned int)((long long)node->position + characters) : node->position;
+
+	for (unsigned int i = 0; i < node->detailsCount; i++) {
+		(void)PG_move_positions(node->details[i], lines, characters);
+	}
+
+	(void)PG_move_positions(node->leftNode, lines, characters);
+	(void)PG_move_positions(node->rightNode, lines, characters);
+}
+
+/**
+ * <p>
+ * Prints the parsetree output of GenerateCheckedParsetree(), which is
+ * the same as the one of GenerateParsetree().
+ * </p>
+ * 
+ * @param *root     Root of the generated parsetree
+ */
+void PG_print_parsetree(Node *root) {
+	LOG(LOG_PARSETREE, LOG_INFO, "\n\n\n>>>>>>>>>>>>>>>>>>>>    PARSETREE    <<<<<<<<<<<<<<<<<<<<\n\n");
+	LOG(LOG_PARSETREE, LOG_INFO, "TOKEN_LENGTH: %li\n", CURRENT_CONTEXT->tokenLength + CURRENT_CONTEXT->releasedTokens);
+
+	if (LG_IS_ENABLED(LOG_PARSETREE, LOG_DEBUG)) {
+		(void)PG_print_from_top_node(root, 0, 0);
+	}
+
+	LOG(LOG_PARSETREE, LOG_INFO, "\n\n\n>>>>>    Tokens converted to tree    <<<<<\n\n");
+}
+
 /**
  * <p>
  * Prints the used CPU time of the measured time.
@@ -294,7 +566,7 @@ Node *GenerateParsetree(TOKEN **tokens) {
  * @param cpu_time_used Used CPU time
  */
 void PG_print_cpu_time(float cpu_time_used) {
-	(void)printf("\nCPU time used for PARSETREE GENERATION: %f seconds\n", cpu_time_used);
+	(void)LG_write("\nCPU time used for PARSETREE GENERATION: %f seconds\n", cpu_time_used);
 }
 
 /**
@@ -342,7 +614,7 @@ NodeReport PG_create_runnable_tree(TOKEN **tokens, size_t startPos, enum RUNNABL
 	int argumentCount = 0;
 	size_t jumper = 0;
 	
-	while (startPos + jumper < TOKEN_LENGTH) {
+	while (startPos + jumper < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
 		if (currentToken->type == _OP_LEFT_BRACE_) {
@@ -361,21 +633,7 @@ NodeReport PG_create_runnable_tree(TOKEN **tokens, size_t startPos, enum RUNNABL
 		NodeReport report = PG_get_report_based_on_token(tokens, startPos + jumper, type);
 
 		if (report.node != NULL) {
-			if (argumentCount == 0) {
-				(void)PG_allocate_node_details(parentNode, 1);
-			} else {
-				Node **temp = (Node**)realloc(parentNode->details, sizeof(Node) * argumentCount + 1);
-
-				if (temp == NULL) {
-					free(parentNode->details);
-					FREE_MEMORY();
-					printf("Something went wrong (runnable)!\n");
-					exit(EXIT_FAILURE);
-				}
-
-				parentNode->details = temp;
-				parentNode->detailsCount = argumentCount + 1;
-			}
+			(void)PG_allocate_node_details(parentNode, argumentCount + 1);
 
 			parentNode->details[argumentCount++] = report.node;
 			jumper += report.tokensToSkip;
@@ -410,86 +668,80 @@ NodeReport PG_get_report_based_on_token(TOKEN **tokens, size_t startPos, enum RU
 		return PG_create_is_statement_tree(tokens, startPos);
 	}
 	
-	switch ((*tokens)[startPos].type) {
-	case _KW_VAR_:
-	case _KW_CONST_:
-		return PG_create_variable_tree(tokens, startPos);
-	case _KW_INCLUDE_:
-		return PG_create_include_tree(tokens, startPos);
-	case _KW_EXPORT_:
-		return PG_create_export_tree(tokens, startPos);
-	case _KW_FOR_:
-		return PG_create_for_statement_tree(tokens, startPos);
-	case _KW_ENUM_:
-		return PG_create_enum_tree(tokens, startPos);
+	TOKENTYPES tokenType = (*tokens)[startPos].type;
+	NodeRule rule = (unsigned int)tokenType < TOKEN_TYPE_COUNT ? STATEMENT_TREE_RULES[tokenType] : NULL;
+
+	if (rule != NULL) {
+		return rule(tokens, startPos);
+	} else if (tokenType == _KW_THIS_
+		&& (*tokens)[startPos + 3].type == _KW_CONSTRUCTOR_) {
+		return PG_create_class_constructor_tree(tokens, startPos);
+	} else if (tokenType == _OP_SEMICOLON_) {
+		return PG_create_node_report(NULL, UNINITIALZED);
+	}
+
+	if ((int)PG_predict_assignment(tokens, startPos) == true) {
+		return PG_create_simple_assignment_tree(tokens, startPos);
+	}
+
+	int fncCallBounds = (int)PG_predict_function_call(tokens, startPos);
+
+	if (fncCallBounds > 0) {
+		return PG_create_simple_term_node(tokens, startPos, fncCallBounds);
+	}
+
+	return PG_create_node_report(NULL, UNINITIALZED);
+}
+
+/**
+ * <p>
+ * Creates the subtree of a variable, function or class with a
+ * visibility modifier.
+ * </p>
+ * 
+ * @returns The NodeReport with the built subtree, an empty report if
+ *          the modifier is not followed by a declaration
+ * 
+ * @param **tokens  Pointer to the token array
+ * @param startPos  Position of the modifier
+ */
+NodeReport PG_create_modified_tree(TOKEN **tokens, size_t startPos) {
+	switch ((*tokens)[startPos + 1].type) {
 	case _KW_FUNCTION_:
 		return PG_create_function_tree(tokens, startPos);
-	case _KW_CATCH_:
-		return PG_create_catch_tree(tokens, startPos);
-	case _KW_TRY_:
-		return PG_create_try_tree(tokens, startPos);
 	case _KW_CLASS_:
 		return PG_create_class_tree(tokens, startPos);
-	case _KW_WHILE_:
-		return PG_create_while_statement_tree(tokens, startPos);
-	case _KW_DO_:
-		return PG_create_do_statement_tree(tokens, startPos);
-	case _KW_CHECK_:
-		return PG_create_check_statement_tree(tokens, startPos);
-	case _KW_IF_:
-		return PG_create_if_statement_tree(tokens, startPos);
-	case _KW_ELSE_:
-		if ((*tokens)[startPos + 1].type == _KW_IF_) {
-			return PG_create_else_if_statement_tree(tokens, startPos);
-		} else {
-			return PG_create_else_statement_tree(tokens, startPos);
-		}
-	case _KW_CONTINUE_:
-	case _KW_BREAK_:
-		return PG_create_abort_operation_tree(tokens, startPos);
-	case _KW_RETURN_:
-		return PG_create_return_statement_tree(tokens, startPos);
-	case _KW_GLOBAL_:
-	case _KW_SECURE_:
-	case _KW_PRIVATE_:
-		if ((*tokens)[startPos + 1].type == _KW_FUNCTION_) {
-			return PG_create_function_tree(tokens, startPos);
-		} else if ((*tokens)[startPos + 1].type == _KW_CLASS_) {
-			return PG_create_class_tree(tokens, startPos);
-		} else if ((*tokens)[startPos + 1].type == _KW_VAR_
-			|| (*tokens)[startPos + 1].type == _KW_CONST_) {
-			return PG_create_variable_tree(tokens, startPos);
-		}
-		break;
+	case _KW_VAR_:
+	case _KW_CONST_:
+		return PG_create_variable_tree(tokens, startPos);
 	default:
-		if ((*tokens)[startPos].type == _KW_THIS_
-			&& (*tokens)[startPos + 3].type == _KW_CONSTRUCTOR_) {
-			return PG_create_class_constructor_tree(tokens, startPos);
-		} else if ((*tokens)[startPos].type == _OP_SEMICOLON_) {
-			break;
-		}
-
-		if ((int)PG_predict_assignment(tokens, startPos) == true) {
-			return PG_create_simple_assignment_tree(tokens, startPos);
-		}
-
-		int fncCallBounds = (int)PG_predict_function_call(tokens, startPos);
-
-		if (fncCallBounds > 0) {
-			return PG_create_simple_term_node(tokens, startPos, fncCallBounds);
-		}
+		return PG_create_node_report(NULL, UNINITIALZED);
+	}
+}
 
-		break;
+/**
+ * <p>
+ * Creates the subtree of an else or an else-if statement.
+ * </p>
+ * 
+ * @returns The NodeReport with the built subtree
+ * 
+ * @param **tokens  Pointer to the token array
+ * @param startPos  Position of the else keyword
+ */
+NodeReport PG_create_else_tree(TOKEN **tokens, size_t startPos) {
+	if ((*tokens)[startPos + 1].type == _KW_IF_) {
+		return PG_create_else_if_statement_tree(tokens, startPos);
 	}
 
-	return PG_create_node_report(NULL, UNINITIALZED);
+	return PG_create_else_statement_tree(tokens, startPos);
 }
 
 //// TEMPORARELY!!!
 int PG_predict_function_call(TOKEN **tokens, size_t startPos) {
 	int counter = 0;
 
-	while (startPos + counter < TOKEN_LENGTH) {
+	while (startPos + counter < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *token = &(*tokens)[startPos + counter];
 
 		if (token->type == _OP_SEMICOLON_) {
@@ -685,7 +937,7 @@ NodeReport PG_create_for_statement_tree(TOKEN **tokens, size_t startPos) {
  * </ul>
  */
 int PG_predict_assignment(TOKEN **tokens, size_t startPos) {
-	for (int i = startPos; i < TOKEN_LENGTH; i++) {
+	for (int i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		switch ((*tokens)[i].type) {
 		case _OP_SEMICOLON_:
 			return false;
@@ -740,7 +992,7 @@ int PG_get_term_bounds(TOKEN **tokens, size_t startPos) {
 	int openBrackets = 0;
 	int openEdgeBrackets = 0;
 
-	for (int i = startPos; i < TOKEN_LENGTH; i++) {
+	for (int i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		switch ((*tokens)[i].type) {
 		case _OP_LEFT_BRACKET_:
 			openBrackets--;
@@ -752,6 +1004,12 @@ int PG_get_term_bounds(TOKEN **tokens, size_t startPos) {
 
 			break;
 		case _OP_RIGHT_BRACKET_:
+			// A closed term can not end the term, so it is skipped as a whole
+			if ((int)TI_is_closed_term(*tokens, i) == true) {
+				i = (int)TI_get_match(*tokens, i);
+				break;
+			}
+
 			openBrackets++;
 			break;
 		case _OP_LEFT_EDGE_BRACKET_:
@@ -791,13 +1049,7 @@ int PG_get_term_bounds(TOKEN **tokens, size_t startPos) {
  * </ul>
  */
 int PG_is_calculation_operator(TOKEN *token) {
-	switch (token->type) {
-	case _OP_PLUS_:     case _OP_MINUS_:
-	case _OP_MULTIPLY_: case _OP_DIVIDE_:
-	case _OP_MODULU_:
-		return true;
-	default: return false;
-	}
+	return IS_TOKEN_CLASS(token->type, TOKEN_CLASS_ARITHMETIC) ? true : false;
 }
 
 /**
@@ -878,7 +1130,7 @@ NodeReport PG_create_simple_assignment_tree(TOKEN **tokens, size_t startPos) {
 int PG_predict_member_access(TOKEN **tokens, size_t startPos, enum CONDITION_TYPE type) {
 	int openEdgeBrackets = 0;
 
-	for (int i = startPos; i < TOKEN_LENGTH; i++) {
+	for (int i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		TOKEN *tok = &(*tokens)[i];
 
 		if ((int)PG_is_calculation_operator(tok) == true
@@ -939,7 +1191,7 @@ NodeReport PG_create_increment_decrement_tree(TOKEN **tokens, size_t startPos) {
 	Node *topNode = PG_create_node("SASS", _SIMPLE_INC_DEC_ASS_NODE_, (*tokens)[startPos].line, (*tokens)[startPos].tokenStart);
 	Node *cache = NULL;
 	
-	while (startPos + skip < TOKEN_LENGTH
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength
 		&& breakLoop == false) {
 		TOKEN *currentToken = &(*tokens)[startPos + skip];
 		Node *currentNode = NULL;
@@ -1006,7 +1258,7 @@ int PG_predict_increment_or_decrement_assignment(TOKEN **tokens, size_t startPos
 	int openBrackets = 0;
 	int openEdgeBrackets = 0;
 	
-	for (int i = startPos; i < TOKEN_LENGTH; i++) {
+	for (int i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		TOKEN *curTok = &(*tokens)[i];
 
 		if (curTok->type == _OP_LEFT_BRACKET_) {
@@ -1316,7 +1568,7 @@ enum VAR_TYPE get_var_type(TOKEN **tokens, size_t startPos) {
 	int equalsPassed = false;
 	int colonSkip = 0;
 
-	for (size_t i = startPos; i < TOKEN_LENGTH; i++) {
+	for (size_t i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		if (colonBefore == true) {
 			if (colonSkip > 0 && (*tokens)[i].type == _IDENTIFIER_) {
 				colonBefore = false;
@@ -1441,7 +1693,7 @@ NodeReport PG_create_condition_assignment_tree(TOKEN **tokens, size_t startPos)
 	*/
 	NodeReport trueValue = {NULL, UNINITIALZED};
 	
-	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, TOKEN_LENGTH) == true) {
+	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, CURRENT_CONTEXT->tokenLength) == true) {
 		trueValue = PG_create_condition_assignment_tree(tokens, startPos + skip);
 	} else {
 		int bounds = PG_get_cond_assignment_bounds(tokens, startPos + skip);
@@ -1454,7 +1706,7 @@ NodeReport PG_create_condition_assignment_tree(TOKEN **tokens, size_t startPos)
 
 	NodeReport falseValue = {NULL, UNINITIALZED};
 	
-	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, TOKEN_LENGTH) == true) {
+	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, CURRENT_CONTEXT->tokenLength) == true) {
 		falseValue = PG_create_condition_assignment_tree(tokens, startPos + skip);
 	} else {
 		int bounds = PG_get_cond_assignment_bounds(tokens, startPos + skip);
@@ -1527,7 +1779,7 @@ Params: TOKEN **tokens => Pointer to the tokens;
 int PG_get_cond_assignment_bounds(TOKEN **tokens, size_t startPos) {
 	int skip = 0;
 
-	while (startPos + skip < TOKEN_LENGTH) {
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength) {
 		if ((*tokens)[startPos + skip].type == _OP_SEMICOLON_
 			|| (*tokens)[startPos + skip].type == _OP_COLON_) {
 			break;
@@ -1647,7 +1899,7 @@ NodeReport PG_create_array_creation_tree(TOKEN **tokens, size_t startPos) {
 	(void)PG_allocate_node_details(topNode, dims);
 	int currentDetail = 0;
 
-	while (startPos + skip < TOKEN_LENGTH
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength
 		&& (*tokens)[startPos + skip].type != _OP_SEMICOLON_) {
 		if ((*tokens)[startPos + skip].type != _OP_RIGHT_EDGE_BRACKET_) {
 			break;
@@ -1668,7 +1920,7 @@ int PG_predict_array_creation_dimension_count(TOKEN **tokens, size_t startPos) {
 	int dims = 0;
 	int openEdgeBrackets = 0;
 
-	while (startPos + jumper < TOKEN_LENGTH) {
+	while (startPos + jumper < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 	
 		if (currentToken->type == _OP_SEMICOLON_) {
@@ -1703,13 +1955,7 @@ _______________________________
 */
 NodeReport PG_create_array_init_tree(TOKEN **tokens, size_t startPos, int dim) {
 	unsigned int size = sizeof(char) * sizeof(int);
-	char *name = (char*)calloc(dim + 2, size);
-
-	if (name == NULL) {
-		FREE_MEMORY();
-		printf("NAME ERROR!\n");
-		exit(EXIT_FAILURE);
-	}
+	char *name = (char*)PG_arena_allocate((dim + 2) * size);
 
 	//Automatic '\0' added
 	(void)snprintf(name, size, "d_%i", dim);
@@ -1720,7 +1966,7 @@ NodeReport PG_create_array_init_tree(TOKEN **tokens, size_t startPos, int dim) {
 	int argCount = (int)PG_predict_array_init_count(tokens, startPos);
 	(void)PG_allocate_node_details(topNode, argCount);
 
-	while (startPos + jumper < TOKEN_LENGTH && running == true) {
+	while (startPos + jumper < CURRENT_CONTEXT->tokenLength && running == true) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 		
 		switch (currentToken->type) {
@@ -1776,13 +2022,24 @@ int PG_predict_array_init_count(TOKEN **tokens, size_t startPos) {
 	int isRunning = true;
 	TOKEN *prevToken = &(*tokens)[startPos];
 
-	while (startPos + jumper < TOKEN_LENGTH && isRunning == true) {
+	while (startPos + jumper < CURRENT_CONTEXT->tokenLength && isRunning == true) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
 		switch (currentToken->type) {
-		case _OP_RIGHT_BRACE_:
+		case _OP_RIGHT_BRACE_: {
+			// Nested dimensions are skipped, if they contain no ';'
+			unsigned int match = (unsigned int)TI_get_match(*tokens, startPos + jumper);
+
+			if (match != TI_NONE
+				&& (unsigned int)TI_get_next_semicolon(*tokens, startPos + jumper) > match) {
+				jumper = match - startPos;
+				currentToken = &(*tokens)[match];
+				break;
+			}
+
 			openBraces++;
 			break;
+		}
 		case _OP_COMMA_:
 			if (openBraces == 0) {
 				count += count == 0 ? 2 : count > 0 ? 1 : 0;
@@ -1827,7 +2084,7 @@ int PG_add_dimensions_to_var_node(Node *node, TOKEN **tokens, size_t startPos, i
 	size_t jumper = 0;
 	size_t currentDetail = offset;
 
-	while (startPos + jumper < TOKEN_LENGTH) {
+	while (startPos + jumper < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
 		if (currentToken->type == _OP_RIGHT_EDGE_BRACKET_) {
@@ -1878,7 +2135,7 @@ Params: TOKEN **tokens => Pointer to the tokens;
 int PG_get_dimension_count(TOKEN **tokens, size_t startPos) {
 	int counter = 0;
 
-	for (size_t i = startPos; i < TOKEN_LENGTH; i++) {
+	for (size_t i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		if ((*tokens)[i].type == _OP_RIGHT_EDGE_BRACKET_) {
 			counter++;
 		} else if ((*tokens)[i].type == _OP_EQUALS_
@@ -1983,7 +2240,7 @@ NodeReport PG_create_chained_condition_tree(TOKEN **tokens, const size_t startPo
 	size_t skip = 0;
 	int hasLogicOperators = (int)PG_contains_logical_operator(tokens, startPos);
 
-	while (skip < TOKEN_LENGTH && hasLogicOperators == true) {
+	while (skip < CURRENT_CONTEXT->tokenLength && hasLogicOperators == true) {
 		TOKEN *currentToken = &(*tokens)[startPos + skip];
 
 		switch (currentToken->type) {
@@ -2061,7 +2318,7 @@ NodeReport PG_create_chained_condition_tree(TOKEN **tokens, const size_t startPo
 int PG_is_logic_operator_bracket(TOKEN **tokens, size_t startPos) {
 	int openBrackets = 0;
 	
-	for (int i = startPos; i < TOKEN_LENGTH; i++) {
+	for (int i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		switch ((*tokens)[i].type) {
 		case _KW_AND_:
 		case _KW_OR_:
@@ -2088,7 +2345,7 @@ int PG_is_logic_operator_bracket(TOKEN **tokens, size_t startPos) {
 }
 
 int PG_contains_logical_operator(TOKEN **tokens, size_t startPos) {
-	for (int i = startPos; i < TOKEN_LENGTH; i++) {
+	for (int i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		if ((*tokens)[i].type == _KW_AND_
 			|| (*tokens)[i].type == _KW_OR_) {
 			return true;
@@ -2111,7 +2368,7 @@ Params: TOKEN **tokens => Point to the tokens array;
 NodeReport PG_create_condition_tree(TOKEN **tokens, size_t startPos) {
 	size_t skip = 0;
 
-	while (startPos + skip < TOKEN_LENGTH) {
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + skip];
 
 		if ((int)PG_is_condition_operator(currentToken->type) == true) {
@@ -2144,7 +2401,7 @@ int PG_get_condition_iden_length(TOKEN **tokens, size_t startPos) {
 	int counter = 0;
 	int openBrackets = 0;
 
-	while (startPos + counter < TOKEN_LENGTH) {
+	while (startPos + counter < CURRENT_CONTEXT->tokenLength) {
 		if ((int)PG_is_condition_operator((*tokens)[startPos + counter].type) == true) {
 			break;
 		} else if ((*tokens)[startPos + counter].type == _OP_SEMICOLON_) {
@@ -2446,7 +2703,7 @@ NodeReport PG_create_enum_tree(TOKEN **tokens, size_t startPos) {
 	size_t skip = 2;
 	int currentEnumeratorValue = 0;
 
-	while (startPos + skip < TOKEN_LENGTH) {
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + skip];
 
 		if (currentToken->type == _OP_LEFT_BRACE_) {
@@ -2455,8 +2712,9 @@ NodeReport PG_create_enum_tree(TOKEN **tokens, size_t startPos) {
 		}
 
 		if (argumentCount > enumNode->detailsCount) {
+			(void)CC_abort_compilation("Enumerator count exceeds the reserved details.", enumNode->line + 1, 0);
 			FREE_MEMORY();
-			printf("SIZE (enum) %li!\n", enumNode->detailsCount);
+			printf("SIZE (enum) %u!\n", enumNode->detailsCount);
 			exit(EXIT_FAILURE);
 		}
 
@@ -2477,14 +2735,7 @@ NodeReport PG_create_enum_tree(TOKEN **tokens, size_t startPos) {
 			}
 
 			//Size for long
-			char *value = (char*)calloc(24, sizeof(char));
-
-			if (value == NULL) {
-				FREE_MEMORY();
-				printf("VALUE = NULL! (enum)\n");
-				exit(EXIT_FAILURE);
-			}
-
+			char *value = (char*)PG_arena_allocate(24 * sizeof(char));
 			(void)snprintf(value, 24, "%d", currentEnumeratorValue++);
 			enumeratorNode->rightNode = PG_create_node(value, _VALUE_NODE_, token->line, token->tokenStart);
 			enumNode->details[argumentCount++] = enumeratorNode;
@@ -2507,7 +2758,7 @@ int PG_predict_enumerator_count(TOKEN **tokens, size_t starPos) {
 	int enumCount = 1;
 	int jumper = 0;
 
-	while (starPos + jumper < TOKEN_LENGTH) {
+	while (starPos + jumper < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *currentToken = &(*tokens)[starPos + jumper];
 
 		if (currentToken->type == _OP_LEFT_BRACE_) {
@@ -2638,7 +2889,7 @@ size_t PG_add_params_to_node(Node *node, TOKEN **tokens, size_t startPos, int ad
 	int detailsPointer = addStart;
 	int skip = 0;
 
-	for (size_t i = startPos; i < TOKEN_LENGTH; skip = i - startPos, i++) {
+	for (size_t i = startPos; i < CURRENT_CONTEXT->tokenLength; skip = i - startPos, i++) {
 		TOKEN *currentToken = &(*tokens)[i];
 
 		if (currentToken->type != _OP_LEFT_BRACKET_
@@ -2654,7 +2905,7 @@ size_t PG_add_params_to_node(Node *node, TOKEN **tokens, size_t startPos, int ad
 
 			NodeReport report = {NULL, -1};
 
-			if ((int)predict_is_conditional_assignment_type(tokens, i, TOKEN_LENGTH) == true) {
+			if ((int)predict_is_conditional_assignment_type(tokens, i, CURRENT_CONTEXT->tokenLength) == true) {
 				report = PG_create_condition_assignment_tree(tokens, i);
 			} else {
 				int bounds = (int)PG_get_bound_of_single_param(tokens, i);
@@ -2686,7 +2937,7 @@ int PG_get_bound_of_single_param(TOKEN **tokens, size_t startPos) {
 	int bound = 0;
 	int openBrackets = 0;
 
-	for (size_t i = startPos; i < TOKEN_LENGTH; i++) {
+	for (size_t i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		TOKEN *token = &(*tokens)[i];
 
 		if ((token->type == _OP_COMMA_ || token->type == _OP_CLASS_CREATOR_
@@ -2730,7 +2981,7 @@ int PG_predict_argument_count(TOKEN **tokens, size_t startPos, int withPredefine
 	int count = 0;
 	int openBrackets = withPredefinedBrackets;
 
-	for (size_t i = startPos; i < TOKEN_LENGTH; i++) {
+	for (size_t i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		TOKEN *token = &(*tokens)[i];
 		
 		if (token->type == _OP_COMMA_) {
@@ -2797,6 +3048,12 @@ int PG_predict_primitive_param_count(TOKEN **tokens, size_t startPos) {
  * @param startPos  Position from where to start counting
  */
 size_t PG_get_size_till_next_semicolon(TOKEN **tokens, size_t startPos) {
+	unsigned int nextSemicolon = (unsigned int)TI_get_next_semicolon(*tokens, startPos);
+
+	if (nextSemicolon != TI_NONE) {
+		return nextSemicolon - startPos;
+	}
+
 	size_t size = 0;
 
 	while ((*tokens)[startPos + size].type != _OP_SEMICOLON_) {
@@ -2820,32 +3077,19 @@ size_t PG_get_size_till_next_semicolon(TOKEN **tokens, size_t startPos) {
  */
 void PG_allocate_node_details(Node *node, size_t size) {
 	if (node == NULL) {
+		(void)CC_abort_compilation("Node details were allocated for a NULL node.", 0, 0);
 		FREE_MEMORY();
 		printf("NODE NULL\n");
 		exit(EXIT_FAILURE);
 	}
 
-	Node **temp = NULL;
-	int resize = node->details == NULL ? false : true;
-
-	if (resize == false) {
-		temp = (Node**)calloc(size, sizeof(Node*));
-	} else {
-		temp = (Node**)realloc(node->details, sizeof(Node) * size);
-
-		for (int i = node->detailsCount; i < size; i++) {
-			node->details[i] = NULL;
-		}
+	if (node->details == NULL) {
+		node->details = (Node**)PG_arena_allocate(sizeof(Node*) * size);
+	} else if (size > node->detailsCount) {
+		// The new entries are always NULL, the arena only hands out zeroed memory
+		node->details = (Node**)PG_arena_resize(node->details, sizeof(Node*) * node->detailsCount, sizeof(Node*) * size);
 	}
 
-	if (temp == NULL) {
-		free(node->details);
-		FREE_MEMORY();
-		printf("DETAILS ERROR!\n");
-		exit(EXIT_FAILURE);
-	}
-	
-	node->details = temp;
 	node->detailsCount = size;
 }
 
@@ -2863,31 +3107,31 @@ void PG_print_from_top_node(Node *topNode, int depth, int pos) {
 
 	for (int i = 0; i < depth; ++i) {
 		if (i + 1 == depth) {
-			(void)printf("+-- ");
+			(void)LG_write("+-- ");
 		} else {
-			(void)printf("|   ");
+			(void)LG_write("|   ");
 		}
 	}
 
 	if (pos == 0) {
-		(void)printf("C: %s -> %i\n", topNode->value, topNode->type);
+		(void)LG_write("C: %s -> %i\n", topNode->value, topNode->type);
 	} else if (pos == 1) {
-		(void)printf("L: %s -> %i\n", topNode->value, topNode->type);
+		(void)LG_write("L: %s -> %i\n", topNode->value, topNode->type);
 	} else {
-		(void)printf("R: %s -> %i\n", topNode->value, topNode->type);
+		(void)LG_write("R: %s -> %i\n", topNode->value, topNode->type);
 	}
 
 	for (int i = 0; i < topNode->detailsCount; i++) {
 		if (topNode->details[i] != NULL) {
 			for (int n = 0; n < depth + 1; n++) {
 				if (n + 1 == depth + 1) {
-					(void)printf("+-- ");
+					(void)LG_write("+-- ");
 				} else {
-					(void)printf("|   ");
+					(void)LG_write("|   ");
 				}
 			}
 
-			(void)printf("(%s) detail: %s -> %i\n", topNode->value, topNode->details[i]->value, topNode->details[i]->type);
+			(void)LG_write("(%s) detail: %s -> %i\n", topNode->value, topNode->details[i]->value, topNode->details[i]->type);
 			(void)PG_print_from_top_node(topNode->details[i]->leftNode, depth + 2, 1);
 			(void)PG_print_from_top_node(topNode->details[i]->rightNode, depth + 2, 2);
 
@@ -2895,7 +3139,7 @@ void PG_print_from_top_node(Node *topNode, int depth, int pos) {
 				(void)PG_print_from_top_node(topNode->details[i]->details[n], depth + 2, 0);
 			}
 		} else {
-			(void)printf("(%s) detail: NULL -> NULL\n", topNode->value);
+			(void)LG_write("(%s) detail: NULL -> NULL\n", topNode->value);
 		}
 	}
 
@@ -3116,7 +3360,7 @@ int PG_forward_till_plus_or_minus(TOKEN **tokens, size_t startPos) {
 	int skip = 0;
 	int openBrackets = 0;
 
-	while (startPos + skip < TOKEN_LENGTH) {
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *tok = &(*tokens)[startPos + skip];
 
 		if (tok->type == _OP_PLUS_
@@ -3189,7 +3433,7 @@ NodeReport PG_create_array_access_tree(TOKEN **tokens, size_t startPos) {
 	int skip = 0;
 	
 	while ((*tokens)[startPos + skip].type == _OP_RIGHT_EDGE_BRACKET_
-		&& startPos + skip < TOKEN_LENGTH) {
+		&& startPos + skip < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *tok = &(*tokens)[startPos + skip];
 		Node *arrAccNode = PG_create_node("ARR_ACC", _ARRAY_ACCESS_NODE_, tok->line, tok->tokenStart);
 		NodeReport rep = {NULL, 0};
@@ -3253,6 +3497,12 @@ size_t PG_go_backwards_till_operator(TOKEN **tokens, size_t startPos) {
  * @param startPos  Position from where to start determining to bounds
  */
 int PG_determine_bounds_for_capsulated_term(TOKEN **tokens, size_t startPos) {
+	unsigned int match = (unsigned int)TI_get_match(*tokens, startPos);
+
+	if (match != TI_NONE && (*tokens)[startPos].type == _OP_RIGHT_BRACKET_) {
+		return match - startPos;
+	}
+
 	size_t bounds = 0;
 	int openBrackets = 0;
 
@@ -3293,7 +3543,7 @@ int PG_is_next_operator_multiply_divide_or_modulo(TOKEN **tokens, size_t startPo
 	int jumper = 0;
 	int openBrackets = 0;
 	
-	while (startPos + jumper < TOKEN_LENGTH) {
+	while (startPos + jumper < CURRENT_CONTEXT->tokenLength) {
 		switch ((*tokens)[startPos + jumper].type) {
 		case _OP_PLUS_:
 		case _OP_MINUS_:
@@ -3346,7 +3596,7 @@ int PG_is_next_operator_multiply_divide_or_modulo(TOKEN **tokens, size_t startPo
 int PG_is_next_iden_a_member_access(TOKEN **tokens, size_t startPos) {
 	int openEdgeBrackets = 0;
 
-	for (size_t i = startPos; i < TOKEN_LENGTH; i++) {
+	for (size_t i = startPos; i < CURRENT_CONTEXT->tokenLength; i++) {
 		TOKEN *currentToken = &(*tokens)[i];
 
 		if (currentToken->type == _OP_LEFT_EDGE_BRACKET_) {
@@ -3394,7 +3644,7 @@ NodeReport PG_create_member_access_tree(TOKEN **tokens, size_t startPos, int use
 	int openEdgeBrackets = 0;
 	int isMemAcc = (int)PG_is_member_access(tokens, startPos);
 
-	while (startPos + skip < TOKEN_LENGTH && isMemAcc == true) {
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength && isMemAcc == true) {
 		TOKEN *currentToken = &(*tokens)[startPos + skip];
 
 		if (useOptionalTyping == false && currentToken->type == _OP_COLON_) {
@@ -3455,7 +3705,7 @@ int PG_is_member_access(TOKEN **tokens, size_t startPos) {
 	int openEdgeBrackets = 0;
 	int skip = 0;
 
-	while (startPos + skip < TOKEN_LENGTH) {
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + skip];
 
 		if (currentToken->type == _OP_LEFT_BRACKET_) {
@@ -3656,66 +3906,70 @@ int PG_propagate_offset_by_direction(TOKEN **tokens, size_t startPos, enum proce
 
 /**
  * <p>
- * Counts how many tokens to go back, until the array
- * access is passed.
+ * Counts how many tokens to go back from an accessor ('.' or '->'),
+ * until the start of the left side is reached.
+ * </p>
+ * 
+ * <p>
+ * The left side is the identifier or the closing bracket of the function
+ * call directly before the accessor, array accesses in between are passed.
+ * </p>
+ * 
+ * <p>
+ * Examples ('^' marks the start):
+ * ```
+ * this->a        ^this
+ * list[0][1]->a  ^list
+ * get()[0]->a    get^()
+ * ```
  * </p>
  * 
  * @returns The number of tokens to go back
  * 
- * @param **tokens  Pointer to the tokens array with the array access
- * @param startPos  Position from where to start going back
+ * @param **tokens  Pointer to the tokens array with the member access
+ * @param startPos  Position of the accessor
  */
 int PG_back_shift_array_access(TOKEN **tokens, size_t startPos) {
-	int back = 0;
+	if (startPos == 0) {
+		return 0;
+	}
 
-	for (int i = startPos; i >= 0; i--) {
-		if (i <= 0) {
-			return 0;
-		}
+	size_t position = startPos - 1;
 
-		switch ((*tokens)[i].type) {
-			case _OP_SEMICOLON_:
-			case _OP_EQUALS_:
-			case _OP_PLUS_EQUALS_:
-			case _OP_MINUS_EQUALS_:
-			case _OP_MULTIPLY_EQUALS_:
-			case _OP_DIVIDE_EQUALS_:
-				i = 0;
+	while (position > 0 && (*tokens)[position].type == _OP_LEFT_EDGE_BRACKET_) {
+		int openEdgeBrackets = 0;
+
+		for (; position > 0; position--) {
+			if ((*tokens)[position].type == _OP_LEFT_EDGE_BRACKET_) {
+				openEdgeBrackets++;
+			} else if ((*tokens)[position].type == _OP_RIGHT_EDGE_BRACKET_
+				&& --openEdgeBrackets == 0) {
 				break;
-			case _OP_RIGHT_EDGE_BRACKET_:
-				if (((*tokens)[i - 1].type == _OP_LEFT_BRACKET_
-					|| (*tokens)[i - 1].type == _IDENTIFIER_)) {
-					back = startPos - (i + 1);
-					i = 0;
-					break;
-				}
-			default: continue;
+			}
 		}
+
+		position -= position > 0 ? 1 : 0;
 	}
 
-	return back;
+	return (int)(startPos - position);
 }
 
 /**
  * <p>
- * Returns the copied value of a token.
+ * Returns the value of a token.
+ * </p>
+ * 
+ * <p>
+ * The value is not copied, it points into the token text pool
+ * of the lexer and stays valid till the tokens are freed.
  * </p>
  * 
- * @return A buffer with the copied token value
+ * @return The value of the token
  * 
- * @param *token    Token to copy
+ * @param *token    Token to get the value from
  */
 char *PG_get_identifier_by_index(TOKEN *token) {
-	char *cache = (char*)calloc(token->size, sizeof(char));
-
-	if (cache == NULL) {
-		free(cache);
-		FREE_MEMORY();
-		(void)printf("ERROR! (CACHE CALLOC)\n");
-	}
-
-	(void)strncpy(cache, token->value, token->size);
-	return cache;
+	return token->value;
 }
 
 /**
@@ -3879,7 +4133,7 @@ int PG_add_varType_definition(TOKEN **tokens, size_t startPos, Node *parentNode)
 	Node *nameOfType = PG_create_node(nameTok->value, _VAR_TYPE_NODE_, nameTok->line, nameTok->tokenStart);
 
 	if (dimensions > 0) {
-		char *buffer = (char*)calloc(16, sizeof(char));
+		char *buffer = (char*)PG_arena_allocate(16 * sizeof(char));
 		int ret = (int)snprintf(buffer, 16 * sizeof(char), "%i", dimensions);
 
 		if (ret <= 16 && ret > 0) {
@@ -3915,7 +4169,7 @@ int PG_count_varType_dimensions(TOKEN **tokens, size_t startPos) {
 
 	while ((*tokens)[startPos + skip].type == _OP_RIGHT_EDGE_BRACKET_
 		&& (*tokens)[startPos + skip + 1].type == _OP_LEFT_EDGE_BRACKET_
-		&& startPos + skip < TOKEN_LENGTH) {
+		&& startPos + skip < CURRENT_CONTEXT->tokenLength) {
 		skip += 2;
 		dimensions++;
 	}
@@ -3956,12 +4210,7 @@ Node *PG_create_modifier_node(TOKEN *token, int *skip) {
  * @param pos   Position of the token
 */
 Node *PG_create_node(char *value, enum NodeType type, int line, int pos) {
-	Node *node = (Node*)calloc(1, sizeof(Node));
-
-	if (node == NULL) {
-		(void)PARSE_TREE_NODE_RESERVATION_EXCEPTION();
-	}
-
+	Node *node = (Node*)PG_arena_allocate(sizeof(Node));
 	node->line = line;
 	node->position = pos;
 	node->type = type;
@@ -3970,43 +4219,112 @@ Node *PG_create_node(char *value, enum NodeType type, int line, int pos) {
 	node->rightNode = NULL;
 	node->details = NULL;
 	node->detailsCount = 0;
+	CURRENT_CONTEXT->nodeCount++;
 	return node;
 }
 
 /**
- * This is an array containing all "mark worthy" operators.
-*/
-const TOKENTYPES operators[] = {
-	_OP_PLUS_, _OP_MINUS_, _OP_MULTIPLY_, _OP_DIVIDE_, _OP_MODULU_,
-	_OP_LEFT_BRACKET_, _OP_RIGHT_BRACKET_, _OP_EQUALS_, _OP_SEMICOLON_,
-	_OP_COMMA_, _OP_RIGHT_BRACE_, _OP_DOT_, _OP_RIGHT_EDGE_BRACKET_,
-	_OP_LEFT_EDGE_BRACKET_, _OP_COLON_, _OP_PLUS_EQUALS_, _OP_MINUS_EQUALS_,
-	_OP_MULTIPLY_EQUALS_, _OP_DIVIDE_EQUALS_, _OP_CLASS_ACCESSOR_,
-	_OP_ADD_ONE_, _OP_SUBTRACT_ONE_
-};
+ * <p>
+ * Reserves zeroed memory in the node arena.
+ * </p>
+ * 
+ * <p>
+ * The allocation is a pointer bump in the current block. A new block
+ * is only added if the current one is full.
+ * </p>
+ * 
+ * @returns Pointer to the reserved memory
+ * 
+ * @param size  Number of bytes to reserve
+ */
+void *PG_arena_allocate(size_t size) {
+	// Keep every allocation aligned for the Node structure
+	size_t alignedSize = (size + NODE_ARENA_ALIGNMENT - 1) & ~(NODE_ARENA_ALIGNMENT - 1);
+
+	if (CURRENT_CONTEXT->currentArenaBlock == NULL
+		|| CURRENT_CONTEXT->currentArenaBlock->capacity - CURRENT_CONTEXT->currentArenaBlock->used < alignedSize) {
+		(void)PG_add_node_arena_block(alignedSize);
+	}
+
+	void *memory = CURRENT_CONTEXT->currentArenaBlock->memory + CURRENT_CONTEXT->currentArenaBlock->used;
+	CURRENT_CONTEXT->currentArenaBlock->used += alignedSize;
+	return memory;
+}
 
 /**
- * @brief Check if a given token is an operator or not.
+ * <p>
+ * Resizes memory of the node arena.
+ * </p>
  * 
- * @returns `True (1)` if the token is an operator, else `False (0)`
+ * <p>
+ * If the memory is the last allocation of the current block, it grows
+ * in place, else the content is copied into a new allocation. The old
+ * memory stays reserved until the arena is released.
+ * </p>
  * 
- * @param *token    Token to check
-*/
-int PG_is_operator(const TOKEN *token) {
-	if (token->type == __EOF__) {
-		return true;
+ * @returns Pointer to the resized memory
+ * 
+ * @param *memory   Memory to resize
+ * @param oldSize   Size, with which the memory was allocated
+ * @param newSize   Required size
+ */
+void *PG_arena_resize(void *memory, size_t oldSize, size_t newSize) {
+	size_t alignedOldSize = (oldSize + NODE_ARENA_ALIGNMENT - 1) & ~(NODE_ARENA_ALIGNMENT - 1);
+	size_t alignedNewSize = (newSize + NODE_ARENA_ALIGNMENT - 1) & ~(NODE_ARENA_ALIGNMENT - 1);
+
+	if (newSize <= oldSize) {
+		return memory;
 	}
 
-	int length = (sizeof(operators) / sizeof(operators[0]));
+	if (CURRENT_CONTEXT->currentArenaBlock != NULL
+		&& (char*)memory + alignedOldSize == CURRENT_CONTEXT->currentArenaBlock->memory + CURRENT_CONTEXT->currentArenaBlock->used
+		&& CURRENT_CONTEXT->currentArenaBlock->used - alignedOldSize + alignedNewSize <= CURRENT_CONTEXT->currentArenaBlock->capacity) {
+		CURRENT_CONTEXT->currentArenaBlock->used += alignedNewSize - alignedOldSize;
+		return memory;
+	}
 
-	for (int i = 0; i < length; i++) {
-		if (token->type == operators[i]
-			|| (int)PG_is_condition_operator(token->type) == true) {
-			return true;
-		}
+	void *newMemory = PG_arena_allocate(newSize);
+	(void)memcpy(newMemory, memory, oldSize);
+	return newMemory;
+}
+
+/**
+ * <p>
+ * Adds a new block to the node arena.
+ * </p>
+ * 
+ * <p>
+ * The block holds at least NODE_ARENA_BLOCK_SIZE bytes, larger requests
+ * get a block of their own size. A calloc is used, in order to have 0
+ * values only.
+ * </p>
+ * 
+ * @param minimumCapacity   Number of bytes the block has to hold at least
+ */
+void PG_add_node_arena_block(size_t minimumCapacity) {
+	size_t capacity = minimumCapacity > NODE_ARENA_BLOCK_SIZE ? minimumCapacity : NODE_ARENA_BLOCK_SIZE;
+	struct NodeArenaBlock *block = (struct NodeArenaBlock*)calloc(1, sizeof(struct NodeArenaBlock) + capacity);
+
+	if (block == NULL) {
+		(void)PARSE_TREE_NODE_RESERVATION_EXCEPTION();
 	}
 
-	return false;
+	block->previousBlock = CURRENT_CONTEXT->currentArenaBlock;
+	block->capacity = capacity;
+	block->used = 0;
+	CURRENT_CONTEXT->currentArenaBlock = block;
+}
+
+/**
+ * @brief Check if a given token is an operator or not ("mark worthy"
+ * operators, condition operators and EOF, see TOKEN_CLASS_OPERATOR).
+ * 
+ * @returns `True (1)` if the token is an operator, else `False (0)`
+ * 
+ * @param *token    Token to check
+*/
+int PG_is_operator(const TOKEN *token) {
+	return IS_TOKEN_CLASS(token->type, TOKEN_CLASS_OPERATOR) ? true : false;
 }
 
 /**
@@ -4027,7 +4345,13 @@ NodeReport PG_create_node_report(Node *topNode, int tokensToSkip) {
 
 /**
  * <p>
- * Frees all nodes recursively.
+ * Frees the parsetree.
+ * </p>
+ * 
+ * <p>
+ * All nodes, details arrays and generated values live in the node
+ * arena, so instead of a recursive walk the arena blocks are released.
+ * The passed node is not needed for that, NULL releases the tree as well.
  * </p>
  * 
  * @returns 1 if it reaches the end
@@ -4035,20 +4359,245 @@ NodeReport PG_create_node_report(Node *topNode, int tokensToSkip) {
  * @param *node     Topnode to free
  */
 int FREE_NODE(Node *node) {
-	if (node != NULL) {
-		FREE_NODE(node->leftNode);
-		FREE_NODE(node->rightNode);
+	while (CURRENT_CONTEXT->currentArenaBlock != NULL) {
+		struct NodeArenaBlock *previousBlock = CURRENT_CONTEXT->currentArenaBlock->previousBlock;
+		(void)free(CURRENT_CONTEXT->currentArenaBlock);
+		CURRENT_CONTEXT->currentArenaBlock = previousBlock;
+	}
+
+	return true;
+}
 
-		for (size_t i = 0; i < node->detailsCount; i++) {
-			FREE_NODE(node->details[i]);
-			free(node->details[i]);
+/**
+ * <p>
+ * Converts a parsetree into its flat form (see FlatTree).
+ * </p>
+ * 
+ * <p>
+ * The nodes are written in preorder into one array and the details
+ * of all nodes into one shared index array. Equal values get the same
+ * value id.
+ * </p>
+ * 
+ * @returns The flat tree or NULL, if the root is NULL
+ * 
+ * @param *root     Root of the parsetree
+ */
+FlatTree *PG_flatten_tree(Node *root) {
+	if (root == NULL) {
+		return NULL;
+	}
+
+	size_t nodeCount = 0;
+	size_t detailsLength = 0;
+	(void)PG_count_flat_tree_size(root, &nodeCount, &detailsLength);
+
+	struct FlatTreeBuilder builder;
+	builder.internCapacity = 16;
+
+	// Keep the intern table at most half full
+	while (builder.internCapacity < nodeCount * 2) {
+		builder.internCapacity *= 2;
+	}
+
+	FlatTree *tree = (FlatTree*)calloc(1, sizeof(FlatTree));
+	builder.tree = tree;
+	builder.internSlots = (unsigned int*)calloc(builder.internCapacity, sizeof(unsigned int));
+
+	if (tree != NULL) {
+		tree->nodes = (FlatNode*)calloc(nodeCount, sizeof(FlatNode));
+		tree->details = (unsigned int*)calloc(detailsLength + 1, sizeof(unsigned int));
+		tree->values = (char**)calloc(nodeCount + 1, sizeof(char*));
+	}
+
+	if (tree == NULL || builder.internSlots == NULL || tree->nodes == NULL
+		|| tree->details == NULL || tree->values == NULL) {
+		(void)free(builder.internSlots);
+		(void)FREE_FLAT_TREE(tree);
+		(void)PARSE_TREE_NODE_RESERVATION_EXCEPTION();
+		return NULL;
+	}
+
+	// Value id 0 is reserved for NULL
+	tree->valueCount = 1;
+	(void)PG_add_flat_node(&builder, root);
+	(void)free(builder.internSlots);
+	return tree;
+}
+
+/**
+ * <p>
+ * Counts the nodes and the details entries of a parsetree.
+ * </p>
+ * 
+ * @param *node             Node to start counting from
+ * @param *nodeCount        Gets increased by the number of nodes
+ * @param *detailsLength    Gets increased by the number of details entries
+ */
+void PG_count_flat_tree_size(Node *node, size_t *nodeCount, size_t *detailsLength) {
+	if (node == NULL) {
+		return;
+	}
+
+	(*nodeCount)++;
+	(*detailsLength) += node->detailsCount;
+
+	for (unsigned int i = 0; i < node->detailsCount; i++) {
+		(void)PG_count_flat_tree_size(node->details[i], nodeCount, detailsLength);
+	}
+
+	(void)PG_count_flat_tree_size(node->leftNode, nodeCount, detailsLength);
+	(void)PG_count_flat_tree_size(node->rightNode, nodeCount, detailsLength);
+}
+
+/**
+ * <p>
+ * Appends a node and all of its children to the flat tree.
+ * </p>
+ * 
+ * <p>
+ * The range in the shared details array is reserved before the
+ * details are added, so the details of a node are next to each other.
+ * </p>
+ * 
+ * @returns Index of the FlatNode or FLAT_NODE_NONE, if the node is NULL
+ * 
+ * @param *builder  State of the flattening
+ * @param *node     Node to append
+ */
+unsigned int PG_add_flat_node(struct FlatTreeBuilder *builder, Node *node) {
+	if (node == NULL) {
+		return FLAT_NODE_NONE;
+	}
+
+	FlatTree *tree = builder->tree;
+	unsigned int index = tree->nodeCount++;
+	FlatNode *flatNode = &tree->nodes[index];
+	flatNode->type = node->type;
+	flatNode->valueId = (unsigned int)PG_intern_flat_value(builder, node->value);
+	flatNode->line = node->line;
+	flatNode->position = node->position;
+	flatNode->detailsStart = tree->detailsLength;
+	flatNode->detailsCount = node->detailsCount;
+	tree->detailsLength += node->detailsCount;
+
+	for (unsigned int i = 0; i < node->detailsCount; i++) {
+		tree->details[flatNode->detailsStart + i] = (unsigned int)PG_add_flat_node(builder, node->details[i]);
+	}
+
+	flatNode->leftNode = (unsigned int)PG_add_flat_node(builder, node->leftNode);
+	flatNode->rightNode = (unsigned int)PG_add_flat_node(builder, node->rightNode);
+	return index;
+}
+
+/**
+ * <p>
+ * Returns the id of a value, values that are not known yet are added.
+ * </p>
+ * 
+ * @returns The value id (0 for NULL)
+ * 
+ * @param *builder  State of the flattening
+ * @param *value    Value to intern
+ */
+unsigned int PG_intern_flat_value(struct FlatTreeBuilder *builder, char *value) {
+	if (value == NULL) {
+		return 0;
+	}
+
+	// FNV-1a
+	size_t hash = 2166136261u;
+
+	for (const char *c = value; *c != '\0'; c++) {
+		hash = (hash ^ (unsigned char)*c) * 16777619u;
+	}
+
+	size_t slot = hash & (builder->internCapacity - 1);
+
+	while (builder->internSlots[slot] != 0) {
+		unsigned int id = builder->internSlots[slot];
+
+		if ((int)strcmp(builder->tree->values[id], value) == 0) {
+			return id;
 		}
 
-		free(node->value);
-		free(node->details);
-		free(node);
-		node = NULL;
+		slot = (slot + 1) & (builder->internCapacity - 1);
 	}
 
-	return true;
-}
\ No newline at end of file
+	unsigned int id = builder->tree->valueCount++;
+	builder->tree->values[id] = value;
+	builder->internSlots[slot] = id;
+	return id;
+}
+
+/**
+ * <p>
+ * Converts a flat tree back into a parsetree. The nodes are allocated
+ * in the node arena, the values are borrowed from the flat tree.
+ * </p>
+ * 
+ * <p><strong>Note:</strong>
+ * The flat tree has to be valid: every child index is greater than the
+ * index of its parent and every value id and details range exists.
+ * </p>
+ * 
+ * @returns The root of the parsetree, NULL for an empty tree
+ * 
+ * @param *tree     Flat tree to convert
+ */
+Node *PG_unflatten_tree(FlatTree *tree) {
+	if (tree == NULL || tree->nodeCount == 0) {
+		return NULL;
+	}
+
+	return PG_create_node_from_flat_node(tree, 0);
+}
+
+/**
+ * <p>
+ * Creates the node at the index of the flat tree with all its children.
+ * </p>
+ * 
+ * @returns The created node, NULL for FLAT_NODE_NONE
+ * 
+ * @param *tree     Flat tree to read from
+ * @param index     Index of the FlatNode
+ */
+Node *PG_create_node_from_flat_node(FlatTree *tree, unsigned int index) {
+	if (index == FLAT_NODE_NONE) {
+		return NULL;
+	}
+
+	FlatNode *flatNode = &tree->nodes[index];
+	Node *node = PG_create_node(tree->values[flatNode->valueId], flatNode->type, flatNode->line, flatNode->position);
+
+	if (flatNode->detailsCount > 0) {
+		(void)PG_allocate_node_details(node, flatNode->detailsCount);
+
+		for (unsigned int i = 0; i < flatNode->detailsCount; i++) {
+			node->details[i] = PG_create_node_from_flat_node(tree, tree->details[flatNode->detailsStart + i]);
+		}
+	}
+
+	node->leftNode = PG_create_node_from_flat_node(tree, flatNode->leftNode);
+	node->rightNode = PG_create_node_from_flat_node(tree, flatNode->rightNode);
+	return node;
+}
+
+/**
+ * <p>
+ * Frees a flat tree. The values are borrowed and not freed.
+ * </p>
+ * 
+ * @param *tree     Tree to free
+ */
+void FREE_FLAT_TREE(FlatTree *tree) {
+	if (tree == NULL) {
+		return;
+	}
+
+	(void)free(tree->nodes);
+	(void)free(tree->details);
+	(void)free(tree->values);
+	(void)free(tree);
+}
@@ -0,0 +1,514 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../headers/profiler.h"
+#include "../headers/hashmap.h"
+#include "../headers/modules.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+/**
+ * The subprogram {@code SPACE/src/profiler.c} was created
+ * to measure the phases of a compilation at runtime.
+ *
+ * "--stats" writes a JSON report to stderr ("--stats=<path>" to a file),
+ * "--trace=<path>" writes the phases in the Chrome trace event format,
+ * that can be opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * For every phase the wall and CPU time, the peak RSS, the allocations
+ * and the HashMap resizes and collisions are recorded. The allocations
+ * are only counted in a build with PROFILER_COUNT_ALLOCATIONS, which wraps
+ * malloc(), calloc() and realloc() of glibc. Otherwise (and on other C
+ * libraries or with sanitizers) they are reported as null.
+ *
+ * @see SPACE/docs/profiler.md
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define DEFAULT_TRACE_PATH "trace.json"
+
+struct PhaseProfile {
+	int measured;
+	double startWallUs;
+	double runStartWallUs;
+	double wallUs;
+	double startCpuMs;
+	double cpuMs;
+	long long startAllocations;
+	long long allocations;
+	long long startAllocatedBytes;
+	long long allocatedBytes;
+	long long startResizes;
+	long long resizes;
+	long long startCollissions;
+	long long collissions;
+	long peakRssKb;
+};
+
+struct Profiler {
+	int enabled;
+	int writeStats;
+	char *statsPath;
+	char *tracePath;
+	double startWallUs;
+	double startCpuMs;
+	struct PhaseProfile phases[PHASE_COUNT];
+};
+
+static struct Profiler PROFILER = {0};
+static const char *PHASE_NAMES[PHASE_COUNT] = {"input", "treeCache", "lexer", "syntax", "parsetree", "semantic"};
+
+static long long ALLOCATIONS = 0;
+static long long ALLOCATED_BYTES = 0;
+
+double PF_get_wall_time_us();
+double PF_get_cpu_time_ms();
+long PF_get_peak_rss_kb();
+void PF_get_allocations(long long *allocations, long long *bytes);
+void PF_write_stats(FILE *output, struct CompilerContext *context);
+void PF_write_trace(FILE *output, struct CompilerContext *context);
+void PF_write_phase_arguments(FILE *output, struct PhaseProfile *phase);
+void PF_write_json_string(FILE *output, const char *text);
+void PF_write_json_count(FILE *output, const char *name, long long count);
+
+/////////////////////////////////
+/////     ALLOCATIONS       /////
+/////////////////////////////////
+
+#if PROFILER_COUNT_ALLOCATIONS == 1 && defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#define PF_ALLOCATION_HOOKS 1
+
+/*
+glibc allows to replace its allocator, the functions below replace it with
+itself and count the calls. The semantic analysis allocates on more than
+one thread, so the counters are added atomically.
+*/
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *memory, size_t size);
+void __libc_free(void *memory);
+
+static void PF_count_allocation(size_t size) {
+	if (PROFILER.enabled == true) {
+		(void)__atomic_fetch_add(&ALLOCATIONS, 1, __ATOMIC_RELAXED);
+		(void)__atomic_fetch_add(&ALLOCATED_BYTES, (long long)size, __ATOMIC_RELAXED);
+	}
+}
+
+void *malloc(size_t size) {
+	(void)PF_count_allocation(size);
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+	(void)PF_count_allocation(count * size);
+	return __libc_calloc(count, size);
+}
+
+void *realloc(void *memory, size_t size) {
+	(void)PF_count_allocation(size);
+	return __libc_realloc(memory, size);
+}
+
+void free(void *memory) {
+	(void)__libc_free(memory);
+}
+
+#else
+#define PF_ALLOCATION_HOOKS 0
+#endif
+
+/**
+ * <p>
+ * Takes "--stats", "--stats=<path>" and "--trace[=<path>]" out of the
+ * arguments and enables the profiler, if one of them is set.
+ * </p>
+ *
+ * @returns true, if the arguments are valid
+ *
+ * @param *argc     Argument count, reduced by the profiler arguments
+ * @param *argv[]   Arguments, the profiler arguments are removed
+ */
+int PF_parse_arguments(int *argc, char *argv[]) {
+	int count = 0;
+
+	for (int i = 0; i < (*argc); i++) {
+		if (i > 0 && strcmp(argv[i], "--stats") == 0) {
+			PROFILER.writeStats = true;
+		} else if (i > 0 && strncmp(argv[i], "--stats=", 8) == 0 && argv[i][8] != '\0') {
+			PROFILER.writeStats = true;
+			PROFILER.statsPath = &argv[i][8];
+		} else if (i > 0 && strcmp(argv[i], "--trace") == 0) {
+			PROFILER.tracePath = DEFAULT_TRACE_PATH;
+		} else if (i > 0 && strncmp(argv[i], "--trace=", 8) == 0 && argv[i][8] != '\0') {
+			PROFILER.tracePath = &argv[i][8];
+		} else if (i > 0 && (strncmp(argv[i], "--stats", 7) == 0 || strncmp(argv[i], "--trace", 7) == 0)) {
+			(void)printf("Unknown profiler option \"%s\", use --stats[=<path>] or --trace[=<path>].\n", argv[i]);
+			return false;
+		} else {
+			argv[count++] = argv[i];
+		}
+	}
+
+	(*argc) = count;
+	argv[count] = NULL;
+	PROFILER.enabled = PROFILER.writeStats == true || PROFILER.tracePath != NULL;
+	PROFILER.startWallUs = (double)PF_get_wall_time_us();
+	PROFILER.startCpuMs = (double)PF_get_cpu_time_ms();
+	return true;
+}
+
+/**
+ * <p>
+ * Checks, if "--stats" or "--trace" is set.
+ * </p>
+ *
+ * @returns true, if the phases are measured
+ */
+int PF_is_enabled() {
+	return PROFILER.enabled;
+}
+
+/**
+ * <p>
+ * Starts the measurement of a phase.
+ * </p>
+ *
+ * @param phase     Phase, that starts now
+ */
+void PF_begin_phase(enum ProfilePhase phase) {
+	if (PROFILER.enabled == false) {
+		return;
+	}
+
+	struct PhaseProfile *profile = &PROFILER.phases[phase];
+	profile->runStartWallUs = (double)PF_get_wall_time_us();
+
+	//A phase, that runs more than once, is added up, the trace shows it at the first run
+	if (profile->measured == false) {
+		profile->startWallUs = profile->runStartWallUs - PROFILER.startWallUs;
+	}
+
+	profile->startCpuMs = (double)PF_get_cpu_time_ms();
+	(void)PF_get_allocations(&profile->startAllocations, &profile->startAllocatedBytes);
+	(void)HM_get_statistics(&profile->startResizes, &profile->startCollissions);
+}
+
+/**
+ * <p>
+ * Ends the measurement of a phase.
+ * </p>
+ *
+ * @param phase     Phase, that ended
+ */
+void PF_end_phase(enum ProfilePhase phase) {
+	if (PROFILER.enabled == false) {
+		return;
+	}
+
+	struct PhaseProfile *profile = &PROFILER.phases[phase];
+	long long allocations = 0, allocatedBytes = 0, resizes = 0, collissions = 0;
+	(void)PF_get_allocations(&allocations, &allocatedBytes);
+	(void)HM_get_statistics(&resizes, &collissions);
+
+	profile->measured = true;
+	profile->wallUs += (double)PF_get_wall_time_us() - profile->runStartWallUs;
+	profile->cpuMs += (double)PF_get_cpu_time_ms() - profile->startCpuMs;
+	profile->allocations += allocations - profile->startAllocations;
+	profile->allocatedBytes += allocatedBytes - profile->startAllocatedBytes;
+	profile->resizes += resizes - profile->startResizes;
+	profile->collissions += collissions - profile->startCollissions;
+	profile->peakRssKb = (long)PF_get_peak_rss_kb();
+}
+
+/**
+ * <p>
+ * Writes the report ("--stats") and the trace ("--trace") of the
+ * compilation.
+ * </p>
+ *
+ * @param *context  Compilation, that was measured
+ */
+void PF_finish(struct CompilerContext *context) {
+	if (PROFILER.enabled == false) {
+		return;
+	}
+
+	if (PROFILER.writeStats == true) {
+		FILE *output = PROFILER.statsPath != NULL ? fopen(PROFILER.statsPath, "w") : stderr;
+
+		if (output == NULL) {
+			(void)printf("Could not write the statistics to \"%s\"!\n", PROFILER.statsPath);
+		} else {
+			(void)PF_write_stats(output, context);
+			(void)fflush(output);
+		}
+
+		if (output != NULL && output != stderr) {
+			(void)fclose(output);
+		}
+	}
+
+	if (PROFILER.tracePath != NULL) {
+		FILE *output = fopen(PROFILER.tracePath, "w");
+
+		if (output == NULL) {
+			(void)printf("Could not write the trace to \"%s\"!\n", PROFILER.tracePath);
+		} else {
+			(void)PF_write_trace(output, context);
+			(void)fclose(output);
+		}
+	}
+
+	PROFILER.enabled = false;
+}
+
+/**
+ * <p>
+ * Writes the statistics as one JSON object.
+ * </p>
+ *
+ * @param *output   File to write to
+ * @param *context  Compilation, that was measured
+ */
+void PF_write_stats(FILE *output, struct CompilerContext *context) {
+	long long allocations = 0, allocatedBytes = 0, resizes = 0, collissions = 0;
+	(void)PF_get_allocations(&allocations, &allocatedBytes);
+	(void)HM_get_statistics(&resizes, &collissions);
+
+	(void)fprintf(output, "{\"file\":");
+	(void)PF_write_json_string(output, context->fileName);
+	(void)fprintf(output, ",\"wallMs\":%.3f,\"cpuMs\":%.3f,\"peakRssKb\":%ld,\"tokens\":%zu,\"nodes\":%zu",
+		((double)PF_get_wall_time_us() - PROFILER.startWallUs) / 1000.0,
+		(double)PF_get_cpu_time_ms() - PROFILER.startCpuMs, (long)PF_get_peak_rss_kb(),
+		context->tokenLength + context->releasedTokens, context->nodeCount);
+	(void)PF_write_json_count(output, "allocations", allocations);
+	(void)PF_write_json_count(output, "allocatedBytes", allocatedBytes);
+	(void)fprintf(output, ",\"hashMapResizes\":%lld,\"hashMapCollissions\":%lld,\"phases\":[", resizes, collissions);
+
+	for (int i = 0, written = 0; i < PHASE_COUNT; i++) {
+		struct PhaseProfile *phase = &PROFILER.phases[i];
+
+		if (phase->measured == false) {
+			continue;
+		}
+
+		(void)fprintf(output, "%s{\"name\":\"%s\",\"wallMs\":%.3f,", written++ > 0 ? "," : "", PHASE_NAMES[i], phase->wallUs / 1000.0);
+		(void)PF_write_phase_arguments(output, phase);
+		(void)fprintf(output, "}");
+	}
+
+	(void)fprintf(output, "]}\n");
+}
+
+/**
+ * <p>
+ * Writes the phases in the Chrome trace event format: a complete event
+ * ("X") per phase and a counter event ("C") with the peak RSS.
+ * </p>
+ *
+ * @param *output   File to write to
+ * @param *context  Compilation, that was measured
+ */
+void PF_write_trace(FILE *output, struct CompilerContext *context) {
+	#ifdef _WIN32
+	long processId = (long)GetCurrentProcessId();
+	#else
+	long processId = (long)getpid();
+	#endif
+
+	(void)fprintf(output, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	(void)fprintf(output, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":1,\"args\":{\"name\":", processId);
+	(void)PF_write_json_string(output, context->fileName);
+	(void)fprintf(output, "}}");
+
+	for (int i = 0; i < PHASE_COUNT; i++) {
+		struct PhaseProfile *phase = &PROFILER.phases[i];
+
+		if (phase->measured == false) {
+			continue;
+		}
+
+		(void)fprintf(output, ",\n{\"name\":\"%s\",\"cat\":\"phase\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":1,\"args\":{",
+			PHASE_NAMES[i], phase->startWallUs, phase->wallUs, processId);
+		(void)PF_write_phase_arguments(output, phase);
+		(void)fprintf(output, "}}");
+		(void)fprintf(output, ",\n{\"name\":\"memory\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%ld,\"tid\":1,\"args\":{\"peakRssKb\":%ld}}",
+			phase->startWallUs + phase->wallUs, processId, phase->peakRssKb);
+	}
+
+	(void)fprintf(output, ",\n{\"name\":\"size\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%ld,\"tid\":1,\"args\":{\"tokens\":%zu,\"nodes\":%zu}}",
+		(double)PF_get_wall_time_us() - PROFILER.startWallUs, processId, context->tokenLength + context->releasedTokens, context->nodeCount);
+	(void)fprintf(output, "\n]}\n");
+}
+
+/**
+ * <p>
+ * Writes the measured values of a phase as JSON members (without braces).
+ * </p>
+ *
+ * @param *output   File to write to
+ * @param *phase    Phase to write
+ */
+void PF_write_phase_arguments(FILE *output, struct PhaseProfile *phase) {
+	(void)fprintf(output, "\"cpuMs\":%.3f,\"peakRssKb\":%ld", phase->cpuMs, phase->peakRssKb);
+	(void)PF_write_json_count(output, "allocations", phase->allocations);
+	(void)PF_write_json_count(output, "allocatedBytes", phase->allocatedBytes);
+	(void)fprintf(output, ",\"hashMapResizes\":%lld,\"hashMapCollissions\":%lld", phase->resizes, phase->collissions);
+}
+
+/**
+ * <p>
+ * Writes an allocation count as JSON member, null if the allocations
+ * are not counted.
+ * </p>
+ */
+void PF_write_json_count(FILE *output, const char *name, long long count) {
+	if (PF_ALLOCATION_HOOKS == 1) {
+		(void)fprintf(output, ",\"%s\":%lld", name, count);
+	} else {
+		(void)fprintf(output, ",\"%s\":null", name);
+	}
+}
+
+/**
+ * <p>
+ * Writes a text as quoted and escaped JSON string.
+ * </p>
+ */
+void PF_write_json_string(FILE *output, const char *text) {
+	(void)fputc('"', output);
+
+	for (size_t i = 0; text != NULL && text[i] != '\0'; i++) {
+		unsigned char character = (unsigned char)text[i];
+
+		if (character == '"' || character == '\\') {
+			(void)fputc('\\', output);
+			(void)fputc(character, output);
+		} else if (character < 0x20) {
+			(void)fprintf(output, "\\u%04x", character);
+		} else {
+			(void)fputc(character, output);
+		}
+	}
+
+	(void)fputc('"', output);
+}
+
+void PF_get_allocations(long long *allocations, long long *bytes) {
+	#if PF_ALLOCATION_HOOKS == 1
+	(*allocations) = __atomic_load_n(&ALLOCATIONS, __ATOMIC_RELAXED);
+	(*bytes) = __atomic_load_n(&ALLOCATED_BYTES, __ATOMIC_RELAXED);
+	#else
+	(*allocations) = ALLOCATIONS;
+	(*bytes) = ALLOCATED_BYTES;
+	#endif
+}
+
+/**
+ * <p>
+ * Returns a monotonic wall clock time.
+ * </p>
+ *
+ * @returns The time in microseconds
+ */
+double PF_get_wall_time_us() {
+	#ifdef _WIN32
+	LARGE_INTEGER frequency, counter;
+	(void)QueryPerformanceFrequency(&frequency);
+	(void)QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart * 1000000.0 / (double)frequency.QuadPart;
+	#else
+	struct timespec now;
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec * 1000000.0 + (double)now.tv_nsec / 1000.0;
+	#endif
+}
+
+/**
+ * <p>
+ * Returns the CPU time of the process (all threads).
+ * </p>
+ *
+ * @returns The time in milliseconds
+ */
+double PF_get_cpu_time_ms() {
+	#ifdef _WIN32
+	FILETIME creation, exit, kernel, user;
+
+	if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user) == 0) {
+		return 0.0;
+	}
+
+	unsigned long long kernelTime = ((unsigned long long)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+	unsigned long long userTime = ((unsigned long long)user.dwHighDateTime << 32) | user.dwLowDateTime;
+	return (double)(kernelTime + userTime) / 10000.0;
+	#else
+	return (double)clock() * 1000.0 / CLOCKS_PER_SEC;
+	#endif
+}
+
+/**
+ * <p>
+ * Returns the peak resident set size of the process.
+ * </p>
+ *
+ * @returns The peak RSS in kilobytes, -1 if unknown
+ */
+long PF_get_peak_rss_kb() {
+	#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0) {
+		return -1;
+	}
+
+	return (long)(counters.PeakWorkingSetSize / 1024);
+	#else
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return -1;
+	}
+
+	#ifdef __APPLE__
+	return (long)(usage.ru_maxrss / 1024);
+	#else
+	return (long)usage.ru_maxrss;
+	#endif
+	#endif
+}
@@ -24,12 +24,18 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <stdlib.h>
 #include <ctype.h>
 #include <time.h>
+#include <stdarg.h>
+#include <setjmp.h>
 #include "../headers/modules.h"
 #include "../headers/errors.h"
 #include "../headers/hashmap.h"
 #include "../headers/list.h"
 #include "../headers/parsetree.h"
 #include "../headers/semantic.h"
+#include "../headers/internPool.h"
+#include "../headers/compilerContext.h"
+#include "../headers/lineIndex.h"
+#include "../headers/logger.h"
 
 /**
  * <p>
@@ -39,6 +45,8 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #define true 1
 #define false 0
 
+#define MEMBER_ACCESS_SIGNATURE_LENGTH 256
+
 enum ErrorType {
 	NONE,
 	ALREADY_DEFINED_EXCEPTION,
@@ -83,12 +91,31 @@ struct ErrorContainer {
 	char *suggestion;
 };
 
+/**
+ * <p>
+ * The details of a failed check, only reserved on the error path (see
+ * SA_create_semantic_report()) and freed with the tables of the check.
+ * </p>
+ */
+struct SemanticError {
+	struct Node *node;
+	enum ErrorType type;
+	struct ErrorContainer container;
+
+	//true, if the description and the suggestion were reserved (see SA_create_expected_got_report())
+	int ownsText;
+};
+
+/**
+ * <p>
+ * Result of a check, that is returned through every level of the
+ * analysis: on success only the status and the type are set.
+ * </p>
+ */
 struct SemanticReport {
 	enum ErrorStatus status;
 	struct VarDec dec;
-	struct Node *errorNode;
-	enum ErrorType errorType;
-	struct ErrorContainer container;
+	struct SemanticError *error;
 };
 
 struct SemanticEntryReport {
@@ -97,6 +124,91 @@ struct SemanticEntryReport {
 	SemanticEntry *entry;
 };
 
+struct ResolvedDeclaration {
+	SemanticTable *table;
+	SemanticEntry *entry;
+	unsigned int generation;
+};
+
+/**
+ * <p>
+ * A member in the memberTable of a class: the entry and the class
+ * table, that declares it (the class itself or a parent).
+ * </p>
+ */
+struct ClassMember {
+	SemanticTable *table;
+	SemanticEntry *entry;
+};
+
+/**
+ * <p>
+ * The type of a member access chain in the accessTypeCache of a table,
+ * the key of the map points on the signature.
+ * </p>
+ */
+struct CachedAccessType {
+	struct VarDec dec;
+	unsigned int generation;
+	char signature[];
+};
+
+struct SemanticOutput {
+	char *text;
+	size_t length;
+	size_t capacity;
+};
+
+enum SemanticTaskState {
+	TASK_PENDING,
+	TASK_RUNNING,
+	TASK_DONE
+};
+
+/**
+ * <p>
+ * A function or constructor body, that is checked after the registration
+ * pass. The task has its own context (diagnostics, external accesses) and
+ * output, they are merged in source order afterwards.
+ * </p>
+ */
+struct SemanticTask {
+	Node *runnable;
+	SemanticTable *table;
+	struct CompilerContext context;
+	enum SemanticTaskState state;
+
+	//Set, if a fatal error stopped the body, its last diagnostic is the fatal one
+	int aborted;
+
+	//External accesses, scope tables and error details of the body, the context points at them
+	struct List externalAccesses;
+	struct List tables;
+	struct List errors;
+
+	//Declarations of the registration pass, that were made before the body
+	size_t visibleDeclarations;
+
+	//Position of the body in the diagnostics, external accesses and output of the main context
+	size_t diagnosticPosition;
+	size_t accessPosition;
+	struct SemanticOutput precedingOutput;
+	struct SemanticOutput output;
+	struct SemanticOutput precedingLog;
+	struct SemanticOutput log;
+};
+
+struct SemanticSchedule {
+	struct SemanticTask **tasks;
+	size_t taskCount;
+	size_t taskCapacity;
+	size_t nextTask;
+	size_t declarationCount;
+	struct SemanticOutput output;
+	struct SemanticOutput log;
+	struct CC_Monitor *monitor;
+};
+
 struct varTypeLookup {
 	char name[12];
 	enum VarType type;
@@ -108,7 +220,6 @@ struct varTypeLookup TYPE_LOOKUP[] = {
 	{"boolean", BOOLEAN}, {"String", STRING}, {"void", VOID}
 };
 
-void SA_init_globals();
 void SA_manage_runnable(Node *root, SemanticTable *table);
 void SA_add_parameters_to_runnable_table(SemanticTable *scopeTable, struct ParamTransferObject *params);
 
@@ -138,7 +249,6 @@ struct SemanticReport SA_set_scope_table_of_member_access(struct VarDec retType,
 int SA_count_set_array_var_dimensions(Node *arrayVar);
 int SA_count_total_array_dimensions(Node *arrayNode);
 int SA_is_break_or_continue_placement_valid(SemanticTable *table);
-char *SA_get_string(char bufferString[]);
 struct SemanticReport SA_evaluate_chained_condition(SemanticTable *table, Node *rootNode);
 int SA_is_obj_already_defined(char *key, SemanticTable *scopeTable);
 SemanticTable *SA_get_next_table_of_type(SemanticTable *currentTable, enum ScopeType type);
@@ -164,7 +274,11 @@ int SA_are_non_strict_VarTypes_equal(struct VarDec type1, struct VarDec type2);
 
 struct ParamTransferObject *SA_get_params(Node *topNode, enum ScopeType stdType);
 struct SemanticReport SA_evaluate_member_access(Node *topNode, SemanticTable *table);
+int SA_get_member_access_signature(Node *topNode, char *signature, size_t capacity);
+const struct VarDec *SA_get_cached_access_type(char *signature, SemanticTable *table);
+void SA_cache_access_type(char *signature, SemanticTable *table, struct VarDec type);
 struct SemanticReport SA_check_restricted_member_access(Node *node, SemanticTable *table, SemanticTable *topScope);
+struct SemanticReport SA_check_restricted_member_entry(Node *node, SemanticEntry *entry, SemanticTable *table, SemanticTable *topScope);
 struct SemanticReport SA_check_non_restricted_member_access(Node *node, SemanticTable *table, SemanticTable *topScope);
 struct SemanticReport SA_handle_inherited_functions_and_vars(SemanticTable **currentScope, SemanticTable *table, Node *cacheNode, struct SemanticReport *resMemRep, struct SemanticEntryReport *entry);
 struct SemanticReport SA_evaluate_potential_this_keyword(Node *node, Node **cacheNode, SemanticTable **currentScope, SemanticTable *table, struct VarDec *retType);
@@ -175,7 +289,31 @@ struct SemanticReport SA_evaluate_modifier(SemanticTable *currentScope, enum Vis
 
 struct SemanticReport SA_execute_access_type_checking(Node *cacheNode, SemanticTable *currentScope, SemanticTable *topScope);
 SemanticTable *SA_get_next_table_with_declaration(char *key, SemanticTable *table);
+struct ResolvedDeclaration SA_resolve_declaration(char *key, SemanticTable *table);
+struct ResolvedDeclaration SA_find_declaration(char *key, SemanticTable *table);
+void SA_add_symbol(SemanticTable *table, char *name, SemanticEntry *entry);
+void SA_add_statement_symbol(SemanticTable *table, char *name, SemanticEntry *entry);
+void SA_add_param(SemanticTable *table, SemanticEntry *entry);
+struct HashMap *SA_create_symbol_map(int capacity);
+int SA_is_entry_visible(SemanticTable *table, SemanticEntry *entry);
+void SA_prepare_table_read(SemanticTable *table);
+void SA_record_declaration(SemanticEntry *entry);
+
+void SA_print(const char *format, ...);
+void SA_log(enum LogLevel level, const char *format, ...);
+void SA_append_formatted_output(struct SemanticOutput *output, const char *format, va_list arguments);
+void SA_append_output(struct SemanticOutput *output, const char *text, size_t length);
+void SA_write_output(struct SemanticOutput *output);
+struct SemanticSchedule *SA_create_schedule();
+int SA_defer_body(Node *runnable, SemanticTable *table);
+void SA_complete_task(struct SemanticTask *task, int wait);
+void SA_check_deferred_bodies(void *argument);
+void SA_finish_schedule(struct CompilerContext *context, struct SemanticSchedule *schedule);
+void SA_free_dropped_diagnostics(struct Diagnostic *diagnostics, size_t start, size_t end);
 struct SemanticEntryReport SA_get_entry_if_available(char *NodeAsKey, SemanticTable *table);
+struct SemanticEntryReport SA_get_member_entry_if_available(char *key, SemanticTable **classTable);
+void SA_create_member_table(SemanticTable *classTable, int memberCount);
+void SA_add_class_member(SemanticTable *classTable, char *name, SemanticEntry *entry);
 struct VarDec SA_convert_identifier_to_VarType(Node *node);
 struct VarDec SA_get_VarType(Node *node, int constant);
 int SA_set_VarType_type(Node *node, struct VarDec *cust);
@@ -190,6 +328,7 @@ SemanticEntry *SA_create_semantic_entry(char *name, struct VarDec varType, enum
 SemanticTable *SA_create_semantic_table(int paramCount, int symbolTableSize, SemanticTable *parent, enum ScopeType type, size_t line, size_t position);
 
 void FREE_TABLE(SemanticTable *rootTable);
+void SA_free_member_table(SemanticTable *classTable);
 
 struct SemanticReport SA_create_expected_got_report(struct VarDec expected, struct VarDec got, Node *errorNode);
 
@@ -209,39 +348,662 @@ void THROW_MEMORY_RESERVATION_EXCEPTION(char *problemPosition);
 void THROW_EXCEPTION(char *message, struct SemanticReport rep);
 void THROW_ASSIGNED_EXCEPTION(struct SemanticReport rep);
 
-extern char *FILE_NAME;
-extern char **BUFFER;
-extern size_t BUFFER_LENGTH;
-
-struct VarDec nullDec = {null, 0, NULL, false};
-struct VarDec externalDec = {EXTERNAL_RET, 0, NULL};
-struct ErrorContainer nullCont = {NULL, NULL, NULL};
-struct SemanticReport nullRep;
+const struct VarDec nullDec = {null, 0, NULL, false};
+const struct VarDec externalDec = {EXTERNAL_RET, 0, NULL};
+const struct ErrorContainer nullCont = {NULL, NULL, NULL};
+const struct SemanticReport nullRep = {SUCCESS, {null, 0, NULL, false}, NULL};
 
 /**
  * <p>
- * This list holds all member accesses or class accesses that
- * are in an external file. Ready to checked by the linker.
+ * Checks the semantic of the parsetree.
  * </p>
+ * 
+ * <p>
+ * All member accesses or class accesses, that are in an external
+ * file, are collected in the externalAccesses of the context, ready
+ * to be checked by the linker.
+ * </p>
+ * 
+ * @returns 0 if the parsetree contains no semantic errors, otherwise 1
+ * 
+ * @param *context  Compilation, that the parsetree belongs to
+ * @param *root     Root of the parsetree
  */
-struct List *listOfExternalAccesses = NULL;
+int CheckSemantic(struct CompilerContext *context, Node *root) {
+	(void)CC_use_context(context);
+	size_t previousDiagnostics = context->diagnosticCount + context->suppressedDiagnostics;
+
+	if (context->externalAccesses == NULL) {
+		context->externalAccesses = CreateNewList(16);
+	}
 
-int CheckSemantic(Node *root) {
-	(void)SA_init_globals();
+	//Tables of a check, that was aborted by a fatal error, are freed before
+	(void)FREE_SEMANTIC_TABLES(context);
+	context->semanticTables = CreateNewList(16);
+	context->semanticErrors = CreateNewList(16);
+
+	//The tasks copy the context, so the line index of the error messages has to exist before (e.g. for a cached parsetree)
+	(void)LI_ensure_line_index();
+
+	//The bodies are deferred by SA_defer_body() and checked, after the declarations are registered
+	context->semanticSchedule = SEMANTIC_PARALLEL_BODIES == 1 ? SA_create_schedule() : NULL;
 
 	SemanticTable *mainTable = SA_create_new_scope_table(root, MAIN, NULL, NULL, 0, 0);
 	(void)SA_manage_runnable(root, mainTable);
-	(void)FREE_TABLE(mainTable);
-	return 1;
+
+	if (context->semanticSchedule != NULL) {
+		(void)SA_finish_schedule(context, context->semanticSchedule);
+	}
+
+	//Frees the main table and all scope tables, that were created while checking
+	(void)FREE_SEMANTIC_TABLES(context);
+	return context->diagnosticCount + context->suppressedDiagnostics > previousDiagnostics ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////     Parallel function bodies     ///////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+The semantic analysis runs in two phases, if SEMANTIC_PARALLEL_BODIES is set:
+
+1. The registration pass checks the tree in source order, like before, but the
+   bodies of functions and constructors are only queued (SA_defer_body()).
+2. The queued bodies are checked on SEMANTIC_ANALYSIS_THREADS threads. A body
+   only writes to its own tables, the tables of the registration pass are read only.
+
+A body sees exactly, what it would see in source order:
+- Declarations of the registration pass are numbered, a body only sees the
+  declarations, that were made before it (SA_is_entry_visible()).
+- If a table of another body is read (e.g. for the arguments of a call), that
+  body is checked first (SA_prepare_table_read()). Only earlier bodies can be
+  visible, so bodies never wait for each other in a cycle.
+
+The output, the diagnostics and the external accesses of a body are kept
+in the task and merged in source order, the result is the same as checking
+the bodies in order.
+*/
+
+/**
+ * <p>
+ * Prints like printf(), while the bodies are checked in parallel the text
+ * is collected in the output of the body instead.
+ * </p>
+ * 
+ * @param *format   Format of the text
+ */
+void SA_print(const char *format, ...) {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+	struct SemanticOutput *output = context == NULL || context->semanticSchedule == NULL ? NULL
+		: context->semanticTask != NULL ? &context->semanticTask->output : &context->semanticSchedule->output;
+	va_list arguments;
+	va_start(arguments, format);
+
+	if (output == NULL) {
+		(void)vprintf(format, arguments);
+	} else {
+		(void)SA_append_formatted_output(output, format, arguments);
+	}
+
+	va_end(arguments);
+}
+
+/**
+ * <p>
+ * Writes a message of the semantic phase into the log, if the level is
+ * enabled ("--log=semantic:<level>").
+ * </p>
+ * 
+ * <p>
+ * While the bodies are checked in parallel the message is collected like
+ * SA_print(), in the output if the log shares stdout, else in the log of
+ * the body.
+ * </p>
+ * 
+ * @param level     Level of the message
+ * @param *format   Format of the message
+ */
+void SA_log(enum LogLevel level, const char *format, ...) {
+	if (!LG_IS_ENABLED(LOG_SEMANTIC, level)) {
+		return;
+	}
+
+	struct CompilerContext *context = CURRENT_CONTEXT;
+	struct SemanticOutput *output = NULL;
+
+	if (context != NULL && context->semanticSchedule != NULL) {
+		int shared = (int)LG_is_writing_to_stdout();
+		output = context->semanticTask != NULL ? (shared == true ? &context->semanticTask->output : &context->semanticTask->log)
+			: (shared == true ? &context->semanticSchedule->output : &context->semanticSchedule->log);
+	}
+
+	va_list arguments;
+	va_start(arguments, format);
+
+	if (output == NULL) {
+		(void)LG_write_arguments(format, arguments);
+	} else {
+		(void)SA_append_formatted_output(output, format, arguments);
+	}
+
+	va_end(arguments);
+}
+
+/**
+ * <p>
+ * Formats the text like vprintf() and appends it to a collected output.
+ * </p>
+ * 
+ * @param *output       Output to append to
+ * @param *format       Format of the text
+ * @param arguments     Arguments of the format
+ */
+void SA_append_formatted_output(struct SemanticOutput *output, const char *format, va_list arguments) {
+	char text[512];
+	va_list copy;
+	va_copy(copy, arguments);
+	int length = (int)vsnprintf(text, sizeof(text), format, copy);
+	va_end(copy);
+
+	if (length < 0) {
+		return;
+	} else if ((size_t)length < sizeof(text)) {
+		(void)SA_append_output(output, text, (size_t)length);
+		return;
+	}
+
+	char *longText = (char*)malloc((size_t)length + 1);
+
+	if (longText != NULL) {
+		(void)vsnprintf(longText, (size_t)length + 1, format, arguments);
+		(void)SA_append_output(output, longText, (size_t)length);
+		(void)free(longText);
+	}
+}
+
+/**
+ * <p>
+ * Appends text to a collected output.
+ * </p>
+ * 
+ * @param *output   Output to append to
+ * @param *text     Text to append
+ * @param length    Length of the text
+ */
+void SA_append_output(struct SemanticOutput *output, const char *text, size_t length) {
+	if (length == 0) {
+		return;
+	}
+
+	if (output->length + length > output->capacity) {
+		size_t capacity = output->capacity == 0 ? 256 : output->capacity;
+
+		while (capacity < output->length + length) {
+			capacity *= 2;
+		}
+
+		char *grownText = (char*)realloc(output->text, capacity);
+
+		if (grownText == NULL) {
+			return;
+		}
+
+		output->text = grownText;
+		output->capacity = capacity;
+	}
+
+	(void)memcpy(&output->text[output->length], text, length);
+	output->length += length;
+}
+
+/**
+ * <p>
+ * Writes a collected output to stdout. An empty output has no text yet,
+ * so nothing is written.
+ * </p>
+ * 
+ * @param *output   Output to write
+ */
+void SA_write_output(struct SemanticOutput *output) {
+	if (output->length > 0) {
+		(void)fwrite(output->text, 1, output->length, stdout);
+	}
+}
+
+/**
+ * <p>
+ * Creates the schedule for the parallel function bodies.
+ * </p>
+ * 
+ * @returns The schedule, NULL if only one thread is available
+ */
+struct SemanticSchedule *SA_create_schedule() {
+	int threads = SEMANTIC_ANALYSIS_THREADS > 0 ? SEMANTIC_ANALYSIS_THREADS : (int)CC_get_processor_count();
+
+	if (threads < 2) {
+		return NULL;
+	}
+
+	struct SemanticSchedule *schedule = (struct SemanticSchedule*)calloc(1, sizeof(struct SemanticSchedule));
+
+	if (schedule == NULL) {
+		return NULL;
+	}
+
+	schedule->monitor = CC_create_monitor();
+
+	if (schedule->monitor == NULL) {
+		(void)free(schedule);
+		return NULL;
+	}
+
+	return schedule;
+}
+
+/**
+ * <p>
+ * Queues a function or constructor body, while the declarations are
+ * registered.
+ * </p>
+ * 
+ * @returns true, if the body was queued, false if it has to be checked now
+ * 
+ * @param *runnable     Runnable node of the body
+ * @param *table        Scope table of the function or constructor
+ */
+int SA_defer_body(Node *runnable, SemanticTable *table) {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+	struct SemanticSchedule *schedule = context->semanticSchedule;
+
+	if (schedule == NULL || context->semanticTask != NULL || runnable == NULL) {
+		return false;
+	}
+
+	if (schedule->taskCount == schedule->taskCapacity) {
+		size_t capacity = schedule->taskCapacity == 0 ? 64 : schedule->taskCapacity * 2;
+		struct SemanticTask **tasks = (struct SemanticTask**)realloc(schedule->tasks, sizeof(struct SemanticTask*) * capacity);
+
+		if (tasks == NULL) {
+			return false;
+		}
+
+		schedule->tasks = tasks;
+		schedule->taskCapacity = capacity;
+	}
+
+	struct SemanticTask *task = (struct SemanticTask*)calloc(1, sizeof(struct SemanticTask));
+
+	if (task == NULL) {
+		return false;
+	}
+
+	(void)L_init_list(&task->externalAccesses, 0);
+	(void)L_init_list(&task->tables, 0);
+	(void)L_init_list(&task->errors, 0);
+
+	task->runnable = runnable;
+	task->table = table;
+	task->state = TASK_PENDING;
+	task->visibleDeclarations = schedule->declarationCount;
+	task->diagnosticPosition = context->diagnosticCount;
+	task->accessPosition = context->externalAccesses->load;
+
+	//The output so far belongs before the body
+	task->precedingOutput = schedule->output;
+	task->precedingLog = schedule->log;
+	(void)memset(&schedule->output, 0, sizeof(struct SemanticOutput));
+	(void)memset(&schedule->log, 0, sizeof(struct SemanticOutput));
+
+	//Shares the input and the tables, but has its own diagnostics; a fatal error jumps back to SA_complete_task()
+	task->context = *context;
+	task->context.semanticTask = task;
+	task->context.externalAccesses = &task->externalAccesses;
+	task->context.semanticTables = &task->tables;
+	task->context.semanticErrors = &task->errors;
+	task->context.diagnostics = NULL;
+	task->context.diagnosticCount = 0;
+	task->context.diagnosticCapacity = 0;
+	task->context.suppressedDiagnostics = 0;
+	task->context.precedingDiagnostics = context->precedingDiagnostics + context->diagnosticCount;
+	task->context.recoveryPoint = NULL;
+
+	table->owner = task;
+	schedule->tasks[schedule->taskCount++] = task;
+	return true;
+}
+
+/**
+ * <p>
+ * Checks the body of a task on the calling thread, if no other thread
+ * checks it already.
+ * </p>
+ * 
+ * <p>
+ * A fatal error in the body (see CC_abort_compilation()) jumps back to the
+ * task instead of ending the process from the worker thread. The error is
+ * the last diagnostic of the task, the task is marked as aborted.
+ * </p>
+ * 
+ * @param *task     Task to check
+ * @param wait      true waits until the body is checked by the other thread
+ */
+void SA_complete_task(struct SemanticTask *task, int wait) {
+	struct CC_Monitor *monitor = task->context.semanticSchedule->monitor;
+	(void)CC_enter_monitor(monitor);
+
+	if (task->state != TASK_PENDING) {
+		while (wait == true && task->state != TASK_DONE) {
+			(void)CC_wait_monitor(monitor);
+		}
+
+		(void)CC_leave_monitor(monitor);
+		return;
+	}
+
+	task->state = TASK_RUNNING;
+	(void)CC_leave_monitor(monitor);
+
+	struct CompilerContext *previousContext = CURRENT_CONTEXT;
+	jmp_buf recoveryPoint;
+	task->context.recoveryPoint = &recoveryPoint;
+	(void)CC_use_context(&task->context);
+
+	//Thrown again on the main thread in source order (see SA_finish_schedule())
+	if (setjmp(recoveryPoint) == 0) {
+		(void)SA_manage_runnable(task->runnable, task->table);
+	} else {
+		task->aborted = true;
+	}
+
+	task->context.recoveryPoint = NULL;
+	(void)CC_use_context(previousContext);
+
+	(void)CC_enter_monitor(monitor);
+	task->state = TASK_DONE;
+	(void)CC_notify_monitor(monitor);
+	(void)CC_leave_monitor(monitor);
+}
+
+/**
+ * <p>
+ * Worker of the parallel bodies: takes the next queued task until all
+ * tasks are taken.
+ * </p>
+ * 
+ * @param *argument     The SemanticSchedule
+ */
+void SA_check_deferred_bodies(void *argument) {
+	struct SemanticSchedule *schedule = (struct SemanticSchedule*)argument;
+
+	while (true) {
+		(void)CC_enter_monitor(schedule->monitor);
+		struct SemanticTask *task = schedule->nextTask < schedule->taskCount ? schedule->tasks[schedule->nextTask++] : NULL;
+		(void)CC_leave_monitor(schedule->monitor);
+
+		if (task == NULL) {
+			return;
+		}
+
+		(void)SA_complete_task(task, false);
+	}
+}
+
+/**
+ * <p>
+ * Checks all queued bodies in parallel and merges the output, the
+ * diagnostics and the external accesses of the bodies in source order
+ * into the context.
+ * </p>
+ * 
+ * <p>
+ * If a body was aborted by a fatal error, the merge ends at it, as if the
+ * bodies were checked in order: the diagnostics and the output behind it
+ * are dropped and the fatal error is thrown again on the calling thread.
+ * </p>
+ * 
+ * @param *context      Context of the semantic analysis
+ * @param *schedule     Schedule with the queued bodies
+ */
+void SA_finish_schedule(struct CompilerContext *context, struct SemanticSchedule *schedule) {
+	int threads = SEMANTIC_ANALYSIS_THREADS > 0 ? SEMANTIC_ANALYSIS_THREADS : (int)CC_get_processor_count();
+	threads = (size_t)threads > schedule->taskCount ? (int)schedule->taskCount : threads;
+
+	if (threads > 1) {
+		(void)CC_run_parallel(threads, SA_check_deferred_bodies, schedule);
+	} else {
+		(void)SA_check_deferred_bodies(schedule);
+	}
+
+	//Merge in source order: the main context up to the task, then the task
+	size_t diagnosticCount = context->diagnosticCount;
+	size_t abortedTask = schedule->taskCount;
+
+	for (size_t i = 0; i < schedule->taskCount; i++) {
+		diagnosticCount += schedule->tasks[i]->context.diagnosticCount;
+		abortedTask = abortedTask == schedule->taskCount && schedule->tasks[i]->aborted == true ? i : abortedTask;
+	}
+
+	struct Diagnostic *diagnostics = diagnosticCount > 0 ? (struct Diagnostic*)malloc(sizeof(struct Diagnostic) * diagnosticCount) : NULL;
+	size_t accessCount = context->externalAccesses->load;
+
+	for (size_t i = 0; i < schedule->taskCount; i++) {
+		accessCount += schedule->tasks[i]->externalAccesses.load;
+	}
+
+	struct List *accesses = CreateNewList((int)accessCount);
+	size_t diagnosticIndex = 0, mainDiagnostic = 0;
+	struct List *mainAccesses = context->externalAccesses;
+	size_t mainAccess = 0;
+
+	int aborted = abortedTask < schedule->taskCount;
+	char fatalMessage[256] = "The semantic analysis of a body failed.";
+	size_t fatalLine = 0;
+
+	for (size_t i = 0; i < schedule->taskCount; i++) {
+		struct SemanticTask *task = schedule->tasks[i];
+
+		if (i > abortedTask) {
+			continue;
+		}
+
+		for (; diagnostics != NULL && mainDiagnostic < task->diagnosticPosition; mainDiagnostic++) {
+			diagnostics[diagnosticIndex++] = context->diagnostics[mainDiagnostic];
+		}
+
+		//The fatal error is thrown again below, it adds its diagnostic then
+		size_t taskDiagnostics = task->context.diagnosticCount;
+
+		if (i == abortedTask && diagnostics != NULL && taskDiagnostics > 0 && task->context.diagnostics[taskDiagnostics - 1].fatal == true) {
+			struct Diagnostic *fatal = &task->context.diagnostics[--taskDiagnostics];
+			(void)snprintf(fatalMessage, sizeof(fatalMessage), "%s", fatal->message);
+			fatalLine = fatal->line;
+			(void)free(fatal->message);
+			(void)free(fatal->rendered);
+		}
+
+		for (size_t n = 0; diagnostics != NULL && n < taskDiagnostics; n++) {
+			diagnostics[diagnosticIndex++] = task->context.diagnostics[n];
+		}
+
+		//Moved into the context, the dropped diagnostics of the tasks behind are freed with the schedule
+		task->context.diagnosticCount = diagnostics != NULL ? 0 : task->context.diagnosticCount;
+
+		context->suppressedDiagnostics += task->context.suppressedDiagnostics;
+
+		(void)L_add_items(accesses, mainAccesses->entries + mainAccess, task->accessPosition - mainAccess);
+		(void)L_add_items(accesses, task->externalAccesses.entries, task->externalAccesses.load);
+		mainAccess = task->accessPosition;
+
+		(void)SA_write_output(&task->precedingOutput);
+		(void)SA_write_output(&task->output);
+		(void)LG_write_text(task->precedingLog.text, task->precedingLog.length);
+		(void)LG_write_text(task->log.text, task->log.length);
+	}
+
+	if (aborted == false) {
+		for (; diagnostics != NULL && mainDiagnostic < context->diagnosticCount; mainDiagnostic++) {
+			diagnostics[diagnosticIndex++] = context->diagnostics[mainDiagnostic];
+		}
+
+		(void)L_add_items(accesses, mainAccesses->entries + mainAccess, mainAccesses->load - mainAccess);
+
+		(void)SA_write_output(&schedule->output);
+		(void)LG_write_text(schedule->log.text, schedule->log.length);
+	} else if (diagnostics != NULL) {
+		(void)SA_free_dropped_diagnostics(context->diagnostics, mainDiagnostic, context->diagnosticCount);
+	}
+
+	if (diagnostics != NULL) {
+		(void)free(context->diagnostics);
+		context->diagnostics = diagnostics;
+		context->diagnosticCount = diagnosticIndex;
+		context->diagnosticCapacity = diagnosticCount;
+	}
+
+	(void)FREE_LIST(context->externalAccesses);
+	context->externalAccesses = accesses;
+	(void)FREE_SEMANTIC_SCHEDULE(context);
+
+	//Like a fatal error in source order: with a recovery point (compile server) it jumps back, else the process exits
+	if (aborted == true) {
+		(void)TERMINATE_COMPILATION(fatalMessage, fatalLine);
+	}
+}
+
+/**
+ * <p>
+ * Frees the schedule of the context and its tasks, the tables of the bodies
+ * are moved to the tables of the context (see FREE_SEMANTIC_TABLES()).
+ * </p>
+ * 
+ * <p>
+ * Also called after a fatal error of the registration pass jumped out of
+ * the check (compile server), the bodies were not checked then.
+ * </p>
+ * 
+ * @param *context  Context, whose schedule is freed
+ */
+void FREE_SEMANTIC_SCHEDULE(struct CompilerContext *context) {
+	struct SemanticSchedule *schedule = context->semanticSchedule;
+	context->semanticSchedule = NULL;
+
+	if (schedule == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < schedule->taskCount; i++) {
+		struct SemanticTask *task = schedule->tasks[i];
+		task->table->owner = NULL;
+
+		if (context->semanticTables != NULL) {
+			(void)L_add_items(context->semanticTables, task->tables.entries, task->tables.load);
+		}
+
+		if (context->semanticErrors != NULL) {
+			(void)L_add_items(context->semanticErrors, task->errors.entries, task->errors.load);
+		}
+
+		(void)SA_free_dropped_diagnostics(task->context.diagnostics, 0, task->context.diagnosticCount);
+		(void)free(task->context.diagnostics);
+		(void)L_release_list(&task->externalAccesses);
+		(void)L_release_list(&task->tables);
+		(void)L_release_list(&task->errors);
+		(void)free(task->precedingOutput.text);
+		(void)free(task->output.text);
+		(void)free(task->precedingLog.text);
+		(void)free(task->log.text);
+		(void)free(task);
+	}
+
+	(void)free(schedule->output.text);
+	(void)free(schedule->log.text);
+	(void)free(schedule->tasks);
+	(void)CC_free_monitor(schedule->monitor);
+	(void)free(schedule);
 }
 
-void SA_init_globals() {
-	nullRep = SA_create_semantic_report(nullDec, SUCCESS, NULL, NONE, nullCont);
-	listOfExternalAccesses = CreateNewList(16);
+/**
+ * <p>
+ * Frees the messages of the diagnostics, that are dropped after a fatal
+ * error of a body (see SA_finish_schedule()).
+ * </p>
+ * 
+ * @param *diagnostics  Diagnostics of a context
+ * @param start         First dropped diagnostic
+ * @param end           End of the dropped diagnostics
+ */
+void SA_free_dropped_diagnostics(struct Diagnostic *diagnostics, size_t start, size_t end) {
+	for (size_t i = start; i < end; i++) {
+		(void)free(diagnostics[i].message);
+		(void)free(diagnostics[i].rendered);
+	}
+}
+
+/**
+ * <p>
+ * Checks, if an entry can be seen by the body, that is checked on the
+ * calling thread.
+ * </p>
+ * 
+ * <p>
+ * In source order a body only sees the declarations, that were made
+ * before it. The registration pass already continued, so declarations
+ * of the registration pass, that were made after the body was queued,
+ * are hidden. The tables of the bodies themselves are always visible.
+ * </p>
+ * 
+ * @returns true, if the entry is visible
+ * 
+ * @param *table    Table of the entry
+ * @param *entry    Entry to check
+ */
+int SA_is_entry_visible(SemanticTable *table, SemanticEntry *entry) {
+	struct SemanticTask *task = CURRENT_CONTEXT->semanticTask;
+
+	if (task == NULL || entry == NULL || table->owner != NULL) {
+		return true;
+	}
+
+	return entry->declarationIndex <= task->visibleDeclarations;
+}
+
+/**
+ * <p>
+ * Makes sure, that a table of a queued body is complete, before it is
+ * read: the body is checked first (or the thread waits for it).
+ * </p>
+ * 
+ * @param *table    Table, that is going to be read
+ */
+void SA_prepare_table_read(SemanticTable *table) {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+
+	if (context->semanticSchedule == NULL || table->owner == NULL || table->owner == context->semanticTask) {
+		return;
+	}
+
+	(void)SA_complete_task(table->owner, true);
+}
+
+/**
+ * <p>
+ * Numbers a declaration of the registration pass (see SA_is_entry_visible()).
+ * </p>
+ * 
+ * @param *entry    Entry of the declaration (can be NULL)
+ */
+void SA_record_declaration(SemanticEntry *entry) {
+	struct CompilerContext *context = CURRENT_CONTEXT;
+
+	if (entry == NULL || context->semanticSchedule == NULL || context->semanticTask != NULL) {
+		return;
+	}
+
+	entry->declarationIndex = ++context->semanticSchedule->declarationCount;
 }
 
 void SA_manage_runnable(Node *root, SemanticTable *table) {
-	printf("Main instructions count: %li\n", root->detailsCount);
+	SA_log(LOG_DEBUG, "Main instructions count: %u\n", root->detailsCount);
 	
 	for (int i = 0; i < root->detailsCount; i++) {
 		Node *currentNode = root->details[i];
@@ -337,7 +1099,7 @@ void SA_add_parameters_to_runnable_table(SemanticTable *scopeTable, struct Param
 	
 	for (int i = 0; i < params->params; i++) {
 		SemanticEntry *entry = params->entries[i];
-		(void)L_add_item(scopeTable->paramList, entry);
+		(void)SA_add_param(scopeTable, entry);
 	}
 
 	(void)free(params->entries);
@@ -369,10 +1131,120 @@ void SA_add_class_to_table(SemanticTable *table, Node *classNode) {
 	scopeTable->name = name;
 	
 	SemanticEntry *referenceEntry = SA_create_semantic_entry(name, nullDec, vis, CLASS, scopeTable, classNode->line, classNode->position);
-	(void)HM_add_entry(name, referenceEntry, table->symbolTable);
+	(void)SA_add_symbol(table, name, referenceEntry);
+
+	if (SEMANTIC_FLAT_MEMBER_TABLES == 1) {
+		(void)SA_create_member_table(scopeTable, runnableNode != NULL ? runnableNode->detailsCount : 0);
+	}
+
 	(void)SA_manage_runnable(runnableNode, scopeTable);
 }
 
+/**
+ * <p>
+ * Creates the memberTable of a class, before its members are registered.
+ * </p>
+ * 
+ * <p>
+ * The table starts with the members of the parent, which already holds
+ * the members of its parents, and the params of the class. The own members
+ * are added by SA_add_symbol(). An own member hides an inherited one and a
+ * symbol hides a param with the same name, like in SA_get_entry_if_available().
+ * Like in SA_handle_inherited_functions_and_vars() only the first extended
+ * class is inherited. If the parent is not a registered class (external,
+ * declared later, ...), no table is created and the accesses walk the
+ * parents instead.
+ * </p>
+ * 
+ * @param *classTable   Table of the class
+ * @param memberCount   Expected number of own members
+ */
+void SA_create_member_table(SemanticTable *classTable, int memberCount) {
+	SemanticTable *parentTable = NULL;
+
+	for (int i = 0; i < classTable->paramList.load && parentTable == NULL; i++) {
+		SemanticEntry *param = (SemanticEntry*)L_get_item(&classTable->paramList, i);
+
+		if (param == NULL || param->internalType != EXT_CLASS_OR_INTERFACE) {
+			continue;
+		}
+
+		struct SemanticEntryReport classEntry = SA_get_entry_if_available(param->name, SA_get_next_table_of_type(classTable, MAIN));
+
+		if (classEntry.entry == NULL || classEntry.entry->internalType != CLASS) {
+			return;
+		}
+
+		parentTable = (SemanticTable*)classEntry.entry->reference;
+
+		if (parentTable == NULL || parentTable->memberTable == NULL) {
+			return;
+		}
+	}
+
+	int capacity = memberCount + classTable->paramList.load + (parentTable != NULL ? parentTable->memberTable->load : 0);
+	classTable->memberTable = SA_create_symbol_map(capacity > 8 ? capacity : 8);
+
+	//The inherited ClassMembers are shared with the parent, the names in the parent are unique
+	if (parentTable != NULL) {
+		struct HashMapIterator iterator = HM_create_iterator(parentTable->memberTable);
+		struct HashMapEntry *mapEntry = NULL;
+
+		while ((mapEntry = HM_next_entry(&iterator)) != NULL) {
+			(void)HM_add_entry(mapEntry->key, mapEntry->value, classTable->memberTable);
+		}
+	}
+
+	for (int i = 0; i < classTable->paramList.load; i++) {
+		SemanticEntry *param = (SemanticEntry*)L_get_item(&classTable->paramList, i);
+		struct HashMapEntry *ownEntry = param != NULL && param->name != NULL ? HM_get_entry(param->name, classTable->memberTable) : NULL;
+
+		//Only the first param with a name is found, like in the paramLookup
+		if (ownEntry == NULL || ((struct ClassMember*)ownEntry->value)->table != classTable) {
+			(void)SA_add_class_member(classTable, param != NULL ? param->name : NULL, param);
+		}
+	}
+}
+
+/**
+ * <p>
+ * Adds an own member to the memberTable of a class, it hides
+ * a member with the same name.
+ * </p>
+ * 
+ * @param *classTable   Class table, that declares the member
+ * @param *name         Name of the member
+ * @param *entry        Entry of the member (can be NULL)
+ */
+void SA_add_class_member(SemanticTable *classTable, char *name, SemanticEntry *entry) {
+	if (entry == NULL || name == NULL) {
+		return;
+	}
+
+	struct HashMapEntry *mapEntry = HM_get_entry(name, classTable->memberTable);
+	struct ClassMember *member = mapEntry != NULL ? (struct ClassMember*)mapEntry->value : NULL;
+
+	//An inherited member belongs to the parent, a hidden param is reused
+	if (member == NULL || member->table != classTable) {
+		//Cached member access types might use the hidden member
+		CURRENT_CONTEXT->declarationGeneration += member != NULL ? 1 : 0;
+		member = (struct ClassMember*)malloc(sizeof(struct ClassMember));
+
+		if (member == NULL) {
+			return;
+		}
+	}
+
+	member->table = classTable;
+	member->entry = entry;
+
+	if (mapEntry != NULL) {
+		mapEntry->value = member;
+	} else {
+		(void)HM_add_entry(name, member, classTable->memberTable);
+	}
+}
+
 void SA_add_function_to_table(SemanticTable *table, Node *functionNode) {
 	if (table->type != MAIN && table->type != CLASS) {
 		char *msg = "Functions are only allowed in classes and the outermost scope.";
@@ -400,8 +1272,11 @@ void SA_add_function_to_table(SemanticTable *table, Node *functionNode) {
 	scopeTable->name = name;
 
 	SemanticEntry *referenceEntry = SA_create_semantic_entry(name, type, vis, FUNCTION, scopeTable, functionNode->line, functionNode->position);
-	(void)HM_add_entry(name, referenceEntry, table->symbolTable);
-	(void)SA_manage_runnable(runnableNode, scopeTable);
+	(void)SA_add_symbol(table, name, referenceEntry);
+
+	if ((int)SA_defer_body(runnableNode, scopeTable) == false) {
+		(void)SA_manage_runnable(runnableNode, scopeTable);
+	}
 }
 
 /**
@@ -456,7 +1331,7 @@ void SA_add_normal_variable_to_table(SemanticTable *table, Node *varNode) {
 	}
 
 	SemanticEntry *entry = SA_create_semantic_entry(name, type, vis, VARIABLE, NULL, varNode->line, varNode->position);
-	(void)HM_add_entry(name, entry, table->symbolTable);
+	(void)SA_add_symbol(table, name, entry);
 }
 
 /**
@@ -505,7 +1380,7 @@ void SA_add_conditional_variable_to_table(SemanticTable *table, Node *varNode) {
 	}
 
 	SemanticEntry *entry = SA_create_semantic_entry(name, type, vis, VARIABLE, NULL, varNode->line, varNode->position);
-	(void)HM_add_entry(name, entry, table->symbolTable);
+	(void)SA_add_symbol(table, name, entry);
 }
 
 void SA_add_instance_variable_to_table(SemanticTable *table, Node *varNode) {
@@ -535,7 +1410,7 @@ void SA_add_instance_variable_to_table(SemanticTable *table, Node *varNode) {
 	}
 
 	SemanticEntry *entry = SA_create_semantic_entry(name, type, vis, CLASS_INSTANCE, NULL, varNode->line, varNode->position);
-	(void)HM_add_entry(name, entry, table->symbolTable);
+	(void)SA_add_symbol(table, name, entry);
 }
 
 void SA_add_array_variable_to_table(SemanticTable *table, Node *varNode) {
@@ -593,7 +1468,7 @@ void SA_add_array_variable_to_table(SemanticTable *table, Node *varNode) {
 	}
 
 	SemanticEntry *entry = SA_create_semantic_entry(name, type, vis, VARIABLE, NULL, varNode->line, varNode->position);
-	(void)HM_add_entry(name, entry, table->symbolTable);
+	(void)SA_add_symbol(table, name, entry);
 }
 
 void SA_add_constructor_to_table(SemanticTable *table, Node *constructorNode) {
@@ -614,14 +1489,17 @@ void SA_add_constructor_to_table(SemanticTable *table, Node *constructorNode) {
 		return;
 	}
 
-	char *name = SA_get_string("Constructor");
+	char *name = "Constructor";
 	struct Node *runnableNode = constructorNode->rightNode;
 	struct VarDec constructDec = {CONSTRUCTOR_PARAM, 0, NULL};
 	struct ParamTransferObject *params = SA_get_params(constructorNode, CONSTRUCTOR_PARAM);
 	SemanticTable *scopeTable = SA_create_new_scope_table(constructorNode, CONSTRUCTOR, table, params, constructorNode->line, constructorNode->position);
 	SemanticEntry *entry = SA_create_semantic_entry(name, constructDec, GLOBAL, CONSTRUCTOR, scopeTable, constructorNode->line, constructorNode->position);
-	(void)L_add_item(table->paramList, entry);
-	(void)SA_manage_runnable(runnableNode, scopeTable);
+	(void)SA_add_param(table, entry);
+
+	if ((int)SA_defer_body(runnableNode, scopeTable) == false) {
+		(void)SA_manage_runnable(runnableNode, scopeTable);
+	}
 }
 
 void SA_add_enum_to_table(SemanticTable *table, Node *enumNode) {
@@ -646,7 +1524,7 @@ void SA_add_enum_to_table(SemanticTable *table, Node *enumNode) {
 	SemanticTable *scopeTable = SA_create_new_scope_table(enumNode, ENUM, table, NULL, enumNode->line, enumNode->position);
 	(void)SA_add_enumerators_to_enum_table(scopeTable, enumNode);
 	SemanticEntry *entry = SA_create_semantic_entry(name, nullDec, vis, ENUM, scopeTable, enumNode->line, enumNode->position);
-	(void)HM_add_entry(name, entry, table->symbolTable);
+	(void)SA_add_symbol(table, name, entry);
 }
 
 void SA_add_enumerators_to_enum_table(SemanticTable *enumTable, struct Node *topNode) {
@@ -670,7 +1548,7 @@ void SA_add_enumerators_to_enum_table(SemanticTable *enumTable, struct Node *top
 		}
 
 		struct SemanticEntry *entry = SA_create_semantic_entry(name, enumDec, P_GLOBAL, ENUMERATOR, NULL, enumerator->line, enumerator->position);
-		(void)HM_add_entry(name, entry, enumTable->symbolTable);
+		(void)SA_add_symbol(enumTable, name, entry);
 		(void)HM_add_entry(assignedValue, NULL, valueMap);
 	}
 
@@ -704,8 +1582,8 @@ void SA_add_include_to_table(SemanticTable *table, struct Node *includeNode) {
 		return;
 	}
 	
-	(void)HM_add_entry(name, entry, table->symbolTable);
-	(void)L_add_item(listOfExternalAccesses, includeNode);
+	(void)SA_add_symbol(table, name, entry);
+	(void)L_add_item(CURRENT_CONTEXT->externalAccesses, includeNode);
 }
 
 /**
@@ -741,10 +1619,10 @@ void SA_add_try_statement(SemanticTable *table, Node *tryNode, Node *parentNode,
 		(void)THROW_STATEMENT_MISPLACEMENT_EXEPTION(rep);
 	}
 
-	char *name = SA_get_string("try");
+	char *name = "try";
 	SemanticTable *tempTable = SA_create_new_scope_table(NULL, TRY, table, NULL, tryNode->line, tryNode->position);
 	struct SemanticEntry *tryEntry = SA_create_semantic_entry(name, nullDec, P_GLOBAL, WHILE, tempTable, tryNode->line, tryNode->position);
-	(void)HM_add_entry(name, tryEntry, table->symbolTable);
+	(void)SA_add_statement_symbol(table, name, tryEntry);
 	(void)SA_manage_runnable(tryNode, tempTable);
 }
 
@@ -782,14 +1660,14 @@ void SA_add_catch_statement(SemanticTable *table, Node *catchNode, Node *parentN
 		return;
 	}
 
-	char *name = SA_get_string("catch");
+	char *name = "catch";
 	SemanticTable *tempTable = SA_create_new_scope_table(catchNode->rightNode, CATCH, table, NULL, catchNode->line, catchNode->position);
 	Node *errorHandleNode = catchNode->leftNode;
 	struct VarDec errorType = {CLASS_REF, 0, errorHandleNode->leftNode->value, true};
 	struct SemanticEntry *param = SA_create_semantic_entry(errorHandleNode->value, errorType, P_GLOBAL, VARIABLE, NULL, errorHandleNode->line, errorHandleNode->position);
-	(void)L_add_item(tempTable->paramList, param);
+	(void)SA_add_param(tempTable, param);
 	struct SemanticEntry *catchEntry = SA_create_semantic_entry(name, nullDec, P_GLOBAL, WHILE, tempTable, catchNode->line, catchNode->position);
-	(void)HM_add_entry(name, catchEntry, table->symbolTable);
+	(void)SA_add_statement_symbol(table, name, catchEntry);
 	(void)SA_manage_runnable(catchNode->rightNode, tempTable);
 }
 
@@ -811,11 +1689,11 @@ void SA_add_while_or_do_to_table(SemanticTable *table, Node *whileDoNode) {
 		return;
 	}
 
-	char *name = whileDoNode->type == _WHILE_STMT_NODE_ ? SA_get_string("while") : SA_get_string("do");
+	char *name = whileDoNode->type == _WHILE_STMT_NODE_ ? "while" : "do";
 	enum ScopeType type = whileDoNode->type == _WHILE_STMT_NODE_ ? WHILE : DO;
 	SemanticTable *whileTable = SA_create_new_scope_table(whileDoNode->rightNode, type, table, NULL, whileDoNode->line, whileDoNode->position);
 	struct SemanticEntry *whileEntry = SA_create_semantic_entry(name, nullDec, P_GLOBAL, type, whileTable, whileDoNode->line, whileDoNode->position);
-	(void)HM_add_entry(name, whileEntry, table->symbolTable);
+	(void)SA_add_statement_symbol(table, name, whileEntry);
 	(void)SA_manage_runnable(whileDoNode->rightNode, whileTable);
 }
 
@@ -836,10 +1714,10 @@ void SA_add_if_to_table(SemanticTable *table, Node *ifNode) {
 		return;
 	}
 
-	char *name = SA_get_string("if");
+	char *name = "if";
 	SemanticTable *whileTable = SA_create_new_scope_table(ifNode->rightNode, IF, table, NULL, ifNode->line, ifNode->position);
 	struct SemanticEntry *ifEntry = SA_create_semantic_entry(name, nullDec, P_GLOBAL, IF, whileTable, ifNode->line, ifNode->position);
-	(void)HM_add_entry(name, ifEntry, table->symbolTable);
+	(void)SA_add_statement_symbol(table, name, ifEntry);
 	(void)SA_manage_runnable(ifNode->rightNode, whileTable);
 }
 
@@ -864,10 +1742,10 @@ void SA_add_else_if_to_table(SemanticTable *table, Node *elseIfNode, Node *paren
 		return;
 	}
 
-	char *name = SA_get_string("else_if");
+	char *name = "else_if";
 	SemanticTable *whileTable = SA_create_new_scope_table(elseIfNode->rightNode, ELSE_IF, table, NULL, elseIfNode->line, elseIfNode->position);
 	struct SemanticEntry *elseIfEntry = SA_create_semantic_entry(name, nullDec, P_GLOBAL, ELSE_IF, whileTable, elseIfNode->line, elseIfNode->position);
-	(void)HM_add_entry(name, elseIfEntry, table->symbolTable);
+	(void)SA_add_symbol(table, name, elseIfEntry);
 	(void)SA_manage_runnable(elseIfNode->rightNode, whileTable);
 }
 
@@ -885,10 +1763,10 @@ void SA_add_else_to_table(SemanticTable *table, Node *elseNode, Node *parentNode
 		return;
 	}
 
-	char *name = SA_get_string("else");
+	char *name = "else";
 	SemanticTable *whileTable = SA_create_new_scope_table(elseNode->rightNode, ELSE, table, NULL, elseNode->line, elseNode->position);
 	struct SemanticEntry *elseEntry = SA_create_semantic_entry(name, nullDec, P_GLOBAL, ELSE, whileTable, elseNode->line, elseNode->position);
-	(void)HM_add_entry(name, elseEntry, table->symbolTable);
+	(void)SA_add_statement_symbol(table, name, elseEntry);
 	(void)SA_manage_runnable(elseNode->rightNode, whileTable);
 }
 
@@ -940,10 +1818,10 @@ void SA_add_return_to_table(SemanticTable *table, Node *returnNode) {
 		rep = SA_evaluate_array_assignment(awaitedType, returnNode->leftNode, table);
 
 		//If a array is returned, but a non-array was awaited, a NO_SUCH_ARRAY_DIM... is thrown
-		if (rep.status == ERROR && rep.errorType == NO_SUCH_ARRAY_DIMENSION_EXCEPTION) {
+		if (rep.status == ERROR && rep.error->type == NO_SUCH_ARRAY_DIMENSION_EXCEPTION) {
 			int foundDim = (int)SA_count_total_array_dimensions(returnNode->leftNode);
 			struct VarDec gotType = {awaitedType.type, foundDim, NULL, false};
-			rep = SA_create_expected_got_report(awaitedType, gotType, rep.errorNode);
+			rep = SA_create_expected_got_report(awaitedType, gotType, rep.error->node);
 		}
 	} else if (returnNode->leftNode->type == _CONDITIONAL_ASSIGNMENT_NODE_) {
 		rep = SA_evaluate_conditional_assignment(awaitedType, returnNode->leftNode, table);
@@ -958,8 +1836,8 @@ void SA_add_return_to_table(SemanticTable *table, Node *returnNode) {
 		(void)THROW_TYPE_MISMATCH_EXCEPTION(errRep);
 	}
 
-	char *name = SA_get_string("return");
-	(void)HM_add_entry(name, NULL, table->symbolTable);
+	char *name = "return";
+	(void)SA_add_statement_symbol(table, name, NULL);
 }
 
 void SA_add_for_to_table(SemanticTable *table, Node *forNode) {
@@ -973,10 +1851,10 @@ void SA_add_for_to_table(SemanticTable *table, Node *forNode) {
 		return;
 	}
 
-	char *name = SA_get_string("for");
+	char *name = "for";
 	SemanticTable *forTable = SA_create_new_scope_table(forNode->rightNode, FOR, table, NULL, forNode->line, forNode->position);
 	struct SemanticEntry *forEntry = SA_create_semantic_entry(name, nullDec, P_GLOBAL, FOR, forTable, forNode->line, forNode->position);
-	(void)HM_add_entry(name, forEntry, table->symbolTable);
+	(void)SA_add_statement_symbol(table, name, forEntry);
 
 	(void)SA_add_array_variable_to_table(forTable, forNode->leftNode);
 	struct SemanticReport conditionRep = SA_evaluate_chained_condition(forTable, forNode->details[0]);
@@ -1183,23 +2061,6 @@ struct SemanticReport SA_evaluate_instance_creation(SemanticTable *table, Node *
 	return SA_create_semantic_report(dec, SUCCESS, NULL, NONE, nullCont);
 }
 
-char *SA_get_string(char bufferString[]) {
-	int length = (int)strlen(bufferString);
-	char *string = (char*)calloc(length + 1, sizeof(char));
-
-	if (string == NULL) {
-		(void)THROW_MEMORY_RESERVATION_EXCEPTION("toString");
-		return NULL;
-	}
-
-	for (int i = 0; i < length; i++) {
-		string[i] = bufferString[i];
-	}
-
-	string[length] = '\0';
-	return string;
-}
-
 /**
  * <p>
  * Checks if a constructor with the exact same types is already defined or not.
@@ -1235,10 +2096,10 @@ struct SemanticReport SA_contains_constructor_of_type(SemanticTable *classTable,
 
 	int actualNodeParamCount = (int)SA_get_node_param_count(paramHolder);
 
-	for (int i = 0; i < classTable->paramList->load; i++) {
-		SemanticEntry *entry = (SemanticEntry*)L_get_item(classTable->paramList, i);
+	for (int i = 0; i < classTable->paramList.load; i++) {
+		SemanticEntry *entry = (SemanticEntry*)L_get_item(&classTable->paramList, i);
 
-		if (entry == NULL) {
+		if (entry == NULL || (int)SA_is_entry_visible(classTable, entry) == false) {
 			continue;
 		} else if (entry->dec.type != CONSTRUCTOR_PARAM) {
 			continue;
@@ -1248,7 +2109,7 @@ struct SemanticReport SA_contains_constructor_of_type(SemanticTable *classTable,
 
 		if (entryTable == NULL) {
 			continue;
-		} else if (entryTable->paramList->load != actualNodeParamCount) {
+		} else if (entryTable->paramList.load != actualNodeParamCount) {
 			continue;
 		}
 		
@@ -1476,8 +2337,8 @@ struct SemanticReport SA_evaluate_term_side(struct VarDec expectedType, Node *no
 	}
 	default: break;
 	}
-	printf("EXP: %i | %i | %i | %s\n", expectedType.type, expectedType.dimension, expectedType.constant, expectedType.classType == NULL ? "null" : expectedType.classType);
-	printf("PRE: %i | %i | %i | %s\n", predictedType.type, predictedType.dimension, predictedType.constant, predictedType.classType == NULL ? "null" : predictedType.classType);
+	SA_log(LOG_TRACE, "EXP: %i | %i | %i | %s\n", expectedType.type, expectedType.dimension, expectedType.constant, expectedType.classType == NULL ? "null" : expectedType.classType);
+	SA_log(LOG_TRACE, "PRE: %i | %i | %i | %s\n", predictedType.type, predictedType.dimension, predictedType.constant, predictedType.classType == NULL ? "null" : predictedType.classType);
 	if ((int)SA_are_VarTypes_equal(expectedType, predictedType, false) == false) {
 		return SA_create_expected_got_report(expectedType, predictedType, node);
 	}
@@ -1514,17 +2375,159 @@ Node *SA_get_most_left_node_from_member_access(Node *node) {
 struct SemanticReport SA_evaluate_member_access(Node *topNode, SemanticTable *table) {
 	SemanticTable *topScope = NULL;
 	struct SemanticReport rep;
+	char signature[MEMBER_ACCESS_SIGNATURE_LENGTH];
+	int cacheable = SEMANTIC_ACCESS_TYPE_CACHE == 1 && (int)SA_get_member_access_signature(topNode, signature, sizeof(signature)) == true;
+	const struct VarDec *cachedType = cacheable == true ? SA_get_cached_access_type(signature, table) : NULL;
+
+	if (cachedType != NULL) {
+		SA_log(LOG_TRACE, ">>>> >>>> >>>> CACHED! %s (%i)\n", signature, cachedType->type);
+		return SA_create_semantic_report(*cachedType, SUCCESS, NULL, NONE, nullCont);
+	}
+
+	if (topNode->type == _MEM_CLASS_ACC_NODE_) {
+		topScope = SA_get_next_table_with_declaration(topNode->leftNode->value, table);
+		rep = SA_check_non_restricted_member_access(topNode, table, topScope);
+	} else {
+		topScope = SA_get_next_table_with_declaration(topNode->value, table);
+		rep = SA_check_restricted_member_access(topNode, table, topScope);
+	}
+
+	SA_log(LOG_TRACE, ">>>> >>>> >>>> EXIT! (%i)\n", rep.dec.type);
+
+	if (rep.status == ERROR) {
+		return rep;
+	} else if (cacheable == true) {
+		(void)SA_cache_access_type(signature, table, rep.dec);
+	}
+
+	return SA_create_semantic_report(rep.dec, SUCCESS, NULL, NONE, nullCont);
+}
+
+/**
+ * <p>
+ * Writes the signature of a member access chain, that only consists of
+ * identifiers (e.g. "a->b->c" or "this->a"), into the buffer.
+ * </p>
+ * 
+ * <p>
+ * The type of such a chain only depends on the declarations, that are
+ * visible from the scope. Chains with function calls or array accesses
+ * check terms, so they have no signature.
+ * </p>
+ * 
+ * @returns true, if the chain has a signature
+ * 
+ * @param *topNode      Start node of the member access tree
+ * @param *signature    Buffer for the signature
+ * @param capacity      Size of the buffer
+ */
+int SA_get_member_access_signature(Node *topNode, char *signature, size_t capacity) {
+	if (topNode->type != _MEM_CLASS_ACC_NODE_ || topNode->leftNode == NULL) {
+		return false;
+	}
+
+	size_t length = 0;
+
+	for (Node *accessor = topNode; accessor != NULL; accessor = accessor->rightNode) {
+		Node *element = accessor->leftNode;
+
+		if (element == NULL || element->value == NULL
+			|| (element->type != _IDEN_NODE_ && element->type != _THIS_NODE_)
+			|| element->leftNode != NULL || element->rightNode != NULL || element->detailsCount != 0) {
+			return false;
+		}
+
+		//The top node holds the first element, the accessors ("->" or ".") the others
+		size_t accessorLength = accessor == topNode ? 0 : strlen(accessor->value);
+		size_t elementLength = strlen(element->value);
+
+		if (length + accessorLength + elementLength >= capacity) {
+			return false;
+		}
+
+		(void)memcpy(&signature[length], accessor->value, accessorLength);
+		(void)memcpy(&signature[length + accessorLength], element->value, elementLength);
+		length += accessorLength + elementLength;
+	}
+
+	signature[length] = '\0';
+	return true;
+}
+
+/**
+ * <p>
+ * Returns the type of a member access chain, that was already evaluated
+ * in the table or in an enclosing scope of the same body (e.g. before a loop).
+ * </p>
+ * 
+ * <p>
+ * Like the resolutionCache a type is only valid for the declarationGeneration,
+ * at which it was evaluated, and only the tables of the own body are cached.
+ * A declaration of a nested scope, that shadows the first element of the
+ * chain, starts a new generation.
+ * </p>
+ * 
+ * @returns The cached type, NULL if the chain has to be evaluated
+ * 
+ * @param *signature    Signature of the chain (see SA_get_member_access_signature())
+ * @param *table        Table in which the chain was written in
+ */
+const struct VarDec *SA_get_cached_access_type(char *signature, SemanticTable *table) {
+	for (SemanticTable *scope = table; scope != NULL && scope->owner == CURRENT_CONTEXT->semanticTask; scope = scope->parent) {
+		struct HashMapEntry *cacheEntry = scope->accessTypeCache != NULL ? HM_get_entry(signature, scope->accessTypeCache) : NULL;
+		struct CachedAccessType *cached = cacheEntry != NULL ? (struct CachedAccessType*)cacheEntry->value : NULL;
+
+		if (cached != NULL) {
+			return cached->generation == CURRENT_CONTEXT->declarationGeneration ? &cached->dec : NULL;
+		}
+
+		//The body ends at the runnable
+		if (scope->type == FUNCTION || scope->type == CONSTRUCTOR || scope->type == CLASS || scope->type == MAIN) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * <p>
+ * Stores the type of an evaluated member access chain in the table.
+ * </p>
+ * 
+ * @param *signature    Signature of the chain
+ * @param *table        Table in which the chain was written in
+ * @param type          Evaluated type of the chain
+ */
+void SA_cache_access_type(char *signature, SemanticTable *table, struct VarDec type) {
+	if (table->owner != CURRENT_CONTEXT->semanticTask) {
+		return;
+	}
 
-	if (topNode->type == _MEM_CLASS_ACC_NODE_) {
-		topScope = SA_get_next_table_with_declaration(topNode->leftNode->value, table);
-		rep = SA_check_non_restricted_member_access(topNode, table, topScope);
-	} else {
-		topScope = SA_get_next_table_with_declaration(topNode->value, table);
-		rep = SA_check_restricted_member_access(topNode, table, topScope);
+	struct HashMapEntry *cacheEntry = table->accessTypeCache != NULL ? HM_get_entry(signature, table->accessTypeCache) : NULL;
+
+	if (cacheEntry != NULL) {
+		struct CachedAccessType *cached = (struct CachedAccessType*)cacheEntry->value;
+		cached->dec = type;
+		cached->generation = CURRENT_CONTEXT->declarationGeneration;
+		return;
 	}
 
-	printf(">>>> >>>> >>>> EXIT! (%i)\n", rep.dec.type);
-	return rep.status == ERROR ? rep : SA_create_semantic_report(rep.dec, SUCCESS, NULL, NONE, nullCont);
+	size_t length = strlen(signature);
+	struct CachedAccessType *cached = (struct CachedAccessType*)malloc(sizeof(struct CachedAccessType) + length + 1);
+
+	if (cached == NULL) {
+		return;
+	}
+
+	if (table->accessTypeCache == NULL) {
+		table->accessTypeCache = SA_create_symbol_map(8);
+	}
+
+	cached->dec = type;
+	cached->generation = CURRENT_CONTEXT->declarationGeneration;
+	(void)memcpy(cached->signature, signature, length + 1);
+	(void)HM_add_entry(cached->signature, cached, table->accessTypeCache);
 }
 
 /**
@@ -1566,10 +2569,13 @@ struct SemanticReport SA_check_non_restricted_member_access(Node *node, Semantic
 	}
 
 	while (cacheNode != NULL) {
-		struct SemanticEntryReport entry = SA_get_entry_if_available(cacheNode->leftNode->value, currentScope);
-		struct SemanticReport resMemRep = SA_check_restricted_member_access(cacheNode->leftNode, table, currentScope);
+		SemanticTable *accessScope = currentScope;
+		struct SemanticEntryReport entry = SA_get_member_entry_if_available(cacheNode->leftNode->value, &currentScope);
+		struct SemanticReport resMemRep = SA_check_restricted_member_entry(cacheNode->leftNode, entry.entry, table, currentScope);
 
 		if (resMemRep.status == ERROR) {
+			//The parents are walked like before, e.g. a function of a parent might match the arguments
+			currentScope = accessScope;
 			struct SemanticReport inheritRep = SA_handle_inherited_functions_and_vars(&currentScope, table, cacheNode, &resMemRep, &entry);
 
 			if (inheritRep.status == ERROR) {
@@ -1610,8 +2616,8 @@ struct SemanticReport SA_handle_inherited_functions_and_vars(SemanticTable **cur
 	if ((*currentScope)->type == CLASS) {
 		SemanticTable *mainTable = SA_get_next_table_of_type((*currentScope), MAIN);
 
-		for (int i = 0; i < (*currentScope)->paramList->load; i++) {
-			SemanticEntry *classToSearch = (SemanticEntry*)L_get_item((*currentScope)->paramList, i);
+		for (int i = 0; i < (*currentScope)->paramList.load; i++) {
+			SemanticEntry *classToSearch = (SemanticEntry*)L_get_item(&(*currentScope)->paramList, i);
 
 			if (classToSearch == NULL) {
 				continue;
@@ -1629,10 +2635,10 @@ struct SemanticReport SA_handle_inherited_functions_and_vars(SemanticTable **cur
 
 			*currentScope = (SemanticTable*)classEntry.entry->reference;
 			*entry = SA_get_entry_if_available(cacheNode->leftNode->value, *currentScope);
-			*resMemRep = SA_check_restricted_member_access(cacheNode->leftNode, table, *currentScope);
+			*resMemRep = SA_check_restricted_member_entry(cacheNode->leftNode, entry->entry, table, *currentScope);
 
 			if ((*currentScope)->type == CLASS) {
-				if (SA_get_entry_if_available(cacheNode->leftNode->value, *currentScope).entry != NULL) {
+				if (entry->entry != NULL) {
 					return SA_create_semantic_report(nullDec, SUCCESS, NULL, NONE, nullCont);
 				}
 
@@ -1740,17 +2746,36 @@ struct SemanticReport SA_set_scope_table_of_member_access(struct VarDec retType,
  */
 struct SemanticReport SA_check_restricted_member_access(Node *node, SemanticTable *table,
 															SemanticTable *topScope) {
-	struct VarDec retType = {CUSTOM, 0, NULL};
 	struct SemanticEntryReport entry = SA_get_entry_if_available(node->value, topScope);
+	return SA_check_restricted_member_entry(node, entry.entry, table, topScope);
+}
 
-	if (entry.entry == NULL) {
+/**
+ * <p>
+ * Checks a member access with one identifier like
+ * SA_check_restricted_member_access(), but with the already
+ * looked up entry.
+ * </p>
+ * 
+ * @returns A SemanticReport with the analyzed type and flags for error an success
+ * 
+ * @param *node     Node to check
+ * @param *entry    Entry of the identifier in the topScope, NULL if not defined
+ * @param *table    The table from the scope, at which the member access occured
+ * @param *topScope The current top scope in the process
+ */
+struct SemanticReport SA_check_restricted_member_entry(Node *node, SemanticEntry *entry, SemanticTable *table,
+															SemanticTable *topScope) {
+	struct VarDec retType = {CUSTOM, 0, NULL};
+
+	if (entry == NULL) {
 		return SA_create_semantic_report(nullDec, ERROR, node, NOT_DEFINED_EXCEPTION, nullCont);
 	}
 
-	retType = entry.entry->dec;
+	retType = entry->dec;
 	
 	if (node->type == _FUNCTION_CALL_NODE_) {
-		struct SemanticReport rep = SA_evaluate_function_call(node, entry.entry, table, FNC_CALL);
+		struct SemanticReport rep = SA_evaluate_function_call(node, entry, table, FNC_CALL);
 
 		if (rep.status == ERROR) {
 			return rep;
@@ -1808,7 +2833,7 @@ struct SemanticReport SA_evaluate_function_call(Node *topNode, SemanticEntry *fu
 
 	for (int i = 0; i < actualParams; i++) {
 		Node *currentNode = topNode->details[i];
-		SemanticEntry *currentEntryParam = (SemanticEntry*)L_get_item(ref->paramList, i);
+		SemanticEntry *currentEntryParam = (SemanticEntry*)L_get_item(&ref->paramList, i);
 		
 		struct VarDec currentNodeType = {CUSTOM, 0, NULL};
 		struct SemanticReport idenRep = SA_execute_identifier_analysis(currentNode, ref, &currentNodeType, currentEntryParam, fnccType);
@@ -1899,7 +2924,11 @@ struct SemanticReport SA_create_expected_got_report(struct VarDec expected, stru
 	struct ErrorContainer errCont = {buffer, exp, sugg};
 	(void)free(expected_str);
 	(void)free(got_str);
-	return SA_create_semantic_report(nullDec, ERROR, errorNode, TYPE_MISMATCH_EXCEPTION, errCont);
+
+	//The texts are freed with the error, even if the report is never thrown
+	struct SemanticReport rep = SA_create_semantic_report(nullDec, ERROR, errorNode, TYPE_MISMATCH_EXCEPTION, errCont);
+	rep.error->ownsText = true;
+	return rep;
 }
 
 /**
@@ -1998,7 +3027,7 @@ struct SemanticReport SA_handle_array_accesses(struct VarDec *currentType, struc
 struct SemanticReport SA_execute_function_call_precheck(SemanticTable *ref, Node *topNode, enum FunctionCallType fnccType) {
 	if (ref == NULL) {
 		return nullRep;
-	} else if (topNode->detailsCount != ref->paramList->load) {
+	} else if (topNode->detailsCount != ref->paramList.load) {
 		char *msg = "The argument count is not equal to the definition.";
 		char *exp = "A function cannot take more or less arguments than its definition.";
 		char *sugg = "Maybe add or remove overlapping parameters.";
@@ -2059,7 +3088,7 @@ struct SemanticReport SA_evaluate_modifier(SemanticTable *currentScope, enum Vis
 		if (nextClassTable == NULL || currentScope->name == NULL
 			|| nextClassTable->name == NULL) {
 			return nullRep;
-		} else if ((int)strcmp(currentScope->name, nextClassTable->name) == 0
+		} else if (IP_EQUALS(currentScope->name, nextClassTable->name)
 			&& nextClassTable->type != MAIN) {
 			return nullRep;
 		} else if (vis == PRIVATE || vis == SECURE) {
@@ -2108,7 +3137,7 @@ struct SemanticReport SA_execute_access_type_checking(Node *cacheNode, SemanticT
 
 			if (((currentScope->type == CLASS
 				&& nextClassTableFromCall->type != CLASS)
-				|| (int)strcmp(currentScope->name, nextClassTableFromCall->name) != 0)
+				|| !IP_EQUALS(currentScope->name, nextClassTableFromCall->name))
 				&& currentScope->type != ENUM) {
 				char *msg = "Used \".\" for class access instead of \"->\".";
 				char *exp = "If you want to access a class externally, you have to use \"->\".";
@@ -2139,18 +3168,188 @@ struct SemanticReport SA_execute_access_type_checking(Node *cacheNode, SemanticT
  * @param *table    The table in which the searching starts (current scope).
  */
 SemanticTable *SA_get_next_table_with_declaration(char *key, SemanticTable *table) {
-	SemanticTable *temp = table;
+	return SA_resolve_declaration(key, table).table;
+}
 
-	while (temp != NULL) {
-		if ((int)HM_contains_key(key, temp->symbolTable) == false
-			&& SA_get_param_entry_if_available(key, temp) == NULL) {
-			temp = temp->parent;
-		} else {
+/**
+ * <p>
+ * Resolves the declaration of a key from the provided table on.
+ * </p>
+ * 
+ * <p>
+ * The result is cached in the resolutionCache of the table, so the next
+ * lookup of the same key in the same scope does not walk the parent
+ * tables again. A cached result is only valid for the declarationGeneration,
+ * at which it was found: a new declaration, that shadows an already visible
+ * one, starts a new generation (see SA_add_symbol()). Keys, that are not
+ * declared, are not cached.
+ * </p>
+ * 
+ * @return The table and the entry of the declaration, both NULL if not declared
+ * 
+ * @param *key      Key to resolve
+ * @param *table    Table in which the resolving starts (current scope)
+ */
+struct ResolvedDeclaration SA_resolve_declaration(char *key, SemanticTable *table) {
+	//Tables of other bodies or the registration pass are shared between the threads
+	if (key == NULL || table == NULL || SEMANTIC_RESOLUTION_CACHE == 0 || table->owner != CURRENT_CONTEXT->semanticTask) {
+		return SA_find_declaration(key, table);
+	}
+
+	unsigned int generation = CURRENT_CONTEXT->declarationGeneration;
+	struct HashMapEntry *cacheEntry = table->resolutionCache != NULL ? HM_get_entry(key, table->resolutionCache) : NULL;
+
+	if (cacheEntry != NULL) {
+		struct ResolvedDeclaration *cached = (struct ResolvedDeclaration*)cacheEntry->value;
+
+		if (cached->generation == generation) {
+			return *cached;
+		}
+	}
+
+	struct ResolvedDeclaration declaration = SA_find_declaration(key, table);
+
+	if (declaration.table == NULL) {
+		return declaration;
+	}
+
+	if (cacheEntry != NULL) {
+		*((struct ResolvedDeclaration*)cacheEntry->value) = declaration;
+		return declaration;
+	}
+
+	struct ResolvedDeclaration *cached = (struct ResolvedDeclaration*)malloc(sizeof(struct ResolvedDeclaration));
+
+	if (cached == NULL) {
+		return declaration;
+	}
+
+	if (table->resolutionCache == NULL) {
+		table->resolutionCache = SA_create_symbol_map(8);
+	}
+
+	*cached = declaration;
+	(void)HM_add_entry(key, cached, table->resolutionCache);
+	return declaration;
+}
+
+/**
+ * <p>
+ * Walks from the provided table up to the MAIN table and returns the first
+ * table, that declares the key (symbol or param).
+ * </p>
+ * 
+ * @return The table and the entry of the declaration, both NULL if not declared
+ * 
+ * @param *key      Key to search
+ * @param *table    Table in which the searching starts (current scope)
+ */
+struct ResolvedDeclaration SA_find_declaration(char *key, SemanticTable *table) {
+	struct ResolvedDeclaration declaration = {NULL, NULL, CURRENT_CONTEXT->declarationGeneration};
+
+	if (key == NULL) {
+		return declaration;
+	}
+
+	for (SemanticTable *temp = table; temp != NULL; temp = temp->parent) {
+		(void)SA_prepare_table_read(temp);
+		struct HashMapEntry *mapEntry = HM_get_entry(key, temp->symbolTable);
+
+		if (mapEntry != NULL && (int)SA_is_entry_visible(temp, (SemanticEntry*)mapEntry->value) == false) {
+			mapEntry = NULL;
+		}
+
+		SemanticEntry *param = mapEntry == NULL ? SA_get_param_entry_if_available(key, temp) : NULL;
+
+		if (mapEntry != NULL || param != NULL) {
+			declaration.table = temp;
+			declaration.entry = mapEntry != NULL ? (SemanticEntry*)mapEntry->value : param;
 			break;
 		}
 	}
 
-	return temp;
+	return declaration;
+}
+
+/**
+ * <p>
+ * Adds a symbol to the symbolTable of the provided table.
+ * </p>
+ * 
+ * <p>
+ * If the name is already visible from the table, the new symbol shadows
+ * it and the cached resolutions can be outdated, so a new
+ * declarationGeneration is started.
+ * </p>
+ * 
+ * @param *table    Table to add the symbol to
+ * @param *name     Name of the symbol
+ * @param *entry    Entry of the symbol (can be NULL)
+ */
+void SA_add_symbol(SemanticTable *table, char *name, SemanticEntry *entry) {
+	if ((SEMANTIC_RESOLUTION_CACHE == 1 || SEMANTIC_ACCESS_TYPE_CACHE == 1) && SA_find_declaration(name, table).table != NULL) {
+		CURRENT_CONTEXT->declarationGeneration++;
+	}
+
+	(void)SA_record_declaration(entry);
+	(void)HM_add_entry(name, entry, table->symbolTable);
+
+	if (table->memberTable != NULL) {
+		(void)SA_add_class_member(table, name, entry);
+	}
+}
+
+/**
+ * <p>
+ * Adds the symbol of a statement scope (try, catch, while, do, if, else,
+ * return, for) to the symbolTable of the provided table.
+ * </p>
+ * 
+ * <p><strong>Note:</strong>
+ * The names are keywords and can't be used as identifiers, so they never
+ * shadow a resolved declaration.
+ * </p>
+ * 
+ * @param *table    Table to add the symbol to
+ * @param *name     Name of the statement
+ * @param *entry    Entry of the statement (can be NULL)
+ */
+void SA_add_statement_symbol(SemanticTable *table, char *name, SemanticEntry *entry) {
+	(void)SA_record_declaration(entry);
+	(void)HM_add_entry(name, entry, table->symbolTable);
+}
+
+/**
+ * <p>
+ * Adds a param to the paramList and the paramLookup of the provided table.
+ * </p>
+ * 
+ * <p><strong>Note:</strong>
+ * Like the list, the lookup returns the first param with a name.
+ * </p>
+ * 
+ * @param *table    Table to add the param to
+ * @param *entry    Entry of the param
+ */
+void SA_add_param(SemanticTable *table, SemanticEntry *entry) {
+	if ((SEMANTIC_RESOLUTION_CACHE == 1 || SEMANTIC_ACCESS_TYPE_CACHE == 1) && SA_find_declaration(entry->name, table).table != NULL) {
+		CURRENT_CONTEXT->declarationGeneration++;
+	}
+
+	(void)SA_record_declaration(entry);
+	(void)L_add_item(&table->paramList, entry);
+
+	if (entry->name == NULL) {
+		return;
+	}
+
+	if (table->paramLookup == NULL) {
+		table->paramLookup = SA_create_symbol_map(table->paramList.size > 0 ? (int)table->paramList.size : 1);
+	}
+
+	if ((int)HM_contains_key(entry->name, table->paramLookup) == false) {
+		(void)HM_add_entry(entry->name, entry, table->paramLookup);
+	}
 }
 
 /**
@@ -2170,12 +3369,15 @@ struct SemanticEntryReport SA_get_entry_if_available(char *NodeAsKey, SemanticTa
 		return SA_create_semantic_entry_report(NULL, false, true);
 	}
 	
-	SemanticEntry *entry = SA_get_param_entry_if_available(NodeAsKey, table);
-	
-	if ((int)HM_contains_key(NodeAsKey, table->symbolTable) == true) {
-		entry = HM_get_entry(NodeAsKey, table->symbolTable)->value;
+	(void)SA_prepare_table_read(table);
+	struct HashMapEntry *mapEntry = HM_get_entry(NodeAsKey, table->symbolTable);
+
+	if (mapEntry != NULL && (int)SA_is_entry_visible(table, (SemanticEntry*)mapEntry->value) == false) {
+		mapEntry = NULL;
 	}
 
+	SemanticEntry *entry = mapEntry != NULL ? (SemanticEntry*)mapEntry->value : SA_get_param_entry_if_available(NodeAsKey, table);
+
 	if (entry == NULL) {
 		return SA_create_semantic_entry_report(NULL, false, true);
 	}
@@ -2183,6 +3385,37 @@ struct SemanticEntryReport SA_get_entry_if_available(char *NodeAsKey, SemanticTa
 	return SA_create_semantic_entry_report(entry, true, false);
 }
 
+/**
+ * <p>
+ * Looks up a member like SA_get_entry_if_available(), in a class with a
+ * memberTable the inherited members are found with the same probe.
+ * </p>
+ * 
+ * <p><strong>Important:</strong>
+ * THE CLASS TABLE IS SET TO THE TABLE, THAT DECLARES THE MEMBER!
+ * </p>
+ * 
+ * @returns A SemanticEntryReport with the found entry, NULL if not found
+ * 
+ * @param *key          The key to search
+ * @param **classTable  Table in which to search in
+ */
+struct SemanticEntryReport SA_get_member_entry_if_available(char *key, SemanticTable **classTable) {
+	if (key == NULL || (*classTable) == NULL || (*classTable)->memberTable == NULL) {
+		return SA_get_entry_if_available(key, *classTable);
+	}
+
+	struct HashMapEntry *mapEntry = HM_get_entry(key, (*classTable)->memberTable);
+	struct ClassMember *member = mapEntry != NULL ? (struct ClassMember*)mapEntry->value : NULL;
+
+	if (member == NULL || (int)SA_is_entry_visible(member->table, member->entry) == false) {
+		return SA_create_semantic_entry_report(NULL, false, true);
+	}
+
+	(*classTable) = member->table;
+	return SA_create_semantic_entry_report(member->entry, true, false);
+}
+
 /**
  * <p>
  * Returns a table with the provided type.
@@ -2412,7 +3645,7 @@ int SA_are_VarTypes_equal(struct VarDec type1, struct VarDec type2, int strict)
  */
 int SA_are_strict_VarTypes_equal(struct VarDec type1, struct VarDec type2) {
 	if (type1.type == CLASS_REF && type2.type == CLASS_REF) {
-		if ((int)strcmp(type1.classType, type2.classType) == 0
+		if (IP_EQUALS(type1.classType, type2.classType)
 			&& type1.dimension == type2.dimension) {
 			return true;
 		} else {
@@ -2464,7 +3697,7 @@ int SA_are_non_strict_VarTypes_equal(struct VarDec type1, struct VarDec type2) {
 	}
 
 	if (type1.type == CLASS_REF && type2.type == CLASS_REF) {
-		if ((int)strcmp(type1.classType, type2.classType) == 0
+		if (IP_EQUALS(type1.classType, type2.classType)
 			&& type1.dimension == type2.dimension) {
 			return true;
 		} else {
@@ -2500,18 +3733,7 @@ int SA_are_non_strict_VarTypes_equal(struct VarDec type1, struct VarDec type2) {
  * @param *scopeTable   Current table in the current scope
  */
 int SA_is_obj_already_defined(char *key, SemanticTable *scopeTable) {
-	SemanticTable *temp = scopeTable;
-
-	while (temp != NULL) {
-		if ((int)HM_contains_key(key, temp->symbolTable) == true
-			|| SA_get_param_entry_if_available(key, temp) != NULL) {
-			return true;
-		}
-
-		temp = temp->parent;
-	}
-
-	return false;
+	return SA_resolve_declaration(key, scopeTable).table != NULL;
 }
 
 /**
@@ -2581,19 +3803,19 @@ struct ParamTransferObject *SA_get_params(Node *topNode, enum ScopeType stdType)
 SemanticEntry *SA_get_param_entry_if_available(char *key, SemanticTable *table) {
 	if (table == NULL) {
 		return NULL;
-	} else if (table->paramList == NULL) {
+	}
+
+	if (table->paramLookup == NULL || key == NULL) {
 		return NULL;
 	}
 
-	for (int i = 0; i < table->paramList->load; i++) {
-		SemanticEntry *entry = (SemanticEntry*)L_get_item(table->paramList, i);
+	struct HashMapEntry *mapEntry = HM_get_entry(key, table->paramLookup);
 
-		if ((int)strcmp(entry->name, key) == 0) {
-			return entry;
-		}
+	if (mapEntry == NULL || (int)SA_is_entry_visible(table, (SemanticEntry*)mapEntry->value) == false) {
+		return NULL;
 	}
 
-	return NULL;
+	return (SemanticEntry*)mapEntry->value;
 }
 
 /**
@@ -2685,7 +3907,8 @@ enum Visibility SA_get_visibility(Node *visibilityNode) {
 	if (visibilityNode == NULL) {
 		return P_GLOBAL;
 	} else if (visibilityNode->type != _MODIFIER_NODE_) {
-		printf("MODIFIER NODE IS INCORRECT!\n\n");
+		SA_print("MODIFIER NODE IS INCORRECT!\n\n");
+		(void)CC_abort_compilation("Modifier node is incorrect.", visibilityNode->line + 1, 0);
 		exit(EXIT_FAILURE);
 	}
 
@@ -2716,13 +3939,26 @@ enum Visibility SA_get_visibility(Node *visibilityNode) {
  */
 struct SemanticReport SA_create_semantic_report(struct VarDec type, enum ErrorStatus status, Node *errorNode, enum ErrorType errorType,
 												struct ErrorContainer container) {
-	struct SemanticReport rep;
-	rep.dec = type;
-	printf(">>>> >>>> >>>> >>>> ERROR OCC: %i %i\n", status, errorType);
-	rep.status = status;
-	rep.errorNode = errorNode;
-	rep.errorType = errorType;
-	rep.container = container;
+	struct SemanticReport rep = {status, type, NULL};
+
+	if (status != ERROR && errorNode == NULL && errorType == NONE) {
+		return rep;
+	}
+
+	SA_log(LOG_TRACE, ">>>> >>>> >>>> >>>> ERROR OCC: %i %i\n", status, errorType);
+	struct SemanticError *error = (struct SemanticError*)malloc(sizeof(struct SemanticError));
+
+	if (error == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("SEMANTIC_ERROR");
+		return rep;
+	}
+
+	error->node = errorNode;
+	error->type = errorType;
+	error->container = container;
+	error->ownsText = false;
+	(void)L_add_item(CURRENT_CONTEXT->semanticErrors, error);
+	rep.error = error;
 	return rep;
 }
 
@@ -2789,44 +4025,167 @@ SemanticTable *SA_create_semantic_table(int paramCount, int symbolTableSize, Sem
 	SemanticTable *table = (SemanticTable*)calloc(1, sizeof(SemanticTable));
 
 	if (table == NULL) {
-		printf("Error on semantic table reservation!\n");
+		SA_print("Error on semantic table reservation!\n");
 		return NULL;
 	}
 
-	table->paramList = CreateNewList(paramCount);
-	table->symbolTable = CreateNewHashMap(symbolTableSize > 0 ? symbolTableSize : 1);
+	(void)L_init_list(&table->paramList, paramCount);
+	table->symbolTable = SA_create_symbol_map(symbolTableSize > 0 ? symbolTableSize : 1);
 	table->parent = parent;
 	table->type = type;
 	table->line = line;
 	table->position = position;
+	table->owner = CURRENT_CONTEXT->semanticTask;
+
+	//Nested scopes (e.g. if, for) and constructors are not reachable from the main table
+	(void)L_add_item(CURRENT_CONTEXT->semanticTables, table);
 	return table;
 }
 
 /**
- * UNDER CONSTRUCTION!!!!
+ * <p>
+ * Creates a HashMap for the symbols of a table, the kind of the map is
+ * set by SEMANTIC_OPEN_ADDRESSING_SYMBOL_TABLES.
+ * </p>
+ * 
+ * @returns The new HashMap
+ * 
+ * @param capacity  Initial capacity of the map
  */
-void FREE_TABLE(SemanticTable *rootTable) {
-	for (int i = 0; i < rootTable->paramList->load; i++) {
-		(void)free(rootTable->paramList->entries[i]);
+struct HashMap *SA_create_symbol_map(int capacity) {
+	if (SEMANTIC_OPEN_ADDRESSING_SYMBOL_TABLES == 1) {
+		return CreateNewOpenHashMap(capacity);
 	}
 
-	(void)FREE_LIST(rootTable->paramList);
+	return CreateNewHashMap(capacity);
+}
 
-	for (int i = 0; i < rootTable->symbolTable->capacity; i++) {
-		if (rootTable->symbolTable->entries[i] == NULL) {
-			continue;
-		} else if (rootTable->symbolTable->entries[i]->value == NULL) {
-			continue;
+/**
+ * <p>
+ * Frees all semantic tables and error details, that were created while
+ * checking, and the lists of them.
+ * </p>
+ * 
+ * @param *context  Compilation, that the tables belong to
+ */
+void FREE_SEMANTIC_TABLES(struct CompilerContext *context) {
+	if (context->semanticErrors != NULL) {
+		for (int i = 0; i < context->semanticErrors->load; i++) {
+			struct SemanticError *error = (struct SemanticError*)L_get_item(context->semanticErrors, i);
+
+			if (error->ownsText == true) {
+				(void)free(error->container.description);
+				(void)free(error->container.suggestion);
+			}
+
+			(void)free(error);
 		}
 
-		SemanticEntry *entry = (SemanticEntry*)rootTable->symbolTable->entries[i]->value;
+		(void)FREE_LIST(context->semanticErrors);
+		context->semanticErrors = NULL;
+	}
+
+	if (context->semanticTables == NULL) {
+		return;
+	}
+
+	for (int i = 0; i < context->semanticTables->load; i++) {
+		(void)FREE_TABLE((SemanticTable*)L_get_item(context->semanticTables, i));
+	}
+
+	(void)FREE_LIST(context->semanticTables);
+	context->semanticTables = NULL;
+}
+
+/**
+ * <p>
+ * Frees a semantic table, the tables of the entries are freed on their
+ * own (see FREE_SEMANTIC_TABLES()).
+ * </p>
+ * 
+ * @param *rootTable    The table to free
+ */
+void FREE_TABLE(SemanticTable *rootTable) {
+	if (rootTable->memberTable != NULL) {
+		(void)SA_free_member_table(rootTable);
+	}
+
+	for (int i = 0; i < rootTable->paramList.load; i++) {
+		(void)free(rootTable->paramList.entries[i]);
+	}
+
+	(void)L_release_list(&rootTable->paramList);
+
+	//The params are owned by the paramList
+	if (rootTable->paramLookup != NULL) {
+		struct HashMapIterator paramIterator = HM_create_iterator(rootTable->paramLookup);
+		struct HashMapEntry *paramEntry = NULL;
 
-		if (entry->reference != NULL) {
-			(void)FREE_TABLE((SemanticTable*)entry->reference);
+		while ((paramEntry = HM_next_entry(&paramIterator)) != NULL) {
+			paramEntry->value = NULL;
 		}
+
+		(void)HM_free(rootTable->paramLookup);
+	}
+
+	//Frees the cached resolutions (the ResolvedDeclarations) only
+	if (rootTable->resolutionCache != NULL) {
+		(void)HM_free(rootTable->resolutionCache);
+	}
+
+	//The keys are part of the CachedAccessTypes
+	if (rootTable->accessTypeCache != NULL) {
+		(void)HM_free(rootTable->accessTypeCache);
 	}
 
 	(void)HM_free(rootTable->symbolTable);
+	(void)free(rootTable);
+}
+
+/**
+ * <p>
+ * Frees the own ClassMembers of a class and its memberTable, the
+ * inherited ClassMembers belong to the memberTable of the parent.
+ * </p>
+ * 
+ * <p>
+ * The parent might be freed already, so only the members with the names
+ * of the own symbols and params are read (they are always own members).
+ * </p>
+ * 
+ * @param *classTable   Table of the class
+ */
+void SA_free_member_table(SemanticTable *classTable) {
+	struct HashMapIterator iterator = HM_create_iterator(classTable->symbolTable);
+	struct HashMapEntry *mapEntry = NULL;
+
+	while ((mapEntry = HM_next_entry(&iterator)) != NULL) {
+		struct HashMapEntry *memberEntry = HM_get_entry(mapEntry->key, classTable->memberTable);
+
+		if (memberEntry != NULL) {
+			(void)free(memberEntry->value);
+			memberEntry->value = NULL;
+		}
+	}
+
+	for (int i = 0; i < classTable->paramList.load; i++) {
+		SemanticEntry *param = (SemanticEntry*)L_get_item(&classTable->paramList, i);
+		struct HashMapEntry *memberEntry = param != NULL && param->name != NULL ? HM_get_entry(param->name, classTable->memberTable) : NULL;
+
+		if (memberEntry != NULL) {
+			(void)free(memberEntry->value);
+			memberEntry->value = NULL;
+		}
+	}
+
+	iterator = HM_create_iterator(classTable->memberTable);
+
+	while ((mapEntry = HM_next_entry(&iterator)) != NULL) {
+		mapEntry->value = NULL;
+	}
+
+	(void)HM_free(classTable->memberTable);
+	classTable->memberTable = NULL;
 }
 
 void THROW_ARITHMETIC_OPERATION_MISPLACEMENT_EXCEPTION(struct SemanticReport rep) {
@@ -2867,14 +4226,6 @@ void THROW_STATEMENT_MISPLACEMENT_EXEPTION(struct SemanticReport rep) {
 
 void THROW_TYPE_MISMATCH_EXCEPTION(struct SemanticReport rep) {
 	(void)THROW_EXCEPTION("TypeMismatchException", rep);
-
-	if (rep.container.description != NULL) {
-		(void)free(rep.container.description);
-	}
-
-	if (rep.container.suggestion != NULL) {
-		(void)free(rep.container.suggestion);
-	}
 }
 
 void THROW_NOT_DEFINED_EXCEPTION(Node *node) {
@@ -2888,9 +4239,10 @@ void THROW_ALREADY_DEFINED_EXCEPTION(Node *node) {
 }
 
 void THROW_MEMORY_RESERVATION_EXCEPTION(char *problemPosition) {
-	printf(TEXT_COLOR_RED "MemoryReservationException: at %s\n", problemPosition);
-	printf("Error was thrown while semantic analysis.\n");
-	printf("This error is an internal issue, please recompile.\n" TEXT_COLOR_RESET);
+	SA_print(TEXT_COLOR_RED "MemoryReservationException: at %s\n", problemPosition);
+	SA_print("Error was thrown while semantic analysis.\n");
+	SA_print("This error is an internal issue, please recompile.\n" TEXT_COLOR_RESET);
+	(void)CC_abort_compilation("Memory reservation failed during the semantic analysis.", 0, 0);
 	exit(EXIT_FAILURE);
 }
 
@@ -2903,74 +4255,51 @@ void THROW_MEMORY_RESERVATION_EXCEPTION(char *problemPosition) {
  * @param rep       Report to print
  */
 void THROW_EXCEPTION(char *message, struct SemanticReport rep) {
-	int charsInLine = 0;
-	int errorCharsAwayFromNL = 0;
-	struct Node *node = rep.errorNode;
-
-	for (int i = node->position; i > 0; i--, errorCharsAwayFromNL++) {
-		if ((*BUFFER)[i - 1] == '\n' || (*BUFFER)[i - 1] == '\0') {
-			break;
+	struct Node *node = rep.error->node;
+	int errorCharsAwayFromNL = (int)LI_get_column(node->position);
+	struct ErrorContainer container = rep.error->container;
+	struct DiagnosticText text = {NULL, 0, 0};
+
+	//Over the error limit the message is not formatted at all
+	if ((int)CC_is_rendering_diagnostics() == true) {
+		size_t sourceLine = (size_t)LI_get_line(node->position);
+		//Nodes of the EOF token have no source line
+		int charsInLine = node->position <= CURRENT_CONTEXT->bufferLength ? (int)LI_get_line_length(sourceLine) : 0;
+
+		(void)CC_append_diagnostic_text(&text, TEXT_COLOR_RED "%s: at line " TEXT_UNDERLINE TEXT_COLOR_BLUE, message);
+		(void)CC_append_diagnostic_text(&text, "%u:%i", node->line + 1, errorCharsAwayFromNL);
+		(void)CC_append_diagnostic_text(&text, TEXT_COLOR_RESET TEXT_COLOR_RED " from \"%s\"\n", CURRENT_CONTEXT->fileName);
+
+		char firstFoldMeta[32];
+		int minSkip = (int)snprintf(firstFoldMeta, 32, "    at: ");
+		(void)CC_append_diagnostic_text(&text, "%s" TEXT_COLOR_GRAY "%.*s\n" TEXT_COLOR_RED, firstFoldMeta, charsInLine,
+			&CURRENT_CONTEXT->buffer[LI_get_line_start(sourceLine)]);
+		(void)CC_append_diagnostic_text(&text, "%*s" TEXT_COLOR_YELLOW, errorCharsAwayFromNL + minSkip, "");
+
+		for (int i = 0; i < (int)strlen(node->value) && i < 1000; i++) {
+			(void)CC_append_diagnostic_text(&text, "^");
 		}
-	}
-
-	for (int i = node->position - charsInLine; (*BUFFER)[i] != '\n' && (*BUFFER)[i] != '\0'; i++, charsInLine++);
-	charsInLine += errorCharsAwayFromNL;
-
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf("%s: at line ", message);
-	(void)printf(TEXT_UNDERLINE);
-	(void)printf(TEXT_COLOR_BLUE);
-	(void)printf("%li:%i", node->line + 1, errorCharsAwayFromNL);
-	(void)printf(TEXT_COLOR_RESET);
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf(" from \"%s\"\n", FILE_NAME);
-	
-	if (rep.errorNode == NULL) {
-		(void)printf(TEXT_COLOR_RESET);
-		return;
-	}
-
-	char firstFoldMeta[32];
-	int minSkip = (int)snprintf(firstFoldMeta, 32, "    at: ");
-	(void)printf(firstFoldMeta);
-	(void)printf(TEXT_COLOR_GRAY);
-
-	for (int i = 0; i < charsInLine; i++) {
-		int pos = node->position - errorCharsAwayFromNL + i;
-		(void)printf("%c", (*BUFFER)[pos]);
-	}
-
-	(void)printf("\n");
-	(void)printf(TEXT_COLOR_RED);
-	int WSSP = node->position - errorCharsAwayFromNL;
-	int WSLen = node->position + minSkip;
-
-	for (int i = WSSP; i < WSLen; i++) {
-		(void)printf(" ");
-	}
-
-	(void)printf(TEXT_COLOR_YELLOW);
 
-	for (int i = 0; i < (int)strlen(node->value) && i < 1000; i++) {
-		(void)printf("^");
-	}
+		(void)CC_append_diagnostic_text(&text, "\n" TEXT_COLOR_RED);
 
-	(void)printf("\n" TEXT_COLOR_RED);
-	struct ErrorContainer container = rep.container;
+		if (container.description != NULL) {
+			(void)CC_append_diagnostic_text(&text, "    Error: %s\n", container.description);
+		}
+		
+		if (container.explanation != NULL) {
+			(void)CC_append_diagnostic_text(&text, "    Explanation: %s\n", container.explanation);
+		}
 
-	if (container.description != NULL) {
-		(void)printf("    Error: %s\n", container.description);
-	}
-	
-	if (container.explanation != NULL) {
-		(void)printf("    Explanation: %s\n", container.explanation);
-	}
+		if (container.suggestion != NULL) {
+			(void)CC_append_diagnostic_text(&text, "    Suggestion: %s\n", container.suggestion);
+		}
 
-	if (container.suggestion != NULL) {
-		(void)printf("    Suggestion: %s\n", container.suggestion);
+		(void)CC_append_diagnostic_text(&text, TEXT_COLOR_RESET);
 	}
 
-	(void)printf(TEXT_COLOR_RESET);
+	struct Diagnostic *diagnostic = CC_add_diagnostic(node->line + 1, errorCharsAwayFromNL + 1, false, "%s: %s", message,
+		container.description != NULL ? container.description : node->value);
+	(void)CC_attach_diagnostic_text(diagnostic, node->position, &text);
 }
 
 /**
@@ -2979,12 +4308,12 @@ void THROW_EXCEPTION(char *message, struct SemanticReport rep) {
  * </p>
  */
 void THROW_ASSIGNED_EXCEPTION(struct SemanticReport rep) {
-	switch (rep.errorType) {
+	switch (rep.error->type) {
 	case ALREADY_DEFINED_EXCEPTION:
-		(void)THROW_ALREADY_DEFINED_EXCEPTION(rep.errorNode);
+		(void)THROW_ALREADY_DEFINED_EXCEPTION(rep.error->node);
 		break;
 	case NOT_DEFINED_EXCEPTION:
-		(void)THROW_NOT_DEFINED_EXCEPTION(rep.errorNode);
+		(void)THROW_NOT_DEFINED_EXCEPTION(rep.error->node);
 		break;
 	case TYPE_MISMATCH_EXCEPTION:
 		(void)THROW_TYPE_MISMATCH_EXCEPTION(rep);
@@ -26,6 +26,10 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <time.h>
 #include "../headers/Token.h"
 #include "../headers/errors.h"
+#include "../headers/tokenIndex.h"
+#include "../headers/lineIndex.h"
+#include "../headers/compilerContext.h"
+#include "../headers/logger.h"
 
 /**
  * The subprogram {@code SPACE.src.syntaxAnalyzer} was created
@@ -54,6 +58,8 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #define true 1
 #define false 0
 
+#define EDIT_SECTION_ATTEMPTS 8
+
 /**
  * <p>
  * Structure for storing Syntax reports.
@@ -81,15 +87,41 @@ enum ParameterType {
 	_PARAM_FUNCTION_CALL_, _PARAM_FUNCTION_, _PARAM_CLASS_
 };
 
+/**
+ * <p>
+ * The search for the end of the checked main statements in a window of the
+ * streaming front end. The position is the next token to look at, the
+ * counters hold the open braces, brackets and edge brackets before it. The flags
+ * tell, if the next token starts a main statement and if the current main
+ * statement starts with a keyword.
+ * </p>
+*/
+struct StatementScan {
+	size_t position;
+	int braces;
+	int brackets;
+	int edgeBrackets;
+	int statementStart;
+	int keywordStatement;
+};
+
 int SA_enter_panic_mode(TOKEN **tokens, size_t startPos, int runnableWithBlock);
 SyntaxReport SA_is_runnable(TOKEN **tokens, size_t startPos, int withBlock);
 int SA_handle_runnable_rep(SyntaxReport report, TOKEN **tokens, size_t startPos, int *jumper, int withBlock);
+size_t SA_find_statements_end(TOKEN *tokens, size_t tokenCount, struct StatementScan *scan);
+void SA_release_statements(TOKEN **tokens, size_t statementsEnd, size_t tokenCount, struct StatementScan *scan);
+struct StatementBoundary *SA_collect_statement_boundaries(TOKEN *tokens, size_t tokenCount, struct StatementBoundary first, size_t *count);
+size_t SA_find_edited_boundary(size_t offset);
+int SA_lex_edited_section(size_t *first, size_t *last, size_t offset, size_t removedLength, long long characters, size_t *lines, size_t *sectionTokens);
 
 SyntaxReport SA_is_non_keyword_based_runnable(TOKEN **tokens, size_t startPos);
 SyntaxReport SA_is_null_assigned_class_instance(TOKEN **tokens, size_t startPos);
 SyntaxReport SA_is_runnable_function_call(TOKEN **tokens, size_t startPos);
 int SA_predict_expression(TOKEN **tokens, size_t startPos);
 SyntaxReport SA_is_keyword_based_runnable(TOKEN **tokens, size_t startPos);
+SyntaxReport SA_is_modified_runnable(TOKEN **tokens, size_t startPos);
+SyntaxReport SA_is_else_runnable(TOKEN **tokens, size_t startPos);
+SyntaxReport SA_is_this_runnable(TOKEN **tokens, size_t startPos);
 SyntaxReport SA_is_class_object_access(TOKEN **tokens, size_t startPos, int independentCall);
 SyntaxReport SA_is_return_statement(TOKEN **tokens, size_t startPos);
 SyntaxReport SA_is_return_class_instance(TOKEN **tokens, size_t startPos);
@@ -149,46 +181,57 @@ int SA_is_reference(TOKEN *token);
 int SA_is_pointer(const TOKEN *token);
 int SA_is_letter(const char character);
 int SA_is_number(const char character);
-int SA_is_rational_operator(const char *sequence);
+int SA_is_rational_operator(TOKENTYPES type);
 int SA_is_arithmetic_operator(const TOKEN *token);
-int SA_is_assignment_operator(const char *sequence);
+int SA_is_assignment_operator(TOKENTYPES type);
 int SA_is_underscore(const char character);
-int SA_is_bool(const char *sequence);
-int SA_is_modifier(const char *sequence);
-int SA_is_logic_operator(const char *sequence);
+int SA_is_bool(TOKENTYPES type);
+int SA_is_modifier(TOKENTYPES type);
+int SA_is_logic_operator(TOKENTYPES type);
 
 SyntaxReport SA_create_syntax_report(TOKEN *token, int tokensToSkip, int errorOccured, char *expextedToken);
 void SA_throw_error(TOKEN *errorToken, char *expectedToken);
 
 /**
- * This flag is turned true, if an error occured
- */
-int FILE_CONTAINS_ERRORS = 0;
-
-/**
- * Holds the total length of all tokens (init during ".CheckInput()")
- */
-size_t MAX_TOKEN_LENGTH = 0;
-
-/**
- * Holds the source code
+ * <p>
+ * Checks a statement, that starts with a keyword.
+ * </p>
  */
-extern char **BUFFER;
+typedef SyntaxReport (*SyntaxRule)(TOKEN **tokens, size_t startPos);
 
 /**
- * Defines the length of the source code
+ * <p>
+ * The rule of every keyword, that starts a statement, indexed by the
+ * token type. Tokens without a rule (NULL) start a non keyword based
+ * runnable, so the next statement is chosen with one lookup.
+ * </p>
  */
-extern size_t BUFFER_LENGTH;
+const SyntaxRule KEYWORD_RUNNABLE_RULES[TOKEN_TYPE_COUNT] = {
+	[_KW_GLOBAL_] = SA_is_modified_runnable,     [_KW_SECURE_] = SA_is_modified_runnable,
+	[_KW_PRIVATE_] = SA_is_modified_runnable,    [_KW_VAR_] = SA_is_variable,
+	[_KW_CONST_] = SA_is_variable,               [_KW_FUNCTION_] = SA_is_function,
+	[_KW_CLASS_] = SA_is_class,                  [_KW_IF_] = SA_is_if_statement,
+	[_KW_ELSE_] = SA_is_else_runnable,           [_KW_WHILE_] = SA_is_while_statement,
+	[_KW_DO_] = SA_is_do_statment,               [_KW_FOR_] = SA_is_for_statement,
+	[_KW_TRY_] = SA_is_try_statement,            [_KW_CATCH_] = SA_is_catch_statement,
+	[_KW_CHECK_] = SA_is_check_statement,        [_KW_INCLUDE_] = SA_is_include,
+	[_KW_EXPORT_] = SA_is_export,                [_KW_ENUM_] = SA_is_enum,
+	[_KW_THIS_] = SA_is_this_runnable,           [_KW_BREAK_] = SA_is_break_statement,
+	[_KW_RETURN_] = SA_is_return_statement,      [_KW_CONTINUE_] = SA_is_continue_statement
+};
 
-/**
- * Contains the name of the source file for error dumping
- */
-extern char *FILE_NAME;
+struct Node *PG_create_main_runnable(TOKEN **tokens);
+size_t PG_append_main_statements(struct Node *runnable, TOKEN **tokens, size_t position, size_t end);
+void PG_print_parsetree(struct Node *root);
+size_t LX_lex_window(size_t *position, size_t *lineNumber, size_t keptTokens);
+void LX_release_tokens(size_t count, size_t tokenCount);
+int LX_lex_section(size_t start, size_t end, size_t *lineNumber, size_t *tokenCount);
+size_t PG_replace_main_statements(struct Node *root, size_t first, size_t end, struct Node *runnable, long long lines, long long characters);
 
-/**
- * Length of the tokens
- */
-extern size_t TOKEN_LENGTH;
+/*
+The state of the syntax check (error flag, token length, panic mode and the
+build position of the main statements) is kept in the CURRENT_CONTEXT (see compilerContext.h)
+*/
 
 /**
  * <p>
@@ -197,42 +240,619 @@ extern size_t TOKEN_LENGTH;
  * introduced by the programmer.
  * </p>
  * 
+ * @param *context  Compilation, that the tokens belong to
  * @param tokens    Pointer the the tokens array from the lexer
 */
-int CheckInput(TOKEN **tokens) {
-	if (tokens == NULL || TOKEN_LENGTH < 1) {
+int CheckInput(struct CompilerContext *context, TOKEN **tokens) {
+	(void)CC_use_context(context);
+
+	if (tokens == NULL || CURRENT_CONTEXT->tokenLength < 1) {
 		(void)PARSER_TOKEN_TRANSMISSION_EXCEPTION();
 		return -1;
 	}
 
-	MAX_TOKEN_LENGTH = TOKEN_LENGTH;
+	CURRENT_CONTEXT->maxTokenLength = CURRENT_CONTEXT->tokenLength;
 	clock_t start, end;
 
 	if (SYNTAX_ANALYZER_DISPLAY_USED_TIME == true) {
 		start = clock();
 	}
 
-	if (SYNTAX_ANALYZER_DEBUG_MODE == true) {
-		(void)printf("\n\n\n>>>>>>>>>>>>>>>>>>>>    SYNTAX ANALYZER    <<<<<<<<<<<<<<<<<<<<\n\n");
-	}
+	LOG(LOG_SYNTAX, LOG_INFO, "\n\n\n>>>>>>>>>>>>>>>>>>>>    SYNTAX ANALYZER    <<<<<<<<<<<<<<<<<<<<\n\n");
 
 	//Start of the check sequence
 	(void)SA_is_runnable(tokens, 0, false);
 
-	if (SYNTAX_ANALYZER_DEBUG_MODE == true) {
-		(void)printf("\n>>>>>    Tokens successfully analyzed    <<<<<\n");
+	LOG(LOG_SYNTAX, LOG_INFO, "\n>>>>>    Tokens successfully analyzed    <<<<<\n");
+
+	if (SYNTAX_ANALYZER_DISPLAY_USED_TIME == true) {
+		end = clock();
+		LOG(LOG_SYNTAX, LOG_INFO, "\nCPU time used for SYNTAX ANALYSIS: %f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);
 	}
 
+	return CURRENT_CONTEXT->fileContainsErrors == false ? 0 : 1;
+}
+
+/**
+ * <p>
+ * Checks the token sequence like CheckInput() and builds the parsetree
+ * with GenerateCheckedParsetree() afterwards.
+ * </p>
+ * 
+ * <p>
+ * These are still two passes over the tokens: the parsetree generator
+ * relies on checked tokens, so an error behind a statement must keep
+ * it from being built.
+ * </p>
+ * 
+ * @returns 0 if the tokens contain no errors, otherwise 1
+ * 
+ * @param *context  Compilation, that the tokens belong to
+ * @param **tokens  Pointer the the tokens array from the lexer
+ * @param **root    Pointer, that receives the parsetree (NULL on errors)
+*/
+int CheckInputAndGenerateParsetree(struct CompilerContext *context, TOKEN **tokens, struct Node **root) {
+	(*root) = NULL;
+	int containsErrors = (int)CheckInput(context, tokens);
+
+	if (containsErrors != 0) {
+		return containsErrors;
+	}
+
+	(*root) = GenerateCheckedParsetree(context, tokens);
+	return 0;
+}
+
+/**
+ * <p>
+ * Builds the parsetree of tokens, that CheckInput() accepted without
+ * errors, one main statement after the other.
+ * </p>
+ * 
+ * <p>
+ * The statements are built by PG_append_main_statements(), like in the
+ * streaming front end and for the edits of the compile server.
+ * </p>
+ * 
+ * @returns The parsetree
+ * 
+ * @param *context  Compilation, that the tokens belong to
+ * @param **tokens  Pointer the the tokens array from the lexer
+*/
+struct Node *GenerateCheckedParsetree(struct CompilerContext *context, TOKEN **tokens) {
+	(void)CC_use_context(context);
+	CURRENT_CONTEXT->buildPosition = 0;
+	clock_t start, end;
+
+	if (PARSETREE_GENERATOR_DISPLAY_USED_TIME == true) {
+		start = clock();
+	}
+
+	struct Node *runnable = PG_create_main_runnable(tokens);
+	(void)PG_append_main_statements(runnable, tokens, CURRENT_CONTEXT->buildPosition, CURRENT_CONTEXT->maxTokenLength);
+	CURRENT_CONTEXT->root = runnable;
+
+	if (PARSETREE_GENERATOR_DISPLAY_USED_TIME == true) {
+		end = clock();
+	}
+
+	//The compile server keeps the boundaries of the main statements for the next edit
+	if (CURRENT_CONTEXT->keepEditBase == true) {
+		struct StatementBoundary first = {0, 0, 0, 0};
+		CURRENT_CONTEXT->statementBoundaries = SA_collect_statement_boundaries(*tokens, CURRENT_CONTEXT->tokenLength, first, &CURRENT_CONTEXT->statementBoundaryCount);
+		CURRENT_CONTEXT->statementBoundaryCount = CURRENT_CONTEXT->statementBoundaries != NULL ? CURRENT_CONTEXT->statementBoundaryCount : 0;
+		(void)free(CURRENT_CONTEXT->mainStatementStarts);
+		CURRENT_CONTEXT->mainStatementStarts = NULL;
+		CURRENT_CONTEXT->mainStatementCount = 0;
+		CURRENT_CONTEXT->mainStatementCapacity = 0;
+	}
+
+	(void)PG_print_parsetree(runnable);
+
+	if (PARSETREE_GENERATOR_DISPLAY_USED_TIME == true) {
+		LOG(LOG_PARSETREE, LOG_INFO, "\nCPU time used for PARSETREE GENERATION: %f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);
+	}
+
+	return runnable;
+}
+
+/**
+ * <p>
+ * Checks the input and generates the parsetree like
+ * CheckInputAndGenerateParsetree(), but the buffer is lexed in windows
+ * (see LX_lex_window()), so only the tokens of one window are in memory.
+ * </p>
+ * 
+ * <p>
+ * The main statements, that are complete in a window, are checked and
+ * built into the tree, then their tokens are released. The unfinished
+ * statement at the end of the window is kept for the next window. The
+ * errors and the tree are the same as with all tokens at once.
+ * </p>
+ * 
+ * @returns
+ * <ul>
+ * <li>0 - No errors
+ * <li>1 - The input contains syntax errors, no tree is returned
+ * </ul>
+ * 
+ * @param *context  Compilation with the source buffer
+ * @param **root    Set to the generated parsetree
+ */
+int CheckStreamAndGenerateParsetree(struct CompilerContext *context, struct Node **root) {
+	(void)CC_use_context(context);
+	(*root) = NULL;
+
+	TOKEN **tokens = &CURRENT_CONTEXT->tokens;
+	struct StatementScan scan = {0, 0, 0, 0, true, false};
+
+	//The released tokens can't be lexed again after an edit
+	CURRENT_CONTEXT->keepEditBase = false;
+	size_t position = 0;
+	size_t lineNumber = 0;
+	size_t keptTokens = 0;
+	int lastWindow = false;
+	int checkEnded = false;
+	struct Node *runnable = NULL;
+	int runnableComplete = false;
+	CURRENT_CONTEXT->buildPosition = 0;
+	clock_t start, end;
+
+	if (SYNTAX_ANALYZER_DISPLAY_USED_TIME == true) {
+		start = clock();
+	}
+
+	LOG(LOG_SYNTAX, LOG_INFO, "\n\n\n>>>>>>>>>>>>>>>>>>>>    SYNTAX ANALYZER    <<<<<<<<<<<<<<<<<<<<\n\n");
+
+	while (lastWindow == false) {
+		size_t tokenCount = (size_t)LX_lex_window(&position, &lineNumber, keptTokens);
+		lastWindow = position >= CURRENT_CONTEXT->bufferLength;
+
+		if (lastWindow == true && CURRENT_CONTEXT->releasedTokens + tokenCount < 1) {
+			(void)PARSER_TOKEN_TRANSMISSION_EXCEPTION();
+			return -1;
+		}
+
+		//The last window is checked up to the EOF token, after the check ended the rest is only lexed
+		size_t statementsEnd = lastWindow == true || checkEnded == true ? tokenCount : (size_t)SA_find_statements_end(*tokens, tokenCount, &scan);
+
+		if (statementsEnd > 0 && checkEnded == false) {
+			(void)TI_build_token_index(*tokens, lastWindow == true ? tokenCount + 1 : tokenCount);
+
+			//No token is released before the first statements end, so the runnable starts at the first token
+			if (runnable == NULL) {
+				runnable = PG_create_main_runnable(tokens);
+			}
+
+			//Like with all tokens at once, the check of the main runnable ends at its first error
+			CURRENT_CONTEXT->maxTokenLength = statementsEnd;
+			checkEnded = SA_is_runnable(tokens, 0, false).errorOccured;
+
+			if (CURRENT_CONTEXT->fileContainsErrors == false && runnableComplete == false) {
+				CURRENT_CONTEXT->buildPosition = (size_t)PG_append_main_statements(runnable, tokens, CURRENT_CONTEXT->buildPosition, statementsEnd);
+				runnableComplete = CURRENT_CONTEXT->buildPosition >= tokenCount;
+			}
+		}
+
+		if (lastWindow == false) {
+			(void)SA_release_statements(tokens, statementsEnd, tokenCount, &scan);
+			keptTokens = tokenCount - statementsEnd;
+		}
+	}
+
+	LOG(LOG_SYNTAX, LOG_INFO, "\n>>>>>    Tokens successfully analyzed    <<<<<\n");
+
 	if (SYNTAX_ANALYZER_DISPLAY_USED_TIME == true) {
 		end = clock();
-		(void)printf("\nCPU time used for SYNTAX ANALYSIS: %f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);   
+		LOG(LOG_SYNTAX, LOG_INFO, "\nCPU time used for SYNTAX ANALYSIS AND PARSETREE GENERATION: %f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);
+	}
+
+	if (CURRENT_CONTEXT->fileContainsErrors == true) {
+		return 1;
+	}
+
+	(*root) = runnable;
+	CURRENT_CONTEXT->root = runnable;
+	(void)PG_print_parsetree(*root);
+	return 0;
+}
+
+/**
+ * <p>
+ * Finds the end of the last main statement, that is complete in the
+ * tokens of a window.
+ * </p>
+ * 
+ * <p>
+ * A main statement ends with a ";" or "}" outside of all brackets, if the
+ * next token starts a new keyword based statement. "else", "catch" and
+ * "while" can continue the statement before, so they don't end it. A "}"
+ * only ends a keyword based statement, the parsetree generator builds a
+ * block without a keyword together with the following statements. After
+ * a closing bracket without an opening one (e.g. a "}" without a "{") no
+ * end is taken anymore, the rest of the input is checked in the last window.
+ * </p>
+ * 
+ * @returns The position after the last complete statement, 0 if there is none
+ * 
+ * @param *tokens       Tokens of the window
+ * @param tokenCount    Number of tokens in the window
+ * @param *scan         State of the search, it goes on from the last window
+ */
+size_t SA_find_statements_end(TOKEN *tokens, size_t tokenCount, struct StatementScan *scan) {
+	size_t statementsEnd = 0;
+
+	for (; scan->position + 1 < tokenCount && scan->braces >= 0 && scan->brackets >= 0 && scan->edgeBrackets >= 0; scan->position++) {
+		TOKENTYPES type = tokens[scan->position].type;
+		TOKENTYPES next = tokens[scan->position + 1].type;
+		int outside = scan->braces == 0 && scan->brackets == 0 && scan->edgeBrackets == 0;
+		int continued = next == _KW_ELSE_ || next == _KW_CATCH_ || next == _KW_WHILE_;
+
+		if (outside == true && scan->statementStart == true) {
+			scan->keywordStatement = KEYWORD_RUNNABLE_RULES[type] != NULL;
+			scan->statementStart = false;
+		}
+
+		switch (type) {
+		case _OP_RIGHT_BRACE_:
+			scan->braces++;
+			break;
+		case _OP_LEFT_BRACE_:
+			scan->braces--;
+			break;
+		case _OP_RIGHT_BRACKET_:
+			scan->brackets++;
+			break;
+		case _OP_LEFT_BRACKET_:
+			scan->brackets--;
+			break;
+		case _OP_RIGHT_EDGE_BRACKET_:
+			scan->edgeBrackets++;
+			break;
+		case _OP_LEFT_EDGE_BRACKET_:
+			scan->edgeBrackets--;
+			break;
+		default:
+			break;
+		}
+
+		outside = scan->braces == 0 && scan->brackets == 0 && scan->edgeBrackets == 0;
+
+		if (outside == false || (type != _OP_SEMICOLON_ && type != _OP_LEFT_BRACE_) || continued == true) {
+			continue;
+		}
+
+		if (KEYWORD_RUNNABLE_RULES[next] != NULL && (type == _OP_SEMICOLON_ || scan->keywordStatement == true)) {
+			statementsEnd = scan->position + 1;
+		}
+
+		scan->statementStart = true;
+	}
+
+	return statementsEnd;
+}
+
+/**
+ * <p>
+ * Releases the tokens of the checked statements of a window and moves the
+ * positions of the syntax analyzer and the parsetree generator to the
+ * kept tokens.
+ * </p>
+ * 
+ * @param **tokens          Pointer to the tokens array
+ * @param statementsEnd     Position after the checked statements
+ * @param tokenCount        Number of tokens in the window
+ * @param *scan             State of the search for the statement ends
+ */
+void SA_release_statements(TOKEN **tokens, size_t statementsEnd, size_t tokenCount, struct StatementScan *scan) {
+	//The panic mode counts the braces from its last start on
+	for (size_t i = CURRENT_CONTEXT->panicModeLastStartPos; i < statementsEnd; i++) {
+		if ((*tokens)[i].type == _OP_LEFT_BRACE_) {
+			CURRENT_CONTEXT->panicModeOpenBraces--;
+		} else if ((*tokens)[i].type == _OP_RIGHT_BRACE_) {
+			CURRENT_CONTEXT->panicModeOpenBraces++;
+		}
+	}
+
+	CURRENT_CONTEXT->panicModeLastStartPos = CURRENT_CONTEXT->panicModeLastStartPos > statementsEnd
+		? CURRENT_CONTEXT->panicModeLastStartPos - statementsEnd : 0;
+	CURRENT_CONTEXT->buildPosition = CURRENT_CONTEXT->buildPosition > statementsEnd
+		? CURRENT_CONTEXT->buildPosition - statementsEnd : 0;
+	scan->position = scan->position > statementsEnd ? scan->position - statementsEnd : 0;
+	(void)LX_release_tokens(statementsEnd, tokenCount);
+}
+
+/**
+ * <p>
+ * Checks an edit of the source against the parsetree of the last
+ * compilation (compile server, see CheckInputAndGenerateParsetree()).
+ * </p>
+ * 
+ * <p>
+ * Only the main statements around the edit are lexed, checked and built
+ * again. The section starts at the last statement boundary before the
+ * edit and ends at the first boundary behind it, where the lexer is in
+ * code again and the boundary is found in the new tokens as well. The
+ * new details replace the ones of the section in the root, the details
+ * and boundaries behind it are moved by the lines and characters of the
+ * edit. The tokens behind the section would be the same, so the tree is
+ * the same as after a whole compilation.
+ * </p>
+ * 
+ * <p>
+ * The buffer of the context has to hold the edited source already.
+ * </p>
+ * 
+ * @returns
+ * <ul>
+ * <li>0 - The parsetree is updated
+ * <li>1 - The edited section contains syntax errors
+ * <li>-1 - The edit can't be checked on its own, the source has to be compiled as a whole
+ * </ul>
+ * 
+ * @param *context          Compilation with the parsetree and the statement boundaries of the last source
+ * @param offset            Index of the first removed character in the last source
+ * @param removedLength     Number of removed characters
+ * @param insertedLength    Number of inserted characters
+ */
+int CheckEditAndUpdateParsetree(struct CompilerContext *context, size_t offset, size_t removedLength, size_t insertedLength) {
+	(void)CC_use_context(context);
+	struct Node *root = CURRENT_CONTEXT->root;
+
+	//The replaced nodes stay in the arena, so a tree with more replaced than living nodes is built again
+	if (root == NULL || CURRENT_CONTEXT->statementBoundaryCount == 0 || CURRENT_CONTEXT->bufferLength > TOKEN_MAX_POSITION
+		|| CURRENT_CONTEXT->replacedNodes * 2 > CURRENT_CONTEXT->nodeCount) {
+		return -1;
+	}
+
+	TOKEN **tokens = &CURRENT_CONTEXT->tokens;
+	long long characters = (long long)insertedLength - (long long)removedLength;
+	size_t first = (size_t)SA_find_edited_boundary(offset);
+	size_t last = first + 1;
+	size_t lines = 0;
+	size_t sectionTokens = 0;
+
+	if ((int)SA_lex_edited_section(&first, &last, offset, removedLength, characters, &lines, &sectionTokens) == false) {
+		return -1;
+	}
+
+	struct StatementBoundary *boundaries = CURRENT_CONTEXT->statementBoundaries;
+	size_t boundaryCount = CURRENT_CONTEXT->statementBoundaryCount;
+	int endsAtBoundary = last < boundaryCount;
+	long long movedLines = endsAtBoundary == true ? (long long)lines - (long long)boundaries[last].line : 0;
+
+	(void)TI_build_token_index(*tokens, CURRENT_CONTEXT->tokenLength + 1);
+	CURRENT_CONTEXT->buildPosition = 0;
+	CURRENT_CONTEXT->maxTokenLength = sectionTokens;
+	(void)SA_is_runnable(tokens, 0, false);
+
+	if (CURRENT_CONTEXT->fileContainsErrors == true) {
+		return 1;
+	}
+
+	struct Node *runnable = PG_create_main_runnable(tokens);
+
+	//A "}" without an opening "{" ends the main runnable, the statements behind it are not built anymore
+	size_t position = (size_t)PG_append_main_statements(runnable, tokens, CURRENT_CONTEXT->buildPosition, sectionTokens);
+
+	if (endsAtBoundary == true && position != sectionTokens) {
+		return -1;
 	}
 
-	return FILE_CONTAINS_ERRORS == false ? 0 : 1;
+	size_t sectionCount = 0;
+	struct StatementBoundary start = {boundaries[first].start, boundaries[first].terminator, boundaries[first].line, 0};
+	struct StatementBoundary *sectionBoundaries = SA_collect_statement_boundaries(*tokens, sectionTokens, start, &sectionCount);
+	(void)free(CURRENT_CONTEXT->mainStatementStarts);
+	CURRENT_CONTEXT->mainStatementStarts = NULL;
+	CURRENT_CONTEXT->mainStatementCount = 0;
+	CURRENT_CONTEXT->mainStatementCapacity = 0;
+	size_t count = boundaryCount - (last - first) + sectionCount;
+	struct StatementBoundary *newBoundaries = (struct StatementBoundary*)malloc(sizeof(struct StatementBoundary) * count);
+
+	if (sectionBoundaries == NULL || newBoundaries == NULL) {
+		(void)free(sectionBoundaries);
+		(void)free(newBoundaries);
+		return -1;
+	}
+
+	//The details behind the section are moved like the boundaries
+	size_t firstDetail = boundaries[first].detail;
+	size_t endDetail = endsAtBoundary == true ? boundaries[last].detail : (size_t)-1;
+	size_t newDetails = (size_t)PG_replace_main_statements(root, firstDetail, endDetail, runnable, movedLines, characters);
+	long long movedDetails = endsAtBoundary == true ? (long long)newDetails - (long long)(endDetail - firstDetail) : 0;
+
+	(void)memcpy(newBoundaries, boundaries, sizeof(struct StatementBoundary) * first);
+
+	for (size_t i = 0; i < sectionCount; i++) {
+		newBoundaries[first + i] = sectionBoundaries[i];
+		newBoundaries[first + i].detail += firstDetail;
+	}
+
+	for (size_t i = last; i < boundaryCount; i++) {
+		struct StatementBoundary *boundary = &newBoundaries[i - last + first + sectionCount];
+		(*boundary) = boundaries[i];
+		boundary->start = (size_t)((long long)boundary->start + characters);
+		boundary->terminator = (size_t)((long long)boundary->terminator + characters);
+		boundary->line = (size_t)((long long)boundary->line + movedLines);
+		boundary->detail = (size_t)((long long)boundary->detail + movedDetails);
+	}
+
+	(void)free(sectionBoundaries);
+	(void)free(boundaries);
+	CURRENT_CONTEXT->statementBoundaries = newBoundaries;
+	CURRENT_CONTEXT->statementBoundaryCount = count;
+
+	LOG(LOG_SYNTAX, LOG_INFO, "Edit checked in %zu tokens, %zu main statements built again\n", sectionTokens, newDetails);
+	return 0;
 }
 
-int panicModeOpenBraces = 0;
-int panicModeLastStartPos = 0;
+/**
+ * <p>
+ * Finds the last statement boundary, that starts at or before the offset.
+ * </p>
+ * 
+ * @returns The index of the boundary
+ * 
+ * @param offset    Index of the first edited character
+ */
+size_t SA_find_edited_boundary(size_t offset) {
+	struct StatementBoundary *boundaries = CURRENT_CONTEXT->statementBoundaries;
+	size_t low = 0;
+	size_t high = CURRENT_CONTEXT->statementBoundaryCount;
+
+	while (high - low > 1) {
+		size_t middle = low + (high - low) / 2;
+
+		if (boundaries[middle].start <= offset) {
+			low = middle;
+		} else {
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+/**
+ * <p>
+ * Lexes the section of an edit, the section grows by one statement till
+ * its tokens start and end like in the whole source.
+ * </p>
+ * 
+ * <p>
+ * The first token has to start the section with a keyword, that ends the
+ * statement before (see SA_find_statements_end()). The end of the section
+ * can't be in a string or comment, its last token has to be the unchanged
+ * terminator before the next boundary and the new tokens have to end at
+ * that boundary. The text behind the section is not edited, so its tokens
+ * are the same.
+ * </p>
+ * 
+ * @returns true, if the section was lexed within EDIT_SECTION_ATTEMPTS attempts
+ * 
+ * @param *first            Index of the first boundary of the section
+ * @param *last             Index of the boundary behind the section, the boundary count for the end of the source
+ * @param offset            Index of the first removed character in the last source
+ * @param removedLength     Number of removed characters
+ * @param characters        Number of inserted minus removed characters
+ * @param *lines            Set to the line at the end of the section
+ * @param *sectionTokens    Set to the number of tokens in the section
+ */
+int SA_lex_edited_section(size_t *first, size_t *last, size_t offset, size_t removedLength, long long characters, size_t *lines, size_t *sectionTokens) {
+	struct StatementBoundary *boundaries = CURRENT_CONTEXT->statementBoundaries;
+	size_t boundaryCount = CURRENT_CONTEXT->statementBoundaryCount;
+
+	//The terminator of the next boundary and the text behind it are not edited
+	while ((*last) < boundaryCount && boundaries[*last].terminator < offset + removedLength) {
+		(*last)++;
+	}
+
+	for (int attempt = 0; attempt < EDIT_SECTION_ATTEMPTS; attempt++) {
+		size_t start = boundaries[*first].start;
+		size_t end = (*last) < boundaryCount ? (size_t)((long long)boundaries[*last].start + characters) : CURRENT_CONTEXT->bufferLength;
+		(*lines) = boundaries[*first].line;
+
+		//The lexer fills cleared tokens, like the ones of a new token array
+		if (CURRENT_CONTEXT->tokens != NULL) {
+			(void)memset(CURRENT_CONTEXT->tokens, 0, sizeof(TOKEN) * CURRENT_CONTEXT->tokensCapacity);
+		}
+
+		if ((int)LX_lex_section(start, end, lines, sectionTokens) == false) {
+			if ((*last) == boundaryCount) {
+				return false;
+			}
+
+			(*last)++;
+			continue;
+		}
+
+		TOKEN *tokens = CURRENT_CONTEXT->tokens;
+		TOKENTYPES type = tokens[0].type;
+
+		if ((*first) > 0 && (tokens[0].tokenStart != start || KEYWORD_RUNNABLE_RULES[type] == NULL
+			|| type == _KW_ELSE_ || type == _KW_CATCH_ || type == _KW_WHILE_)) {
+			(*first)--;
+			continue;
+		} else if ((*last) == boundaryCount) {
+			return true;
+		}
+
+		struct StatementScan scan = {0, 0, 0, 0, true, false};
+		size_t terminator = (size_t)((long long)boundaries[*last].terminator + characters);
+		int endsAtTerminator = (*sectionTokens) > 0 && tokens[(*sectionTokens) - 1].tokenStart == terminator
+			&& (tokens[(*sectionTokens) - 1].type == _OP_SEMICOLON_ || tokens[(*sectionTokens) - 1].type == _OP_LEFT_BRACE_);
+
+		if (endsAtTerminator == true && (size_t)SA_find_statements_end(tokens, (*sectionTokens) + 1, &scan) == (*sectionTokens)
+			&& scan.braces == 0 && scan.brackets == 0 && scan.edgeBrackets == 0) {
+			return true;
+		}
+
+		(*last)++;
+	}
+
+	return false;
+}
+
+/**
+ * <p>
+ * Collects the boundaries of the main statements in the tokens, at which
+ * SA_find_statements_end() would end a window, and maps them to the
+ * details of the main runnable, that was built from the tokens. Only the
+ * ends, at which a detail starts, are taken.
+ * </p>
+ * 
+ * @returns The boundaries (allocated), NULL if no memory could be reserved
+ * 
+ * @param *tokens       Tokens of the main statements
+ * @param tokenCount    Number of tokens, the token behind the last statement included
+ * @param first         Boundary at the first token
+ * @param *count        Set to the number of boundaries
+ */
+struct StatementBoundary *SA_collect_statement_boundaries(TOKEN *tokens, size_t tokenCount, struct StatementBoundary first, size_t *count) {
+	size_t capacity = 16;
+	struct StatementBoundary *boundaries = (struct StatementBoundary*)malloc(sizeof(struct StatementBoundary) * capacity);
+	struct StatementScan scan = {0, 0, 0, 0, true, false};
+	size_t *starts = CURRENT_CONTEXT->mainStatementStarts;
+	size_t detailCount = 0;
+	(*count) = 0;
+
+	if (boundaries == NULL) {
+		return NULL;
+	}
+
+	boundaries[(*count)++] = first;
+
+	//Every call looks at one more token, so every end is found
+	for (size_t length = 2; length <= tokenCount; length++) {
+		size_t end = (size_t)SA_find_statements_end(tokens, length, &scan);
+
+		while (end > 0 && detailCount < CURRENT_CONTEXT->mainStatementCount && starts[detailCount] < end) {
+			detailCount++;
+		}
+
+		//A statement can be built over the end (e.g. after a "}" the main runnable ends), the section can't start there
+		if (end == 0 || detailCount >= CURRENT_CONTEXT->mainStatementCount || starts[detailCount] != end) {
+			continue;
+		}
+
+		if ((*count) == capacity) {
+			capacity *= 2;
+			struct StatementBoundary *grownBoundaries = (struct StatementBoundary*)realloc(boundaries, sizeof(struct StatementBoundary) * capacity);
+
+			if (grownBoundaries == NULL) {
+				(void)free(boundaries);
+				return NULL;
+			}
+
+			boundaries = grownBoundaries;
+		}
+
+		struct StatementBoundary boundary = {tokens[end].tokenStart, tokens[end - 1].tokenStart, tokens[end].line, detailCount};
+		boundaries[(*count)++] = boundary;
+	}
+
+	return boundaries;
+}
 
 /**
  * <p>
@@ -245,26 +865,35 @@ int panicModeLastStartPos = 0;
  * @param runnableWithBlock Is the panic mode happening in a block-runnable
 */
 int SA_enter_panic_mode(TOKEN **tokens, size_t startPos, int runnableWithBlock) {
-	for (size_t i = panicModeLastStartPos; i < startPos; i++) {
+	for (size_t i = CURRENT_CONTEXT->panicModeLastStartPos; i < startPos; i++) {
 		if ((*tokens)[i].type == _OP_LEFT_BRACE_) {
-			panicModeOpenBraces--;
+			CURRENT_CONTEXT->panicModeOpenBraces--;
 		} else if ((*tokens)[i].type == _OP_RIGHT_BRACE_) {
-			panicModeOpenBraces++;
+			CURRENT_CONTEXT->panicModeOpenBraces++;
 		}
 	}
 
-	panicModeLastStartPos = startPos;
+	CURRENT_CONTEXT->panicModeLastStartPos = startPos;
 
-	for (size_t i = startPos + 1; i < MAX_TOKEN_LENGTH + 1; i++) {
+	for (size_t i = startPos + 1; i < CURRENT_CONTEXT->maxTokenLength + 1; i++) {
 		TOKEN *currentToken = &(*tokens)[i];
 
 		if (currentToken->type == __EOF__) {
-			if (panicModeOpenBraces > 1) {
-				(void)printf("SYNTAX ERROR: Missing %i closing braces \"}\".\n", panicModeOpenBraces);
-				(void)printf("Estimated line: %li (%s)\n", (*tokens)[startPos].line + 1, FILE_NAME);
-			} else if (panicModeLastStartPos == 1) {
-				(void)printf("SYNTAX ERROR: Missing 1 closing brace \"}\".\n");
-				(void)printf("Estimated line: %li (%s)\n", (*tokens)[startPos].line + 1, FILE_NAME);
+			int missingBraces = CURRENT_CONTEXT->panicModeOpenBraces > 1 ? CURRENT_CONTEXT->panicModeOpenBraces
+				: CURRENT_CONTEXT->panicModeLastStartPos == 1 ? 1 : 0;
+
+			if (missingBraces > 0) {
+				struct DiagnosticText text = {NULL, 0, 0};
+
+				if ((int)CC_is_rendering_diagnostics() == true) {
+					(void)CC_append_diagnostic_text(&text, missingBraces > 1 ? "SYNTAX ERROR: Missing %i closing braces \"}\".\n"
+						: "SYNTAX ERROR: Missing %i closing brace \"}\".\n", missingBraces);
+					(void)CC_append_diagnostic_text(&text, "Estimated line: %u (%s)\n", (*tokens)[startPos].line + 1, CURRENT_CONTEXT->fileName);
+				}
+
+				struct Diagnostic *diagnostic = CC_add_diagnostic((*tokens)[startPos].line + 1, 0, false, missingBraces > 1
+					? "Missing %i closing braces \"}\"." : "Missing %i closing brace \"}\".", missingBraces);
+				(void)CC_attach_diagnostic_text(diagnostic, (*tokens)[startPos].tokenStart, &text);
 			}
 
 			return i - startPos;
@@ -272,13 +901,13 @@ int SA_enter_panic_mode(TOKEN **tokens, size_t startPos, int runnableWithBlock)
 
 		if (runnableWithBlock == true) {
 			if (currentToken->type == _OP_LEFT_BRACE_) {
-				panicModeOpenBraces --;
+				CURRENT_CONTEXT->panicModeOpenBraces --;
 
-				if (panicModeOpenBraces == 0) {
+				if (CURRENT_CONTEXT->panicModeOpenBraces == 0) {
 					return i - startPos;
 				}
 			} else if (currentToken->type == _OP_RIGHT_BRACE_) {
-				panicModeOpenBraces++;
+				CURRENT_CONTEXT->panicModeOpenBraces++;
 			}
 		} else if ((int)is_keyword(currentToken) == true) {
 			switch (currentToken->type) {
@@ -317,7 +946,7 @@ SyntaxReport SA_is_runnable(TOKEN **tokens, size_t startPos, int withBlock) {
 		}
 	}
 
-	while (startPos + jumper <  MAX_TOKEN_LENGTH) {
+	while (startPos + jumper <  CURRENT_CONTEXT->maxTokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 		
 		if (currentToken->type == __EOF__) {
@@ -544,7 +1173,7 @@ SyntaxReport SA_is_runnable_function_call(TOKEN **tokens, size_t startPos) {
 int SA_predict_class_instance(TOKEN **tokens, size_t startPos) {
 	int jumper = 0;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH) {
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength) {
 		switch ((*tokens)[startPos + jumper].type) {
 		case _KW_NEW_:
 			return true;
@@ -570,9 +1199,16 @@ int SA_predict_class_instance(TOKEN **tokens, size_t startPos) {
  * @param startPos  Position from where to start checking
 */
 int SA_predict_expression(TOKEN **tokens, size_t startPos) {
+	unsigned int nextAssignment = (unsigned int)TI_get_next_assignment(*tokens, startPos);
+	unsigned int nextEnd = (unsigned int)TI_get_next_expression_end(*tokens, startPos);
+
+	if (nextAssignment != TI_NONE || nextEnd != TI_NONE) {
+		return nextAssignment < nextEnd && nextAssignment < CURRENT_CONTEXT->maxTokenLength;
+	}
+
 	int jumper = 0;
 
-	while (startPos + jumper <  MAX_TOKEN_LENGTH) {
+	while (startPos + jumper <  CURRENT_CONTEXT->maxTokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
 		switch (currentToken->type) {
@@ -585,7 +1221,7 @@ int SA_predict_expression(TOKEN **tokens, size_t startPos) {
 		case _OP_RIGHT_BRACE_:
 			return false;
 		default:
-			if ((int)SA_is_assignment_operator(currentToken->value) == true) {
+			if ((int)SA_is_assignment_operator(currentToken->type) == true) {
 				return true;
 			}
 
@@ -609,22 +1245,28 @@ int SA_predict_expression(TOKEN **tokens, size_t startPos) {
  * @param startPos  Position from where to start checking
 */
 SyntaxReport SA_is_keyword_based_runnable(TOKEN **tokens, size_t startPos) {
-	switch ((*tokens)[startPos].type) {
-	case _KW_GLOBAL_:
-	case _KW_SECURE_:
-	case _KW_PRIVATE_:
-		if ((*tokens)[startPos + 1].type == _KW_VAR_
-			|| (*tokens)[startPos + 1].type == _KW_CONST_) {
-			return SA_is_variable(tokens, startPos);
-		} else if ((*tokens)[startPos + 1].type == _KW_FUNCTION_) {
-			return SA_is_function(tokens, startPos);
-		} else if ((*tokens)[startPos + 1].type == _KW_CLASS_) {
-			return SA_is_class(tokens, startPos);
-		} else {
-			return SA_create_syntax_report(&(*tokens)[startPos + 1], 0, true, "var\", \"const\" or \"function");
-		}
+	TOKENTYPES type = (*tokens)[startPos].type;
+	SyntaxRule rule = (unsigned int)type < TOKEN_TYPE_COUNT ? KEYWORD_RUNNABLE_RULES[type] : NULL;
 
-		break;
+	if (rule != NULL) {
+		return rule(tokens, startPos);
+	}
+
+	return SA_create_syntax_report(NULL, 0, false, "N/A");
+}
+
+/**
+ * <p>
+ * Checks a variable, function or class with a visibility modifier.
+ * </p>
+ * 
+ * @returns SyntaxReport, that expresses an error or contains the tokens to skip on success
+ * 
+ * @param **tokens  Pointer to the TOKEN array
+ * @param startPos  Position of the modifier
+*/
+SyntaxReport SA_is_modified_runnable(TOKEN **tokens, size_t startPos) {
+	switch ((*tokens)[startPos + 1].type) {
 	case _KW_VAR_:
 	case _KW_CONST_:
 		return SA_is_variable(tokens, startPos);
@@ -632,46 +1274,43 @@ SyntaxReport SA_is_keyword_based_runnable(TOKEN **tokens, size_t startPos) {
 		return SA_is_function(tokens, startPos);
 	case _KW_CLASS_:
 		return SA_is_class(tokens, startPos);
-	case _KW_IF_:
-		return SA_is_if_statement(tokens, startPos);
-	case _KW_ELSE_:
-		if ((*tokens)[startPos + 1].type == _KW_IF_) {
-			return SA_is_else_if_statement(tokens, startPos);
-		} else {
-			return SA_is_else_statement(tokens, startPos);
-		}
-	case _KW_WHILE_:
-		return SA_is_while_statement(tokens, startPos);
-	case _KW_DO_:
-		return SA_is_do_statment(tokens, startPos);
-	case _KW_FOR_:
-		return SA_is_for_statement(tokens, startPos);
-	case _KW_TRY_:
-		return SA_is_try_statement(tokens, startPos);
-	case _KW_CATCH_:
-		return SA_is_catch_statement(tokens, startPos);
-	case _KW_CHECK_:
-		return SA_is_check_statement(tokens, startPos);
-	case _KW_INCLUDE_:
-		return SA_is_include(tokens, startPos);
-	case _KW_EXPORT_:
-		return SA_is_export(tokens, startPos);
-	case _KW_ENUM_:
-		return SA_is_enum(tokens, startPos);
-	case _KW_THIS_:
-		if ((*tokens)[startPos + 1].type == _OP_COLON_) {
-			return SA_is_class_constructor(tokens, startPos);
-		}
-
-		break;
-	case _KW_BREAK_:
-		return SA_is_break_statement(tokens, startPos);
-	case _KW_RETURN_:
-		return SA_is_return_statement(tokens, startPos);
-	case _KW_CONTINUE_:
-		return SA_is_continue_statement(tokens, startPos);
 	default:
-		break;
+		return SA_create_syntax_report(&(*tokens)[startPos + 1], 0, true, "var\", \"const\" or \"function");
+	}
+}
+
+/**
+ * <p>
+ * Checks an else or an else-if statement.
+ * </p>
+ * 
+ * @returns SyntaxReport, that expresses an error or contains the tokens to skip on success
+ * 
+ * @param **tokens  Pointer to the TOKEN array
+ * @param startPos  Position of the else keyword
+*/
+SyntaxReport SA_is_else_runnable(TOKEN **tokens, size_t startPos) {
+	if ((*tokens)[startPos + 1].type == _KW_IF_) {
+		return SA_is_else_if_statement(tokens, startPos);
+	}
+
+	return SA_is_else_statement(tokens, startPos);
+}
+
+/**
+ * <p>
+ * Checks a class constructor ("this::constructor"), other statements
+ * with "this" are no keyword based runnables.
+ * </p>
+ * 
+ * @returns SyntaxReport, that expresses an error or contains the tokens to skip on success
+ * 
+ * @param **tokens  Pointer to the TOKEN array
+ * @param startPos  Position of the this keyword
+*/
+SyntaxReport SA_is_this_runnable(TOKEN **tokens, size_t startPos) {
+	if ((*tokens)[startPos + 1].type == _OP_COLON_) {
+		return SA_is_class_constructor(tokens, startPos);
 	}
 
 	return SA_create_syntax_report(NULL, 0, false, "N/A");
@@ -930,7 +1569,7 @@ SyntaxReport SA_is_expression(TOKEN **tokens, size_t startPos, int inRunnable) {
 	TOKEN *crucialToken = &(*tokens)[startPos + isIdentifier.tokensToSkip];
 	skip += isIdentifier.tokensToSkip;
 
-	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, MAX_TOKEN_LENGTH) == true) {
+	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, CURRENT_CONTEXT->maxTokenLength) == true) {
 		SyntaxReport isConditionAssignment = SA_is_conditional_assignment(tokens, startPos + skip, false);
 
 		if (isConditionAssignment.errorOccured == true) {
@@ -942,7 +1581,7 @@ SyntaxReport SA_is_expression(TOKEN **tokens, size_t startPos, int inRunnable) {
 		|| crucialToken->type == _OP_SUBTRACT_ONE_) {
 		int jumper = 0;
 
-		while (startPos + skip + jumper < MAX_TOKEN_LENGTH) {
+		while (startPos + skip + jumper < CURRENT_CONTEXT->maxTokenLength) {
 			if ((*tokens)[startPos + skip + jumper].type != _OP_ADD_ONE_
 				&& (*tokens)[startPos + skip + jumper].type != _OP_SUBTRACT_ONE_) {
 				break;
@@ -952,7 +1591,7 @@ SyntaxReport SA_is_expression(TOKEN **tokens, size_t startPos, int inRunnable) {
 		}
 
 		skip += jumper;
-	} else if ((int)SA_is_assignment_operator(crucialToken->value) == true
+	} else if ((int)SA_is_assignment_operator(crucialToken->type) == true
 		|| crucialToken->type == _OP_EQUALS_) {
 		SyntaxReport isSimpleTerm = SA_is_simple_term(tokens, startPos + skip + 1, false);
 
@@ -1246,7 +1885,7 @@ SyntaxReport SA_is_check_statement(TOKEN **tokens, size_t startPos) {
 
 	int jumper = isIdentifier.tokensToSkip + 4;
 
-	while (startPos + jumper <  MAX_TOKEN_LENGTH
+	while (startPos + jumper <  CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + jumper].type != __EOF__) {
 		if ((*tokens)[startPos + jumper].type == _OP_LEFT_BRACE_) {
 			jumper++;
@@ -1388,7 +2027,7 @@ SyntaxReport SA_is_variable(TOKEN **tokens, size_t startPos) {
 			&& varTok->type != _KW_CONST_) {
 			return SA_create_syntax_report(NULL, skip + 1, false, NULL);
 		} else if (crucialToken->type == _OP_EQUALS_) {
-			if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, MAX_TOKEN_LENGTH) == true) {
+			if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, CURRENT_CONTEXT->maxTokenLength) == true) {
 				report = SA_is_conditional_assignment(tokens, startPos + skip, false);
 			} else if ((*tokens)[startPos + skip + 1].type == _KW_NEW_) {
 				report = SA_is_class_instance(tokens, startPos + skip);
@@ -1536,7 +2175,7 @@ SyntaxReport SA_is_conditional_assignment(TOKEN **tokens, size_t startPos, int i
 	skip++;
 	SyntaxReport leftVal = {NULL, -1};
 
-	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, MAX_TOKEN_LENGTH) == true) {
+	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, CURRENT_CONTEXT->maxTokenLength) == true) {
 		leftVal = SA_is_conditional_assignment(tokens, startPos + skip, true);
 	} else {
 		leftVal = SA_is_simple_term(tokens, startPos + skip, true);
@@ -1555,7 +2194,7 @@ SyntaxReport SA_is_conditional_assignment(TOKEN **tokens, size_t startPos, int i
 	skip++;
 	SyntaxReport rightVal = {NULL, -1};
 
-	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, MAX_TOKEN_LENGTH) == true) {
+	if ((int)predict_is_conditional_assignment_type(tokens, startPos + skip, CURRENT_CONTEXT->maxTokenLength) == true) {
 		rightVal = SA_is_conditional_assignment(tokens, startPos + skip, true);
 	} else {
 		rightVal = SA_is_simple_term(tokens, startPos + skip, true);
@@ -1602,7 +2241,7 @@ SyntaxReport SA_is_chained_condition(TOKEN **tokens, size_t startPos, int inPara
 	int openBrackets = 1;
 	int hasToBeLogicOperator = false;
 	
-	while (startPos + jumper <  MAX_TOKEN_LENGTH
+	while (startPos + jumper <  CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + jumper].type != __EOF__) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 		
@@ -1680,16 +2319,14 @@ SyntaxReport SA_is_chained_condition(TOKEN **tokens, size_t startPos, int inPara
  * @param inParam   Flag if the condition is in a parameter
 */
 SyntaxReport SA_is_condition(TOKEN **tokens, size_t startPos, int inParam) {
-	if ((int)SA_is_bool((*tokens)[startPos].value) == false) {
+	if ((int)SA_is_bool((*tokens)[startPos].type) == false) {
 		SyntaxReport leftTerm = SA_is_simple_term(tokens, startPos, false);
 
 		if (leftTerm.errorOccured == true) {
 			return SA_create_syntax_report(leftTerm.token, 0, true, leftTerm.expectedToken);
 		}
 
-		char *sequence = (*tokens)[startPos + leftTerm.tokensToSkip].value;
-
-		if ((int)SA_is_rational_operator(sequence) == false) {
+		if ((int)SA_is_rational_operator((*tokens)[startPos + leftTerm.tokensToSkip].type) == false) {
 			return SA_create_syntax_report(&(*tokens)[startPos + leftTerm.tokensToSkip], 0, true, "==\", \"<=\", \">=\", \"!=\", \"<\" or \">");
 		}
 
@@ -1786,7 +2423,7 @@ SyntaxReport SA_is_array_creation(TOKEN **tokens, size_t startPos) {
 
 	int skip = 3;
 
-	while (startPos + skip < MAX_TOKEN_LENGTH
+	while (startPos + skip < CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + skip].type != _OP_SEMICOLON_) {
 		if ((*tokens)[startPos + skip].type != _OP_RIGHT_EDGE_BRACKET_) {
 			return SA_create_syntax_report(&(*tokens)[startPos + skip], 0, true, "[");
@@ -1863,7 +2500,7 @@ SyntaxReport SA_is_array_assignment_element(TOKEN **tokens, size_t startPos, int
 	int jumper = 0;
 	int hasToBeComma = false;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + jumper].type != __EOF__) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
@@ -1943,7 +2580,7 @@ SyntaxReport SA_is_array_assignment_element(TOKEN **tokens, size_t startPos, int
 SyntaxReport SA_is_array_element(TOKEN **tokens, size_t startPos) {
 	int jumper = 0;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + jumper].type != __EOF__) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
@@ -2364,7 +3001,7 @@ SyntaxReport SA_is_enumerator(TOKEN **tokens, size_t startPos) {
 	int jumper = 0;
 	int hasToBeComma = false;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + jumper].type != __EOF__
 		&& (*tokens)[startPos + jumper].type != _OP_LEFT_BRACE_) {
 		switch (hasToBeComma) {
@@ -2559,7 +3196,7 @@ SyntaxReport SA_is_parameter(TOKEN **tokens, size_t startPos, enum ParameterType
 	int jumper = 0;
 	unsigned char hasToBeComma = false;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + jumper].type != __EOF__) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
@@ -2578,7 +3215,7 @@ SyntaxReport SA_is_parameter(TOKEN **tokens, size_t startPos, enum ParameterType
 			case _PARAM_FUNCTION_CALL_: {
 				SyntaxReport rep = {NULL, -1};
 
-				if ((int)predict_is_conditional_assignment_type(tokens, startPos + jumper, MAX_TOKEN_LENGTH) == true) {
+				if ((int)predict_is_conditional_assignment_type(tokens, startPos + jumper, CURRENT_CONTEXT->maxTokenLength) == true) {
 					rep = SA_is_conditional_assignment(tokens, startPos + jumper, true);
 				} else {
 					rep = SA_is_simple_term(tokens, startPos + jumper, true);
@@ -2669,7 +3306,7 @@ SyntaxReport SA_is_parameter(TOKEN **tokens, size_t startPos, enum ParameterType
 SyntaxReport SA_is_array_dimension_definition(TOKEN **tokens, size_t startPos) {
 	int skip = 0;
 
-	while (startPos + skip < MAX_TOKEN_LENGTH) {
+	while (startPos + skip < CURRENT_CONTEXT->maxTokenLength) {
 		if ((*tokens)[startPos + skip].type != _OP_RIGHT_EDGE_BRACKET_) {
 			break;
 		}
@@ -2767,7 +3404,7 @@ SyntaxReport SA_is_simple_term(TOKEN **tokens, size_t startPos, int inParameter)
 	int jumper = 0;
 	int hasToBeArithmeticOperator = false;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + jumper].type != __EOF__) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
@@ -2831,7 +3468,7 @@ SyntaxReport SA_is_simple_term(TOKEN **tokens, size_t startPos, int inParameter)
 			if ((int)SA_predict_term_expression(tokens, pos)) {
 				isIdentifier = SA_is_term_expression(tokens, pos);
 			} else if ((int)SA_is_letter(currentToken->value[0]) == true) {
-				if ((int)SA_is_bool((*tokens)[pos].value) == true
+				if ((int)SA_is_bool((*tokens)[pos].type) == true
 					|| currentToken->type == _KW_NULL_) {
 					jumper++;
 					continue;
@@ -2890,7 +3527,7 @@ SyntaxReport SA_is_simple_term(TOKEN **tokens, size_t startPos, int inParameter)
 int SA_skip_increment_and_decrement_assignments(TOKEN **tokens, size_t startPos) {
 	int skip = 0;
 
-	while (startPos + skip < TOKEN_LENGTH) {
+	while (startPos + skip < CURRENT_CONTEXT->tokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + skip];
 
 		if (currentToken->type != _OP_ADD_ONE_
@@ -2918,7 +3555,7 @@ SyntaxReport SA_is_term_expression(TOKEN **tokens, size_t startPos) {
 	int jumper = 0;
 	int identifiers = 0;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH) {
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 		int rootIden = SA_is_root_identifier(currentToken);
 		identifiers += rootIden;
@@ -2966,7 +3603,7 @@ SyntaxReport SA_is_identifier(TOKEN **tokens, size_t startPos) {
 	int jumper = 0;
 	int hasToBeDot = false;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength
 		&& (*tokens)[startPos + jumper].type != __EOF__) {
 		TOKEN *currentToken = &(*tokens)[startPos + jumper];
 
@@ -3067,7 +3704,7 @@ SyntaxReport SA_handle_potential_array_access_or_function_call(TOKEN **tokens, s
 SyntaxReport SA_is_array_access(TOKEN **tokens, size_t startPos) {
 	int jumper = 0;
 
-	while (startPos + jumper < MAX_TOKEN_LENGTH) {
+	while (startPos + jumper < CURRENT_CONTEXT->maxTokenLength) {
 		if ((int)is_end_indicator(&(*tokens)[startPos + jumper]) == true) {
 			break;
 		}
@@ -3205,7 +3842,7 @@ SyntaxReport SA_is_numeral_identifier(TOKEN *token) {
 int SA_is_logic_operator_bracket(TOKEN **tokens, size_t startPos) {
 	int openBrackets = 0;
 	
-	for (int i = startPos; i < MAX_TOKEN_LENGTH; i++) {
+	for (int i = startPos; i < CURRENT_CONTEXT->maxTokenLength; i++) {
 		switch ((*tokens)[i].type) {
 		case _KW_AND_:
 		case _KW_OR_:
@@ -3245,7 +3882,7 @@ int SA_is_logic_operator_bracket(TOKEN **tokens, size_t startPos) {
  * `false (0)`
 */
 int SA_predict_term_expression(TOKEN **tokens, size_t startPos) {
-	for (int i = 0; i < MAX_TOKEN_LENGTH; i++) {
+	for (int i = 0; i < CURRENT_CONTEXT->maxTokenLength; i++) {
 		if ((*tokens)[startPos + i].type == _OP_ADD_ONE_
 			|| (*tokens)[startPos + i].type == _OP_SUBTRACT_ONE_) {
 			return true;
@@ -3270,7 +3907,7 @@ int SA_predict_term_expression(TOKEN **tokens, size_t startPos) {
  * @param startPos  Position from where to start predicting
 */
 int SA_predict_array_access(TOKEN **tokens, size_t startPos) {
-	for (int i = startPos; i < MAX_TOKEN_LENGTH; i++) {
+	for (int i = startPos; i < CURRENT_CONTEXT->maxTokenLength; i++) {
 		TOKEN *currentToken = &(*tokens)[i];
 
 		if (currentToken->type == _OP_RIGHT_EDGE_BRACKET_) {
@@ -3404,15 +4041,8 @@ int SA_is_number(const char character) {
 
 /**
  * <p>
- * The list of all rational operators of the SPACE language
- * (at first version).
- * </p>
- */
-const char rationalOperators[][3] = {"==", "<=", ">=", "!=", "<", ">"};
-
-/**
- * <p>
- * Checks if a character sequence is indicating a rational operator.
+ * Checks if a token type is a rational operator
+ * ("==", "<=", ">=", "!=", "<" or ">").
  * </p>
  * 
  * @returns
@@ -3421,18 +4051,10 @@ const char rationalOperators[][3] = {"==", "<=", ">=", "!=", "<", ">"};
  * <li>false - is not a rational operator
  * </ul>
  * 
- * @param *sequence     Sequence to check
+ * @param type      Type of the token to check
  */
-int SA_is_rational_operator(const char *sequence) {
-	int size = (sizeof(rationalOperators) / sizeof(rationalOperators[0]));
-
-	for (int i = 0; i < size; i++) {
-		if ((int)strcmp(sequence, rationalOperators[i]) == 0) {
-			return true;
-		}
-	}
-
-	return false;
+int SA_is_rational_operator(TOKENTYPES type) {
+	return IS_TOKEN_CLASS(type, TOKEN_CLASS_CONDITION) ? true : false;
 }
 
 /**
@@ -3449,30 +4071,14 @@ int SA_is_rational_operator(const char *sequence) {
  * @param *token    Token to check
  */
 int SA_is_arithmetic_operator(const TOKEN *token) {
-	//Could be double operators like += or -= or *= ect.
-	// 1 Operator takes size = 2; 2 take size = 3;
-	if (token->size != 2) {
-		return false;
-	}
-
-	switch (token->value[0]) {
-	case '+':   case '-':   case '/':   case '*':   case '%':
-		return true;
-	default:
-		return false;
-	}
+	//Double operators like += or -= have their own types
+	return IS_TOKEN_CLASS(token->type, TOKEN_CLASS_ARITHMETIC) ? true : false;
 }
 
 /**
  * <p>
- * A colleaction of all assignment operators in the SPACE-Lang.
- * </p>
- */
-const char assignmentOperator[][3] = {"+=", "-=", "*=", "/=", "++", "--"};
-
-/**
- * <p>
- * Checks if a character sequence matches an assignment operator.
+ * Checks if a token type is an assignment operator
+ * ("+=", "-=", "*=", "/=", "++" or "--").
  * </p>
  * 
  * @returns
@@ -3481,18 +4087,10 @@ const char assignmentOperator[][3] = {"+=", "-=", "*=", "/=", "++", "--"};
  * <li>false - is not an assignment operator
  * </ul>
  * 
- * @param *sequence     Sequence to check
+ * @param type      Type of the token to check
  */
-int SA_is_assignment_operator(const char *sequence) {
-	int lengthOfAssignmentOperators = (sizeof(assignmentOperator) / sizeof(assignmentOperator[0]));
-
-	for (int i = 0; i < lengthOfAssignmentOperators; i++) {
-		if ((int)strcmp(sequence, assignmentOperator[i]) == 0) {
-			return true;
-		}
-	}
-
-	return false;
+int SA_is_assignment_operator(TOKENTYPES type) {
+	return IS_TOKEN_CLASS(type, TOKEN_CLASS_ASSIGNMENT) ? true : false;
 }
 
 /**
@@ -3514,7 +4112,7 @@ int SA_is_underscore(const char character) {
 
 /**
  * <p>
- * Checks if a character sequence matches a boolean.
+ * Checks if a token type is a boolean.
  * </p>
  * 
  * @returns
@@ -3523,16 +4121,15 @@ int SA_is_underscore(const char character) {
  * <li>false - is not a boolean
  * </ul>
  * 
- * @param *sequence     Sequence to check
+ * @param type      Type of the token to check
  */
-int SA_is_bool(const char *sequence) {
-	return ((int)strcmp(sequence, "true") == 0
-		|| (int)strcmp(sequence, "false") == 0) ? true : false;
+int SA_is_bool(TOKENTYPES type) {
+	return IS_TOKEN_CLASS(type, TOKEN_CLASS_BOOL) ? true : false;
 }
 
 /**
  * <p>
- * Checks if a character sequence matches a modifier.
+ * Checks if a token type is a modifier.
  * </p>
  * 
  * @returns
@@ -3541,17 +4138,15 @@ int SA_is_bool(const char *sequence) {
  * <li>false - is not a modifier
  * </ul>
  * 
- * @param *sequence     Sequence to check
+ * @param type      Type of the token to check
  */
-int SA_is_modifier(const char *sequence) {
-	return ((int)strcmp(sequence, "global") == 0
-			|| (int)strcmp(sequence, "local") == 0
-			|| (int)strcmp(sequence, "secure") == 0) ? true : false;
+int SA_is_modifier(TOKENTYPES type) {
+	return IS_TOKEN_CLASS(type, TOKEN_CLASS_MODIFIER) ? true : false;
 }
 
 /**
  * <p>
- * Checks if a character sequence matches a logic operator.
+ * Checks if a token type is a logic operator.
  * </p>
  * 
  * @returns
@@ -3560,12 +4155,10 @@ int SA_is_modifier(const char *sequence) {
  * <li>false - is not a logic operator
  * </ul>
  * 
- * @param *sequence     Sequence to evaluate
+ * @param type      Type of the token to evaluate
  */
-int SA_is_logic_operator(const char *sequence) {
-	return ((int)strcmp(sequence, "and") == 0
-			|| (int)strcmp(sequence, "or") == 0
-			|| (int)strcmp(sequence, "!") == 0) ? true : false;
+int SA_is_logic_operator(TOKENTYPES type) {
+	return IS_TOKEN_CLASS(type, TOKEN_CLASS_LOGIC) ? true : false;
 }
 
 /**
@@ -3596,60 +4189,44 @@ Params: TOKEN *errorToken => Token that caused the issue;
 		char *expectedToken => String that contain TOKEN suggestions
 */
 void SA_throw_error(TOKEN *errorToken, char *expectedToken) {
-	FILE_CONTAINS_ERRORS = true;
+	CURRENT_CONTEXT->fileContainsErrors = true;
 
-	if (BUFFER == NULL) {
+	if (CURRENT_CONTEXT->buffer == NULL) {
 		(void)printf("Source code pointer = NULL!");
 		return;
 	}
 
-	int errorCharsAwayFromNL = 0;
 	size_t errorLine = errorToken->line + 1;
-
-	for (int i = errorToken->tokenStart; i > 0; i--, errorCharsAwayFromNL++) {
-		if ((*BUFFER)[i - 1] == '\n' || (*BUFFER)[i - 1] == '\0') {
-			break;
-		}
-	}
-
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf("SYNTAX ERROR occured on line ");
-	(void)printf(TEXT_COLOR_BLUE);
-	(void)printf(TEXT_UNDERLINE);
-	(void)printf("%li:%i", errorLine, errorCharsAwayFromNL);
-	(void)printf(TEXT_COLOR_RESET);
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf(" in \"%s\"\n", FILE_NAME);
-	
-	char buffer[32];
-	int tokPos = ((errorToken->tokenStart + 1) - errorCharsAwayFromNL);
-	int blankLength = (int)snprintf(buffer, 32, "%li : %i | ", errorLine, tokPos);
-	(void)printf("%s", buffer);
-	(void)printf(TEXT_COLOR_GRAY);
-
-	for (int i = errorToken->tokenStart - errorCharsAwayFromNL; i < BUFFER_LENGTH; i++) {
-		if ((*BUFFER)[i] == '\n' || (*BUFFER)[i] == '\0') {
-			break;
+	int errorCharsAwayFromNL = (int)LI_get_column(errorToken->tokenStart);
+	struct DiagnosticText text = {NULL, 0, 0};
+
+	//Over the error limit the message is not formatted at all
+	if ((int)CC_is_rendering_diagnostics() == true) {
+		size_t sourceLine = (size_t)LI_get_line(errorToken->tokenStart);
+		//The EOF token has no source line
+		int lineLength = errorToken->tokenStart <= CURRENT_CONTEXT->bufferLength ? (int)LI_get_line_length(sourceLine) : 0;
+
+		(void)CC_append_diagnostic_text(&text, TEXT_COLOR_RED "SYNTAX ERROR occured on line " TEXT_COLOR_BLUE TEXT_UNDERLINE);
+		(void)CC_append_diagnostic_text(&text, "%li:%i", errorLine, errorCharsAwayFromNL);
+		(void)CC_append_diagnostic_text(&text, TEXT_COLOR_RESET TEXT_COLOR_RED " in \"%s\"\n", CURRENT_CONTEXT->fileName);
+
+		char buffer[32];
+		int tokPos = ((errorToken->tokenStart + 1) - errorCharsAwayFromNL);
+		int blankLength = (int)snprintf(buffer, 32, "%li : %i | ", errorLine, tokPos);
+		(void)CC_append_diagnostic_text(&text, "%s" TEXT_COLOR_GRAY "%.*s\n" TEXT_COLOR_YELLOW, buffer, lineLength,
+			&CURRENT_CONTEXT->buffer[LI_get_line_start(sourceLine)]);
+		(void)CC_append_diagnostic_text(&text, "%*s", blankLength + errorCharsAwayFromNL, "");
+
+		for (size_t i = 0; i < (size_t)strlen(errorToken->value); i++) {
+			(void)CC_append_diagnostic_text(&text, "^");
 		}
 
-		(void)printf("%c", (*BUFFER)[i]);
-	}
-
-	(void)printf("\n");
-	(void)printf(TEXT_COLOR_YELLOW);
-
-	for (int i = 0; i < blankLength + errorCharsAwayFromNL; i++) {
-		(void)printf(" ");
-	}
-
-	for (int i = 0; i < errorToken->size - 1; i++) {
-		(void)printf("^");
+		(void)CC_append_diagnostic_text(&text, TEXT_COLOR_RED "\n");
+		(void)CC_append_diagnostic_text(&text, "    Unexpected token \"%s\",\n", errorToken->value);
+		(void)CC_append_diagnostic_text(&text, "    maybe replace with \"%s\".\n", expectedToken);
+		(void)CC_append_diagnostic_text(&text, "\n\n" TEXT_COLOR_RESET);
 	}
 
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf("\n");
-	(void)printf("    Unexpected token \"%s\",\n", errorToken->value);
-	(void)printf("    maybe replace with \"%s\".\n", expectedToken);
-	(void)printf("\n\n");
-	(void)printf(TEXT_COLOR_RESET);
+	struct Diagnostic *diagnostic = CC_add_diagnostic(errorLine, errorCharsAwayFromNL + 1, false, "Unexpected token \"%s\", maybe replace with \"%s\".", errorToken->value, expectedToken);
+	(void)CC_attach_diagnostic_text(diagnostic, errorToken->tokenStart, &text);
 }
\ No newline at end of file
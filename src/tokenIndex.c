@@ -0,0 +1,407 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/tokenIndex.h"
+#include "../headers/compilerContext.h"
+#include "../headers/errors.h"
+
+/** 
+ * The subprogram {@code SPACE/src/tokenIndex.c} was created
+ * to provide an index over the tokens, that is built once after
+ * the lexer.
+ * 
+ * The parsetree generator and the syntax analyzer look ahead from
+ * every statement: till the next ';', till the matching bracket or
+ * till the next assignment. The index stores these positions, so the
+ * lookahead is answered without rescanning the tokens.
+ * 
+ * For every '(' the index also records, if the tokens till the matching
+ * ')' contain no term terminator (';', '=', '+=', ..., '}') and only
+ * balanced edge brackets, so a term scan can jump over it.
+ * 
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+/**
+ * <p>
+ * The index of the current compilation (see CompilerContext).
+ * </p>
+ */
+#define TOKEN_INDEX (CURRENT_CONTEXT->tokenIndex)
+
+/**
+ * <p>
+ * An open '(' while building the index.
+ * </p>
+ */
+struct BracketFrame {
+	unsigned int position;
+	unsigned int terminatorsAtOpen;
+	int edgeDepthAtOpen;
+	int minEdgeDepth;
+};
+
+const char indexedAssignmentOperators[][3] = {"+=", "-=", "*=", "/=", "++", "--"};
+
+int TI_index_brackets(TOKEN *tokens, size_t length);
+void TI_index_next_positions(TOKEN *tokens, size_t length);
+int TI_is_term_terminator(TOKENTYPES type);
+int TI_is_assignment(const TOKEN *token);
+int TI_is_indexed(const TOKEN *tokens, size_t position);
+
+/**
+ * <p>
+ * Builds the index over the tokens, a previous index is replaced.
+ * </p>
+ * 
+ * @returns true, if the index was built
+ * 
+ * @param *tokens   Token array of the lexer
+ * @param length    Number of tokens (including the EOF token)
+ */
+int TI_build_token_index(TOKEN *tokens, size_t length) {
+	(void)FREE_TOKEN_INDEX();
+
+	if (tokens == NULL || length == 0 || length >= TI_NONE) {
+		return false;
+	}
+
+	TOKEN_INDEX.match = (unsigned int*)malloc(sizeof(unsigned int) * length * 4);
+	TOKEN_INDEX.closedTerm = (unsigned char*)calloc(length, sizeof(unsigned char));
+
+	if (TOKEN_INDEX.match == NULL || TOKEN_INDEX.closedTerm == NULL) {
+		(void)FREE_TOKEN_INDEX();
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return false;
+	}
+
+	TOKEN_INDEX.nextSemicolon = TOKEN_INDEX.match + length;
+	TOKEN_INDEX.nextAssignment = TOKEN_INDEX.match + length * 2;
+	TOKEN_INDEX.nextExpressionEnd = TOKEN_INDEX.match + length * 3;
+
+	if ((int)TI_index_brackets(tokens, length) == false) {
+		(void)FREE_TOKEN_INDEX();
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return false;
+	}
+
+	(void)TI_index_next_positions(tokens, length);
+
+	TOKEN_INDEX.tokens = tokens;
+	TOKEN_INDEX.length = length;
+	return true;
+}
+
+/**
+ * <p>
+ * Matches the brackets, braces and edge brackets with one stack each
+ * and marks the closed terms.
+ * </p>
+ * 
+ * @returns false, if the stacks could not be reserved
+ * 
+ * @param *tokens   Token array
+ * @param length    Number of tokens
+ */
+int TI_index_brackets(TOKEN *tokens, size_t length) {
+	struct BracketFrame *brackets = (struct BracketFrame*)malloc(sizeof(struct BracketFrame) * length);
+	unsigned int *braces = (unsigned int*)malloc(sizeof(unsigned int) * length * 2);
+
+	if (brackets == NULL || braces == NULL) {
+		(void)free(brackets);
+		(void)free(braces);
+		return false;
+	}
+
+	unsigned int *edgeBrackets = braces + length;
+	size_t bracketCount = 0, braceCount = 0, edgeBracketCount = 0;
+	unsigned int terminators = 0;
+	int edgeDepth = 0;
+
+	for (size_t i = 0; i < length; i++) {
+		TOKENTYPES type = tokens[i].type;
+		TOKEN_INDEX.match[i] = TI_NONE;
+
+		if ((int)TI_is_term_terminator(type) == true) {
+			terminators++;
+		}
+
+		switch (type) {
+		case _OP_RIGHT_BRACKET_: {
+			struct BracketFrame frame = {(unsigned int)i, terminators, edgeDepth, edgeDepth};
+			brackets[bracketCount++] = frame;
+			break;
+		}
+		case _OP_LEFT_BRACKET_:
+			if (bracketCount > 0) {
+				struct BracketFrame *frame = &brackets[--bracketCount];
+				TOKEN_INDEX.match[i] = frame->position;
+				TOKEN_INDEX.match[frame->position] = (unsigned int)i;
+				TOKEN_INDEX.closedTerm[frame->position] = frame->terminatorsAtOpen == terminators
+					&& frame->minEdgeDepth >= frame->edgeDepthAtOpen
+					&& edgeDepth == frame->edgeDepthAtOpen;
+
+				if (bracketCount > 0 && frame->minEdgeDepth < brackets[bracketCount - 1].minEdgeDepth) {
+					brackets[bracketCount - 1].minEdgeDepth = frame->minEdgeDepth;
+				}
+			}
+
+			break;
+		case _OP_RIGHT_BRACE_:
+			braces[braceCount++] = (unsigned int)i;
+			break;
+		case _OP_LEFT_BRACE_:
+			if (braceCount > 0) {
+				unsigned int open = braces[--braceCount];
+				TOKEN_INDEX.match[i] = open;
+				TOKEN_INDEX.match[open] = (unsigned int)i;
+			}
+
+			break;
+		case _OP_RIGHT_EDGE_BRACKET_:
+			edgeDepth++;
+			edgeBrackets[edgeBracketCount++] = (unsigned int)i;
+			break;
+		case _OP_LEFT_EDGE_BRACKET_:
+			edgeDepth--;
+
+			if (bracketCount > 0 && edgeDepth < brackets[bracketCount - 1].minEdgeDepth) {
+				brackets[bracketCount - 1].minEdgeDepth = edgeDepth;
+			}
+
+			if (edgeBracketCount > 0) {
+				unsigned int open = edgeBrackets[--edgeBracketCount];
+				TOKEN_INDEX.match[i] = open;
+				TOKEN_INDEX.match[open] = (unsigned int)i;
+			}
+
+			break;
+		default:
+			break;
+		}
+	}
+
+	(void)free(brackets);
+	(void)free(braces);
+	return true;
+}
+
+/**
+ * <p>
+ * Fills the next ';', the next assignment and the next expression end
+ * (';', '{' or EOF) of every position in one backward pass.
+ * </p>
+ * 
+ * @param *tokens   Token array
+ * @param length    Number of tokens
+ */
+void TI_index_next_positions(TOKEN *tokens, size_t length) {
+	unsigned int nextSemicolon = TI_NONE;
+	unsigned int nextAssignment = TI_NONE;
+	unsigned int nextExpressionEnd = TI_NONE;
+
+	for (size_t i = length; i-- > 0;) {
+		switch (tokens[i].type) {
+		case _OP_SEMICOLON_:
+			nextSemicolon = (unsigned int)i;
+			nextExpressionEnd = (unsigned int)i;
+			break;
+		case _OP_RIGHT_BRACE_:
+		case __EOF__:
+			nextExpressionEnd = (unsigned int)i;
+			break;
+		default:
+			if ((int)TI_is_assignment(&tokens[i]) == true) {
+				nextAssignment = (unsigned int)i;
+			}
+
+			break;
+		}
+
+		TOKEN_INDEX.nextSemicolon[i] = nextSemicolon;
+		TOKEN_INDEX.nextAssignment[i] = nextAssignment;
+		TOKEN_INDEX.nextExpressionEnd[i] = nextExpressionEnd;
+	}
+}
+
+/**
+ * <p>
+ * Checks if a token ends a term (see PG_get_term_bounds()).
+ * </p>
+ * 
+ * @param type  Type of the token
+ */
+int TI_is_term_terminator(TOKENTYPES type) {
+	switch (type) {
+	case _OP_SEMICOLON_:        case _OP_EQUALS_:
+	case _OP_PLUS_EQUALS_:      case _OP_MINUS_EQUALS_:
+	case _OP_MULTIPLY_EQUALS_:  case _OP_DIVIDE_EQUALS_:
+	case _OP_LEFT_BRACE_:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * <p>
+ * Checks if a token is an assignment, like SA_predict_expression() does
+ * ('=', '++', '--' or an assignment operator).
+ * </p>
+ * 
+ * @param *token    Token to check
+ */
+int TI_is_assignment(const TOKEN *token) {
+	switch (token->type) {
+	case _OP_EQUALS_:
+	case _OP_ADD_ONE_:
+	case _OP_SUBTRACT_ONE_:
+		return true;
+	default:
+		break;
+	}
+
+	if (token->value == NULL) {
+		return false;
+	}
+
+	int operatorCount = sizeof(indexedAssignmentOperators) / sizeof(indexedAssignmentOperators[0]);
+
+	for (int i = 0; i < operatorCount; i++) {
+		if ((int)strcmp(token->value, indexedAssignmentOperators[i]) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * <p>
+ * Checks if the position of the token array is covered by the index.
+ * </p>
+ * 
+ * @param *tokens   Token array
+ * @param position  Position to check
+ */
+int TI_is_indexed(const TOKEN *tokens, size_t position) {
+	return tokens == TOKEN_INDEX.tokens && tokens != NULL && position < TOKEN_INDEX.length;
+}
+
+/**
+ * <p>
+ * Returns the position of the matching bracket, brace or edge bracket.
+ * </p>
+ * 
+ * @returns The matching position, TI_NONE if there is none
+ * 
+ * @param *tokens   Token array
+ * @param position  Position of the bracket
+ */
+unsigned int TI_get_match(const TOKEN *tokens, size_t position) {
+	return (int)TI_is_indexed(tokens, position) == true ? TOKEN_INDEX.match[position] : TI_NONE;
+}
+
+/**
+ * <p>
+ * Returns the position of the next ';' at or after the position.
+ * </p>
+ * 
+ * @returns The position of the ';', TI_NONE if there is none
+ * 
+ * @param *tokens   Token array
+ * @param position  Position from where to search
+ */
+unsigned int TI_get_next_semicolon(const TOKEN *tokens, size_t position) {
+	return (int)TI_is_indexed(tokens, position) == true ? TOKEN_INDEX.nextSemicolon[position] : TI_NONE;
+}
+
+/**
+ * <p>
+ * Returns the position of the next assignment ('=', '+=', '++', ...)
+ * at or after the position.
+ * </p>
+ * 
+ * @returns The position of the assignment, TI_NONE if there is none
+ * 
+ * @param *tokens   Token array
+ * @param position  Position from where to search
+ */
+unsigned int TI_get_next_assignment(const TOKEN *tokens, size_t position) {
+	return (int)TI_is_indexed(tokens, position) == true ? TOKEN_INDEX.nextAssignment[position] : TI_NONE;
+}
+
+/**
+ * <p>
+ * Returns the position of the next ';', '{' or EOF at or after the position.
+ * </p>
+ * 
+ * @returns The position of the expression end, TI_NONE if there is none
+ * 
+ * @param *tokens   Token array
+ * @param position  Position from where to search
+ */
+unsigned int TI_get_next_expression_end(const TOKEN *tokens, size_t position) {
+	return (int)TI_is_indexed(tokens, position) == true ? TOKEN_INDEX.nextExpressionEnd[position] : TI_NONE;
+}
+
+/**
+ * <p>
+ * Checks if a '(' encloses a closed term: till the matching ')'
+ * there is no term terminator and the edge brackets are balanced.
+ * </p>
+ * 
+ * @returns true, if the term scan can jump to the matching ')'
+ * 
+ * @param *tokens   Token array
+ * @param position  Position of the '('
+ */
+int TI_is_closed_term(const TOKEN *tokens, size_t position) {
+	return (int)TI_is_indexed(tokens, position) == true && TOKEN_INDEX.closedTerm[position] == true;
+}
+
+/**
+ * <p>
+ * Frees the token index.
+ * </p>
+ * 
+ * @returns true, if the index was freed
+ */
+int FREE_TOKEN_INDEX() {
+	(void)free(TOKEN_INDEX.match);
+	(void)free(TOKEN_INDEX.closedTerm);
+	TOKEN_INDEX.tokens = NULL;
+	TOKEN_INDEX.length = 0;
+	TOKEN_INDEX.match = NULL;
+	TOKEN_INDEX.nextSemicolon = NULL;
+	TOKEN_INDEX.nextAssignment = NULL;
+	TOKEN_INDEX.nextExpressionEnd = NULL;
+	TOKEN_INDEX.closedTerm = NULL;
+	return true;
+}
@@ -0,0 +1,327 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/treeCache.h"
+#include "../headers/internPool.h"
+
+/** 
+ * The subprogram {@code SPACE/src/treeCache.c} was created
+ * to provide a persistent cache of the validated parsetree.
+ * 
+ * The cache file is keyed by the FNV-1a hash and the length of the
+ * source, so an unchanged source skips the lexer, the syntax analyzer
+ * and the parsetree generator and goes straight to the semantic analysis.
+ * 
+ * The parsetree is stored as a FlatTree (see PG_flatten_tree()):
+ * a header, the FlatNodes, the details indices and the values as
+ * '\0' terminated strings. The values are interned while loading.
+ * Files with another version, another FlatNode layout or broken
+ * indices are treated as a miss.
+ * 
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define TREE_CACHE_VERSION 1
+
+/**
+ * <p>
+ * The header at the start of a cache file.
+ * </p>
+ */
+struct TreeCacheHeader {
+	char magic[4];
+	unsigned int version;
+	unsigned int flatNodeSize;
+	unsigned int nodeCount;
+	unsigned int detailsLength;
+	unsigned int valueCount;
+	unsigned long long sourceHash;
+	unsigned long long sourceLength;
+	unsigned long long valuesSize;
+};
+
+const char treeCacheMagic[4] = {'S', 'P', 'T', 'C'};
+
+char *TC_get_cache_path(const char *sourcePath);
+int TC_read_values(FlatTree *tree, char *text, size_t size);
+int TC_is_valid_flat_tree(FlatTree *tree);
+
+/**
+ * <p>
+ * Loads the parsetree of the source from its cache file.
+ * </p>
+ * 
+ * @returns The parsetree, NULL if there is no valid cache file for this source
+ * 
+ * @param *context      Compilation, that receives the nodes and values
+ * @param *sourcePath   Path of the source file
+ * @param *buffer       Content of the source file
+ * @param length        Length of the content
+ */
+Node *TC_load_parsetree(struct CompilerContext *context, const char *sourcePath, const char *buffer, size_t length) {
+	(void)CC_use_context(context);
+	char *cachePath = TC_get_cache_path(sourcePath);
+
+	if (cachePath == NULL) {
+		return NULL;
+	}
+
+	FILE *file = fopen(cachePath, "rb");
+	(void)free(cachePath);
+
+	if (file == NULL) {
+		return NULL;
+	}
+
+	struct TreeCacheHeader header;
+	Node *root = NULL;
+
+	if (fread(&header, sizeof(header), 1, file) != 1
+		|| (int)memcmp(header.magic, treeCacheMagic, sizeof(treeCacheMagic)) != 0
+		|| header.version != TREE_CACHE_VERSION
+		|| header.flatNodeSize != sizeof(FlatNode)
+		|| header.sourceLength != length
+		|| header.sourceHash != TC_hash_source(buffer, length)
+		|| header.nodeCount == 0) {
+		(void)fclose(file);
+		return NULL;
+	}
+
+	FlatTree tree = {NULL, header.nodeCount, NULL, header.detailsLength, NULL, header.valueCount};
+	tree.nodes = (FlatNode*)malloc(sizeof(FlatNode) * header.nodeCount);
+	tree.details = (unsigned int*)malloc(sizeof(unsigned int) * (header.detailsLength + 1));
+	tree.values = (char**)calloc(header.valueCount + 1, sizeof(char*));
+	char *text = (char*)malloc(header.valuesSize + 1);
+
+	if (tree.nodes != NULL && tree.details != NULL && tree.values != NULL && text != NULL
+		&& fread(tree.nodes, sizeof(FlatNode), header.nodeCount, file) == header.nodeCount
+		&& fread(tree.details, sizeof(unsigned int), header.detailsLength, file) == header.detailsLength
+		&& fread(text, 1, header.valuesSize, file) == header.valuesSize
+		&& (int)TC_read_values(&tree, text, header.valuesSize) == true
+		&& (int)TC_is_valid_flat_tree(&tree) == true) {
+		root = PG_unflatten_tree(&tree);
+		context->root = root;
+	}
+
+	(void)fclose(file);
+	(void)free(tree.nodes);
+	(void)free(tree.details);
+	(void)free(tree.values);
+	(void)free(text);
+	return root;
+}
+
+/**
+ * <p>
+ * Writes the parsetree of the source into its cache file.
+ * </p>
+ * 
+ * @returns true, if the cache file was written
+ * 
+ * @param *sourcePath   Path of the source file
+ * @param *buffer       Content of the source file
+ * @param length        Length of the content
+ * @param *root         Validated parsetree of the source
+ */
+int TC_store_parsetree(const char *sourcePath, const char *buffer, size_t length, Node *root) {
+	char *cachePath = TC_get_cache_path(sourcePath);
+
+	if (cachePath == NULL || root == NULL) {
+		(void)free(cachePath);
+		return false;
+	}
+
+	FlatTree *tree = PG_flatten_tree(root);
+	FILE *file = tree != NULL ? fopen(cachePath, "wb") : NULL;
+
+	if (file == NULL) {
+		(void)FREE_FLAT_TREE(tree);
+		(void)free(cachePath);
+		return false;
+	}
+
+	struct TreeCacheHeader header;
+	(void)memset(&header, 0, sizeof(header));
+	(void)memcpy(header.magic, treeCacheMagic, sizeof(treeCacheMagic));
+	header.version = TREE_CACHE_VERSION;
+	header.flatNodeSize = sizeof(FlatNode);
+	header.nodeCount = tree->nodeCount;
+	header.detailsLength = tree->detailsLength;
+	header.valueCount = tree->valueCount;
+	header.sourceHash = TC_hash_source(buffer, length);
+	header.sourceLength = length;
+
+	for (unsigned int i = 1; i < tree->valueCount; i++) {
+		header.valuesSize += strlen(tree->values[i]) + 1;
+	}
+
+	int written = fwrite(&header, sizeof(header), 1, file) == 1
+		&& fwrite(tree->nodes, sizeof(FlatNode), tree->nodeCount, file) == tree->nodeCount
+		&& fwrite(tree->details, sizeof(unsigned int), tree->detailsLength, file) == tree->detailsLength;
+
+	for (unsigned int i = 1; i < tree->valueCount && written == true; i++) {
+		size_t valueSize = strlen(tree->values[i]) + 1;
+		written = fwrite(tree->values[i], 1, valueSize, file) == valueSize;
+	}
+
+	written = fclose(file) == 0 && written;
+
+	// A partly written file must not be found as a hit later on
+	if (written == false) {
+		(void)remove(cachePath);
+	}
+
+	(void)FREE_FLAT_TREE(tree);
+	(void)free(cachePath);
+	return written;
+}
+
+/**
+ * <p>
+ * Computes the 64 bit FNV-1a hash of the source.
+ * </p>
+ * 
+ * @returns The hash
+ * 
+ * @param *buffer   Source to hash
+ * @param length    Length of the source
+ */
+unsigned long long TC_hash_source(const char *buffer, size_t length) {
+	unsigned long long hash = 14695981039346656037ull;
+
+	for (size_t i = 0; i < length; i++) {
+		hash = (hash ^ (unsigned char)buffer[i]) * 1099511628211ull;
+	}
+
+	return hash;
+}
+
+/**
+ * <p>
+ * Creates the path of the cache file (source path + TREE_CACHE_SUFFIX).
+ * </p>
+ * 
+ * @returns The allocated path, NULL for the standard input ("-")
+ * 
+ * @param *sourcePath   Path of the source file
+ */
+char *TC_get_cache_path(const char *sourcePath) {
+	if (sourcePath == NULL || (int)strcmp(sourcePath, "-") == 0) {
+		return NULL;
+	}
+
+	size_t length = strlen(sourcePath);
+	char *path = (char*)malloc(length + sizeof(TREE_CACHE_SUFFIX));
+
+	if (path != NULL) {
+		(void)memcpy(path, sourcePath, length);
+		(void)memcpy(path + length, TREE_CACHE_SUFFIX, sizeof(TREE_CACHE_SUFFIX));
+	}
+
+	return path;
+}
+
+/**
+ * <p>
+ * Interns the '\0' terminated values of a cache file into the values
+ * of the flat tree, the value id 0 stays NULL.
+ * </p>
+ * 
+ * @returns true, if the text holds exactly the expected number of values
+ * 
+ * @param *tree     Flat tree to fill the values in
+ * @param *text     Values read from the cache file
+ * @param size      Size of the text
+ */
+int TC_read_values(FlatTree *tree, char *text, size_t size) {
+	size_t offset = 0;
+	text[size] = '\0';
+
+	for (unsigned int i = 1; i < tree->valueCount; i++) {
+		if (offset >= size) {
+			return false;
+		}
+
+		size_t valueLength = strlen(text + offset);
+		tree->values[i] = IP_intern_length(text + offset, valueLength);
+		offset += valueLength + 1;
+	}
+
+	return offset == size;
+}
+
+/**
+ * <p>
+ * Checks the indices of a loaded flat tree, so a broken cache file can
+ * not lead to an out of bounds access, a cycle or a shared node.
+ * </p>
+ * 
+ * @returns true, if the flat tree can be converted
+ * 
+ * @param *tree     Flat tree to check
+ */
+int TC_is_valid_flat_tree(FlatTree *tree) {
+	// Every node apart from the root has to be referenced exactly once
+	unsigned char *referenced = (unsigned char*)calloc(tree->nodeCount, sizeof(unsigned char));
+
+	if (referenced == NULL) {
+		return false;
+	}
+
+	int valid = true;
+
+	for (unsigned int i = 0; i < tree->nodeCount && valid == true; i++) {
+		FlatNode *node = &tree->nodes[i];
+
+		if (node->valueId >= tree->valueCount
+			|| node->detailsStart > tree->detailsLength
+			|| node->detailsCount > tree->detailsLength - node->detailsStart) {
+			valid = false;
+			break;
+		}
+
+		for (unsigned int j = 0; j < node->detailsCount + 2 && valid == true; j++) {
+			unsigned int child = j < node->detailsCount ? tree->details[node->detailsStart + j]
+				: j == node->detailsCount ? node->leftNode : node->rightNode;
+
+			if (child == FLAT_NODE_NONE) {
+				continue;
+			}
+
+			valid = child > i && child < tree->nodeCount && referenced[child] == false;
+
+			if (valid == true) {
+				referenced[child] = true;
+			}
+		}
+	}
+
+	(void)free(referenced);
+	return valid;
+}
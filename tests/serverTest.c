@@ -0,0 +1,192 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/modules.h"
+
+/**
+ * The test {@code SPACE/tests/serverTest.c} makes sure, that a fatal error
+ * does not end the compile server ("space --server").
+ *
+ * The requests compile sources, whose function bodies end the compilation
+ * (an unfinished string inside of a function), between valid sources on
+ * the same path. With SEMANTIC_PARALLEL_BODIES 1 the bodies of the other
+ * functions are queued for the parallel check, when the error is thrown.
+ * Every request has to be answered and the server has to exit with 0 on
+ * the final shutdown request.
+ *
+ * Compile and run (from the repository directory, "space.exe" is the
+ * compiler to test):
+ * gcc -O2 tests/serverTest.c -o serverTest.exe
+ * serverTest.exe space.exe
+ *
+ * @version 1.0     14.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+#define true 1
+#define false 0
+
+#define TEST_REQUEST_FILE "serverTest.jsonl"
+#define TEST_LINE_SIZE 4096
+
+struct ServerCase {
+	const char *request;
+	const char *status;
+	const char *severity;
+};
+
+static const struct ServerCase CASES[] = {
+	{"{\"id\": 1, \"method\": \"check\", \"path\": \"fatal.txt\", \"source\": \"function a() {\\n\\tvar x = 1;\\n}\\n\\nfunction b() {\\n\\tvar text = \\\"unfinished;\\n}\\n\"}", "error", "fatal"},
+	{"{\"id\": 2, \"method\": \"check\", \"path\": \"fatal.txt\", \"source\": \"function a() {\\n\\tvar x = 1;\\n}\\n\\nfunction b() {\\n\\tvar text = \\\"finished\\\";\\n}\\n\"}", "ok", NULL},
+	{"{\"id\": 3, \"method\": \"edit\", \"path\": \"fatal.txt\", \"offset\": 66, \"removed\": 1, \"text\": \" \"}", "error", "fatal"},
+	{"{\"id\": 4, \"method\": \"check\", \"path\": \"fatal.txt\", \"source\": \"function a() {\\n\\tvar x = 1;\\n}\\n\"}", "ok", NULL},
+	{"{\"id\": 5, \"method\": \"check\", \"path\": \"other.txt\", \"source\": \"var:int a = 10;\\n\"}", "ok", NULL},
+	{"{\"id\": 6, \"method\": \"shutdown\"}", "ok", NULL}
+};
+
+#define CASE_COUNT (sizeof(CASES) / sizeof(CASES[0]))
+
+int ST_write_requests();
+int ST_check_response(const struct ServerCase *serverCase, size_t index, const char *response);
+
+int main(int argc, char *argv[]) {
+	if (argc != 2) {
+		(void)printf("Usage: %s <compiler>\n", argv[0]);
+		return -1;
+	}
+
+	if (SEMANTIC_PARALLEL_BODIES == 0) {
+		(void)printf("Note: SEMANTIC_PARALLEL_BODIES is 0, the bodies are checked in source order.\n");
+	}
+
+	if ((int)ST_write_requests() == false) {
+		(void)printf("Could not write \"%s\"!\n", TEST_REQUEST_FILE);
+		return -1;
+	}
+
+	char command[TEST_LINE_SIZE];
+	(void)snprintf(command, sizeof(command), "\"%s\" --server < %s", argv[1], TEST_REQUEST_FILE);
+	FILE *server = popen(command, "r");
+
+	if (server == NULL) {
+		(void)printf("Could not start \"%s\"!\n", argv[1]);
+		(void)remove(TEST_REQUEST_FILE);
+		return -1;
+	}
+
+	char line[TEST_LINE_SIZE];
+	size_t answered = 0;
+	int passed = true;
+
+	while (fgets(line, sizeof(line), server) != NULL) {
+		if (answered < CASE_COUNT && (int)ST_check_response(&CASES[answered], answered, line) == false) {
+			passed = false;
+		}
+
+		answered++;
+	}
+
+	int exitCode = pclose(server);
+	(void)remove(TEST_REQUEST_FILE);
+
+	if (answered != CASE_COUNT) {
+		(void)printf("FAILED: %zu responses to %zu requests!\n", answered, CASE_COUNT);
+		return 1;
+	}
+
+	if (exitCode != 0) {
+		(void)printf("FAILED: the server exited with %i!\n", exitCode);
+		return 1;
+	}
+
+	(void)printf("%s: %zu requests\n", passed == true ? "PASSED" : "FAILED", CASE_COUNT);
+	return passed == true ? 0 : 1;
+}
+
+/**
+ * <p>
+ * Writes the requests of the cases into the request file, that the
+ * server reads as stdin.
+ * </p>
+ *
+ * @returns true, if the file was written
+ */
+int ST_write_requests() {
+	FILE *file = fopen(TEST_REQUEST_FILE, "w");
+
+	if (file == NULL) {
+		return false;
+	}
+
+	for (size_t i = 0; i < CASE_COUNT; i++) {
+		(void)fprintf(file, "%s\n", CASES[i].request);
+	}
+
+	return fclose(file) == 0;
+}
+
+/**
+ * <p>
+ * Checks the id, the status and the severity of the last diagnostic of a
+ * response.
+ * </p>
+ *
+ * @returns true, if the response is the expected one
+ *
+ * @param *serverCase   Case, that the response answers
+ * @param index         Index of the case
+ * @param *response     Response line of the server
+ */
+int ST_check_response(const struct ServerCase *serverCase, size_t index, const char *response) {
+	char expected[64];
+	(void)snprintf(expected, sizeof(expected), "{\"id\":%zu,", index + 1);
+
+	if (strncmp(response, expected, strlen(expected)) != 0) {
+		(void)printf("Request %zu: unexpected response %s", index + 1, response);
+		return false;
+	}
+
+	(void)snprintf(expected, sizeof(expected), "\"status\":\"%s\"", serverCase->status);
+
+	if (strstr(response, expected) == NULL) {
+		(void)printf("Request %zu: expected the status \"%s\": %s", index + 1, serverCase->status, response);
+		return false;
+	}
+
+	if (serverCase->severity != NULL) {
+		(void)snprintf(expected, sizeof(expected), "\"severity\":\"%s\"", serverCase->severity);
+
+		if (strstr(response, expected) == NULL) {
+			(void)printf("Request %zu: expected a \"%s\" diagnostic: %s", index + 1, serverCase->severity, response);
+			return false;
+		}
+	}
+
+	return true;
+}